@@ -673,6 +673,52 @@ float DallasTemperature::getTempF(const uint8_t* deviceAddress) {
 	return rawToFahrenheit(getTemp(deviceAddress));
 }
 
+// resolves the device at index for getTemp(const SensorHandle&): the bus
+// is searched here, once, instead of on every read
+bool DallasTemperature::getSensorHandle(SensorHandle& handle, uint8_t index) {
+
+	handle.bitResolution = 0;
+	handle.alone = (devices == 1);
+	if (!getAddress(handle.address, index))
+		return false;
+
+	handle.bitResolution = getResolution(handle.address);
+	return (handle.bitResolution != 0);
+
+}
+
+// returns temperature in 1/128 degrees C or DEVICE_DISCONNECTED_RAW.
+// A sensor alone on its bus is read with skip ROM, saving the 8 address
+// bytes of match ROM. All nine bytes are read and checked by CRC, so the
+// closing reset of readScratchPad() is not needed.
+int16_t DallasTemperature::getTemp(const SensorHandle& handle) {
+
+	ScratchPad scratchPad;
+
+	if (handle.bitResolution == 0 || _wire->reset() == 0)
+		return DEVICE_DISCONNECTED_RAW;
+
+	if (handle.alone)
+		_wire->skip();
+	else
+		_wire->select(handle.address);
+	_wire->write(READSCRATCH);
+
+	for (uint8_t i = 0; i < 9; i++) {
+		scratchPad[i] = _wire->read();
+	}
+
+	if (isAllZeros(scratchPad) || _wire->crc8(scratchPad, 8) != scratchPad[SCRATCHPAD_CRC])
+		return DEVICE_DISCONNECTED_RAW;
+	return calculateTemperature(handle.address, scratchPad);
+
+}
+
+// returns temperature in degrees C for a handle or DEVICE_DISCONNECTED_C
+float DallasTemperature::getTempC(const SensorHandle& handle) {
+	return rawToCelsius(getTemp(handle));
+}
+
 // returns true if the bus requires parasite power
 bool DallasTemperature::isParasitePowerMode(void) {
 	return parasite;
@@ -62,6 +62,13 @@ private:
 
 typedef uint8_t DeviceAddress[8];
 
+// A sensor resolved once by getSensorHandle(), so reads need no bus search
+typedef struct {
+	DeviceAddress address;
+	uint8_t bitResolution; // 0 if the sensor was not found
+	bool alone;            // only device on its bus: reads use skip ROM
+} SensorHandle;
+
 class DallasTemperature {
 public:
 
@@ -152,6 +159,17 @@ public:
 	// Get temperature for device index (slow)
 	float getTempFByIndex(uint8_t);
 
+	// resolves the device at index (address, resolution, alone on the bus)
+	// once, after begin(); returns false if it is not found
+	bool getSensorHandle(SensorHandle&, uint8_t);
+
+	// returns temperature raw value for a handle (fast: no search, skip ROM
+	// when the sensor is alone, no closing reset)
+	int16_t getTemp(const SensorHandle&);
+
+	// returns temperature in degrees C for a handle
+	float getTempC(const SensorHandle&);
+
 	// returns true if the bus requires parasite power
 	bool isParasitePowerMode(void);
 
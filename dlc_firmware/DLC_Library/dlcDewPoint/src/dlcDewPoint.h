@@ -0,0 +1,83 @@
+/*
+  dlcDewPoint.h - Fixed-point August-Roche-Magnus dew point
+  DarkLight Cover Calibrator
+
+  The one dew point kernel of dlc_firmware.ino (the AVR has no FPU: log()
+  and the float divisions of the formula cost hundreds of microseconds) and
+  of the ESP32-S3 port (DewPoint::fixed(), with ENABLE_FIXED_DEW_POINT).
+  dewPointCenti() does it in integer math, ln(RH) from the position of the
+  top bit and a 16-entry table of ln(1 + x) with linear interpolation, and
+  the rest in Q12 (1.0 = 4096). Over -40..85 C and 1..100 %RH it stays
+  within 0.1 C of the float formula, checked by dlc_dew_point_bench in the
+  ESP32-S3 simulator (dlc_firmware_s3/sim).
+
+  Header-only; everything is static so each sketch file gets its own copy.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef DLC_DEW_POINT_H
+#define DLC_DEW_POINT_H
+
+#include <Arduino.h>
+
+//fixed-point forms of the August-Roche-Magnus constants (a = 17.27, b = 237.7) - DO NOT MODIFY
+static const int32_t DEW_ALPHA_Q12 = 70738;              // a * 4096
+static const int32_t DEW_BETA_CENTI = 23770;             // b * 100
+static const uint32_t DEW_ALPHA_BETA_Q12 = 1681440358UL; // a * b * 100 * 4096
+static const int32_t DEW_LN_2_Q16 = 45426;               // ln(2) * 65536
+static const int32_t DEW_LN_10000_Q16 = 603609;          // ln(100 %RH in 0.01 %) * 65536
+
+//ln(1 + i / 16) * 65536, i = 0..16
+static const uint16_t DEW_LN_TABLE[17] PROGMEM = {
+  0, 3973, 7719, 11262, 14624, 17821, 20870, 23783, 26573,
+  29248, 31818, 34292, 36675, 38975, 41196, 43345, 45426
+};
+
+//dew point in 0.01 C from temperature in 0.01 C and relative humidity in 0.01 %,
+//inputs clamped to -40..85 C and 1..100 %RH
+static inline int16_t dewPointCenti(int16_t tempCenti, uint16_t humidityCenti) {
+  if (tempCenti < -4000) tempCenti = -4000;
+  if (tempCenti > 8500) tempCenti = 8500;
+  if (humidityCenti < 100) humidityCenti = 100;
+  if (humidityCenti > 10000) humidityCenti = 10000;
+
+  //a * T / (b + T) = a - a * b / (b + T), Q12
+  uint32_t divisor = (uint32_t)(DEW_BETA_CENTI + tempCenti);
+  int32_t gamma = DEW_ALPHA_Q12 - (int32_t)((DEW_ALPHA_BETA_Q12 + divisor / 2) / divisor);
+
+  //RH = 2^e * (1 + i / 16 + frac / 32768), 1 + ... in [1, 2)
+  uint16_t mantissa = humidityCenti;
+  int8_t exponent = 15;
+  while (mantissa < 0x8000) {
+    mantissa <<= 1;
+    exponent--;
+  }
+  uint8_t i = (mantissa >> 11) & 0x0F;
+  uint32_t frac = mantissa & 0x07FF;
+  uint16_t low = pgm_read_word(&DEW_LN_TABLE[i]);
+  uint16_t high = pgm_read_word(&DEW_LN_TABLE[i + 1]);
+  int32_t lnMantissa = low + (int32_t)(((uint32_t)(high - low) * frac + 1024) >> 11);
+
+  //+ ln(RH / 100 %), never positive; Q16 to Q12
+  int32_t lnRatio = DEW_LN_10000_Q16 - (exponent * DEW_LN_2_Q16 + lnMantissa);
+  if (lnRatio < 0) lnRatio = 0;
+  gamma -= (lnRatio + 8) >> 4;
+
+  //b * gamma / (a - gamma), 0.01 C, rounded
+  int32_t numerator = DEW_BETA_CENTI * gamma;
+  int32_t denominator = DEW_ALPHA_Q12 - gamma;
+  return (int16_t)((numerator + (numerator < 0 ? -denominator : denominator) / 2) / denominator);
+}
+
+//dew point in C from temperature in C and relative humidity in %, same clamping
+static inline float dewPointFixed(float temp, float humidity) {
+  if (temp < -40.0f) temp = -40.0f;
+  if (temp > 85.0f) temp = 85.0f;
+  if (humidity < 1.0f) humidity = 1.0f;
+  if (humidity > 100.0f) humidity = 100.0f;
+  return dewPointCenti((int16_t)lround(temp * 100.0f), (uint16_t)lround(humidity * 100.0f)) / 100.0f;
+}
+
+#endif // DLC_DEW_POINT_H
@@ -4,7 +4,7 @@
   Contributors: Taylor J (Initial Dew Heater Integration)
   Date:         6/27/25
 
-  Version: 1.2.0
+  Version: 1.3.0
   *View GitHub Wiki for version change details
   https://github.com/10thTeeAstronomy/DarkLight_CoverCalibrator/wiki/Firmware-Version-History
   
@@ -94,7 +94,7 @@ const uint32_t debounceDelay = 150; //(ms) debounce time for the buttons *may ne
 //------------ VARIABLE DECLARATION -------------
 
 //----- VERSIONING CONTROL -----
-const char* dlcVersion = "v1.2.0";
+const char* dlcVersion = "v1.3.0";
 
 //----- MEMORY -----
 #ifdef ENABLE_SAVING_TO_MEMORY
@@ -200,6 +200,7 @@ uint8_t heaterState; //reports # 0:NotPresent, 1:Off, 3:On, 4:Unknown, 5:Error,
   #include <Wire.h>
   #include <OneWire.h>
   #include <DallasTemperature.h>
+  #include <dlcDewPoint.h> //fixed-point dew point, no log() on the AVR
   bool autoHeat = false; //true if always on auto control
   bool manualHeat = false; //true if activated
   bool heatOnClose = false; //if true turns heater on after closing from open position
@@ -211,16 +212,17 @@ uint8_t heaterState; //reports # 0:NotPresent, 1:Off, 3:On, 4:Unknown, 5:Error,
   uint32_t previousDewMillis; //timing for dew control
   uint32_t startHeaterTimer;
   float outsideTemp, humidityLevel, dewPoint; //sensors to monitor outdoor environment
+  uint32_t conversionStart; //when the heater sensors were last told to convert
+  uint16_t conversionWait = 0; //ms a conversion takes, longest of the heater sensors
 
   //dew heater system constants - DO NOT MODIFY
-  const float DEW_POINT_ALPHA = 17.27;    // August-Roche-Magnus dew point constant
-  const float DEW_POINT_BETA = 237.7;     // August-Roche-Magnus dew point constant
   const float PWM_MAP_MULTIPLIER = 100.0; // PWM mapping scale factor
   const float PWM_MAP_RANGE = 500.0;      // PWM mapping range value
 
   #ifdef HEATER_ONE_INSTALLED
     OneWire oneWireA(chOneHeatTempSensor); //setup oneWire instance to communicate with sensor one
     DallasTemperature chOneSensor(&oneWireA);
+    SensorHandle chOneHandle; //sensor one resolved once, no bus search on reads
     float heaterOneTemp; //hold heater temp
     uint8_t heaterOnePWM = 0; //PWM value for heater one
   #endif
@@ -228,6 +230,7 @@ uint8_t heaterState; //reports # 0:NotPresent, 1:Off, 3:On, 4:Unknown, 5:Error,
   #ifdef HEATER_TWO_INSTALLED
     OneWire oneWireB(chTwoHeatTempSensor); //setup oneWire instance to communicate with sensor two
     DallasTemperature chTwoSensor(&oneWireB);
+    SensorHandle chTwoHandle; //sensor two resolved once, no bus search on reads
     float heaterTwoTemp; //hold heater temp
     uint8_t heaterTwoPWM = 0; //PWM value for heater two
   #endif
@@ -426,12 +429,17 @@ void initializeVariables(){
 
     #ifdef HEATER_ONE_INSTALLED
       chOneSensor.begin();
+      chOneSensor.setWaitForConversion(false); //conversions run between readings
+      findHeaterSensor(chOneSensor, chOneHandle);
     #endif
 
     #ifdef HEATER_TWO_INSTALLED
       chTwoSensor.begin();
+      chTwoSensor.setWaitForConversion(false); //conversions run between readings
+      findHeaterSensor(chTwoSensor, chTwoHandle);
     #endif
 
+    startConversions(); //the first reading finds its conversion done
     setHeaterState();
   #else
     heaterState = 0; //heater not installed, set reporting to 0:NotPresent
@@ -707,6 +715,13 @@ void initializeVariables(){
           break;
       #endif //HEATER_INSTALLED
 
+      //aggregated status for one-frame polling
+      //format P:L:R:B:S:h1t:h1p:h2t:h2p:o:h:d (fields not installed report "na")
+      case 'U':
+        getStatus();
+        respondToCommand(response);
+        break;
+
       //DLC firmware version
       case 'V':
         respondToCommand(dlcVersion);
@@ -1070,6 +1085,66 @@ void initializeVariables(){
   void getCalibratorState(){
     itoa(calibratorState, response, 10); //convert integer to string
   }
+
+  void getStatus(){
+    char field[10]; //buffer for each value
+    response[0] = '\0'; //clear the response buffer
+
+    snprintf(response, maxNumSendChars, "%d:%d:%d", currentCoverState, calibratorState, heaterState);
+
+    #ifdef LIGHT_INSTALLED
+      itoa(lightValue / brightnessSteps, field, 10);
+      appendStatusField(field);
+    #else
+      appendStatusField("na");
+    #endif
+
+    #ifdef COVER_INSTALLED
+      itoa(primaryServoLastPosition, field, 10);
+      appendStatusField(field);
+    #else
+      appendStatusField("na");
+    #endif
+
+    //heater telemetry, same values as 'Y'
+    #if defined(HEATER_INSTALLED) && defined(HEATER_ONE_INSTALLED)
+      dtostrf(heaterOneTemp, 0, 1, field);
+      appendStatusField(field);
+      itoa(heaterOnePWM, field, 10);
+      appendStatusField(field);
+    #else
+      appendStatusField("na");
+      appendStatusField("na");
+    #endif
+
+    #if defined(HEATER_INSTALLED) && defined(HEATER_TWO_INSTALLED)
+      dtostrf(heaterTwoTemp, 0, 1, field);
+      appendStatusField(field);
+      itoa(heaterTwoPWM, field, 10);
+      appendStatusField(field);
+    #else
+      appendStatusField("na");
+      appendStatusField("na");
+    #endif
+
+    #ifdef HEATER_INSTALLED
+      dtostrf(outsideTemp, 0, 1, field);
+      appendStatusField(field);
+      dtostrf(humidityLevel, 0, 1, field);
+      appendStatusField(field);
+      dtostrf(dewPoint, 0, 1, field);
+      appendStatusField(field);
+    #else
+      appendStatusField("na");
+      appendStatusField("na");
+      appendStatusField("na");
+    #endif
+  }//end of getStatus
+
+  void appendStatusField(const char* field){
+    size_t length = strlen(response);
+    snprintf(response + length, maxNumSendChars - length, ":%s", field);
+  }//end of appendStatusField
 #endif
 
 #ifdef LIGHT_INSTALLED
@@ -1149,7 +1224,8 @@ void initializeVariables(){
     if (!heaterError && (autoHeat || manualHeat)) {
       uint32_t currentDewMillis = millis();
       
-      if (currentDewMillis - previousDewMillis >= dewInterval){
+      //a conversion restarted since the last interval (<E>, sensor search) is read once it is done
+      if (currentDewMillis - previousDewMillis >= dewInterval && conversionsDone()){
         previousDewMillis = currentDewMillis; //update time check
   
         //read sensors and check for errors
@@ -1157,9 +1233,8 @@ void initializeVariables(){
           return; //skip further processing if there's an error
         }
         
-        //calculate dew point
-        float temp = ((DEW_POINT_ALPHA * outsideTemp) / (DEW_POINT_BETA + outsideTemp)) + log(humidityLevel/100.0);
-        dewPoint = (DEW_POINT_BETA * temp) / (DEW_POINT_ALPHA - temp);
+        //calculate dew point (August-Roche-Magnus, fixed-point)
+        dewPoint = dewPointFixed(outsideTemp, humidityLevel);
 
         #ifdef HEATER_ONE_INSTALLED
           activateHeater(heaterOneTemp, chOneHeater, dewPoint, deltaPoint, maxPWM, PWM_MAP_MULTIPLIER, PWM_MAP_RANGE, heaterOnePWM);
@@ -1177,8 +1252,9 @@ void initializeVariables(){
       setHeaterState();
     }
   
-    //if there's a reading issue, attempt to reset the error state
-    if (heaterError || (heaterUnknown && heatOnClose)) {
+    //if there's a reading issue, attempt to reset the error state (once per interval, not every loop)
+    if ((heaterError || (heaterUnknown && heatOnClose)) && millis() - previousDewMillis >= dewInterval) {
+      previousDewMillis = millis();
       readSensors();
     }
   }//end of manageHeat
@@ -1203,23 +1279,28 @@ void initializeVariables(){
     bool errorReading = false;
     static bool lastErrorReading = true; //track the previous state
     
-    #ifdef HEATER_ONE_INSTALLED
-      //read DS18B20 heater temperature
-      chOneSensor.requestTemperatures();
-      heaterOneTemp = chOneSensor.getTempCByIndex(0);
-      if (heaterOneTemp == DEVICE_DISCONNECTED_C) {
-        errorReading = true;
-      }
-    #endif
+    //read the DS18B20 conversions started last time, both channels one after the other;
+    //never wait for one still running, keep the last heater temperatures instead
+    if (conversionsDone()) {
+      #ifdef HEATER_ONE_INSTALLED
+        //read DS18B20 heater temperature
+        heaterOneTemp = readHeaterSensor(chOneSensor, chOneHandle);
+        if (heaterOneTemp == DEVICE_DISCONNECTED_C) {
+          errorReading = true;
+        }
+      #endif
 
-    #ifdef HEATER_TWO_INSTALLED
-      //read DS18B20 heater temperature
-      chTwoSensor.requestTemperatures();
-      heaterTwoTemp = chTwoSensor.getTempCByIndex(0);
-      if (heaterTwoTemp == DEVICE_DISCONNECTED_C) {
-        errorReading = true;
-      }
-    #endif
+      #ifdef HEATER_TWO_INSTALLED
+        //read DS18B20 heater temperature
+        heaterTwoTemp = readHeaterSensor(chTwoSensor, chTwoHandle);
+        if (heaterTwoTemp == DEVICE_DISCONNECTED_C) {
+          errorReading = true;
+        }
+      #endif
+
+      //start the next conversions now, also on a bus just searched again; they are done by the next reading
+      startConversions();
+    }
 
     #ifdef ENABLE_BME280
       //read BME280 outside temperature and humidity
@@ -1268,6 +1349,43 @@ void initializeVariables(){
     return errorReading;
   } //end of readSensors
 
+  //resolve the first sensor on a heater bus once (address, resolution) so reads skip the bus search
+  void findHeaterSensor(DallasTemperature& sensor, SensorHandle& handle) {
+    sensor.getSensorHandle(handle, 0);
+    uint16_t wait = sensor.millisToWaitForConversion(handle.bitResolution);
+    if (wait > conversionWait) {
+      conversionWait = wait;
+    }
+  }//end of findHeaterSensor
+
+  //read a heater sensor by its handle; if it doesn't answer, search its bus again for a replaced sensor
+  float readHeaterSensor(DallasTemperature& sensor, SensorHandle& handle) {
+    float temp = sensor.getTempC(handle);
+    if (temp == DEVICE_DISCONNECTED_C) {
+      sensor.begin();
+      findHeaterSensor(sensor, handle);
+    }
+    return temp;
+  }//end of readHeaterSensor
+
+  //start a conversion on every heater bus (skip ROM broadcast) without waiting for it
+  void startConversions() {
+    #ifdef HEATER_ONE_INSTALLED
+      chOneSensor.requestTemperatures();
+    #endif
+
+    #ifdef HEATER_TWO_INSTALLED
+      chTwoSensor.requestTemperatures();
+    #endif
+
+    conversionStart = millis();
+  }//end of startConversions
+
+  //true once the conversions started last have had their time (started in initializeVariables and after every reading)
+  bool conversionsDone() {
+    return millis() - conversionStart >= conversionWait;
+  }//end of conversionsDone
+
   void resetErrorReadings(){
     errorCounter = 0;        //reset error counter on successful reading
     heaterUnknown = false;   //clear unknown state
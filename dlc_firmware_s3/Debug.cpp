@@ -7,88 +7,294 @@
 */
 
 #include "Debug.h"
+#include "config.h"
 #include <stdarg.h>
+#include <atomic>
+
+#if defined(LOG_TO_SYSLOG) && defined(ENABLE_WIFI)
+  #include <WiFiUdp.h>
+  #define LOG_SYSLOG_ACTIVE
+#endif
+
+// The memory log is only readable through the Web UI
+#if defined(LOG_TO_MEMORY) && defined(ENABLE_WIFI)
+  #define LOG_MEMORY_ACTIVE
+#endif
 
 DebugLevel Debug::_level = DBG_INFO;
+bool Debug::_networkUp = false;
+// Without the serial protocol no host opts in, and nothing else uses the port
+#ifdef ENABLE_SERIAL_CONTROL
+  bool Debug::_usbFrames = false;
+#else
+  bool Debug::_usbFrames = true;
+#endif
 
-void Debug::begin(DebugLevel level) {
-  _level = level;
+// ============================================================
+// Log queue
+// ============================================================
+// Bounded multi-producer / single-consumer queue (Vyukov). Producers claim a
+// slot with a CAS on _enqueuePos and publish it through the slot sequence;
+// only Debug::loop() consumes. A full queue drops the line and counts it.
+
+struct LogEntry {
+  std::atomic<uint32_t> seq;
+  uint32_t time;
+  DebugLevel level;
+  char module[LOG_MODULE_CHARS];
+  char msg[LOG_MSG_CHARS];
+};
+
+static LogEntry _queue[LOG_QUEUE_SIZE];
+static std::atomic<uint32_t> _enqueuePos(0);
+static uint32_t _dequeuePos = 0;
+static std::atomic<uint32_t> _dropped(0);
+static bool _queueReady = false;
+
+static_assert((LOG_QUEUE_SIZE & (LOG_QUEUE_SIZE - 1)) == 0, "LOG_QUEUE_SIZE must be a power of two");
+
+// Reserve a slot, or nullptr if the queue is full
+static LogEntry* claimEntry(uint32_t& pos) {
+  if (!_queueReady) return nullptr;
+
+  pos = _enqueuePos.load(std::memory_order_relaxed);
+  while (true) {
+    LogEntry& entry = _queue[pos & (LOG_QUEUE_SIZE - 1)];
+    int32_t diff = (int32_t)(entry.seq.load(std::memory_order_acquire) - pos);
+    if (diff == 0) {
+      if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) return &entry;
+    } else if (diff < 0) {
+      _dropped.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    } else {
+      pos = _enqueuePos.load(std::memory_order_relaxed);
+    }
+  }
 }
 
-void Debug::setLevel(DebugLevel level) {
-  _level = level;
+static void publishEntry(LogEntry* entry, uint32_t pos) {
+  entry->seq.store(pos + 1, std::memory_order_release);
 }
 
-DebugLevel Debug::getLevel() {
-  return _level;
+// Oldest published entry, or nullptr if none (consumer only)
+static LogEntry* peekEntry() {
+  LogEntry& entry = _queue[_dequeuePos & (LOG_QUEUE_SIZE - 1)];
+  if (entry.seq.load(std::memory_order_acquire) != _dequeuePos + 1) return nullptr;
+  return &entry;
 }
 
-void Debug::error(const char* module, const char* msg) {
-  log(DBG_ERROR, module, msg);
+static void releaseEntry(LogEntry* entry) {
+  entry->seq.store(_dequeuePos + LOG_QUEUE_SIZE, std::memory_order_release);
+  _dequeuePos++;
 }
 
-void Debug::warning(const char* module, const char* msg) {
-  log(DBG_WARNING, module, msg);
+static uint32_t queuedEntries() {
+  return _enqueuePos.load(std::memory_order_relaxed) - _dequeuePos;
 }
 
-void Debug::info(const char* module, const char* msg) {
-  log(DBG_INFO, module, msg);
+// ============================================================
+// Sinks
+// ============================================================
+
+#ifdef LOG_MEMORY_ACTIVE
+  static char _memory[LOG_MEMORY_SIZE];
+  static uint16_t _memoryHead = 0;
+  static bool _memoryWrapped = false;
+
+  static void memoryAppend(const char* text, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+      _memory[_memoryHead++] = text[i];
+      if (_memoryHead >= LOG_MEMORY_SIZE) {
+        _memoryHead = 0;
+        _memoryWrapped = true;
+      }
+    }
+  }
+#endif
+
+#ifdef LOG_SYSLOG_ACTIVE
+  static WiFiUDP _syslogUdp;
+  static IPAddress _syslogHost;
+  static bool _syslogReady = false;
+
+  // RFC 3164 severity for each debug level (facility local0)
+  static uint8_t syslogPriority(DebugLevel level) {
+    uint8_t severity;
+    switch (level) {
+      case DBG_ERROR:   severity = 3; break;
+      case DBG_WARNING: severity = 4; break;
+      case DBG_INFO:    severity = 6; break;
+      default:          severity = 7; break;
+    }
+    return 16 * 8 + severity;
+  }
+#endif
+
+void Debug::begin(DebugLevel level) {
+  _level = level;
+
+  for (uint32_t i = 0; i < LOG_QUEUE_SIZE; i++) {
+    _queue[i].seq.store(i, std::memory_order_relaxed);
+  }
+  _queueReady = true;
+
+  #ifdef LOG_TO_USB
+    Serial.begin(SERIAL_SPEED);
+  #endif
+
+  #ifdef LOG_TO_UART0
+    Serial0.begin(LOG_UART_SPEED);
+  #endif
+
+  #ifdef LOG_SYSLOG_ACTIVE
+    _syslogReady = _syslogHost.fromString(LOG_SYSLOG_HOST);
+  #endif
 }
 
-void Debug::debug(const char* module, const char* msg) {
-  log(DBG_DEBUG, module, msg);
+void Debug::loop() {
+  // Report lines lost to a full queue once there is room again
+  uint32_t dropped = _dropped.load(std::memory_order_relaxed);
+  if (dropped > 0 && queuedEntries() < LOG_QUEUE_SIZE / 2) {
+    _dropped.fetch_sub(dropped, std::memory_order_relaxed);
+    warningf("DEBUG", "%lu log lines dropped", (unsigned long)dropped);
+  }
+
+  for (uint8_t n = 0; n < LOG_DRAIN_LINES; n++) {
+    LogEntry* entry = peekEntry();
+    if (!entry) break;
+
+    char line[LOG_MODULE_CHARS + LOG_MSG_CHARS + 16];
+    int length = snprintf(line, sizeof(line), "[%s][%s] %s", levelStr(entry->level), entry->module, entry->msg);
+    if (length < 0) length = 0;
+    if ((size_t)length >= sizeof(line)) length = sizeof(line) - 1;
+
+    // USB is shared with protocol replies: only write when the whole frame fits
+    // the CDC buffer. If the host is not reading, keep the line queued until
+    // the queue is half full, then let the other sinks have it without USB.
+    bool toUsb = false;
+    #ifdef LOG_TO_USB
+      if (_usbFrames) {
+        if (Serial.availableForWrite() >= length + 3) {
+          toUsb = true;
+        } else if (queuedEntries() < LOG_QUEUE_SIZE / 2) {
+          break;
+        }
+      }
+    #endif
+
+    writeLine(entry->level, line, (size_t)length, toUsb);
+    releaseEntry(entry);
+  }
 }
 
-void Debug::verbose(const char* module, const char* msg) {
-  log(DBG_VERBOSE, module, msg);
+void Debug::writeLine(DebugLevel level, const char* line, size_t length, bool toUsb) {
+  #ifdef LOG_TO_USB
+    if (toUsb) {
+      // One <#...> frame; the markers must not appear inside it
+      char frame[LOG_MODULE_CHARS + LOG_MSG_CHARS + 20];
+      size_t n = 0;
+      frame[n++] = SERIAL_START_MARKER;
+      frame[n++] = SERIAL_LOG_MARKER;
+      for (size_t i = 0; i < length && n < sizeof(frame) - 1; i++) {
+        char c = line[i];
+        if (c == SERIAL_START_MARKER) c = '(';
+        else if (c == SERIAL_END_MARKER) c = ')';
+        frame[n++] = c;
+      }
+      frame[n++] = SERIAL_END_MARKER;
+      Serial.write((const uint8_t*)frame, n);
+    }
+  #else
+    (void)toUsb;
+  #endif
+
+  #ifdef LOG_TO_UART0
+    Serial0.write((const uint8_t*)line, length);
+    Serial0.write((const uint8_t*)"\r\n", 2);
+  #endif
+
+  #ifdef LOG_MEMORY_ACTIVE
+    memoryAppend(line, length);
+    memoryAppend("\n", 1);
+  #endif
+
+  #ifdef LOG_SYSLOG_ACTIVE
+    if (_networkUp && _syslogReady) {
+      char header[32];
+      snprintf(header, sizeof(header), "<%u>%s dlc: ", syslogPriority(level), MDNS_HOST);
+      _syslogUdp.beginPacket(_syslogHost, LOG_SYSLOG_PORT);
+      _syslogUdp.print(header);
+      _syslogUdp.write((const uint8_t*)line, length);
+      _syslogUdp.endPacket();
+    }
+  #endif
+
+  (void)level;
 }
 
-void Debug::errorf(const char* module, const char* fmt, ...) {
-  va_list args;
-  va_start(args, fmt);
-  logf(DBG_ERROR, module, fmt, args);
-  va_end(args);
+void Debug::setUsbFrames(bool on) {
+  _usbFrames = on;
 }
 
-void Debug::warningf(const char* module, const char* fmt, ...) {
-  va_list args;
-  va_start(args, fmt);
-  logf(DBG_WARNING, module, fmt, args);
-  va_end(args);
+void Debug::setNetworkUp(bool up) {
+  _networkUp = up;
 }
 
-void Debug::infof(const char* module, const char* fmt, ...) {
-  va_list args;
-  va_start(args, fmt);
-  logf(DBG_INFO, module, fmt, args);
-  va_end(args);
+size_t Debug::copyMemoryLog(char* out, size_t size) {
+  if (size == 0) return 0;
+  size_t n = 0;
+
+  #ifdef LOG_MEMORY_ACTIVE
+    // Oldest data starts at the head once wrapped; skip the partial first line
+    uint16_t start = _memoryWrapped ? _memoryHead : 0;
+    uint16_t count = _memoryWrapped ? LOG_MEMORY_SIZE : _memoryHead;
+    bool skipping = _memoryWrapped;
+    for (uint16_t i = 0; i < count && n < size - 1; i++) {
+      char c = _memory[(start + i) % LOG_MEMORY_SIZE];
+      if (skipping) {
+        skipping = (c != '\n');
+        continue;
+      }
+      out[n++] = c;
+    }
+  #endif
+
+  out[n] = '\0';
+  return n;
 }
 
-void Debug::debugf(const char* module, const char* fmt, ...) {
-  va_list args;
-  va_start(args, fmt);
-  logf(DBG_DEBUG, module, fmt, args);
-  va_end(args);
+void Debug::setLevel(DebugLevel level) {
+  _level = level;
 }
 
-void Debug::verbosef(const char* module, const char* fmt, ...) {
-  va_list args;
-  va_start(args, fmt);
-  logf(DBG_VERBOSE, module, fmt, args);
-  va_end(args);
+DebugLevel Debug::getLevel() {
+  return _level;
 }
 
 void Debug::log(DebugLevel level, const char* module, const char* msg) {
   if (level > _level) return;
-  Serial.printf("[%s][%s] %s\n", levelStr(level), module, msg);
+  uint32_t pos;
+  LogEntry* entry = claimEntry(pos);
+  if (!entry) return;
+
+  entry->time = millis();
+  entry->level = level;
+  snprintf(entry->module, sizeof(entry->module), "%s", module);
+  snprintf(entry->msg, sizeof(entry->msg), "%s", msg);
+  publishEntry(entry, pos);
 }
 
 void Debug::logf(DebugLevel level, const char* module, const char* fmt, va_list args) {
   if (level > _level) return;
-  Serial.printf("[%s][%s] ", levelStr(level), module);
-  char buf[256];
-  vsnprintf(buf, sizeof(buf), fmt, args);
-  Serial.println(buf);
+  uint32_t pos;
+  LogEntry* entry = claimEntry(pos);
+  if (!entry) return;
+
+  entry->time = millis();
+  entry->level = level;
+  snprintf(entry->module, sizeof(entry->module), "%s", module);
+  vsnprintf(entry->msg, sizeof(entry->msg), fmt, args);
+  publishEntry(entry, pos);
 }
 
 const char* Debug::levelStr(DebugLevel level) {
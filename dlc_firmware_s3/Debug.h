@@ -2,6 +2,12 @@
   Debug.h - Leveled debug logging
   DarkLight Cover Calibrator - ESP32-S3 Port
 
+  Log calls only format into a lock-free queue; Debug::loop() drains it to
+  the sinks selected in config.h (USB <#...> frames, UART0, UDP syslog,
+  in-memory buffer). Logging never waits on an output, so it cannot delay
+  a serial protocol reply. USB frames only go out once the host has opted
+  in with <N1>, so a driver that does not know them never sees one.
+
   (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
   Creative Commons Attribution-NonCommercial 4.0 International License
 */
@@ -10,6 +16,8 @@
 #define DEBUG_H
 
 #include <Arduino.h>
+#include <stdarg.h>
+#include "config.h"
 
 // Debug levels
 enum DebugLevel : uint8_t {
@@ -24,26 +32,86 @@ enum DebugLevel : uint8_t {
 class Debug {
 public:
   static void begin(DebugLevel level = DBG_INFO);
+  static void loop();  // drain queued lines to the sinks
   static void setLevel(DebugLevel level);
   static DebugLevel getLevel();
 
-  static void error(const char* module, const char* msg);
-  static void warning(const char* module, const char* msg);
-  static void info(const char* module, const char* msg);
-  static void debug(const char* module, const char* msg);
-  static void verbose(const char* module, const char* msg);
+  // Network sinks (syslog) only send while the network is up
+  static void setNetworkUp(bool up);
+
+  // USB <#...> frames, off until the host sends <N1> (on without ENABLE_SERIAL_CONTROL)
+  static void setUsbFrames(bool on);
+
+  // Copy the in-memory log (oldest line first), returns length written
+  static size_t copyMemoryLog(char* out, size_t size);
+
+  // Module tags are string literals checked against LOG_MODULE_CHARS at compile
+  // time, so a long tag fails the build instead of being cut in the log
+  template <size_t N> static void error(const char (&module)[N], const char* msg) {
+    static_assert(N <= LOG_MODULE_CHARS, "Module tag too long, raise LOG_MODULE_CHARS");
+    log(DBG_ERROR, module, msg);
+  }
+  template <size_t N> static void warning(const char (&module)[N], const char* msg) {
+    static_assert(N <= LOG_MODULE_CHARS, "Module tag too long, raise LOG_MODULE_CHARS");
+    log(DBG_WARNING, module, msg);
+  }
+  template <size_t N> static void info(const char (&module)[N], const char* msg) {
+    static_assert(N <= LOG_MODULE_CHARS, "Module tag too long, raise LOG_MODULE_CHARS");
+    log(DBG_INFO, module, msg);
+  }
+  template <size_t N> static void debug(const char (&module)[N], const char* msg) {
+    static_assert(N <= LOG_MODULE_CHARS, "Module tag too long, raise LOG_MODULE_CHARS");
+    log(DBG_DEBUG, module, msg);
+  }
+  template <size_t N> static void verbose(const char (&module)[N], const char* msg) {
+    static_assert(N <= LOG_MODULE_CHARS, "Module tag too long, raise LOG_MODULE_CHARS");
+    log(DBG_VERBOSE, module, msg);
+  }
 
   // Formatted variants
-  static void errorf(const char* module, const char* fmt, ...);
-  static void warningf(const char* module, const char* fmt, ...);
-  static void infof(const char* module, const char* fmt, ...);
-  static void debugf(const char* module, const char* fmt, ...);
-  static void verbosef(const char* module, const char* fmt, ...);
+  template <size_t N> static void errorf(const char (&module)[N], const char* fmt, ...) {
+    static_assert(N <= LOG_MODULE_CHARS, "Module tag too long, raise LOG_MODULE_CHARS");
+    va_list args;
+    va_start(args, fmt);
+    logf(DBG_ERROR, module, fmt, args);
+    va_end(args);
+  }
+  template <size_t N> static void warningf(const char (&module)[N], const char* fmt, ...) {
+    static_assert(N <= LOG_MODULE_CHARS, "Module tag too long, raise LOG_MODULE_CHARS");
+    va_list args;
+    va_start(args, fmt);
+    logf(DBG_WARNING, module, fmt, args);
+    va_end(args);
+  }
+  template <size_t N> static void infof(const char (&module)[N], const char* fmt, ...) {
+    static_assert(N <= LOG_MODULE_CHARS, "Module tag too long, raise LOG_MODULE_CHARS");
+    va_list args;
+    va_start(args, fmt);
+    logf(DBG_INFO, module, fmt, args);
+    va_end(args);
+  }
+  template <size_t N> static void debugf(const char (&module)[N], const char* fmt, ...) {
+    static_assert(N <= LOG_MODULE_CHARS, "Module tag too long, raise LOG_MODULE_CHARS");
+    va_list args;
+    va_start(args, fmt);
+    logf(DBG_DEBUG, module, fmt, args);
+    va_end(args);
+  }
+  template <size_t N> static void verbosef(const char (&module)[N], const char* fmt, ...) {
+    static_assert(N <= LOG_MODULE_CHARS, "Module tag too long, raise LOG_MODULE_CHARS");
+    va_list args;
+    va_start(args, fmt);
+    logf(DBG_VERBOSE, module, fmt, args);
+    va_end(args);
+  }
 
 private:
   static DebugLevel _level;
+  static bool _networkUp;
+  static bool _usbFrames;
   static void log(DebugLevel level, const char* module, const char* msg);
   static void logf(DebugLevel level, const char* module, const char* fmt, va_list args);
+  static void writeLine(DebugLevel level, const char* line, size_t length, bool toUsb);
   static const char* levelStr(DebugLevel level);
 };
 
@@ -0,0 +1,158 @@
+/*
+  alpaca_batch.cpp - Script parser for the Alpaca "Batch" action
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#include "alpaca_batch.h"
+
+#ifdef COVER_INSTALLED
+  #include "easing.h"
+#endif
+
+static const size_t BATCH_STEP_LEN = 48;    // longest step text kept
+static const size_t BATCH_TOKEN_LEN = 24;
+
+// Parses one step ("op" or "op arg") into command. Returns 0, or an ASCOM
+// error number with reason set.
+static int parseStep(const char* op, const char* arg, const CoverCalibratorSnapshot& device,
+                     AlpacaCommand& command, const char*& reason) {
+  bool hasArg = arg[0] != '\0';
+  uint16_t maxBrightness = device.maxBrightness;
+  command.value = 0;
+
+  if (strcasecmp(op, "open") == 0 || strcasecmp(op, "close") == 0 || strcasecmp(op, "halt") == 0 ||
+      strcasecmp(op, "easing") == 0 || (strcasecmp(op, "wait") == 0 && strcasecmp(arg, "cover") == 0)) {
+    if (device.coverState == COVER_NOT_PRESENT) {
+      reason = "cover is not present";
+      return 0x400;
+    }
+  }
+  if (strcasecmp(op, "on") == 0 || strcasecmp(op, "off") == 0 ||
+      (strcasecmp(op, "wait") == 0 && strcasecmp(arg, "calibrator") == 0)) {
+    if (device.calibratorState == CAL_NOT_PRESENT) {
+      reason = "calibrator is not present";
+      return 0x400;
+    }
+  }
+
+  if (strcasecmp(op, "open") == 0)  command.type = ALPACA_CMD_OPEN_COVER;
+  else if (strcasecmp(op, "close") == 0) command.type = ALPACA_CMD_CLOSE_COVER;
+  else if (strcasecmp(op, "halt") == 0)  command.type = ALPACA_CMD_HALT_COVER;
+  else if (strcasecmp(op, "off") == 0)   command.type = ALPACA_CMD_CALIBRATOR_OFF;
+  else if (strcasecmp(op, "on") == 0) {
+    command.type = ALPACA_CMD_CALIBRATOR_ON;
+    if (strcasecmp(arg, "broadband") == 0) {
+      command.value = BATCH_BRIGHTNESS_BROADBAND;
+    } else if (strcasecmp(arg, "narrowband") == 0) {
+      command.value = BATCH_BRIGHTNESS_NARROWBAND;
+    } else {
+      char* end;
+      long brightness = strtol(arg, &end, 10);
+      if (!hasArg || *end != '\0' || brightness < 0 || brightness > maxBrightness) {
+        reason = "on needs a brightness from 0 to MaxBrightness, broadband or narrowband";
+        return 0x401;
+      }
+      command.value = brightness;
+    }
+    return 0;
+  }
+  else if (strcasecmp(op, "easing") == 0) {
+    command.type = ALPACA_CMD_SET_EASING;
+    #ifdef COVER_INSTALLED
+      EasingProfile profile;
+      if (!Easing::fromName(arg, profile)) {
+        reason = "unknown easing profile";
+        return 0x401;
+      }
+      command.value = profile;
+    #endif
+    return 0;
+  }
+  else if (strcasecmp(op, "wait") == 0) {
+    if (strcasecmp(arg, "cover") == 0) {
+      command.type = ALPACA_CMD_WAIT_COVER;
+    } else if (strcasecmp(arg, "calibrator") == 0) {
+      command.type = ALPACA_CMD_WAIT_CALIBRATOR;
+    } else {
+      char* end;
+      long ms = strtol(arg, &end, 10);
+      if (!hasArg || *end != '\0' || ms < 0 || ms > (long)ALPACA_BATCH_WAIT_TIMEOUT) {
+        reason = "wait needs cover, calibrator or a time in ms";
+        return 0x401;
+      }
+      command.type = ALPACA_CMD_WAIT_TIME;
+      command.value = ms;
+    }
+    return 0;
+  }
+  else {
+    reason = "unknown operation";
+    return 0x401;
+  }
+
+  // open, close, halt and off take no argument
+  if (hasArg) {
+    reason = "unexpected argument";
+    return 0x401;
+  }
+  return 0;
+}
+
+int parseAlpacaBatch(const char* script, const CoverCalibratorSnapshot& device, AlpacaBatch& batch,
+                     char* message, size_t messageSize) {
+  batch.count = 0;
+  const char* p = script;
+
+  while (*p) {
+    size_t length = strcspn(p, ";,\n");
+    char step[BATCH_STEP_LEN];
+    snprintf(step, sizeof(step), "%.*s", (int)length, p);
+    p += length;
+    if (*p) p++;
+
+    char op[BATCH_TOKEN_LEN] = "";
+    char arg[BATCH_TOKEN_LEN] = "";
+    char extra[2] = "";
+    int tokens = sscanf(step, "%23s %23s %1s", op, arg, extra);
+    if (tokens <= 0) continue;  // blank step
+
+    if (batch.count == ALPACA_BATCH_MAX_STEPS) {
+      snprintf(message, messageSize, "More than %d steps", ALPACA_BATCH_MAX_STEPS);
+      return 0x401;
+    }
+
+    AlpacaCommand& command = batch.steps[batch.count];
+    command.id = batch.count + 1;
+    const char* reason = "unexpected argument";
+    int errorNumber = tokens > 2 ? 0x401 : parseStep(op, arg, device, command, reason);
+    if (errorNumber != 0) {
+      snprintf(message, messageSize, "Step %d (%s): %s", batch.count + 1, op, reason);
+      return errorNumber;
+    }
+    batch.count++;
+  }
+
+  if (batch.count == 0) {
+    snprintf(message, messageSize, "Batch needs at least one step");
+    return 0x401;
+  }
+  return 0;
+}
+
+const char* alpacaBatchStepName(AlpacaCommandType type) {
+  switch (type) {
+    case ALPACA_CMD_OPEN_COVER:      return "open";
+    case ALPACA_CMD_CLOSE_COVER:     return "close";
+    case ALPACA_CMD_HALT_COVER:      return "halt";
+    case ALPACA_CMD_CALIBRATOR_ON:   return "on";
+    case ALPACA_CMD_CALIBRATOR_OFF:  return "off";
+    case ALPACA_CMD_SET_EASING:      return "easing";
+    case ALPACA_CMD_WAIT_COVER:      return "wait cover";
+    case ALPACA_CMD_WAIT_CALIBRATOR: return "wait calibrator";
+    case ALPACA_CMD_WAIT_TIME:       return "wait";
+    default:                         return "?";
+  }
+}
@@ -0,0 +1,38 @@
+/*
+  alpaca_batch.h - Script parser for the Alpaca "Batch" action
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  A batch is a short list of steps, separated by ';', ',' or new lines,
+  that loop() runs in order for a single Action request:
+
+    open | close | halt
+    on <brightness | broadband | narrowband> | off
+    easing <name | 0-7>
+    wait cover | wait calibrator | wait <ms>
+
+  Example: "close; wait cover; on narrowband; wait calibrator". The whole
+  script is checked before anything runs.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef ALPACA_BATCH_H
+#define ALPACA_BATCH_H
+
+#include <Arduino.h>
+#include "alpaca_handler.h"
+
+// ALPACA_CMD_CALIBRATOR_ON values for the saved flat presets, resolved by loop()
+const int32_t BATCH_BRIGHTNESS_BROADBAND  = -1;
+const int32_t BATCH_BRIGHTNESS_NARROWBAND = -2;
+
+// Checks the script against the device it was sent to (parts present,
+// MaxBrightness). Returns 0, or an ASCOM error number with the reason in message.
+int parseAlpacaBatch(const char* script, const CoverCalibratorSnapshot& device, AlpacaBatch& batch,
+                     char* message, size_t messageSize);
+
+// Step keyword, for progress and error messages
+const char* alpacaBatchStepName(AlpacaCommandType type);
+
+#endif // ALPACA_BATCH_H
@@ -0,0 +1,144 @@
+/*
+  alpaca_discovery.cpp - ASCOM Alpaca UDP discovery responder
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#include "alpaca_discovery.h"
+#include "Debug.h"
+#include <lwip/sockets.h>
+
+static const char DISCOVERY_QUERY[] = "alpacadiscovery";   // followed by the protocol version digit
+static const size_t DISCOVERY_QUERY_LEN = sizeof(DISCOVERY_QUERY) - 1;
+static const char DISCOVERY_GROUP6[] = "ff12::a1:9aca";
+
+static int openSocket(int family) {
+  int fd = socket(family, SOCK_DGRAM, IPPROTO_UDP);
+  if (fd < 0) return -1;
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+  int on = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+  return fd;
+}
+
+void AlpacaDiscovery::begin() {
+  _replyLength = snprintf(_reply, sizeof(_reply), "{\"AlpacaPort\":%u}", ALPACA_PORT);
+  openIPv4();
+  openIPv6();
+  Debug::infof("ALPACA", "Discovery listener on port %d (IPv4%s)", ALPACA_DISC_PORT,
+               _stats.ipv6 ? ", IPv6" : "");
+}
+
+void AlpacaDiscovery::openIPv4() {
+  _socket4 = openSocket(AF_INET);
+  if (_socket4 < 0) return;
+
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(ALPACA_DISC_PORT);
+  if (bind(_socket4, (sockaddr*)&addr, sizeof(addr)) != 0) {
+    Debug::errorf("ALPACA", "Discovery IPv4 bind failed (%d)", errno);
+    close(_socket4);
+    _socket4 = -1;
+  }
+}
+
+// Optional: without IPv6 (or MLD) on the interface, discovery stays IPv4-only
+void AlpacaDiscovery::openIPv6() {
+  _socket6 = openSocket(AF_INET6);
+  if (_socket6 < 0) return;
+
+  int on = 1;
+  setsockopt(_socket6, IPPROTO_IPV6, IPV6_V6ONLY, &on, sizeof(on));
+
+  sockaddr_in6 addr = {};
+  addr.sin6_family = AF_INET6;
+  addr.sin6_addr = in6addr_any;
+  addr.sin6_port = htons(ALPACA_DISC_PORT);
+
+  ipv6_mreq group = {};
+  inet_pton(AF_INET6, DISCOVERY_GROUP6, &group.ipv6mr_multiaddr);
+  group.ipv6mr_interface = 0;  // every interface
+
+  if (bind(_socket6, (sockaddr*)&addr, sizeof(addr)) != 0 ||
+      setsockopt(_socket6, IPPROTO_IPV6, IPV6_JOIN_GROUP, &group, sizeof(group)) != 0) {
+    Debug::warningf("ALPACA", "Discovery IPv6 unavailable (%d)", errno);
+    close(_socket6);
+    _socket6 = -1;
+    return;
+  }
+  _stats.ipv6 = true;
+}
+
+// Called from loop(): reads whatever is queued, up to DISCOVERY_MAX_PACKETS
+// per call, and never blocks
+void AlpacaDiscovery::loop() {
+  uint8_t budget = DISCOVERY_MAX_PACKETS;
+  if (_socket4 >= 0) budget -= drain(_socket4, budget);
+  if (_socket6 >= 0) drain(_socket6, budget);
+}
+
+uint8_t AlpacaDiscovery::drain(int fd, uint8_t budget) {
+  uint8_t count = 0;
+  char buffer[64];
+
+  while (count < budget) {
+    sockaddr_storage from;
+    socklen_t fromLength = sizeof(from);
+    int n = recvfrom(fd, buffer, sizeof(buffer), MSG_DONTWAIT, (sockaddr*)&from, &fromLength);
+    if (n < 0) break;  // EWOULDBLOCK: queue empty
+    count++;
+    _stats.received++;
+
+    // "alpacadiscovery" + version 1-9; later versions must accept the v1 reply
+    if ((size_t)n <= DISCOVERY_QUERY_LEN || memcmp(buffer, DISCOVERY_QUERY, DISCOVERY_QUERY_LEN) != 0 ||
+        buffer[DISCOVERY_QUERY_LEN] < '1' || buffer[DISCOVERY_QUERY_LEN] > '9') {
+      _stats.ignored++;
+      continue;
+    }
+
+    // Rate limit per source address (any port), IPv4 as ::ffff:a.b.c.d
+    uint8_t address[16] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff};
+    if (from.ss_family == AF_INET) {
+      memcpy(address + 12, &((sockaddr_in*)&from)->sin_addr, 4);
+    } else {
+      memcpy(address, &((sockaddr_in6*)&from)->sin6_addr, 16);
+    }
+    if (!allowReply(address)) {
+      _stats.rateLimited++;
+      continue;
+    }
+
+    if (sendto(fd, _reply, _replyLength, MSG_DONTWAIT, (sockaddr*)&from, fromLength) == (int)_replyLength) {
+      _stats.replied++;
+    } else {
+      _stats.sendFailed++;
+    }
+  }
+  return count;
+}
+
+// True when address has had no reply for DISCOVERY_MIN_INTERVAL. A new
+// address takes the slot with the oldest reply.
+bool AlpacaDiscovery::allowReply(const uint8_t* address) {
+  uint32_t now = millis();
+  Source* oldest = &_sources[0];
+
+  for (Source& source : _sources) {
+    if (memcmp(source.address, address, 16) == 0 && source.lastReply != 0) {
+      if (now - source.lastReply < DISCOVERY_MIN_INTERVAL) return false;
+      source.lastReply = now | 1;  // 0 marks a free slot
+      return true;
+    }
+    if (source.lastReply == 0 || (oldest->lastReply != 0 && now - source.lastReply > now - oldest->lastReply)) {
+      oldest = &source;
+    }
+  }
+
+  memcpy(oldest->address, address, 16);
+  oldest->lastReply = now | 1;
+  return true;
+}
@@ -0,0 +1,55 @@
+/*
+  alpaca_discovery.h - ASCOM Alpaca UDP discovery responder
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Answers "alpacadiscovery1" on ALPACA_DISC_PORT over IPv4 broadcast and
+  the IPv6 multicast group ff12::a1:9aca. loop() drains the non-blocking
+  sockets in bounded batches and replies with a datagram built once at
+  start-up. Each source address gets at most one reply per
+  DISCOVERY_MIN_INTERVAL, so a busy LAN cannot flood loop() or the radio.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef ALPACA_DISCOVERY_H
+#define ALPACA_DISCOVERY_H
+
+#include <Arduino.h>
+#include "config.h"
+
+struct DiscoveryStats {
+  uint32_t received;      // datagrams read, both families
+  uint32_t replied;
+  uint32_t rateLimited;   // valid queries inside a source's interval
+  uint32_t ignored;       // not an Alpaca discovery query
+  uint32_t sendFailed;
+  bool ipv6;              // multicast group joined
+};
+
+class AlpacaDiscovery {
+public:
+  void begin();
+  void loop();
+  const DiscoveryStats& getStats() const { return _stats; }
+
+private:
+  struct Source {
+    uint8_t address[16];  // IPv6, or IPv4-mapped
+    uint32_t lastReply;
+  };
+
+  int _socket4 = -1;
+  int _socket6 = -1;
+  char _reply[32];
+  size_t _replyLength = 0;
+  Source _sources[DISCOVERY_SOURCE_SLOTS] = {};
+  DiscoveryStats _stats = {};
+
+  void openIPv4();
+  void openIPv6();
+  uint8_t drain(int fd, uint8_t budget);
+  bool allowReply(const uint8_t* address);
+};
+
+#endif // ALPACA_DISCOVERY_H
@@ -3,7 +3,26 @@
   DarkLight Cover Calibrator - ESP32-S3 Port
 
   Implements ICoverCalibratorV2 interface with UDP discovery on port 32227
-  and REST API on port 11111. Designed for Conform Universal compliance.
+  (alpaca_discovery.h) and REST API on port 11111. Designed for Conform Universal compliance.
+
+  The REST API is served by esp_http_server from its own task on core 0,
+  with several keep-alive connections open at once. Handlers never touch
+  the controllers: properties come from the deviceState snapshot, and
+  methods are queued to loop(), whose controllers have published the new
+  state by the time the request is answered.
+
+  Every DEVICES entry is its own device number. httpd has one wildcard
+  route per method; dispatch() finds the handler and device number with
+  one perfect-hash probe (alpaca_router.h), so adding devices or members
+  adds neither routes nor lookup time.
+
+  Custom actions: "Easing" reads or sets the cover movement profile.
+  "Batch" runs a script of methods and waits (alpaca_batch.h) on loop()
+  and answers once, when it has finished; the httpd task stays free in
+  the meantime. DeviceState and the "BatchStatus" action report the
+  progress of the latest batch.
+  "WaitForState" (long poll) answers when CoverState or CalibratorState
+  differs from the value the client already knows, or at a timeout.
 
   ASCOM Error Codes:
     0x000 (0)    = Success
@@ -11,17 +30,24 @@
     0x401 (1025) = InvalidValue
     0x407 (1031) = NotConnectedException
     0x40B (1035) = InvalidOperationException
+    0x4FF (1279) = UnspecifiedError (loop() did not run a method in time)
 
   (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
   Creative Commons Attribution-NonCommercial 4.0 International License
 */
 
 #include "alpaca_handler.h"
+#include "alpaca_batch.h"
 #include "Debug.h"
+#include "device_state.h"
+#include "json_writer.h"
 #include <WiFi.h>
+#include <sdkconfig.h>
 
 #ifdef COVER_INSTALLED
   #include "cover_controller.h"
+  #include "easing.h"
+  #include "storage_manager.h"
 #endif
 #ifdef LIGHT_INSTALLED
   #include "light_controller.h"
@@ -36,294 +62,711 @@ AlpacaHandler& getAlpacaHandler() {
   return instance;
 }
 
+constexpr AlpacaHandler::Route AlpacaHandler::_routes[] = {
+  // --- Management API ---
+  {"/management/apiversions", HTTP_GET, &AlpacaHandler::handleApiVersions},
+  {"/management/v1/description", HTTP_GET, &AlpacaHandler::handleDescription},
+  {"/management/v1/configureddevices", HTTP_GET, &AlpacaHandler::handleConfiguredDevices},
+
+  // --- Setup pages (HTML, required by Alpaca spec) ---
+  {"/setup", HTTP_GET, &AlpacaHandler::handleSetupPage},
+  {"/setup/v1/covercalibrator/#/setup", HTTP_GET, &AlpacaHandler::handleDeviceSetupPage},
+
+  // --- Device members ---
+  {"/api/v1/covercalibrator/#/action", HTTP_PUT, &AlpacaHandler::handlePutAction},
+  {"/api/v1/covercalibrator/#/brightness", HTTP_GET, &AlpacaHandler::handleGetBrightness},
+  {"/api/v1/covercalibrator/#/calibratorchanging", HTTP_GET, &AlpacaHandler::handleGetCalibratorChanging},
+  {"/api/v1/covercalibrator/#/calibratoroff", HTTP_PUT, &AlpacaHandler::handlePutCalibratorOff},
+  {"/api/v1/covercalibrator/#/calibratoron", HTTP_PUT, &AlpacaHandler::handlePutCalibratorOn},
+  {"/api/v1/covercalibrator/#/calibratorstate", HTTP_GET, &AlpacaHandler::handleGetCalibratorState},
+  {"/api/v1/covercalibrator/#/closecover", HTTP_PUT, &AlpacaHandler::handlePutCloseCover},
+  {"/api/v1/covercalibrator/#/commandblind", HTTP_PUT, &AlpacaHandler::handlePutCommandBlind},
+  {"/api/v1/covercalibrator/#/commandbool", HTTP_PUT, &AlpacaHandler::handlePutCommandBool},
+  {"/api/v1/covercalibrator/#/commandstring", HTTP_PUT, &AlpacaHandler::handlePutCommandString},
+  {"/api/v1/covercalibrator/#/connect", HTTP_PUT, &AlpacaHandler::handlePutConnect},
+  {"/api/v1/covercalibrator/#/connected", HTTP_GET, &AlpacaHandler::handleGetConnected},
+  {"/api/v1/covercalibrator/#/connected", HTTP_PUT, &AlpacaHandler::handlePutConnected},
+  {"/api/v1/covercalibrator/#/connecting", HTTP_GET, &AlpacaHandler::handleGetConnecting},
+  {"/api/v1/covercalibrator/#/covermoving", HTTP_GET, &AlpacaHandler::handleGetCoverMoving},
+  {"/api/v1/covercalibrator/#/coverstate", HTTP_GET, &AlpacaHandler::handleGetCoverState},
+  {"/api/v1/covercalibrator/#/description", HTTP_GET, &AlpacaHandler::handleGetDescription},
+  {"/api/v1/covercalibrator/#/devicestate", HTTP_GET, &AlpacaHandler::handleGetDeviceState},
+  {"/api/v1/covercalibrator/#/disconnect", HTTP_PUT, &AlpacaHandler::handlePutDisconnect},
+  {"/api/v1/covercalibrator/#/driverinfo", HTTP_GET, &AlpacaHandler::handleGetDriverInfo},
+  {"/api/v1/covercalibrator/#/driverversion", HTTP_GET, &AlpacaHandler::handleGetDriverVersion},
+  {"/api/v1/covercalibrator/#/haltcover", HTTP_PUT, &AlpacaHandler::handlePutHaltCover},
+  {"/api/v1/covercalibrator/#/interfaceversion", HTTP_GET, &AlpacaHandler::handleGetInterfaceVersion},
+  {"/api/v1/covercalibrator/#/maxbrightness", HTTP_GET, &AlpacaHandler::handleGetMaxBrightness},
+  {"/api/v1/covercalibrator/#/name", HTTP_GET, &AlpacaHandler::handleGetName},
+  {"/api/v1/covercalibrator/#/opencover", HTTP_PUT, &AlpacaHandler::handlePutOpenCover},
+  {"/api/v1/covercalibrator/#/supportedactions", HTTP_GET, &AlpacaHandler::handleGetSupportedActions},
+};
+
+constexpr AlpacaRouteTable AlpacaHandler::_routeTable = buildAlpacaRouteTable(AlpacaHandler::_routes);
+
 void AlpacaHandler::begin() {
-  // Generate unique ID from MAC address (UUID-like format)
+  // The server and discovery sockets survive WiFi reconnects
+  if (_running) return;
+
+  // Generate unique IDs from MAC address (UUID-like format), device number in the third group
   uint8_t mac[6];
   WiFi.macAddress(mac);
-  char macStr[40];
-  snprintf(macStr, sizeof(macStr), "%02x%02x%02x%02x-%02x%02x-0000-0000-%02x%02x%02x%02x%02x%02x",
-           mac[0], mac[1], mac[2], mac[3], mac[4], mac[5],
-           mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
-  _uniqueID = String(macStr);
-
-  setupRoutes();
-  _server.begin();
-  startDiscovery();
+  for (uint8_t d = 0; d < DEVICE_COUNT; d++) {
+    snprintf(_uniqueIDs[d], sizeof(_uniqueIDs[d]), "%02x%02x%02x%02x-%02x%02x-%04x-0000-%02x%02x%02x%02x%02x%02x",
+             mac[0], mac[1], mac[2], mac[3], mac[4], mac[5], d,
+             mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+  }
+
+  _commands = xQueueCreate(ALPACA_COMMAND_QUEUE, sizeof(AlpacaCommand));
+  _results = xQueueCreate(ALPACA_COMMAND_QUEUE, sizeof(AlpacaCommandResult));
+  _waitQueue = xQueueCreate(ALPACA_MAX_WAITS, sizeof(AlpacaWait));
+
+  if (!startServer()) {
+    Debug::errorf("ALPACA", "Server failed to start on port %d", ALPACA_PORT);
+    return;
+  }
+  _discovery.begin();
   _running = true;
 
-  Debug::infof("ALPACA", "Server started on port %d, ID=%s", ALPACA_PORT, _uniqueID.c_str());
+  Debug::infof("ALPACA", "Server started on port %d, %d device(s), ID=%s", ALPACA_PORT, DEVICE_COUNT, _uniqueIDs[0]);
 }
 
+// Runs the methods queued by the server task. Requests themselves are
+// served by the httpd task.
 void AlpacaHandler::loop() {
   if (!_running) return;
-  _server.handleClient();
-  handleDiscovery();
+  runCommands();
+  runBatch();
+  runWaits();
+  _discovery.loop();
+}
+
+bool AlpacaHandler::startServer() {
+  httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+  config.server_port = ALPACA_PORT;
+  config.task_priority = ALPACA_TASK_PRIORITY;
+  config.stack_size = ALPACA_TASK_STACK;
+  config.core_id = ALPACA_TASK_CORE;
+  config.max_open_sockets = ALPACA_MAX_CLIENTS;
+  config.max_uri_handlers = ALPACA_MAX_ROUTES;
+  config.lru_purge_enable = true;  // a new client closes the longest idle keep-alive connection
+  config.uri_match_fn = httpd_uri_match_wildcard;
+
+  static_assert((ALPACA_MAX_CLIENTS + HTTPD_OWN_SOCKETS) + (WEB_EVENTS_MAX_CLIENTS + 1 + HTTPD_OWN_SOCKETS) +
+                WEB_SERVER_SOCKETS + DISCOVERY_SOCKETS + SYSLOG_SOCKETS <= CONFIG_LWIP_MAX_SOCKETS,
+                "The servers need more sockets than lwIP has, see SOCKET BUDGET in config.h");
+  // Held waits and batches keep their sockets; one more must serve everyone else
+  static_assert(ALPACA_MAX_WAITS + ALPACA_MAX_BATCHES < ALPACA_MAX_CLIENTS,
+                "Held requests can take every Alpaca socket, lower ALPACA_MAX_WAITS");
+  static_assert(_routeTable.valid, "No hash seed separates the Alpaca routes, raise ALPACA_ROUTE_SLOTS");
+
+  if (httpd_start(&_server, &config) != ESP_OK) return false;
+
+  const httpd_method_t methods[] = {HTTP_GET, HTTP_PUT};
+  for (httpd_method_t method : methods) {
+    httpd_uri_t uri = {};
+    uri.uri = "/*";
+    uri.method = method;
+    uri.handler = dispatch;
+    httpd_register_uri_handler(_server, &uri);
+  }
+  return true;
+}
+
+// httpd entry point for every request: finds the route, reads the
+// arguments, then calls the handler
+esp_err_t AlpacaHandler::dispatch(httpd_req_t* req) {
+  AlpacaRequest request;
+  request.req = req;
+  request.device = 0;
+
+  RouteHandler handler = findRoute(req, request.device);
+  if (!handler) return ESP_OK;  // error reply sent
+
+  // An oversized query is cut short; the Alpaca arguments come first
+  esp_err_t err = httpd_req_get_url_query_str(req, request.query, sizeof(request.query));
+  if (err != ESP_OK && err != ESP_ERR_HTTPD_RESULT_TRUNC) request.query[0] = '\0';
+
+  // Form body of a PUT; anything past the buffer is discarded by httpd
+  size_t received = 0;
+  while (received < req->content_len && received < sizeof(request.body) - 1) {
+    int n = httpd_req_recv(req, request.body + received, sizeof(request.body) - 1 - received);
+    if (n == HTTPD_SOCK_ERR_TIMEOUT) continue;
+    if (n <= 0) return ESP_FAIL;  // closes the connection
+    received += n;
+  }
+  request.body[received] = '\0';
+  request.clientTransactionID = parseClientTransactionID(request);
+
+  AlpacaHandler& alpaca = getAlpacaHandler();
+  (alpaca.*handler)(request);
+  return ESP_OK;
+}
+
+// One hash probe (alpaca_router.h). Replies 400 to an unknown device
+// number (Alpaca spec), 405 to a known path under the other method and
+// 404 otherwise, as httpd does.
+AlpacaHandler::RouteHandler AlpacaHandler::findRoute(httpd_req_t* req, uint8_t& device) {
+  uint32_t number;
+  int index = findAlpacaRoute(_routes, _routeTable, req->uri, (httpd_method_t)req->method, number);
+
+  if (index < 0) {
+    httpd_method_t other = req->method == HTTP_GET ? HTTP_PUT : HTTP_GET;
+    bool otherMethod = findAlpacaRoute(_routes, _routeTable, req->uri, other, number) >= 0;
+    httpd_resp_send_err(req, otherMethod ? HTTPD_405_METHOD_NOT_ALLOWED : HTTPD_404_NOT_FOUND, nullptr);
+    return nullptr;
+  }
+  if (number != ALPACA_ROUTE_NO_DEVICE) {
+    if (number >= DEVICE_COUNT) {
+      httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Unknown device number");
+      return nullptr;
+    }
+    device = (uint8_t)number;
+  }
+  return _routes[index].handler;
 }
 
 // ============================================================
-// Discovery
+// Controller State and Commands
 // ============================================================
 
-void AlpacaHandler::startDiscovery() {
-  _udp.begin(ALPACA_DISC_PORT);
-  Debug::infof("ALPACA", "Discovery listener on port %d", ALPACA_DISC_PORT);
+// Called from loop(): runs each queued method. The controllers publish
+// as they change, so the reply goes out after the new state is readable.
+void AlpacaHandler::runCommands() {
+  AlpacaCommand command;
+  while (xQueueReceive(_commands, &command, 0) == pdTRUE) {
+    // A batch answers its own request when it finishes
+    if (command.type == ALPACA_CMD_RUN_BATCH) {
+      startBatch();
+      continue;
+    }
+    AlpacaCommandResult result = {command.id, executeCommand(command)};
+    xQueueSend(_results, &result, 0);
+  }
 }
 
-void AlpacaHandler::handleDiscovery() {
-  int packetSize = _udp.parsePacket();
-  if (packetSize > 0) {
-    char buffer[64];
-    int len = _udp.read(buffer, sizeof(buffer) - 1);
-    buffer[len] = '\0';
+int AlpacaHandler::executeCommand(const AlpacaCommand& command) {
+  // The controllers of the device the request was sent to
+  #ifdef COVER_INSTALLED
+    CoverController& cover = covers[command.device];
+  #endif
+  #ifdef LIGHT_INSTALLED
+    LightController& light = lights[command.device];
+  #endif
+
+  switch (command.type) {
+    #ifdef COVER_INSTALLED
+      case ALPACA_CMD_OPEN_COVER:
+        cover.openCover();
+        return 0;
+      case ALPACA_CMD_CLOSE_COVER:
+        cover.closeCover();
+        return 0;
+      case ALPACA_CMD_HALT_COVER:
+        // Checked here so the state cannot change between check and halt
+        if (cover.getState() != COVER_MOVING) return 0x400;
+        cover.haltCover();
+        return 0;
+      case ALPACA_CMD_SET_EASING:
+        cover.setEasing((EasingProfile)command.value);
+        #ifdef ENABLE_SAVING_TO_MEMORY
+          deviceStorage[command.device].saveEasing((EasingProfile)command.value);
+        #endif
+        return 0;
+    #endif
+
+    #ifdef LIGHT_INSTALLED
+      case ALPACA_CMD_CALIBRATOR_ON:
+        if (command.value == BATCH_BRIGHTNESS_BROADBAND) {
+          light.turnPanelTo(light.getBroadbandStep());
+        } else if (command.value == BATCH_BRIGHTNESS_NARROWBAND) {
+          light.turnPanelTo(light.getNarrowbandStep());
+        } else {
+          light.turnPanelTo((uint16_t)command.value);
+        }
+        return 0;
+      case ALPACA_CMD_CALIBRATOR_OFF:
+        light.turnPanelOff();
+        return 0;
+    #endif
+
+    default:
+      return 0x400;
+  }
+}
+
+// Called from the server task: queues a method for loop() and waits for
+// it to run, so a CoverState read right after OpenCover already says
+// Moving. Returns the ASCOM error number (0x4FF if loop() did not answer).
+int AlpacaHandler::runCommand(uint8_t device, AlpacaCommandType type, int32_t value) {
+  AlpacaCommand command = {++_nextCommandID, type, device, value};
+  uint32_t start = millis();
+
+  if (xQueueSend(_commands, &command, pdMS_TO_TICKS(ALPACA_COMMAND_TIMEOUT)) != pdTRUE) return 0x4FF;
+
+  // Skip late results of earlier commands that timed out
+  AlpacaCommandResult result;
+  while (true) {
+    uint32_t waited = millis() - start;
+    if (waited >= ALPACA_COMMAND_TIMEOUT) break;
+    if (xQueueReceive(_results, &result, pdMS_TO_TICKS(ALPACA_COMMAND_TIMEOUT - waited)) != pdTRUE) break;
+    if (result.id == command.id) return result.errorNumber;
+  }
+
+  Debug::warningf("ALPACA", "Command %d timed out", (int)type);
+  return 0x4FF;
+}
+
+// ============================================================
+// Batch Action
+// ============================================================
+
+// Server task: takes over the request and queues the parsed batch for
+// loop(), which sends the one reply when the last step is done. The httpd
+// task serves other requests in the meantime. The held request keeps its
+// socket, counted by ALPACA_MAX_BATCHES in the budget checked in startServer().
+void AlpacaHandler::submitBatch(AlpacaRequest& request) {
+  static_assert(ALPACA_MAX_BATCHES == 1, "One batch slot: _batchBusy and _batchRequest");
+  bool idle = false;
+  if (!_batchBusy.compare_exchange_strong(idle, true)) {
+    sendValueResponse(request, 0x40B, "A batch is already running", "");
+    return;
+  }
+
+  char message[96];
+  char script[ALPACA_MAX_ARGS_LEN];
+  findArg(request, "Parameters", true, script, sizeof(script));
+  int errorNumber = parseAlpacaBatch(script, readDevice(request), _batch,
+                                     message, sizeof(message));
+  if (errorNumber != 0) {
+    _batchBusy = false;
+    sendValueResponse(request, errorNumber, message, "");
+    return;
+  }
+
+  for (uint8_t i = 0; i < _batch.count; i++) _batch.steps[i].device = request.device;
+
+  if (!holdRequest(request, _batchRequest)) {
+    _batchBusy = false;
+    return;
+  }
+
+  AlpacaCommand command = {++_nextCommandID, ALPACA_CMD_RUN_BATCH, request.device, 0};
+  if (xQueueSend(_commands, &command, pdMS_TO_TICKS(ALPACA_COMMAND_TIMEOUT)) != pdTRUE) {
+    // Never reached loop(), so the reply is still ours to send
+    answerHeld(_batchRequest, _response, sizeof(_response), 0x4FF, "Controller did not respond in time", "");
+    _batchBusy = false;
+  }
+}
 
-    // Match "alpacadiscovery1" (protocol version 1)
-    if (strstr(buffer, "alpacadiscovery") != nullptr) {
-      char response[64];
-      snprintf(response, sizeof(response), "{\"AlpacaPort\":%d}", ALPACA_PORT);
+void AlpacaHandler::startBatch() {
+  _batchStep = 0;
+  _batchStepStart = millis();
+  deviceState.publishBatch(BATCH_RUNNING, 0, _batch.count);
+  Debug::infof("ALPACA", "Batch started, %d steps", _batch.count);
+  runBatch();
+}
 
-      _udp.beginPacket(_udp.remoteIP(), _udp.remotePort());
-      _udp.print(response);
-      _udp.endPacket();
+// Called from loop(): runs steps until one has to wait, then picks up
+// from there on the next pass
+void AlpacaHandler::runBatch() {
+  if (!_batchBusy || deviceState.read().batchState != BATCH_RUNNING) return;
+
+  while (_batchStep < _batch.count) {
+    const AlpacaCommand& step = _batch.steps[_batchStep];
+    CoverCalibratorSnapshot state = deviceState.read().devices[step.device];
+    bool done = true;
+    int errorNumber = 0;
+    const char* failure = "failed";
+
+    switch (step.type) {
+      case ALPACA_CMD_WAIT_COVER:
+        done = state.coverState != COVER_MOVING;
+        if (state.coverState == COVER_ERROR) {
+          errorNumber = 0x40B;
+          failure = "cover error";
+        }
+        break;
+      case ALPACA_CMD_WAIT_CALIBRATOR:
+        done = state.calibratorState != CAL_NOT_READY;
+        if (state.calibratorState == CAL_ERROR) {
+          errorNumber = 0x40B;
+          failure = "calibrator error";
+        }
+        break;
+      case ALPACA_CMD_WAIT_TIME:
+        done = millis() - _batchStepStart >= (uint32_t)step.value;
+        break;
+      default:
+        errorNumber = executeCommand(step);
+        if (errorNumber == 0x400 && step.type == ALPACA_CMD_HALT_COVER) failure = "cover is not moving";
+        break;
+    }
 
-      Debug::debugf("ALPACA", "Discovery response sent to %s", _udp.remoteIP().toString().c_str());
+    if (!done && millis() - _batchStepStart >= ALPACA_BATCH_WAIT_TIMEOUT) {
+      errorNumber = 0x4FF;
+      failure = "timed out";
     }
+    if (errorNumber != 0) {
+      char message[64];
+      snprintf(message, sizeof(message), "Step %d (%s): %s",
+               _batchStep + 1, alpacaBatchStepName(step.type), failure);
+      finishBatch(errorNumber, message);
+      return;
+    }
+    if (!done) return;
+
+    _batchStep++;
+    _batchStepStart = millis();
+    deviceState.publishBatch(BATCH_RUNNING, _batchStep, _batch.count);
   }
+  finishBatch(0, "");
+}
+
+// Publishes the outcome, answers the held request and frees the batch slot
+void AlpacaHandler::finishBatch(int errorNumber, const char* errorMessage) {
+  deviceState.publishBatch(errorNumber ? BATCH_FAILED : BATCH_DONE, _batchStep, _batch.count);
+
+  char value[16];
+  snprintf(value, sizeof(value), "%d/%d", _batchStep, _batch.count);
+  answerHeld(_batchRequest, _loopResponse, sizeof(_loopResponse), errorNumber, errorMessage, value);
+
+  Debug::infof("ALPACA", "Batch %s after %s steps", errorNumber ? "failed" : "done", value);
+  _batchBusy = false;
 }
 
 // ============================================================
-// Route Setup
+// WaitForState Action
 // ============================================================
 
-void AlpacaHandler::setupRoutes() {
-  // --- Management API ---
-  _server.on("/management/apiversions", HTTP_GET, [this]() { handleApiVersions(); });
-  _server.on("/management/v1/description", HTTP_GET, [this]() { handleDescription(); });
-  _server.on("/management/v1/configureddevices", HTTP_GET, [this]() { handleConfiguredDevices(); });
+// Server task: "<CoverState|CalibratorState> <value> [timeout ms]". Answers
+// at once if the state already differs, otherwise hands the request to
+// loop(), which answers on the first change. The reply's Value is the state
+// (unchanged on timeout).
+void AlpacaHandler::submitWait(AlpacaRequest& request) {
+  char params[ALPACA_MAX_ARGS_LEN];
+  findArg(request, "Parameters", true, params, sizeof(params));
+  char field[24] = "";
+  int value = -1;
+  unsigned long timeout = ALPACA_WAIT_DEFAULT_TIMEOUT;
+  char extra[2] = "";
+  int tokens = sscanf(params, "%23s %d %lu %1s", field, &value, &timeout, extra);
+
+  AlpacaWait wait = {};
+  if (strcasecmp(field, "CoverState") == 0) {
+    wait.field = ALPACA_WAIT_COVER_STATE;
+  } else if (strcasecmp(field, "CalibratorState") == 0) {
+    wait.field = ALPACA_WAIT_CALIBRATOR_STATE;
+  } else {
+    tokens = 0;
+  }
+  if (tokens < 2 || tokens > 3 || value < 0 || value > 255 || timeout > ALPACA_WAIT_MAX_TIMEOUT) {
+    sendValueResponse(request, 0x401, "Parameters: CoverState|CalibratorState <value> [timeout ms]", "");
+    return;
+  }
 
-  // --- Setup pages (HTML, required by Alpaca spec) ---
-  _server.on("/setup", HTTP_GET, [this]() { handleSetupPage(); });
-  _server.on("/setup/v1/covercalibrator/0/setup", HTTP_GET, [this]() { handleDeviceSetupPage(); });
-
-  // --- Common device properties (GET) ---
-  _server.on("/api/v1/covercalibrator/0/connected", HTTP_GET, [this]() { handleGetConnected(); });
-  _server.on("/api/v1/covercalibrator/0/connecting", HTTP_GET, [this]() { handleGetConnecting(); });
-  _server.on("/api/v1/covercalibrator/0/description", HTTP_GET, [this]() { handleGetDescription(); });
-  _server.on("/api/v1/covercalibrator/0/driverinfo", HTTP_GET, [this]() { handleGetDriverInfo(); });
-  _server.on("/api/v1/covercalibrator/0/driverversion", HTTP_GET, [this]() { handleGetDriverVersion(); });
-  _server.on("/api/v1/covercalibrator/0/interfaceversion", HTTP_GET, [this]() { handleGetInterfaceVersion(); });
-  _server.on("/api/v1/covercalibrator/0/name", HTTP_GET, [this]() { handleGetName(); });
-  _server.on("/api/v1/covercalibrator/0/supportedactions", HTTP_GET, [this]() { handleGetSupportedActions(); });
-  _server.on("/api/v1/covercalibrator/0/devicestate", HTTP_GET, [this]() { handleGetDeviceState(); });
-
-  // --- Common device methods (PUT) ---
-  _server.on("/api/v1/covercalibrator/0/connected", HTTP_PUT, [this]() { handlePutConnected(); });
-  _server.on("/api/v1/covercalibrator/0/connect", HTTP_PUT, [this]() { handlePutConnect(); });
-  _server.on("/api/v1/covercalibrator/0/disconnect", HTTP_PUT, [this]() { handlePutDisconnect(); });
-  _server.on("/api/v1/covercalibrator/0/action", HTTP_PUT, [this]() { handlePutAction(); });
-  _server.on("/api/v1/covercalibrator/0/commandblind", HTTP_PUT, [this]() { handlePutCommandBlind(); });
-  _server.on("/api/v1/covercalibrator/0/commandbool", HTTP_PUT, [this]() { handlePutCommandBool(); });
-  _server.on("/api/v1/covercalibrator/0/commandstring", HTTP_PUT, [this]() { handlePutCommandString(); });
-
-  // --- CoverCalibrator properties (GET) ---
-  _server.on("/api/v1/covercalibrator/0/brightness", HTTP_GET, [this]() { handleGetBrightness(); });
-  _server.on("/api/v1/covercalibrator/0/calibratorstate", HTTP_GET, [this]() { handleGetCalibratorState(); });
-  _server.on("/api/v1/covercalibrator/0/coverstate", HTTP_GET, [this]() { handleGetCoverState(); });
-  _server.on("/api/v1/covercalibrator/0/maxbrightness", HTTP_GET, [this]() { handleGetMaxBrightness(); });
-  _server.on("/api/v1/covercalibrator/0/covermoving", HTTP_GET, [this]() { handleGetCoverMoving(); });
-  _server.on("/api/v1/covercalibrator/0/calibratorchanging", HTTP_GET, [this]() { handleGetCalibratorChanging(); });
-
-  // --- CoverCalibrator methods (PUT) ---
-  _server.on("/api/v1/covercalibrator/0/calibratoroff", HTTP_PUT, [this]() { handlePutCalibratorOff(); });
-  _server.on("/api/v1/covercalibrator/0/calibratoron", HTTP_PUT, [this]() { handlePutCalibratorOn(); });
-  _server.on("/api/v1/covercalibrator/0/closecover", HTTP_PUT, [this]() { handlePutCloseCover(); });
-  _server.on("/api/v1/covercalibrator/0/haltcover", HTTP_PUT, [this]() { handlePutHaltCover(); });
-  _server.on("/api/v1/covercalibrator/0/opencover", HTTP_PUT, [this]() { handlePutOpenCover(); });
+  CoverCalibratorSnapshot state = readDevice(request);
+  int current = wait.field == ALPACA_WAIT_COVER_STATE ? (int)state.coverState : (int)state.calibratorState;
+  char text[8];
+  snprintf(text, sizeof(text), "%d", current);
+  if (current != value || timeout == 0) {
+    sendValueResponse(request, 0, "", text);
+    return;
+  }
+
+  if (_waitCount.fetch_add(1) >= ALPACA_MAX_WAITS) {
+    _waitCount--;
+    sendValueResponse(request, 0x40B, "Too many WaitForState requests", "");
+    return;
+  }
+  if (!holdRequest(request, wait.request)) {
+    _waitCount--;
+    return;
+  }
+  wait.device = request.device;
+  wait.value = (uint8_t)value;
+  wait.start = millis();
+  wait.timeout = timeout;
+  xQueueSend(_waitQueue, &wait, 0);  // room for ALPACA_MAX_WAITS, which _waitCount bounds
+}
+
+// Called from loop(): one snapshot read per pass while requests are held
+void AlpacaHandler::runWaits() {
+  while (_waitsHeld < ALPACA_MAX_WAITS && xQueueReceive(_waitQueue, &_waits[_waitsHeld], 0) == pdTRUE) {
+    _waitsHeld++;
+  }
+  if (_waitsHeld == 0) return;
+
+  DeviceSnapshot state = deviceState.read();
+  for (uint8_t i = _waitsHeld; i-- > 0;) {
+    AlpacaWait& wait = _waits[i];
+    const CoverCalibratorSnapshot& device = state.devices[wait.device];
+    int current = wait.field == ALPACA_WAIT_COVER_STATE ? (int)device.coverState : (int)device.calibratorState;
+    if (current == wait.value && millis() - wait.start < wait.timeout) continue;
+
+    char text[8];
+    snprintf(text, sizeof(text), "%d", current);
+    answerHeld(wait.request, _loopResponse, sizeof(_loopResponse), 0, "", text);
+    _waits[i] = _waits[--_waitsHeld];
+    _waitCount--;
+  }
+}
+
+// ============================================================
+// Held Requests
+// ============================================================
+
+// Server task: keeps the request open past the handler's return. On
+// failure an error reply has been sent.
+bool AlpacaHandler::holdRequest(AlpacaRequest& request, AlpacaHeldRequest& held) {
+  held.clientTransactionID = request.clientTransactionID;
+  if (httpd_req_async_handler_begin(request.req, &held.req) != ESP_OK) {
+    sendValueResponse(request, 0x4FF, "Could not hold the request", "");
+    return false;
+  }
+  return true;
+}
+
+// Sends a string-Value reply to a held request and releases it. buffer
+// must belong to the calling task.
+void AlpacaHandler::answerHeld(AlpacaHeldRequest& held, char* buffer, size_t size,
+                               int errorNumber, const char* errorMessage, const char* value) {
+  JsonWriter json = beginResponse(buffer, size);
+  json.field("Value", value);
+  endResponse(held.req, held.clientTransactionID, json, errorNumber, errorMessage);
+  httpd_req_async_handler_complete(held.req);
 }
 
 // ============================================================
 // Response Helpers
 // ============================================================
 
-// Case-insensitive argument lookup — Alpaca GET requests send lowercase
-// query params (e.g. "clienttransactionid") while PUT requests use PascalCase.
-String AlpacaHandler::findArgCaseInsensitive(const char* name) {
-  for (int i = 0; i < _server.args(); i++) {
-    if (_server.argName(i).equalsIgnoreCase(name)) {
-      return _server.arg(i);
+// Decodes one form/query value ('+' and %XX) into out, cut to size
+static void decodeArg(const char* begin, const char* end, char* out, size_t size) {
+  char* decoded = out;
+  size_t len = 0;
+  for (const char* p = begin; p < end && len < size - 1; p++) {
+    if (*p == '+') {
+      decoded[len++] = ' ';
+    } else if (*p == '%' && end - p > 2 && isxdigit((unsigned char)p[1]) && isxdigit((unsigned char)p[2])) {
+      char hex[3] = {p[1], p[2], '\0'};
+      decoded[len++] = (char)strtol(hex, nullptr, 16);
+      p += 2;
+    } else {
+      decoded[len++] = *p;
     }
   }
-  return String();
+  decoded[len] = '\0';
 }
 
-int32_t AlpacaHandler::getClientTransactionID() {
-  String val = findArgCaseInsensitive("ClientTransactionID");
-  if (val.length() > 0) {
-    int32_t id = (int32_t)val.toInt();
-    return (id >= 0) ? id : 0;
+// Finds an argument in the query string, then the form body, and returns
+// its raw (still encoded) value as [begin, end)
+static bool findArgSpan(const AlpacaRequest& request, const char* name, bool ignoreCase,
+                        const char*& begin, const char*& end) {
+  const char* sources[] = {request.query, request.body};
+  size_t nameLen = strlen(name);
+
+  for (const char* p : sources) {
+    while (*p) {
+      const char* argEnd = strchr(p, '&');
+      if (!argEnd) argEnd = p + strlen(p);
+      const char* eq = (const char*)memchr(p, '=', argEnd - p);
+      const char* nameEnd = eq ? eq : argEnd;
+
+      if ((size_t)(nameEnd - p) == nameLen &&
+          (ignoreCase ? strncasecmp(p, name, nameLen) : strncmp(p, name, nameLen)) == 0) {
+        begin = eq ? eq + 1 : argEnd;
+        end = argEnd;
+        return true;
+      }
+      p = *argEnd ? argEnd + 1 : argEnd;
+    }
   }
-  return 0;
+  return false;
 }
 
-int32_t AlpacaHandler::getClientID() {
-  String val = findArgCaseInsensitive("ClientID");
-  if (val.length() > 0) {
-    int32_t id = (int32_t)val.toInt();
-    return (id >= 0) ? id : 0;
+// Leading decimal digits as a uint32 (Alpaca IDs); 0 if absent, negative or too large
+static uint32_t parseID(const char* begin, const char* end) {
+  uint32_t id = 0;
+  for (const char* p = begin; p < end && *p >= '0' && *p <= '9'; p++) {
+    uint32_t digit = *p - '0';
+    if (id > (UINT32_MAX - digit) / 10) return 0;
+    id = id * 10 + digit;
   }
-  return 0;
+  return id;
+}
+
+// Decodes into the caller's buffer, no heap. ignoreCase is for names
+// Alpaca clients send in either case: GET requests send lowercase query
+// params (e.g. "clienttransactionid") while PUT requests use PascalCase.
+bool AlpacaHandler::findArg(const AlpacaRequest& request, const char* name, bool ignoreCase, char* value, size_t size) {
+  const char* begin;
+  const char* end;
+  if (!findArgSpan(request, name, ignoreCase, begin, end)) {
+    value[0] = '\0';
+    return false;
+  }
+  decodeArg(begin, end, value, size);
+  return true;
+}
+
+// Read once per request by dispatch(); every reply echoes it
+uint32_t AlpacaHandler::parseClientTransactionID(const AlpacaRequest& request) {
+  const char* begin;
+  const char* end;
+  if (!findArgSpan(request, "ClientTransactionID", true, begin, end)) return 0;
+  return parseID(begin, end);
+}
+
+uint32_t AlpacaHandler::getClientID(AlpacaRequest& request) {
+  const char* begin;
+  const char* end;
+  if (!findArgSpan(request, "ClientID", true, begin, end)) return 0;
+  return parseID(begin, end);
 }
 
 // Returns false and sends NotConnected error if device is not connected.
 // Caller should return immediately if this returns false.
-bool AlpacaHandler::checkConnected() {
-  if (!_connected) {
-    sendErrorResponse(0x407, "Not connected");
+bool AlpacaHandler::checkConnected(AlpacaRequest& request) {
+  if (!_connected[request.device]) {
+    sendErrorResponse(request, 0x407, "Not connected");
     return false;
   }
   return true;
 }
 
+// State of the device the request was sent to. A cover or panel that is
+// not installed, or not fitted to this device, reads NotPresent.
+CoverCalibratorSnapshot AlpacaHandler::readDevice(const AlpacaRequest& request) {
+  return deviceState.read().devices[request.device];
+}
+
+// Replies are written into _response, which only the server task uses
+JsonWriter AlpacaHandler::beginResponse() {
+  return beginResponse(_response, sizeof(_response));
+}
+
+JsonWriter AlpacaHandler::beginResponse(char* buffer, size_t size) {
+  JsonWriter json(buffer, size);
+  json.beginObject();
+  return json;
+}
+
+// Closes the reply with the fields every Alpaca response carries
+void AlpacaHandler::endResponse(AlpacaRequest& request, JsonWriter& json, int errorNumber, const char* errorMessage) {
+  endResponse(request.req, request.clientTransactionID, json, errorNumber, errorMessage);
+}
+
+void AlpacaHandler::endResponse(httpd_req_t* req, uint32_t clientTransactionID, JsonWriter& json,
+                                int errorNumber, const char* errorMessage) {
+  json.field("ClientTransactionID", clientTransactionID);
+  json.field("ServerTransactionID", ++_serverTransactionID);
+  json.field("ErrorNumber", errorNumber);
+  json.field("ErrorMessage", errorMessage);
+  json.endObject();
+
+  if (json.overflowed()) {
+    Debug::errorf("ALPACA", "Response over %u bytes dropped", (unsigned)sizeof(_response));
+    httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Response too large");
+    return;
+  }
+  httpd_resp_set_type(req, "application/json");
+  httpd_resp_send(req, json.c_str(), json.length());
+}
+
 // Response with a Value field (for property GETs)
-void AlpacaHandler::sendValueResponse(int errorNumber, const char* errorMessage, int value) {
-  JsonDocument doc;
-  doc["Value"] = value;
-  doc["ClientTransactionID"] = getClientTransactionID();
-  doc["ServerTransactionID"] = ++_serverTransactionID;
-  doc["ErrorNumber"] = errorNumber;
-  doc["ErrorMessage"] = errorMessage;
-
-  char buffer[512];
-  serializeJson(doc, buffer, sizeof(buffer));
-  _server.send(200, "application/json", buffer);
-}
-
-void AlpacaHandler::sendValueResponse(int errorNumber, const char* errorMessage, bool value) {
-  JsonDocument doc;
-  doc["Value"] = value;
-  doc["ClientTransactionID"] = getClientTransactionID();
-  doc["ServerTransactionID"] = ++_serverTransactionID;
-  doc["ErrorNumber"] = errorNumber;
-  doc["ErrorMessage"] = errorMessage;
-
-  char buffer[512];
-  serializeJson(doc, buffer, sizeof(buffer));
-  _server.send(200, "application/json", buffer);
-}
-
-void AlpacaHandler::sendValueResponse(int errorNumber, const char* errorMessage, const char* value) {
-  JsonDocument doc;
-  doc["Value"] = value;
-  doc["ClientTransactionID"] = getClientTransactionID();
-  doc["ServerTransactionID"] = ++_serverTransactionID;
-  doc["ErrorNumber"] = errorNumber;
-  doc["ErrorMessage"] = errorMessage;
-
-  char buffer[512];
-  serializeJson(doc, buffer, sizeof(buffer));
-  _server.send(200, "application/json", buffer);
-}
-
-// Response with a Value array
-void AlpacaHandler::sendArrayResponse(JsonArray& arr) {
-  JsonDocument doc;
-  doc["Value"] = arr;
-  doc["ClientTransactionID"] = getClientTransactionID();
-  doc["ServerTransactionID"] = ++_serverTransactionID;
-  doc["ErrorNumber"] = 0;
-  doc["ErrorMessage"] = "";
-
-  char buffer[512];
-  serializeJson(doc, buffer, sizeof(buffer));
-  _server.send(200, "application/json", buffer);
+void AlpacaHandler::sendValueResponse(AlpacaRequest& request, int errorNumber, const char* errorMessage, int value) {
+  JsonWriter json = beginResponse();
+  json.field("Value", value);
+  endResponse(request, json, errorNumber, errorMessage);
 }
 
-// Response for void methods (no Value field)
-void AlpacaHandler::sendMethodResponse(int errorNumber, const char* errorMessage) {
-  JsonDocument doc;
-  doc["ClientTransactionID"] = getClientTransactionID();
-  doc["ServerTransactionID"] = ++_serverTransactionID;
-  doc["ErrorNumber"] = errorNumber;
-  doc["ErrorMessage"] = errorMessage;
+void AlpacaHandler::sendValueResponse(AlpacaRequest& request, int errorNumber, const char* errorMessage, bool value) {
+  JsonWriter json = beginResponse();
+  json.field("Value", value);
+  endResponse(request, json, errorNumber, errorMessage);
+}
+
+void AlpacaHandler::sendValueResponse(AlpacaRequest& request, int errorNumber, const char* errorMessage, const char* value) {
+  JsonWriter json = beginResponse();
+  json.field("Value", value);
+  endResponse(request, json, errorNumber, errorMessage);
+}
 
-  char buffer[256];
-  serializeJson(doc, buffer, sizeof(buffer));
-  _server.send(200, "application/json", buffer);
+// Response for void methods (no Value field)
+void AlpacaHandler::sendMethodResponse(AlpacaRequest& request, int errorNumber, const char* errorMessage) {
+  JsonWriter json = beginResponse();
+  endResponse(request, json, errorNumber, errorMessage);
 }
 
 // Error-only response (no Value field, used for NotConnected etc.)
-void AlpacaHandler::sendErrorResponse(int errorNumber, const char* errorMessage) {
-  sendMethodResponse(errorNumber, errorMessage);
+void AlpacaHandler::sendErrorResponse(AlpacaRequest& request, int errorNumber, const char* errorMessage) {
+  sendMethodResponse(request, errorNumber, errorMessage);
+}
+
+// Response for a method run through runCommand()
+void AlpacaHandler::sendCommandResponse(AlpacaRequest& request, int errorNumber) {
+  sendMethodResponse(request, errorNumber, errorNumber ? "Controller did not respond in time" : "");
 }
 
 // ============================================================
 // Management API
 // ============================================================
 
-void AlpacaHandler::handleApiVersions() {
-  JsonDocument doc;
-  JsonArray versions = doc["Value"].to<JsonArray>();
-  versions.add(1);
-  doc["ClientTransactionID"] = getClientTransactionID();
-  doc["ServerTransactionID"] = ++_serverTransactionID;
-  doc["ErrorNumber"] = 0;
-  doc["ErrorMessage"] = "";
-
-  char buffer[256];
-  serializeJson(doc, buffer, sizeof(buffer));
-  _server.send(200, "application/json", buffer);
-}
-
-void AlpacaHandler::handleDescription() {
-  JsonDocument doc;
-  JsonObject val = doc["Value"].to<JsonObject>();
-  val["ServerName"] = "DarkLight Cover Calibrator";
-  val["Manufacturer"] = "DarkLight";
-  val["ManufacturerVersion"] = DLC_VERSION;
-  val["Location"] = "";
-  doc["ClientTransactionID"] = getClientTransactionID();
-  doc["ServerTransactionID"] = ++_serverTransactionID;
-  doc["ErrorNumber"] = 0;
-  doc["ErrorMessage"] = "";
-
-  char buffer[512];
-  serializeJson(doc, buffer, sizeof(buffer));
-  _server.send(200, "application/json", buffer);
-}
-
-void AlpacaHandler::handleConfiguredDevices() {
-  JsonDocument doc;
-  JsonArray devices = doc["Value"].to<JsonArray>();
-  JsonObject device = devices.add<JsonObject>();
-  device["DeviceName"] = "DarkLight CoverCalibrator";
-  device["DeviceType"] = "CoverCalibrator";
-  device["DeviceNumber"] = 0;
-  device["UniqueID"] = _uniqueID;
-  doc["ClientTransactionID"] = getClientTransactionID();
-  doc["ServerTransactionID"] = ++_serverTransactionID;
-  doc["ErrorNumber"] = 0;
-  doc["ErrorMessage"] = "";
-
-  char buffer[512];
-  serializeJson(doc, buffer, sizeof(buffer));
-  _server.send(200, "application/json", buffer);
+void AlpacaHandler::handleApiVersions(AlpacaRequest& request) {
+  JsonWriter json = beginResponse();
+  json.key("Value");
+  json.beginArray();
+  json.value(1);
+  json.endArray();
+  endResponse(request, json, 0, "");
+}
+
+void AlpacaHandler::handleDescription(AlpacaRequest& request) {
+  JsonWriter json = beginResponse();
+  json.key("Value");
+  json.beginObject();
+  json.field("ServerName", "DarkLight Cover Calibrator");
+  json.field("Manufacturer", "DarkLight");
+  json.field("ManufacturerVersion", DLC_VERSION);
+  json.field("Location", "");
+  json.endObject();
+  endResponse(request, json, 0, "");
+}
+
+void AlpacaHandler::handleConfiguredDevices(AlpacaRequest& request) {
+  JsonWriter json = beginResponse();
+  json.key("Value");
+  json.beginArray();
+  for (uint8_t d = 0; d < DEVICE_COUNT; d++) {
+    json.beginObject();
+    json.field("DeviceName", DEVICES[d].name);
+    json.field("DeviceType", "CoverCalibrator");
+    json.field("DeviceNumber", d);
+    json.field("UniqueID", _uniqueIDs[d]);
+    json.endObject();
+  }
+  json.endArray();
+  endResponse(request, json, 0, "");
 }
 
 // ============================================================
 // Setup Pages (HTML)
 // ============================================================
 
-void AlpacaHandler::handleSetupPage() {
+void AlpacaHandler::handleSetupPage(AlpacaRequest& request) {
   // Redirect to the web UI setup on port 80
   String html = "<html><head><meta http-equiv='refresh' content='0;url=http://";
   html += WiFi.localIP().toString();
   html += "/setup'></head><body><a href='http://";
   html += WiFi.localIP().toString();
   html += "/setup'>Go to setup</a></body></html>";
-  _server.send(200, "text/html", html);
+  httpd_resp_set_type(request.req, "text/html");
+  httpd_resp_send(request.req, html.c_str(), html.length());
 }
 
-void AlpacaHandler::handleDeviceSetupPage() {
-  handleSetupPage(); // Same redirect
+void AlpacaHandler::handleDeviceSetupPage(AlpacaRequest& request) {
+  handleSetupPage(request); // Same redirect
 }
 
 // ============================================================
@@ -333,162 +776,191 @@ void AlpacaHandler::handleDeviceSetupPage() {
 //   InterfaceVersion, Name, SupportedActions
 // ============================================================
 
-void AlpacaHandler::handleGetConnected() {
-  sendValueResponse(0, "", _connected);
+void AlpacaHandler::handleGetConnected(AlpacaRequest& request) {
+  sendValueResponse(request, 0, "", _connected[request.device]);
 }
 
-void AlpacaHandler::handleGetConnecting() {
+void AlpacaHandler::handleGetConnecting(AlpacaRequest& request) {
   // Connection is instantaneous for embedded device
-  sendValueResponse(0, "", false);
+  sendValueResponse(request, 0, "", false);
 }
 
-void AlpacaHandler::handleGetDescription() {
-  sendValueResponse(0, "", "DarkLight Cover Calibrator - ESP32-S3");
+void AlpacaHandler::handleGetDescription(AlpacaRequest& request) {
+  sendValueResponse(request, 0, "", "DarkLight Cover Calibrator - ESP32-S3");
 }
 
-void AlpacaHandler::handleGetDriverInfo() {
-  sendValueResponse(0, "", "DarkLight CoverCalibrator Driver");
+void AlpacaHandler::handleGetDriverInfo(AlpacaRequest& request) {
+  sendValueResponse(request, 0, "", "DarkLight CoverCalibrator Driver");
 }
 
-void AlpacaHandler::handleGetDriverVersion() {
+void AlpacaHandler::handleGetDriverVersion(AlpacaRequest& request) {
   // ASCOM spec requires "n.n" format without prefix
-  sendValueResponse(0, "", "2.0.0");
-}
-
-void AlpacaHandler::handleGetInterfaceVersion() {
-  sendValueResponse(0, "", 2); // ICoverCalibratorV2
+  static_assert(DLC_VERSION[0] == 'v', "DriverVersion is DLC_VERSION without its 'v'");
+  sendValueResponse(request, 0, "", DLC_VERSION + 1);
 }
 
-void AlpacaHandler::handleGetName() {
-  sendValueResponse(0, "", "DarkLight CoverCalibrator");
+void AlpacaHandler::handleGetInterfaceVersion(AlpacaRequest& request) {
+  sendValueResponse(request, 0, "", 2); // ICoverCalibratorV2
 }
 
-void AlpacaHandler::handleGetSupportedActions() {
-  JsonDocument arrDoc;
-  JsonArray arr = arrDoc.to<JsonArray>(); // Empty array
-  sendArrayResponse(arr);
+void AlpacaHandler::handleGetName(AlpacaRequest& request) {
+  sendValueResponse(request, 0, "", DEVICES[request.device].name);
 }
 
-void AlpacaHandler::handleGetDeviceState() {
-  // V2 DeviceState: aggregated operational state as array of {Name, Value} pairs
-  if (!checkConnected()) return;
-
-  JsonDocument doc;
-  JsonArray stateArr = doc["Value"].to<JsonArray>();
-
-  // CoverState
-  JsonObject cs = stateArr.add<JsonObject>();
-  cs["Name"] = "CoverState";
+void AlpacaHandler::handleGetSupportedActions(AlpacaRequest& request) {
+  JsonWriter json = beginResponse();
+  json.key("Value");
+  json.beginArray();
   #ifdef COVER_INSTALLED
-    cs["Value"] = (int)cover.getState();
-  #else
-    cs["Value"] = (int)COVER_NOT_PRESENT;
-  #endif
-
-  // CalibratorState
-  JsonObject cals = stateArr.add<JsonObject>();
-  cals["Name"] = "CalibratorState";
-  #ifdef LIGHT_INSTALLED
-    cals["Value"] = (int)light.getState();
-  #else
-    cals["Value"] = (int)CAL_NOT_PRESENT;
-  #endif
-
-  // Brightness
-  JsonObject br = stateArr.add<JsonObject>();
-  br["Name"] = "Brightness";
-  #ifdef LIGHT_INSTALLED
-    br["Value"] = (int)light.getCurrentBrightness();
-  #else
-    br["Value"] = 0;
-  #endif
-
-  // CoverMoving
-  JsonObject cm = stateArr.add<JsonObject>();
-  cm["Name"] = "CoverMoving";
-  #ifdef COVER_INSTALLED
-    cm["Value"] = (cover.getState() == COVER_MOVING);
-  #else
-    cm["Value"] = false;
-  #endif
-
-  // CalibratorChanging
-  JsonObject cc = stateArr.add<JsonObject>();
-  cc["Name"] = "CalibratorChanging";
-  #ifdef LIGHT_INSTALLED
-    cc["Value"] = (light.getState() == CAL_NOT_READY);
-  #else
-    cc["Value"] = false;
+    if (readDevice(request).coverState != COVER_NOT_PRESENT) json.value("Easing");
   #endif
+  json.value("Batch");
+  json.value("BatchStatus");
+  json.value("WaitForState");
+  json.endArray();
+  endResponse(request, json, 0, "");
+}
 
-  doc["ClientTransactionID"] = getClientTransactionID();
-  doc["ServerTransactionID"] = ++_serverTransactionID;
-  doc["ErrorNumber"] = 0;
-  doc["ErrorMessage"] = "";
+// Appends one {Name, Value} pair of the DeviceState array
+template <typename T>
+static void addStateItem(JsonWriter& json, const char* name, T value) {
+  json.beginObject();
+  json.field("Name", name);
+  json.field("Value", value);
+  json.endObject();
+}
 
-  char buffer[1024];
-  serializeJson(doc, buffer, sizeof(buffer));
-  _server.send(200, "application/json", buffer);
+void AlpacaHandler::handleGetDeviceState(AlpacaRequest& request) {
+  // V2 DeviceState: aggregated operational state as array of {Name, Value} pairs,
+  // then the progress of the latest "Batch" action (BatchState: 0 idle,
+  // 1 running, 2 done, 3 failed; BatchStep of BatchSteps finished)
+  if (!checkConnected(request)) return;
+  DeviceSnapshot snapshot = deviceState.read();
+  const CoverCalibratorSnapshot& state = snapshot.devices[request.device];
+
+  JsonWriter json = beginResponse();
+  json.key("Value");
+  json.beginArray();
+  addStateItem(json, "CoverState", (int)state.coverState);
+  addStateItem(json, "CalibratorState", (int)state.calibratorState);
+  addStateItem(json, "Brightness", (int)state.brightness);
+  addStateItem(json, "CoverMoving", state.coverState == COVER_MOVING);
+  addStateItem(json, "CalibratorChanging", state.calibratorState == CAL_NOT_READY);
+  addStateItem(json, "BatchState", (int)snapshot.batchState);
+  addStateItem(json, "BatchStep", (int)snapshot.batchStep);
+  addStateItem(json, "BatchSteps", (int)snapshot.batchSteps);
+  json.endArray();
+  endResponse(request, json, 0, "");
 }
 
 // ============================================================
 // Common Device Methods (PUT)
 // ============================================================
 
-void AlpacaHandler::handlePutConnected() {
+void AlpacaHandler::handlePutConnected(AlpacaRequest& request) {
   // Read "Connected" from form-encoded body (case-sensitive)
-  if (_server.hasArg("Connected")) {
-    String val = _server.arg("Connected");
+  char val[8];
+  if (findArg(request, "Connected", false, val, sizeof(val))) {
     // Accept "true"/"True"/"TRUE" and "false"/"False"/"FALSE"
-    if (val.equalsIgnoreCase("true")) {
-      _connected = true;
-      Debug::info("ALPACA", "Connected = true");
-    } else if (val.equalsIgnoreCase("false")) {
-      _connected = false;
-      Debug::info("ALPACA", "Connected = false");
+    if (strcasecmp(val, "true") == 0) {
+      _connected[request.device] = true;
+      Debug::infof("ALPACA", "Device %d: Connected = true", request.device);
+    } else if (strcasecmp(val, "false") == 0) {
+      _connected[request.device] = false;
+      Debug::infof("ALPACA", "Device %d: Connected = false", request.device);
     } else {
-      sendMethodResponse(0x401, "Invalid value for Connected parameter");
+      sendMethodResponse(request, 0x401, "Invalid value for Connected parameter");
       return;
     }
-    sendMethodResponse(0, "");
+    sendMethodResponse(request, 0, "");
   } else {
-    sendMethodResponse(0x401, "Connected parameter is required");
+    sendMethodResponse(request, 0x401, "Connected parameter is required");
   }
 }
 
-void AlpacaHandler::handlePutConnect() {
+void AlpacaHandler::handlePutConnect(AlpacaRequest& request) {
   // V2 Connect method - non-blocking, instantaneous for embedded
-  _connected = true;
-  Debug::info("ALPACA", "Connect()");
-  sendMethodResponse(0, "");
+  _connected[request.device] = true;
+  Debug::infof("ALPACA", "Device %d: Connect()", request.device);
+  sendMethodResponse(request, 0, "");
 }
 
-void AlpacaHandler::handlePutDisconnect() {
+void AlpacaHandler::handlePutDisconnect(AlpacaRequest& request) {
   // V2 Disconnect method
-  _connected = false;
-  Debug::info("ALPACA", "Disconnect()");
-  sendMethodResponse(0, "");
+  _connected[request.device] = false;
+  Debug::infof("ALPACA", "Device %d: Disconnect()", request.device);
+  sendMethodResponse(request, 0, "");
 }
 
-void AlpacaHandler::handlePutAction() {
-  if (!checkConnected()) return;
-  // No custom actions supported
-  sendMethodResponse(0x40C, "Action is not implemented in this driver");
+void AlpacaHandler::handlePutAction(AlpacaRequest& request) {
+  if (!checkConnected(request)) return;
+  char action[24];  // longer than any action name, so a cut value never matches one
+  findArg(request, "Action", true, action, sizeof(action));
+
+  #ifdef COVER_INSTALLED
+    // Easing: empty Parameters reads the profile, a name or 0-7 selects it
+    if (strcasecmp(action, "Easing") == 0 && readDevice(request).coverState != COVER_NOT_PRESENT) {
+      char params[24];  // longer than any profile name
+      findArg(request, "Parameters", true, params, sizeof(params));
+      char* name = params;
+      while (isspace((unsigned char)*name)) name++;
+      size_t length = strlen(name);
+      while (length > 0 && isspace((unsigned char)name[length - 1])) name[--length] = '\0';
+      if (length > 0) {
+        EasingProfile profile;
+        if (!Easing::fromName(name, profile)) {
+          sendValueResponse(request, 0x401, "Invalid easing profile", "");
+          return;
+        }
+        int errorNumber = runCommand(request.device, ALPACA_CMD_SET_EASING, profile);
+        if (errorNumber != 0) {
+          sendValueResponse(request, errorNumber, "Controller did not respond in time", "");
+          return;
+        }
+      }
+      sendValueResponse(request, 0, "", Easing::name(readDevice(request).easing));
+      return;
+    }
+  #endif
+
+  // WaitForState: long poll on CoverState or CalibratorState
+  if (strcasecmp(action, "WaitForState") == 0) {
+    submitWait(request);
+    return;
+  }
+
+  // Batch: Parameters is the script; the reply comes when it has finished
+  if (strcasecmp(action, "Batch") == 0) {
+    submitBatch(request);
+    return;
+  }
+
+  // BatchStatus: "<Idle|Running|Done|Failed> <steps finished>/<steps>"
+  if (strcasecmp(action, "BatchStatus") == 0) {
+    static const char* const names[] = {"Idle", "Running", "Done", "Failed"};
+    DeviceSnapshot state = deviceState.read();
+    char value[24];
+    snprintf(value, sizeof(value), "%s %d/%d", names[state.batchState], state.batchStep, state.batchSteps);
+    sendValueResponse(request, 0, "", value);
+    return;
+  }
+
+  sendMethodResponse(request, 0x40C, "Action is not implemented in this driver");
 }
 
-void AlpacaHandler::handlePutCommandBlind() {
-  if (!checkConnected()) return;
-  sendMethodResponse(0x400, "CommandBlind is not implemented");
+void AlpacaHandler::handlePutCommandBlind(AlpacaRequest& request) {
+  if (!checkConnected(request)) return;
+  sendMethodResponse(request, 0x400, "CommandBlind is not implemented");
 }
 
-void AlpacaHandler::handlePutCommandBool() {
-  if (!checkConnected()) return;
-  sendValueResponse(0x400, "CommandBool is not implemented", false);
+void AlpacaHandler::handlePutCommandBool(AlpacaRequest& request) {
+  if (!checkConnected(request)) return;
+  sendValueResponse(request, 0x400, "CommandBool is not implemented", false);
 }
 
-void AlpacaHandler::handlePutCommandString() {
-  if (!checkConnected()) return;
-  sendValueResponse(0x400, "CommandString is not implemented", "");
+void AlpacaHandler::handlePutCommandString(AlpacaRequest& request) {
+  if (!checkConnected(request)) return;
+  sendValueResponse(request, 0x400, "CommandString is not implemented", "");
 }
 
 // ============================================================
@@ -497,67 +969,71 @@ void AlpacaHandler::handlePutCommandString() {
 // return NotPresent - those never throw per spec)
 // ============================================================
 
-void AlpacaHandler::handleGetBrightness() {
+void AlpacaHandler::handleGetBrightness(AlpacaRequest& request) {
   // Per spec: throws PropertyNotImplementedException when CalibratorState is NotPresent
-  #ifdef LIGHT_INSTALLED
-    if (!checkConnected()) return;
-    sendValueResponse(0, "", (int)light.getCurrentBrightness());
-  #else
-    if (!checkConnected()) return;
-    sendValueResponse(0x400, "Calibrator is not present", 0);
-  #endif
+  if (!checkConnected(request)) return;
+  CoverCalibratorSnapshot state = readDevice(request);
+  if (state.calibratorState == CAL_NOT_PRESENT) {
+    sendValueResponse(request, 0x400, "Calibrator is not present", 0);
+    return;
+  }
+  sendValueResponse(request, 0, "", (int)state.brightness);
 }
 
-void AlpacaHandler::handleGetCalibratorState() {
+void AlpacaHandler::handleGetCalibratorState(AlpacaRequest& request) {
   // Per spec: returns NotPresent (0) without throwing, even when not connected
   // Conform Universal expects this to work regardless of connection state
-  #ifdef LIGHT_INSTALLED
-    if (!checkConnected()) return;
-    sendValueResponse(0, "", (int)light.getState());
-  #else
-    sendValueResponse(0, "", (int)CAL_NOT_PRESENT);
-  #endif
+  CoverCalibratorSnapshot state = readDevice(request);
+  if (state.calibratorState == CAL_NOT_PRESENT) {
+    sendValueResponse(request, 0, "", (int)CAL_NOT_PRESENT);
+    return;
+  }
+  if (!checkConnected(request)) return;
+  sendValueResponse(request, 0, "", (int)state.calibratorState);
 }
 
-void AlpacaHandler::handleGetCoverState() {
+void AlpacaHandler::handleGetCoverState(AlpacaRequest& request) {
   // Per spec: returns NotPresent (0) without throwing, even when not connected
-  #ifdef COVER_INSTALLED
-    if (!checkConnected()) return;
-    sendValueResponse(0, "", (int)cover.getState());
-  #else
-    sendValueResponse(0, "", (int)COVER_NOT_PRESENT);
-  #endif
+  CoverCalibratorSnapshot state = readDevice(request);
+  if (state.coverState == COVER_NOT_PRESENT) {
+    sendValueResponse(request, 0, "", (int)COVER_NOT_PRESENT);
+    return;
+  }
+  if (!checkConnected(request)) return;
+  sendValueResponse(request, 0, "", (int)state.coverState);
 }
 
-void AlpacaHandler::handleGetMaxBrightness() {
+void AlpacaHandler::handleGetMaxBrightness(AlpacaRequest& request) {
   // Per spec: throws PropertyNotImplementedException when CalibratorState is NotPresent
-  #ifdef LIGHT_INSTALLED
-    if (!checkConnected()) return;
-    sendValueResponse(0, "", (int)light.getMaxBrightness());
-  #else
-    if (!checkConnected()) return;
-    sendValueResponse(0x400, "Calibrator is not present", 0);
-  #endif
+  if (!checkConnected(request)) return;
+  CoverCalibratorSnapshot state = readDevice(request);
+  if (state.calibratorState == CAL_NOT_PRESENT) {
+    sendValueResponse(request, 0x400, "Calibrator is not present", 0);
+    return;
+  }
+  sendValueResponse(request, 0, "", (int)state.maxBrightness);
 }
 
-void AlpacaHandler::handleGetCoverMoving() {
+void AlpacaHandler::handleGetCoverMoving(AlpacaRequest& request) {
   // V2: returns false when CoverState is NotPresent (never throws)
-  #ifdef COVER_INSTALLED
-    if (!checkConnected()) return;
-    sendValueResponse(0, "", (cover.getState() == COVER_MOVING));
-  #else
-    sendValueResponse(0, "", false);
-  #endif
+  CoverCalibratorSnapshot state = readDevice(request);
+  if (state.coverState == COVER_NOT_PRESENT) {
+    sendValueResponse(request, 0, "", false);
+    return;
+  }
+  if (!checkConnected(request)) return;
+  sendValueResponse(request, 0, "", (state.coverState == COVER_MOVING));
 }
 
-void AlpacaHandler::handleGetCalibratorChanging() {
+void AlpacaHandler::handleGetCalibratorChanging(AlpacaRequest& request) {
   // V2: returns false when CalibratorState is NotPresent (never throws)
-  #ifdef LIGHT_INSTALLED
-    if (!checkConnected()) return;
-    sendValueResponse(0, "", (light.getState() == CAL_NOT_READY));
-  #else
-    sendValueResponse(0, "", false);
-  #endif
+  CoverCalibratorSnapshot state = readDevice(request);
+  if (state.calibratorState == CAL_NOT_PRESENT) {
+    sendValueResponse(request, 0, "", false);
+    return;
+  }
+  if (!checkConnected(request)) return;
+  sendValueResponse(request, 0, "", (state.calibratorState == CAL_NOT_READY));
 }
 
 // ============================================================
@@ -565,78 +1041,77 @@ void AlpacaHandler::handleGetCalibratorChanging() {
 // All require connected state and throw NotImplemented for NotPresent
 // ============================================================
 
-void AlpacaHandler::handlePutCalibratorOff() {
-  if (!checkConnected()) return;
+void AlpacaHandler::handlePutCalibratorOff(AlpacaRequest& request) {
+  if (!checkConnected(request)) return;
 
-  #ifdef LIGHT_INSTALLED
-    light.turnPanelOff();
-    sendMethodResponse(0, "");
-  #else
-    sendMethodResponse(0x400, "CalibratorOff is not implemented - calibrator is not present");
-  #endif
+  if (readDevice(request).calibratorState == CAL_NOT_PRESENT) {
+    sendMethodResponse(request, 0x400, "CalibratorOff is not implemented - calibrator is not present");
+    return;
+  }
+  sendCommandResponse(request, runCommand(request.device, ALPACA_CMD_CALIBRATOR_OFF, 0));
 }
 
-void AlpacaHandler::handlePutCalibratorOn() {
-  if (!checkConnected()) return;
+void AlpacaHandler::handlePutCalibratorOn(AlpacaRequest& request) {
+  if (!checkConnected(request)) return;
 
-  #ifdef LIGHT_INSTALLED
-    // Brightness parameter is required, case-sensitive, in form body
-    if (!_server.hasArg("Brightness")) {
-      sendMethodResponse(0x401, "Brightness parameter is required");
-      return;
-    }
+  CoverCalibratorSnapshot state = readDevice(request);
+  if (state.calibratorState == CAL_NOT_PRESENT) {
+    sendMethodResponse(request, 0x400, "CalibratorOn is not implemented - calibrator is not present");
+    return;
+  }
 
-    int brightness = _server.arg("Brightness").toInt();
+  // Brightness parameter is required, case-sensitive, in form body
+  char val[12];
+  if (!findArg(request, "Brightness", false, val, sizeof(val))) {
+    sendMethodResponse(request, 0x401, "Brightness parameter is required");
+    return;
+  }
 
-    // Validate range: 0 to MaxBrightness (must reject out-of-range, not clamp)
-    if (brightness < 0 || brightness > (int)light.getMaxBrightness()) {
-      char errMsg[80];
-      snprintf(errMsg, sizeof(errMsg), "Brightness must be between 0 and %d", light.getMaxBrightness());
-      sendMethodResponse(0x401, errMsg);
-      return;
-    }
+  int brightness = atoi(val);
 
-    light.turnPanelTo((uint16_t)brightness);
-    sendMethodResponse(0, "");
-  #else
-    sendMethodResponse(0x400, "CalibratorOn is not implemented - calibrator is not present");
-  #endif
+  // Validate range: 0 to MaxBrightness (must reject out-of-range, not clamp)
+  if (brightness < 0 || brightness > (int)state.maxBrightness) {
+    char errMsg[80];
+    snprintf(errMsg, sizeof(errMsg), "Brightness must be between 0 and %d", state.maxBrightness);
+    sendMethodResponse(request, 0x401, errMsg);
+    return;
+  }
+
+  sendCommandResponse(request, runCommand(request.device, ALPACA_CMD_CALIBRATOR_ON, brightness));
 }
 
-void AlpacaHandler::handlePutCloseCover() {
-  if (!checkConnected()) return;
+void AlpacaHandler::handlePutCloseCover(AlpacaRequest& request) {
+  if (!checkConnected(request)) return;
 
-  #ifdef COVER_INSTALLED
-    cover.closeCover();
-    sendMethodResponse(0, "");
-  #else
-    sendMethodResponse(0x400, "CloseCover is not implemented - cover is not present");
-  #endif
+  if (readDevice(request).coverState == COVER_NOT_PRESENT) {
+    sendMethodResponse(request, 0x400, "CloseCover is not implemented - cover is not present");
+    return;
+  }
+  sendCommandResponse(request, runCommand(request.device, ALPACA_CMD_CLOSE_COVER, 0));
 }
 
-void AlpacaHandler::handlePutHaltCover() {
-  if (!checkConnected()) return;
+void AlpacaHandler::handlePutHaltCover(AlpacaRequest& request) {
+  if (!checkConnected(request)) return;
 
-  #ifdef COVER_INSTALLED
-    if (cover.getState() == COVER_MOVING) {
-      cover.haltCover();
-      sendMethodResponse(0, "");
-    } else {
-      // Conform expects MethodNotImplementedException when cover is not moving
-      sendMethodResponse(0x400, "Cover is not moving");
-    }
-  #else
-    sendMethodResponse(0x400, "HaltCover is not implemented - cover is not present");
-  #endif
+  if (readDevice(request).coverState == COVER_NOT_PRESENT) {
+    sendMethodResponse(request, 0x400, "HaltCover is not implemented - cover is not present");
+    return;
+  }
+  int errorNumber = runCommand(request.device, ALPACA_CMD_HALT_COVER, 0);
+  if (errorNumber == 0x400) {
+    // Conform expects MethodNotImplementedException when cover is not moving
+    sendMethodResponse(request, 0x400, "Cover is not moving");
+  } else {
+    sendCommandResponse(request, errorNumber);
+  }
 }
 
-void AlpacaHandler::handlePutOpenCover() {
-  if (!checkConnected()) return;
+void AlpacaHandler::handlePutOpenCover(AlpacaRequest& request) {
+  if (!checkConnected(request)) return;
 
-  #ifdef COVER_INSTALLED
-    cover.openCover();
-    sendMethodResponse(0, "");
-  #else
-    sendMethodResponse(0x400, "OpenCover is not implemented - cover is not present");
-  #endif
+  if (readDevice(request).coverState == COVER_NOT_PRESENT) {
+    sendMethodResponse(request, 0x400, "OpenCover is not implemented - cover is not present");
+    return;
+  }
+  sendCommandResponse(request, runCommand(request.device, ALPACA_CMD_OPEN_COVER, 0));
 }
@@ -3,6 +3,9 @@
   DarkLight Cover Calibrator - ESP32-S3 Port
 
   Implements ICoverCalibratorV2 interface for Conform Universal compliance.
+  The REST API runs on esp_http_server in its own task: requests read a
+  state snapshot published by loop(), and methods are queued to loop().
+  Every DEVICES entry (config.h) is served as its own device number.
 
   (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
   Creative Commons Attribution-NonCommercial 4.0 International License
@@ -12,87 +15,211 @@
 #define ALPACA_HANDLER_H
 
 #include <Arduino.h>
-#include <WebServer.h>
-#include <WiFiUdp.h>
-#include <ArduinoJson.h>
+#include <esp_http_server.h>
+#include <atomic>
 #include "config.h"
+#include "json_writer.h"
+#include "device_state.h"
+#include "alpaca_discovery.h"
+#include "alpaca_router.h"
+
+// Controller methods run by loop() on behalf of the Alpaca task
+enum AlpacaCommandType : uint8_t {
+  ALPACA_CMD_OPEN_COVER,
+  ALPACA_CMD_CLOSE_COVER,
+  ALPACA_CMD_HALT_COVER,
+  ALPACA_CMD_CALIBRATOR_ON,
+  ALPACA_CMD_CALIBRATOR_OFF,
+  ALPACA_CMD_SET_EASING,
+  ALPACA_CMD_RUN_BATCH,
+  // Batch steps that hold the next step (value: ms for WAIT_TIME)
+  ALPACA_CMD_WAIT_COVER,
+  ALPACA_CMD_WAIT_CALIBRATOR,
+  ALPACA_CMD_WAIT_TIME
+};
+
+struct AlpacaCommand {
+  uint32_t id;
+  AlpacaCommandType type;
+  uint8_t device;
+  int32_t value;
+};
+
+struct AlpacaCommandResult {
+  uint32_t id;
+  int errorNumber;
+};
+
+// A request held open (httpd async) until loop() answers it
+struct AlpacaHeldRequest {
+  httpd_req_t* req;
+  uint32_t clientTransactionID;
+};
+
+// WaitForState action: answered once the field differs from value, or at the timeout
+enum AlpacaWaitField : uint8_t {
+  ALPACA_WAIT_COVER_STATE,
+  ALPACA_WAIT_CALIBRATOR_STATE
+};
+
+struct AlpacaWait {
+  AlpacaHeldRequest request;
+  AlpacaWaitField field;
+  uint8_t device;
+  uint8_t value;
+  uint32_t start;
+  uint32_t timeout;
+};
+
+// Steps of a "Batch" action (alpaca_batch.h)
+struct AlpacaBatch {
+  AlpacaCommand steps[ALPACA_BATCH_MAX_STEPS];
+  uint8_t count;
+};
+
+// One Alpaca request: its query string and form body, read once up front
+struct AlpacaRequest {
+  httpd_req_t* req;
+  char query[ALPACA_MAX_ARGS_LEN];
+  char body[ALPACA_MAX_ARGS_LEN];
+  uint32_t clientTransactionID;
+  uint8_t device;                   // "#" segment of the URL, else 0
+};
 
 class AlpacaHandler {
 public:
   void begin();
   void loop();
   bool isRunning() const { return _running; }
+  const DiscoveryStats& getDiscoveryStats() const { return _discovery.getStats(); }
 
 private:
-  WebServer _server;
-  WiFiUDP _udp;
-  bool _running = false;
-  bool _connected = false;
-  uint32_t _serverTransactionID = 0;
-  String _uniqueID;
+  typedef void (AlpacaHandler::*RouteHandler)(AlpacaRequest& request);
+
+  typedef AlpacaRoute<RouteHandler> Route;
 
-  void setupRoutes();
-  void startDiscovery();
-  void handleDiscovery();
+  // Every Alpaca URL, "#" for the device number (alpaca_router.h)
+  static const Route _routes[];
+  static const AlpacaRouteTable _routeTable;
+
+  httpd_handle_t _server = nullptr;
+  AlpacaDiscovery _discovery;
+  bool _running = false;
+  char _uniqueIDs[DEVICE_COUNT][40];
+
+  // Owned by the server task
+  bool _connected[DEVICE_COUNT] = {};
+  uint32_t _nextCommandID = 0;
+  char _response[ALPACA_RESPONSE_LEN];
+
+  // Shared between loop() and the server task
+  std::atomic<uint32_t> _serverTransactionID{0};
+  QueueHandle_t _commands = nullptr;
+  QueueHandle_t _results = nullptr;
+
+  // Batch action: the server task fills these while _batchBusy is clear,
+  // then loop() owns them until it has sent the reply
+  std::atomic<bool> _batchBusy{false};
+  AlpacaBatch _batch;
+  AlpacaHeldRequest _batchRequest;
+
+  // WaitForState: handed to loop() through _waitQueue; _waitCount bounds
+  // the requests held, from submit to reply
+  QueueHandle_t _waitQueue = nullptr;
+  std::atomic<uint8_t> _waitCount{0};
+
+  // loop() side of a running batch and the held waits
+  uint8_t _batchStep = 0;
+  uint32_t _batchStepStart = 0;
+  AlpacaWait _waits[ALPACA_MAX_WAITS];
+  uint8_t _waitsHeld = 0;
+  char _loopResponse[ALPACA_LOOP_RESPONSE_LEN];
+
+  bool startServer();
+  static esp_err_t dispatch(httpd_req_t* req);
+  static RouteHandler findRoute(httpd_req_t* req, uint8_t& device);
+
+  // loop() side
+  void runCommands();
+  int executeCommand(const AlpacaCommand& command);
+  void startBatch();
+  void runBatch();
+  void finishBatch(int errorNumber, const char* errorMessage);
+  void runWaits();
+
+  // Server task side
+  int runCommand(uint8_t device, AlpacaCommandType type, int32_t value);
+
+  // Server task side of a batch or wait
+  void submitBatch(AlpacaRequest& request);
+  void submitWait(AlpacaRequest& request);
+  bool holdRequest(AlpacaRequest& request, AlpacaHeldRequest& held);
 
   // Response helpers
-  void sendValueResponse(int errorNumber, const char* errorMessage, int value);
-  void sendValueResponse(int errorNumber, const char* errorMessage, bool value);
-  void sendValueResponse(int errorNumber, const char* errorMessage, const char* value);
-  void sendArrayResponse(JsonArray& arr);
-  void sendMethodResponse(int errorNumber, const char* errorMessage);
-  void sendErrorResponse(int errorNumber, const char* errorMessage);
-
-  int32_t getClientTransactionID();
-  int32_t getClientID();
-  String findArgCaseInsensitive(const char* name);
-  bool checkConnected(); // Returns false and sends 0x407 if not connected
+  JsonWriter beginResponse();
+  static JsonWriter beginResponse(char* buffer, size_t size);
+  void endResponse(AlpacaRequest& request, JsonWriter& json, int errorNumber, const char* errorMessage);
+  void endResponse(httpd_req_t* req, uint32_t clientTransactionID, JsonWriter& json, int errorNumber, const char* errorMessage);
+  void answerHeld(AlpacaHeldRequest& held, char* buffer, size_t size, int errorNumber, const char* errorMessage, const char* value);
+  void sendValueResponse(AlpacaRequest& request, int errorNumber, const char* errorMessage, int value);
+  void sendValueResponse(AlpacaRequest& request, int errorNumber, const char* errorMessage, bool value);
+  void sendValueResponse(AlpacaRequest& request, int errorNumber, const char* errorMessage, const char* value);
+  void sendMethodResponse(AlpacaRequest& request, int errorNumber, const char* errorMessage);
+  void sendErrorResponse(AlpacaRequest& request, int errorNumber, const char* errorMessage);
+  void sendCommandResponse(AlpacaRequest& request, int errorNumber);
+
+  static uint32_t parseClientTransactionID(const AlpacaRequest& request);
+  uint32_t getClientID(AlpacaRequest& request);
+  // Decoded argument into value ("" if absent, cut to size); false if absent
+  static bool findArg(const AlpacaRequest& request, const char* name, bool ignoreCase, char* value, size_t size);
+  bool checkConnected(AlpacaRequest& request); // Returns false and sends 0x407 if not connected
+  static CoverCalibratorSnapshot readDevice(const AlpacaRequest& request);
 
   // Management API
-  void handleApiVersions();
-  void handleDescription();
-  void handleConfiguredDevices();
+  void handleApiVersions(AlpacaRequest& request);
+  void handleDescription(AlpacaRequest& request);
+  void handleConfiguredDevices(AlpacaRequest& request);
 
   // Setup pages (HTML on Alpaca port)
-  void handleSetupPage();
-  void handleDeviceSetupPage();
+  void handleSetupPage(AlpacaRequest& request);
+  void handleDeviceSetupPage(AlpacaRequest& request);
 
   // Common device properties (GET)
-  void handleGetConnected();
-  void handleGetConnecting();
-  void handleGetDescription();
-  void handleGetDriverInfo();
-  void handleGetDriverVersion();
-  void handleGetInterfaceVersion();
-  void handleGetName();
-  void handleGetSupportedActions();
-  void handleGetDeviceState();
+  void handleGetConnected(AlpacaRequest& request);
+  void handleGetConnecting(AlpacaRequest& request);
+  void handleGetDescription(AlpacaRequest& request);
+  void handleGetDriverInfo(AlpacaRequest& request);
+  void handleGetDriverVersion(AlpacaRequest& request);
+  void handleGetInterfaceVersion(AlpacaRequest& request);
+  void handleGetName(AlpacaRequest& request);
+  void handleGetSupportedActions(AlpacaRequest& request);
+  void handleGetDeviceState(AlpacaRequest& request);
 
   // Common device methods (PUT)
-  void handlePutConnected();
-  void handlePutConnect();
-  void handlePutDisconnect();
-  void handlePutAction();
-  void handlePutCommandBlind();
-  void handlePutCommandBool();
-  void handlePutCommandString();
+  void handlePutConnected(AlpacaRequest& request);
+  void handlePutConnect(AlpacaRequest& request);
+  void handlePutDisconnect(AlpacaRequest& request);
+  void handlePutAction(AlpacaRequest& request);
+  void handlePutCommandBlind(AlpacaRequest& request);
+  void handlePutCommandBool(AlpacaRequest& request);
+  void handlePutCommandString(AlpacaRequest& request);
 
   // CoverCalibrator properties (GET)
-  void handleGetBrightness();
-  void handleGetCalibratorState();
-  void handleGetCoverState();
-  void handleGetMaxBrightness();
-  void handleGetCoverMoving();
-  void handleGetCalibratorChanging();
+  void handleGetBrightness(AlpacaRequest& request);
+  void handleGetCalibratorState(AlpacaRequest& request);
+  void handleGetCoverState(AlpacaRequest& request);
+  void handleGetMaxBrightness(AlpacaRequest& request);
+  void handleGetCoverMoving(AlpacaRequest& request);
+  void handleGetCalibratorChanging(AlpacaRequest& request);
 
   // CoverCalibrator methods (PUT)
-  void handlePutCalibratorOff();
-  void handlePutCalibratorOn();
-  void handlePutCloseCover();
-  void handlePutHaltCover();
-  void handlePutOpenCover();
+  void handlePutCalibratorOff(AlpacaRequest& request);
+  void handlePutCalibratorOn(AlpacaRequest& request);
+  void handlePutCloseCover(AlpacaRequest& request);
+  void handlePutHaltCover(AlpacaRequest& request);
+  void handlePutOpenCover(AlpacaRequest& request);
 
-  AlpacaHandler() : _server(ALPACA_PORT) {}
+  AlpacaHandler() {}
   friend AlpacaHandler& getAlpacaHandler();
 };
 
@@ -0,0 +1,168 @@
+/*
+  alpaca_router.h - Perfect-hash router for Alpaca URLs
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Route paths are templates in which a "#" segment, next to last, stands
+  for a device number: "/api/v1/covercalibrator/#/coverstate". A table
+  built at compile time gives every (path, method) a slot of its own,
+  keyed on the path length (the number counted as one character), the
+  last segment's length and first, middle and last characters, and the
+  method. A lookup reads those, the device number and the one route in
+  that slot, which it compares with two memcmp()s. Its cost follows the
+  path length only, not the number of routes or devices.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef ALPACA_ROUTER_H
+#define ALPACA_ROUTER_H
+
+#include <Arduino.h>
+#include <esp_http_server.h>
+#include "config.h"
+
+const uint8_t ALPACA_ROUTE_EMPTY = 0xFF;
+const uint32_t ALPACA_ROUTE_NO_DEVICE = UINT32_MAX;  // the path has no "#" segment
+
+template <typename Handler>
+struct AlpacaRoute {
+  const char* path;        // template, "#" for the device number segment
+  httpd_method_t method;
+  Handler handler;
+};
+
+struct AlpacaRouteSlot {
+  uint8_t route;           // index in the routes, or ALPACA_ROUTE_EMPTY
+  uint8_t prefixLength;    // bytes before "#", or the whole path
+  uint8_t suffixLength;    // bytes after "#"
+  bool device;             // the path has a "#" segment
+};
+
+struct AlpacaRouteTable {
+  bool valid;              // false if no seed in the search range separates the routes
+  uint32_t seed;
+  AlpacaRouteSlot slots[ALPACA_ROUTE_SLOTS];
+};
+
+// ============================================================
+// Hashing
+// ============================================================
+
+// Path length ("#" or the number as one character), last segment and method
+constexpr uint32_t alpacaRouteHash(uint32_t seed, size_t length, const char* last, size_t lastLength,
+                                   httpd_method_t method) {
+  const uint32_t keys[] = {
+    (uint32_t)length, (uint32_t)lastLength,
+    lastLength ? (uint8_t)last[0] : 0u,
+    lastLength ? (uint8_t)last[lastLength / 2] : 0u,
+    lastLength ? (uint8_t)last[lastLength - 1] : 0u,
+    (uint32_t)method,
+  };
+  uint32_t hash = 2166136261u ^ seed;
+  for (uint32_t key : keys) hash = (hash ^ key) * 16777619u;
+  return hash ^ (hash >> 15);
+}
+
+constexpr size_t alpacaRouteLength(const char* path) {
+  size_t length = 0;
+  while (path[length]) length++;
+  return length;
+}
+
+// Slot for one template: "#" counts only as the segment before the last
+constexpr AlpacaRouteSlot alpacaRouteSlot(const char* path, uint8_t route) {
+  size_t length = alpacaRouteLength(path);
+  size_t last = length;
+  while (last > 0 && path[last - 1] != '/') last--;
+
+  AlpacaRouteSlot slot = {route, (uint8_t)length, 0, false};
+  if (last >= 3 && path[last - 2] == '#' && path[last - 3] == '/') {
+    slot.prefixLength = (uint8_t)(last - 2);
+    slot.suffixLength = (uint8_t)(length - last + 1);
+    slot.device = true;
+  }
+  return slot;
+}
+
+// Tries seeds until every route lands in a slot of its own. Runs in the
+// compiler; check the result with static_assert(table.valid).
+template <typename Handler, size_t N>
+constexpr AlpacaRouteTable buildAlpacaRouteTable(const AlpacaRoute<Handler> (&routes)[N]) {
+  static_assert(N < ALPACA_ROUTE_EMPTY && N * 3 <= ALPACA_ROUTE_SLOTS, "ALPACA_ROUTE_SLOTS too small");
+  static_assert((ALPACA_ROUTE_SLOTS & (ALPACA_ROUTE_SLOTS - 1)) == 0, "ALPACA_ROUTE_SLOTS must be a power of two");
+
+  AlpacaRouteTable table = {};
+  for (uint32_t seed = 1; seed <= 1000; seed++) {
+    for (AlpacaRouteSlot& slot : table.slots) slot = {ALPACA_ROUTE_EMPTY, 0, 0, false};
+
+    bool separated = true;
+    for (size_t i = 0; i < N && separated; i++) {
+      const char* path = routes[i].path;
+      size_t length = alpacaRouteLength(path);
+      size_t last = length;
+      while (last > 0 && path[last - 1] != '/') last--;
+
+      uint32_t hash = alpacaRouteHash(seed, length, path + last, length - last, routes[i].method);
+      AlpacaRouteSlot& slot = table.slots[hash & (ALPACA_ROUTE_SLOTS - 1)];
+      if (slot.route != ALPACA_ROUTE_EMPTY) {
+        separated = false;
+      } else {
+        slot = alpacaRouteSlot(path, (uint8_t)i);
+      }
+    }
+    if (separated) {
+      table.valid = true;
+      table.seed = seed;
+      return table;
+    }
+  }
+  return table;
+}
+
+// ============================================================
+// Lookup
+// ============================================================
+
+// Index of the route for uri (up to '?') and method, or -1. device is
+// the number in the "#" segment, or ALPACA_ROUTE_NO_DEVICE.
+template <typename Handler, size_t N>
+int findAlpacaRoute(const AlpacaRoute<Handler> (&routes)[N], const AlpacaRouteTable& table,
+                    const char* uri, httpd_method_t method, uint32_t& device) {
+  size_t length = strcspn(uri, "?");
+  size_t last = length;
+  while (last > 0 && uri[last - 1] != '/') last--;
+
+  // A segment of 1-9 digits before the last one is the device number
+  size_t digits = last > 0 ? last - 1 : 0;
+  while (digits > 0 && uri[digits - 1] >= '0' && uri[digits - 1] <= '9') digits--;
+  size_t digitCount = last > 0 ? last - 1 - digits : 0;
+  bool hasDevice = digitCount > 0 && digitCount < 10 && digits > 0 && uri[digits - 1] == '/';
+
+  device = ALPACA_ROUTE_NO_DEVICE;
+  size_t templateLength = length;
+  if (hasDevice) {
+    device = 0;
+    for (size_t i = digits; i < last - 1; i++) device = device * 10 + (uri[i] - '0');
+    templateLength -= digitCount - 1;
+  }
+
+  uint32_t hash = alpacaRouteHash(table.seed, templateLength, uri + last, length - last, method);
+  const AlpacaRouteSlot& slot = table.slots[hash & (ALPACA_ROUTE_SLOTS - 1)];
+  if (slot.route == ALPACA_ROUTE_EMPTY || slot.device != hasDevice || routes[slot.route].method != method) {
+    return -1;
+  }
+
+  const char* path = routes[slot.route].path;
+  if (hasDevice) {
+    if (digits != slot.prefixLength || length - (last - 1) != slot.suffixLength ||
+        memcmp(uri, path, digits) != 0 || memcmp(uri + last - 1, path + digits + 1, slot.suffixLength) != 0) {
+      return -1;
+    }
+  } else if (length != slot.prefixLength || memcmp(uri, path, length) != 0) {
+    return -1;
+  }
+  return slot.route;
+}
+
+#endif // ALPACA_ROUTER_H
@@ -22,6 +22,8 @@
 #define ENABLE_SERIAL_CONTROL // comment out if not utilized
 #define ENABLE_MANUAL_CONTROL // comment out if not utilized
 #define ENABLE_SAVING_TO_MEMORY // comment out if not utilized
+#define ENABLE_WIFI           // comment out if not utilized (WiFi, Alpaca, Web UI)
+//#define SECOND_DEVICE_INSTALLED // second cover/panel on this board (Alpaca device 1), see DEVICES below
 
 //----- (UA) (COVER) -----
 #define DEFAULT_TIME_TO_MOVE 5000   // (ms) time to move between open/close (1000-10000, recommend 5000)
@@ -35,8 +37,9 @@
 #define DEFAULT_SERVO_RANGE_MIN 0     // usable range minimum (0 to SERVO_MAX_ANGLE)
 #define DEFAULT_SERVO_RANGE_MAX 270   // usable range maximum (0 to SERVO_MAX_ANGLE)
 
-//----- (UA) (COVER) SELECT A MOVEMENT -----
+//----- (UA) (COVER) SELECT A DEFAULT MOVEMENT -----
 //----- UNCOMMENT ONLY ONE OPTION -----
+//----- (changeable at runtime: serial <Kn>, Web UI setup page, Alpaca "Easing" action) -----
 #define USE_LINEAR
 //#define USE_CIRCULAR
 //#define USE_CUBIC
@@ -56,21 +59,57 @@
 #define DEFAULT_HEATER_SHUTOFF 3600000  // (ms) max time for manual heating (1 hour)
 #define DEFAULT_DELTA_POINT 5.0f        // (degrees) target temp above dew point
 
+//----- (UA) (HEATER) SELECT A DEFAULT CONTROL LAW -----
+//----- UNCOMMENT ONLY ONE OPTION -----
+//----- (changeable at runtime: serial <Jn>, Web UI setup page) -----
+//----- (PID and predictive are opt-in: tune the gains below or autotune with <JA> first) -----
+#define USE_HEAT_PROPORTIONAL    // original firmware: PWM proportional to the shortfall
+//#define USE_HEAT_PID           // PID, anti-windup, derivative on measurement
+//#define USE_HEAT_PREDICTIVE    // PID on a thermal-model prediction, with model feedforward
+
+#define DEFAULT_HEAT_KP 40.0f           // (PWM per degree) proportional gain
+#define DEFAULT_HEAT_KI 0.2f            // (PWM per degree-second) integral gain
+#define DEFAULT_HEAT_KD 60.0f           // (PWM-seconds per degree) derivative gain
+#define DEFAULT_HEAT_MODEL_RISE 30.0f   // (degrees) heater rise over ambient at full power
+#define DEFAULT_HEAT_MODEL_TAU 120.0f   // (s) heater time constant
+
 //----- (UA) (HEATER) TEMPERATURE & HUMIDITY SENSOR -----
 //----- UNCOMMENT ONLY ONE OPTION -----
 #define ENABLE_BME280
 //#define ENABLE_DHT22
 
+//----- (UA) (HEATER) DEW POINT -----
+//#define ENABLE_FIXED_DEW_POINT  // integer dew point (within 0.1 C of the formula) instead of log(), comment out if not utilized
+
 //----- (UA) (BUTTON) -----
 #define DEBOUNCE_DELAY 150      // (ms) debounce time
 
+//----- (UA) (DEBUG) LOG OUTPUTS -----
+#define LOG_TO_USB            // <#...> frames on the USB serial port once the host sends <N1>, comment out if not utilized
+//#define LOG_TO_UART0          // plain lines on UART0 TX (GPIO43)
+//#define LOG_TO_SYSLOG         // UDP syslog to LOG_SYSLOG_HOST (requires ENABLE_WIFI)
+#define LOG_TO_MEMORY         // recent lines at http://<ip>/api/log (requires ENABLE_WIFI)
+#define LOG_SYSLOG_HOST "192.168.1.100"   // syslog collector IP address
+
+//----- (UA) (DEBUG) LOOP PROFILER -----
+//#define ENABLE_PERF_MONITOR   // per-subsystem loop() timing via <I> and /api/perf, comment out if not utilized
+
+//----- (UA) TELEMETRY HISTORY -----
+//#define ENABLE_TELEMETRY_HISTORY  // 1 s samples for an hour, 1 min for a day via <X> and /api/history (70 KB of RAM), comment out if not utilized
+
 //----- END OF (UA) USER-ADJUSTABLE OPTIONS -----
 //-----------------------------------------------
 //-------------- DO NOT EDIT BELOW --------------
 //-----------------------------------------------
 
+//----- HOST SIMULATOR -----
+// The Linux simulator (sim/) selects its own feature set at build time
+#ifdef DLC_SIMULATOR
+  #include "sim/sim_config.h"
+#endif
+
 //----- VERSIONING -----
-#define DLC_VERSION "v2.1.0"
+#define DLC_VERSION "v2.2.0"
 
 //----- VALIDATION: easing options -----
 #ifdef COVER_INSTALLED
@@ -105,6 +144,31 @@ const uint8_t PIN_RELAY_K1   = 4;   // K1 relay (light panel power gate)
 const uint8_t PIN_I2C_SDA    = 8;   // I2C SDA (BME280)
 const uint8_t PIN_I2C_SCL    = 9;   // I2C SCL (BME280)
 const uint8_t PIN_DHT        = 13;  // DHT22 (shares pin with DS18B20, only one active)
+const uint8_t PIN_SERVO_2    = 14;  // Second device servo PWM
+const uint8_t PIN_LIGHT_2    = 15;  // Second device light panel PWM
+const uint8_t PIN_RELAY_K2   = 5;   // Second device K2 relay (light panel power gate)
+const uint8_t PIN_NONE       = 0xFF;  // part not fitted (DEVICES table)
+
+//----- DEVICES -----
+// One Alpaca CoverCalibrator per entry, numbered in order. Each has its own
+// pins and NVS namespace (15 characters at most); PIN_NONE for servoPin or
+// lightPin leaves that part out of the device. Further entries work the
+// same way. The serial protocol, button and Web UI control device 0.
+struct DeviceConfig {
+  const char* name;          // Alpaca DeviceName
+  const char* nvsNamespace;  // saved settings of this cover and panel
+  uint8_t servoPin;
+  uint8_t lightPin;
+  uint8_t relayPin;          // panel power gate, or PIN_NONE
+};
+
+const DeviceConfig DEVICES[] = {
+  {"DarkLight CoverCalibrator", "dlc", PIN_SERVO, PIN_LIGHT, PIN_RELAY_K1},
+  #ifdef SECOND_DEVICE_INSTALLED
+    {"DarkLight CoverCalibrator 2", "dlc2", PIN_SERVO_2, PIN_LIGHT_2, PIN_RELAY_K2},
+  #endif
+};
+const uint8_t DEVICE_COUNT = sizeof(DEVICES) / sizeof(DEVICES[0]);
 
 //----- STATE ENUMS -----
 enum CoverState : uint8_t {
@@ -135,20 +199,115 @@ enum HeaterState : uint8_t {
   HEATER_SET         = 6   // Heat-on-close armed
 };
 
+enum BatchState : uint8_t {
+  BATCH_IDLE    = 0,
+  BATCH_RUNNING = 1,
+  BATCH_DONE    = 2,
+  BATCH_FAILED  = 3
+};
+
+//----- EASING PROFILES -----
+enum EasingProfile : uint8_t {
+  EASE_LINEAR   = 0,
+  EASE_CIRCULAR = 1,
+  EASE_CUBIC    = 2,
+  EASE_EXPO     = 3,
+  EASE_QUAD     = 4,
+  EASE_QUART    = 5,
+  EASE_QUINT    = 6,
+  EASE_SINE     = 7,
+  EASE_PROFILE_COUNT
+};
+
+#if defined(USE_CIRCULAR)
+  const EasingProfile DEFAULT_EASING = EASE_CIRCULAR;
+#elif defined(USE_CUBIC)
+  const EasingProfile DEFAULT_EASING = EASE_CUBIC;
+#elif defined(USE_EXPO)
+  const EasingProfile DEFAULT_EASING = EASE_EXPO;
+#elif defined(USE_QUAD)
+  const EasingProfile DEFAULT_EASING = EASE_QUAD;
+#elif defined(USE_QUART)
+  const EasingProfile DEFAULT_EASING = EASE_QUART;
+#elif defined(USE_QUINT)
+  const EasingProfile DEFAULT_EASING = EASE_QUINT;
+#elif defined(USE_SINE)
+  const EasingProfile DEFAULT_EASING = EASE_SINE;
+#else
+  const EasingProfile DEFAULT_EASING = EASE_LINEAR;
+#endif
+
+//----- HEATER CONTROL LAWS -----
+enum HeatControlLaw : uint8_t {
+  HEAT_LAW_PROPORTIONAL = 0,
+  HEAT_LAW_PID          = 1,
+  HEAT_LAW_PREDICTIVE   = 2,
+  HEAT_LAW_COUNT
+};
+
+#if defined(USE_HEAT_PREDICTIVE)
+  const HeatControlLaw DEFAULT_HEAT_LAW = HEAT_LAW_PREDICTIVE;
+#elif defined(USE_HEAT_PID)
+  const HeatControlLaw DEFAULT_HEAT_LAW = HEAT_LAW_PID;
+#else
+  const HeatControlLaw DEFAULT_HEAT_LAW = HEAT_LAW_PROPORTIONAL;
+#endif
+
+// Gains and thermal model, set by autotune and kept in NVS
+struct HeatTuning {
+  float kp;
+  float ki;
+  float kd;
+  float modelRise;   // degrees over ambient at full power
+  float modelTau;    // s
+};
+
+const uint8_t  EASING_TABLE_BITS = 7;                        // 128 segments per profile
+const uint16_t EASING_TABLE_SIZE = 1 << EASING_TABLE_BITS;
+
 //----- SERIAL PROTOCOL -----
 const uint32_t SERIAL_SPEED         = 115200;
 const char     SERIAL_START_MARKER  = '<';
 const char     SERIAL_END_MARKER    = '>';
+const char     SERIAL_EVENT_MARKER  = '!';  // prefix of unsolicited <!Xn> state events
 const uint8_t  MAX_RECV_CHARS       = 10;
 const uint8_t  MAX_SEND_CHARS       = 75;
 
+//----- TELEMETRY HISTORY -----
+const uint16_t HISTORY_FINE_SAMPLES   = 3600;   // 1 s samples kept (1 hour)
+const uint16_t HISTORY_COARSE_SAMPLES = 1440;   // 1 min samples kept (1 day)
+const uint32_t HISTORY_FINE_INTERVAL  = 1;      // s between fine samples
+const uint32_t HISTORY_COARSE_INTERVAL = 60;    // s between coarse samples (a multiple of the fine one)
+const uint8_t  HISTORY_SERIAL_ROWS    = 4;      // rows written per loop() pass by <X>
+const size_t   HISTORY_CHUNK_SIZE     = 1024;   // bytes per /api/history chunk
+const uint8_t  HISTORY_WEB_CHUNKS     = 2;      // /api/history chunks written per loop() pass
+
+//----- DEBUG LOG -----
+const char     SERIAL_LOG_MARKER = '#';    // prefix of <#...> log frames on USB
+const uint8_t  LOG_QUEUE_SIZE    = 32;     // queued lines awaiting output (power of two)
+const uint8_t  LOG_MODULE_CHARS  = 12;     // module tag incl. terminator, checked at compile time
+const uint8_t  LOG_MSG_CHARS     = 120;    // max formatted message length
+const uint8_t  LOG_DRAIN_LINES   = 4;      // lines written per Debug::loop()
+const uint16_t LOG_MEMORY_SIZE   = 4096;   // bytes of recent log kept for /api/log
+const uint16_t LOG_SYSLOG_PORT   = 514;
+const uint32_t LOG_UART_SPEED    = 115200;
+
 //----- HEATER CONSTANTS -----
 const float DEW_POINT_ALPHA       = 17.27f;   // August-Roche-Magnus constant
 const float DEW_POINT_BETA        = 237.7f;   // August-Roche-Magnus constant
+const float DEW_POINT_TOLERANCE   = 0.1f;     // (degrees) fixed-point dew point vs the formula, -40..85 C, 1..100 %RH
 const float PWM_MAP_MULTIPLIER    = 100.0f;   // PWM mapping scale factor
 const float PWM_MAP_RANGE         = 500.0f;   // PWM mapping range value
 const float MAX_HEATER_PWM        = 255.0f;   // Max PWM value for heater
 const uint8_t MAX_ERROR_COUNT     = 5;        // Consecutive error threshold
+const float HEAT_DERIVATIVE_FILTER = 0.5f;    // weight of the newest slope in the filtered derivative
+const uint32_t HEAT_SENSOR_LAG    = 750;      // ms from DS18B20 conversion start to the reading
+const uint32_t I2C_CLOCK          = 400000;   // Hz, BME280 bus (fast mode)
+const uint32_t HEAT_CONTROL_STALE = 30000;    // ms without a reading before the PID starts afresh
+const float HEAT_AUTOTUNE_RISE    = 5.0f;     // autotune setpoint at least this far over ambient
+const float HEAT_AUTOTUNE_BAND    = 0.3f;     // relay hysteresis (degrees either side)
+const uint8_t HEAT_AUTOTUNE_CYCLES = 4;       // oscillations measured after the first
+const uint32_t HEAT_AUTOTUNE_TIMEOUT = 3600000;  // ms before autotune gives up
 
 #ifdef ENABLE_BME280
   const uint32_t DEW_INTERVAL = 1000;  // 1 second for BME280
@@ -159,16 +318,72 @@ const uint8_t MAX_ERROR_COUNT     = 5;        // Consecutive error threshold
 
 //----- COVER CONSTANTS -----
 const uint32_t SERVO_DETACH_TIME = 3000;  // ms after stop before detaching servo
+const uint32_t SERVO_FRAME_MS    = 20;    // trajectory update period (50 Hz servo frame)
+const uint16_t MAX_TRAJECTORY_FRAMES = 512;  // planned angles per move (longer moves use a coarser step)
+const uint8_t  SERVO_TASK_PRIORITY = 3;   // above loop() (1), below WiFi
+const uint32_t SERVO_TASK_STACK  = 2048;
+const uint8_t  SERVO_TASK_CORE   = 1;     // same core as loop() so the task preempts it
 
 //----- WIFI DEFAULTS -----
 const uint16_t ALPACA_PORT       = 11111;
 const uint16_t WEB_PORT          = 80;
+const uint16_t WEB_EVENTS_PORT   = WEB_PORT + 1;  // dashboard.js connects to its own port + 1
 const uint16_t ALPACA_DISC_PORT  = 32227;
 const char*    const AP_SSID     = "DLC-Setup";
 const char*    const AP_PASS     = "darklight";
 const char*    const MDNS_HOST   = "darklightcc";
 const uint32_t WIFI_TIMEOUT      = 15000;  // ms to wait for STA connection
 
+//----- SOCKET BUDGET -----
+// Every server shares CONFIG_LWIP_MAX_SOCKETS (16 in the Arduino core), and
+// each esp_http_server holds a listen and a control socket on top of its
+// clients: Alpaca 4 + 2, events 2 + 1 + 2, WebServer 2, discovery 2 and
+// syslog 1 make 16. Held Alpaca requests (waits, a batch) are never purged
+// for a new client, so they must leave one of the Alpaca 4 free.
+// Checked against the core's limit in alpaca_handler.cpp.
+const uint8_t  HTTPD_OWN_SOCKETS    = 2;     // listen + control socket of each esp_http_server
+const uint8_t  WEB_SERVER_SOCKETS   = 2;     // WebServer on WEB_PORT: listener + the one client it serves
+const uint8_t  DISCOVERY_SOCKETS    = 2;     // Alpaca discovery, IPv4 and IPv6
+#ifdef LOG_TO_SYSLOG
+  const uint8_t SYSLOG_SOCKETS      = 1;
+#else
+  const uint8_t SYSLOG_SOCKETS      = 0;
+#endif
+
+//----- ALPACA SERVER CONSTANTS -----
+const uint8_t  ALPACA_TASK_PRIORITY = 5;     // esp_http_server default (tskIDLE_PRIORITY + 5)
+const uint32_t ALPACA_TASK_STACK    = 8192;
+const uint8_t  ALPACA_TASK_CORE     = 0;     // WiFi core, away from loop() and the servo task
+const uint16_t ALPACA_MAX_CLIENTS   = 4;     // open keep-alive sockets, the longest idle one is closed for a new client (see SOCKET BUDGET)
+const uint16_t ALPACA_MAX_ROUTES    = 2;     // registered URI handlers: one per method, alpaca_router.h does the rest
+const size_t   ALPACA_ROUTE_SLOTS   = 128;   // perfect-hash slots (power of two, at least 3 per route)
+const uint8_t  ALPACA_COMMAND_QUEUE = 4;     // methods waiting for loop() to run them
+const uint32_t ALPACA_COMMAND_TIMEOUT = 2000;  // ms a method waits for loop() before failing
+const size_t   ALPACA_MAX_ARGS_LEN  = 256;   // query string or form body bytes kept per request
+const size_t   ALPACA_RESPONSE_LEN  = 1024;  // largest JSON reply (written in place, no heap)
+const uint8_t  DISCOVERY_MAX_PACKETS = 32;    // discovery datagrams read per loop() (the rest wait for the next)
+const uint8_t  DISCOVERY_SOURCE_SLOTS = 16;   // source addresses remembered for rate limiting
+const uint32_t DISCOVERY_MIN_INTERVAL = 1000; // ms between replies to one source address
+const uint8_t  ALPACA_BATCH_MAX_STEPS = 16;   // operations in one "Batch" action
+const uint8_t  ALPACA_MAX_BATCHES = 1;        // Batch requests held at once (one runs at a time), each keeps its socket
+const uint32_t ALPACA_BATCH_WAIT_TIMEOUT = 120000;  // ms one "wait" step may take before the batch fails
+const uint8_t  ALPACA_MAX_WAITS = 2;          // WaitForState requests held at once; each keeps its socket, and with the batches at least one of ALPACA_MAX_CLIENTS stays free
+const uint32_t ALPACA_WAIT_DEFAULT_TIMEOUT = 30000;  // ms WaitForState holds a request by default
+const uint32_t ALPACA_WAIT_MAX_TIMEOUT = 120000;     // longest timeout a client may ask for
+const size_t   ALPACA_LOOP_RESPONSE_LEN = 256;  // Batch and WaitForState replies, written by loop()
+
+//----- WEB EVENTS CONSTANTS -----
+const uint16_t WEB_EVENTS_CTRL_PORT  = 32769;  // httpd control socket (Alpaca uses the default 32768)
+const uint8_t  WEB_EVENTS_MAX_CLIENTS = 2;     // open dashboards (more fall back to polling); one more socket answers 503 or exports history
+const uint8_t  WEB_EVENTS_MAX_HANDLERS = 2;    // /events and /api/history
+const uint8_t  WEB_EVENTS_TASK_PRIORITY = 2;   // above loop() (1), below httpd and the servo task
+const uint32_t WEB_EVENTS_TASK_STACK = 4096;
+const uint8_t  WEB_EVENTS_TASK_CORE  = 0;
+const uint32_t WEB_EVENTS_POLL_MS    = 50;     // state version check (wait-free, nothing sent unless changed)
+const uint32_t WEB_EVENTS_KEEPALIVE  = 15000;  // ms of silence before a comment line probes the clients
+const uint16_t WEB_EVENTS_SEND_TIMEOUT = 2;    // s a stalled client may block the sender before it is dropped
+const size_t   WEB_EVENTS_EVENT_LEN  = 384;    // one "data:" event with every field
+
 //----- NVS PREFERENCE KEYS -----
 // Original firmware values
 const char* const KEY_COVER_STATE   = "coverState";
@@ -184,6 +399,7 @@ const char* const KEY_SERVO_MAX_PW  = "servoMaxPW";
 const char* const KEY_MOVE_TIME     = "moveTime";
 const char* const KEY_SERVO_RANGE_MIN = "servoRngMin";
 const char* const KEY_SERVO_RANGE_MAX = "servoRngMax";
+const char* const KEY_EASING        = "easing";
 
 // Light configuration
 const char* const KEY_MAX_BRIGHT    = "maxBright";
@@ -193,6 +409,12 @@ const char* const KEY_STAB_TIME     = "stabTime";
 const char* const KEY_HEATER_MODE   = "heaterMode";
 const char* const KEY_DELTA_POINT   = "deltaPoint";
 const char* const KEY_SHUTOFF_TIME  = "shutoffTime";
+const char* const KEY_HEAT_LAW      = "heatLaw";
+const char* const KEY_HEAT_KP       = "heatKp";
+const char* const KEY_HEAT_KI       = "heatKi";
+const char* const KEY_HEAT_KD       = "heatKd";
+const char* const KEY_HEAT_RISE     = "heatRise";
+const char* const KEY_HEAT_TAU      = "heatTau";
 
 // WiFi configuration
 const char* const KEY_WIFI_SSID     = "wifiSSID";
@@ -19,27 +19,47 @@
 #ifdef COVER_INSTALLED
 
 #include "storage_manager.h"
+#include "easing.h"
+#include "device_state.h"
 #include "Debug.h"
 
-CoverController cover;
+CoverController covers[DEVICE_COUNT];
+CoverController& cover = covers[0];
+
+void CoverController::begin(uint8_t device) {
+  _device = device;
+  _pin = DEVICES[device].servoPin;
+  _storage = &deviceStorage[device];
+
+  // No servo on this device: stays NotPresent and ignores every command
+  if (_pin == PIN_NONE) {
+    _currentState = COVER_NOT_PRESENT;
+    publishState();
+    return;
+  }
+
+  _servoMutex = xSemaphoreCreateMutex();
 
-void CoverController::begin() {
   #ifdef ENABLE_SAVING_TO_MEMORY
-    _currentState = (CoverState)storage.loadCoverState();
+    _currentState = (CoverState)_storage->loadCoverState();
     if (_currentState == 0) _currentState = COVER_UNKNOWN;
 
     // Load servo configuration from NVS
-    _openAngle  = storage.loadServoOpenAngle();
-    _closeAngle = storage.loadServoCloseAngle();
-    _minPulse   = storage.loadServoMinPulse();
-    _maxPulse   = storage.loadServoMaxPulse();
-    _timeToMove = storage.loadMoveTime();
-    _rangeMin   = storage.loadServoRangeMin();
-    _rangeMax   = storage.loadServoRangeMax();
+    _openAngle  = _storage->loadServoOpenAngle();
+    _closeAngle = _storage->loadServoCloseAngle();
+    _minPulse   = _storage->loadServoMinPulse();
+    _maxPulse   = _storage->loadServoMaxPulse();
+    _timeToMove = _storage->loadMoveTime();
+    _rangeMin   = _storage->loadServoRangeMin();
+    _rangeMax   = _storage->loadServoRangeMax();
+    _easing     = (EasingProfile)_storage->loadEasing();
+    if (_easing >= EASE_PROFILE_COUNT) _easing = DEFAULT_EASING;
   #else
     _currentState = COVER_UNKNOWN;
   #endif
 
+  _moveEasing = _easing;
+
   // CRITICAL: attach servo FIRST, then write position.
   // ESP32Servo ignores write() if not attached.
   attachServo();
@@ -57,13 +77,18 @@ void CoverController::begin() {
 
   _previousMoveCoverTo = (uint8_t)_currentState;
   setDetachTimer();
+  publishState();
+
+  xTaskCreatePinnedToCore(servoTask, "servo", SERVO_TASK_STACK, this,
+                          SERVO_TASK_PRIORITY, &_servoTask, SERVO_TASK_CORE);
 
-  Debug::infof("COVER", "Initialized: state=%d, open=%d, close=%d, time=%lu",
-               _currentState, _openAngle, _closeAngle, _timeToMove);
+  Debug::infof("COVER", "Device %d initialized: state=%d, open=%d, close=%d, time=%lu",
+               _device, _currentState, _openAngle, _closeAngle, _timeToMove);
 }
 
 void CoverController::loop() {
   processCoverMovement();
+  publishMovingPosition();
 
   if (_detachPending) {
     completeDetach();
@@ -75,7 +100,7 @@ void CoverController::openCover() {
   if (_currentState != COVER_MOVING && _currentState != COVER_OPEN && _currentState != COVER_NOT_PRESENT) {
     if (_currentState == COVER_CLOSED) {
       // Notify that we're about to open (light off, heater off callbacks)
-      if (_onOpenStart) _onOpenStart();
+      if (_onOpenStart) _onOpenStart(_device);
     }
     _moveCoverTo = 3; // Open
     setMovement();
@@ -94,9 +119,15 @@ void CoverController::closeCover() {
 
 void CoverController::haltCover() {
   if (_currentState == COVER_MOVING) {
+    xSemaphoreTake(_servoMutex, portMAX_DELAY);
+    _planActive = false;
+    _planDone = false;
+    if (_previousWrittenAngle >= 0) _movingPosition = _previousWrittenAngle;
+    xSemaphoreGive(_servoMutex);
+
     _halt = true;
     _previousMoveCoverTo = _moveCoverTo;
-    _currentState = COVER_UNKNOWN;
+    setState(COVER_UNKNOWN);
     _elapsedMoveTime += millis() - _startServoTimer;
     setDetachTimer();
     Debug::info("COVER", "Halting cover");
@@ -105,18 +136,22 @@ void CoverController::haltCover() {
 
 int16_t CoverController::nudgeServo(int16_t direction) {
   // Don't nudge while cover is in motion
-  if (_currentState == COVER_MOVING) return _lastPosition;
+  if (_currentState == COVER_MOVING || _currentState == COVER_NOT_PRESENT) return _lastPosition;
 
   int16_t newPos = _lastPosition + direction;
   newPos = constrain(newPos, (int16_t)_rangeMin, (int16_t)_rangeMax);
 
   // Attach, write current position first to prevent snap, then move
+  xSemaphoreTake(_servoMutex, portMAX_DELAY);
   attachServo();
   writeAngle(_lastPosition);
   delay(20); // brief settle
   writeAngle(newPos);
+  xSemaphoreGive(_servoMutex);
   _lastPosition = newPos;
-  _currentState = COVER_UNKNOWN;
+  _movingPosition = -1;
+  setState(COVER_UNKNOWN);
+  publishState(); // position changes even if the state does not
   setDetachTimer();
 
   Debug::infof("COVER", "Nudge to %d", newPos);
@@ -126,7 +161,7 @@ int16_t CoverController::nudgeServo(int16_t direction) {
 int16_t CoverController::setCurrentAsOpen() {
   _openAngle = _lastPosition;
   #ifdef ENABLE_SAVING_TO_MEMORY
-    storage.saveServoOpenAngle(_openAngle);
+    _storage->saveServoOpenAngle(_openAngle);
   #endif
   Debug::infof("COVER", "Open angle set to %d", _openAngle);
   return _openAngle;
@@ -135,14 +170,39 @@ int16_t CoverController::setCurrentAsOpen() {
 int16_t CoverController::setCurrentAsClose() {
   _closeAngle = _lastPosition;
   #ifdef ENABLE_SAVING_TO_MEMORY
-    storage.saveServoCloseAngle(_closeAngle);
+    _storage->saveServoCloseAngle(_closeAngle);
   #endif
   Debug::infof("COVER", "Close angle set to %d", _closeAngle);
   return _closeAngle;
 }
 
+void CoverController::setState(CoverState state) {
+  if (state == _currentState) return;
+  _currentState = state;
+  publishState();
+  if (_onStateChange) _onStateChange(_device, state);
+}
+
+void CoverController::publishState() {
+  deviceState.publishCover(_device, _currentState, _easing, reportedPosition());
+}
+
+// _lastPosition only moves when a move ends, so while the plan plays publish
+// the angle the servo task last wrote, at most once per servo frame
+void CoverController::publishMovingPosition() {
+  if (_currentState != COVER_MOVING) return;
+
+  xSemaphoreTake(_servoMutex, portMAX_DELAY);
+  int16_t angle = _planActive ? _previousWrittenAngle : -1;
+  xSemaphoreGive(_servoMutex);
+
+  if (angle < 0 || angle == _movingPosition) return;
+  _movingPosition = angle;
+  publishState();
+}
+
 void CoverController::attachServo() {
-  _servo.attach(PIN_SERVO, _minPulse, _maxPulse);
+  _servo.attach(_pin, _minPulse, _maxPulse);
 }
 
 void CoverController::setDetachTimer() {
@@ -152,7 +212,9 @@ void CoverController::setDetachTimer() {
 
 void CoverController::completeDetach() {
   if (millis() - _startDetachTimer >= SERVO_DETACH_TIME) {
+    xSemaphoreTake(_servoMutex, portMAX_DELAY);
     _servo.detach();
+    xSemaphoreGive(_servoMutex);
     _detachPending = false;
     Debug::debug("COVER", "Servo detached");
   }
@@ -167,12 +229,23 @@ void CoverController::writeAngle(int16_t angle) {
   _previousWrittenAngle = angle;
 }
 
+void CoverController::setEasing(EasingProfile profile) {
+  if (profile >= EASE_PROFILE_COUNT) return;
+  _easing = profile;
+  publishState();
+  Debug::infof("COVER", "Easing: %s", Easing::name(profile));
+}
+
 void CoverController::setMovement() {
   _detachPending = false; // Reset in case restart issued right after halt
 
+  // A profile change mid-move would jump the servo; it applies from here.
+  // Reversing after a halt keeps the profile the halted move used.
+  if (!_halt) _moveEasing = _easing;
+
   // Use tracked _lastPosition instead of _servo.read() — _servo.read() is
   // unreliable on ESP32Servo after detach/reattach cycles.
-  #ifdef USE_LINEAR
+  if (_moveEasing == EASE_LINEAR) {
     if (!_halt) {
       // _lastPosition already holds the correct position
     } else {
@@ -181,7 +254,7 @@ void CoverController::setMovement() {
         _lastPosition = (_moveCoverTo == 3) ? _closeAngle : _openAngle;
       }
     }
-  #else
+  } else {
     if (_halt && _moveCoverTo != _previousMoveCoverTo) {
       _elapsedMoveTime = _timeToMove - _elapsedMoveTime;
     }
@@ -192,18 +265,82 @@ void CoverController::setMovement() {
     if (abs(_remainingDistance) > abs((int16_t)_openAngle - (int16_t)_closeAngle) / 2) {
       _elapsedMoveTime = 0;
     }
-  #endif
+  }
 
+  xSemaphoreTake(_servoMutex, portMAX_DELAY);
   attachServo();
   // Write current position immediately after attach to prevent servo snapping
   writeAngle(_lastPosition);
 
-  _currentState = COVER_MOVING;
   _previousWrittenAngle = -1; // reset so first movement frame always writes
   _startServoTimer = millis();
+  planTrajectory();
+  _planActive = true;
+  _planDone = false;
+  xSemaphoreGive(_servoMutex);
+
+  setState(COVER_MOVING);
   _halt = false;
 }
 
+// Sample calculateServoPosition() over the whole move. The step is the servo
+// frame unless the move is too long for MAX_TRAJECTORY_FRAMES.
+void CoverController::planTrajectory() {
+  int16_t targetPosition = (_moveCoverTo == 3) ? _openAngle : _closeAngle;
+
+  _planDuration = (_timeToMove > _elapsedMoveTime) ? _timeToMove - _elapsedMoveTime : 0;
+  _planPeriod = SERVO_FRAME_MS;
+  if (_planDuration / _planPeriod + 2 > MAX_TRAJECTORY_FRAMES) {
+    _planPeriod = (_planDuration + MAX_TRAJECTORY_FRAMES - 3) / (MAX_TRAJECTORY_FRAMES - 2);
+  }
+  _planFrames = (_planDuration + _planPeriod - 1) / _planPeriod + 1;
+
+  for (uint16_t i = 0; i < _planFrames; i++) {
+    uint32_t t = i * _planPeriod;
+    if (t > _planDuration) t = _planDuration;
+    _plan[i] = calculateServoPosition(
+      _startServoTimer + t, _startServoTimer, _lastPosition, targetPosition,
+      moveProgress(t + _elapsedMoveTime), _remainingDistance, _openAngle, _closeAngle
+    );
+  }
+}
+
+// Progress in Q16 fixed point (EASING_ONE = 1.0) after elapsed ms of the full move
+uint32_t CoverController::moveProgress(uint32_t elapsed) const {
+  uint64_t scaled = (_timeToMove > 0) ? (uint64_t)elapsed * EASING_ONE / _timeToMove : EASING_ONE;
+  return (scaled < EASING_ONE) ? (uint32_t)scaled : EASING_ONE;
+}
+
+void CoverController::servoTask(void* param) {
+  CoverController* self = static_cast<CoverController*>(param);
+  TickType_t lastWake = xTaskGetTickCount();
+  while (true) {
+    vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(SERVO_FRAME_MS));
+    self->runTrajectoryFrame();
+  }
+}
+
+// Servo task: write the planned angle for the current time
+void CoverController::runTrajectoryFrame() {
+  xSemaphoreTake(_servoMutex, portMAX_DELAY);
+  if (_planActive) {
+    uint32_t elapsed = millis() - _startServoTimer;
+    uint32_t frame = elapsed / _planPeriod;
+    if (frame >= _planFrames || elapsed >= _planDuration) frame = _planFrames - 1;
+
+    // Only write to servo if angle actually changed (reduces bus noise)
+    if (_plan[frame] != _previousWrittenAngle) {
+      writeAngle(_plan[frame]);
+    }
+
+    if (elapsed >= _planDuration) {
+      _planActive = false;
+      _planDone = true;
+    }
+  }
+  xSemaphoreGive(_servoMutex);
+}
+
 void CoverController::processCoverMovement() {
   // Monitor moving and unknown cover
   if (_currentState == COVER_MOVING || _currentState == COVER_UNKNOWN) {
@@ -211,45 +348,40 @@ void CoverController::processCoverMovement() {
 
     // Report ERROR if timeToMove * 2 reached
     if (currentMillis - _startServoTimer >= _timeToMove * 2) {
-      _currentState = COVER_ERROR;
+      xSemaphoreTake(_servoMutex, portMAX_DELAY);
+      _planActive = false;
+      xSemaphoreGive(_servoMutex);
+      setState(COVER_ERROR);
       #ifdef ENABLE_SAVING_TO_MEMORY
-        storage.saveCoverState((uint8_t)_currentState);
+        _storage->saveCoverState((uint8_t)_currentState);
       #endif
       Debug::error("COVER", "Movement timeout - ERROR state");
       return;
     }
 
-    // If moving, then move cover
+    // If moving, finish once the servo task has written the last angle
     if (_currentState == COVER_MOVING) {
-      uint32_t currentServoTimer = millis();
-      float progress = (float)(currentServoTimer - _startServoTimer + _elapsedMoveTime) / _timeToMove;
-      progress = constrain(progress, 0.0f, 1.0f);
+      xSemaphoreTake(_servoMutex, portMAX_DELAY);
+      bool done = _planDone;
+      _planDone = false;
+      int16_t currentAngle = _plan[_planFrames - 1];
+      xSemaphoreGive(_servoMutex);
 
-      int16_t targetPosition = (_moveCoverTo == 3) ? _openAngle : _closeAngle;
-
-      int16_t currentAngle = calculateServoPosition(
-        currentServoTimer, _startServoTimer, _lastPosition, targetPosition,
-        progress, _remainingDistance, _openAngle, _closeAngle
-      );
-
-      // Only write to servo if angle actually changed (reduces bus noise)
-      if (currentAngle != _previousWrittenAngle) {
-        writeAngle(currentAngle);
-      }
-
-      if (progress >= 1.0f) {
+      if (done) {
         // Movement complete
         if (_moveCoverTo == 1) {
           // Cover closed - trigger callbacks
-          if (_onCloseComplete) _onCloseComplete();
+          if (_onCloseComplete) _onCloseComplete(_device);
         }
 
         _elapsedMoveTime = 0;
         _lastPosition = currentAngle;
-        _previousMoveCoverTo = _currentState = (_moveCoverTo == 3) ? COVER_OPEN : COVER_CLOSED;
+        _movingPosition = -1;
+        setState((_moveCoverTo == 3) ? COVER_OPEN : COVER_CLOSED);
+        _previousMoveCoverTo = _currentState;
 
         #ifdef ENABLE_SAVING_TO_MEMORY
-          storage.saveCoverState((uint8_t)_currentState);
+          _storage->saveCoverState((uint8_t)_currentState);
         #endif
 
         setDetachTimer();
@@ -259,48 +391,25 @@ void CoverController::processCoverMovement() {
   }
 }
 
+// Angles are blended as lastPos + (targetPos - lastPos) * progress in Q16,
+// floored like the float version's truncation
 int CoverController::calculateServoPosition(uint32_t currentTime, uint32_t startTime,
-                                             int lastPos, int targetPos, float progress,
+                                             int lastPos, int targetPos, uint32_t progress,
                                              int remainDist, int openAngle, int closeAngle) {
-  #ifdef USE_LINEAR
-    return lastPos + (targetPos - lastPos) * progress;
-  #else
-    if (abs(remainDist) > abs(openAngle - closeAngle) / 2) {
-      float easedProgress = calculateEasedProgress(progress);
-      return lastPos + (targetPos - lastPos) * easedProgress;
-    } else {
-      float adjustedProgress = (float)(currentTime - startTime) / (_timeToMove - _elapsedMoveTime);
-      adjustedProgress = constrain(adjustedProgress, 0.0f, 1.0f);
-      return lastPos + (targetPos - lastPos) * adjustedProgress;
-    }
-  #endif
-}
+  uint32_t blend;
+  if (_moveEasing == EASE_LINEAR) {
+    blend = progress;
+  } else if (abs(remainDist) > abs(openAngle - closeAngle) / 2) {
+    blend = Easing::apply(_moveEasing, progress);
+  } else {
+    // Short remaining move after a halt: finish linearly in the time left
+    uint32_t remainingTime = _timeToMove - _elapsedMoveTime;
+    uint64_t scaled = (remainingTime > 0) ? (uint64_t)(currentTime - startTime) * EASING_ONE / remainingTime : EASING_ONE;
+    blend = (scaled < EASING_ONE) ? (uint32_t)scaled : EASING_ONE;
+  }
 
-float CoverController::calculateEasedProgress(float progress) {
-  #ifdef USE_CIRCULAR
-    return (progress < 0.5f) ? 0.5f * (1.0f - sqrt(1.0f - 4.0f * pow(progress, 2)))
-                             : 0.5f * (sqrt(-((2.0f * progress) - 3.0f) * ((2.0f * progress) - 1.0f)) + 1.0f);
-  #elif defined(USE_CUBIC)
-    return (progress < 0.5f) ? 4.0f * progress * progress * progress
-                             : 1.0f - pow(-2.0f * progress + 2.0f, 3) / 2.0f;
-  #elif defined(USE_EXPO)
-    return (progress == 0.0f) ? 0.0f : (progress == 1.0f) ? 1.0f
-           : (progress < 0.5f) ? pow(2.0f, 20.0f * progress - 10.0f) / 2.0f
-                               : (2.0f - pow(2.0f, -20.0f * progress + 10.0f)) / 2.0f;
-  #elif defined(USE_QUAD)
-    return (progress < 0.5f) ? 2.0f * progress * progress
-                             : 1.0f - pow(-2.0f * progress + 2.0f, 2) / 2.0f;
-  #elif defined(USE_QUART)
-    return (progress < 0.5f) ? 8.0f * progress * progress * progress * progress
-                             : 1.0f - pow(-2.0f * progress + 2.0f, 4) / 2.0f;
-  #elif defined(USE_QUINT)
-    return (progress < 0.5f) ? 16.0f * progress * progress * progress * progress * progress
-                             : 1.0f - pow(-2.0f * progress + 2.0f, 5) / 2.0f;
-  #elif defined(USE_SINE)
-    return -(cos(M_PI * progress) - 1.0f) / 2.0f;
-  #else
-    return progress; // Linear fallback
-  #endif
+  int32_t scaled = (int32_t)lastPos * (int32_t)EASING_ONE + (int32_t)(targetPos - lastPos) * (int32_t)blend;
+  return scaled >> 16;
 }
 
 #endif // COVER_INSTALLED
@@ -2,6 +2,13 @@
   cover_controller.h - Servo cover control with easing motion profiles
   DarkLight Cover Calibrator - ESP32-S3 Port
 
+  Each move is planned into a table of angles when it starts. A FreeRTOS
+  task above loop() priority plays the table back at the servo frame rate,
+  so motion does not depend on how long the rest of loop() takes.
+
+  There is one controller per DEVICES entry (config.h), with its own
+  servo pin, settings namespace and servo task.
+
   (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
   Creative Commons Attribution-NonCommercial 4.0 International License
 */
@@ -16,9 +23,11 @@
 
 #include <ESP32Servo.h>
 
+class StorageManager;
+
 class CoverController {
 public:
-  void begin();
+  void begin(uint8_t device);   // index into DEVICES
   void loop();
 
   void openCover();
@@ -33,7 +42,7 @@ public:
   CoverState getState() const { return _currentState; }
   uint8_t    getMoveTo() const { return _moveCoverTo; }
   uint8_t    getPreviousMoveTo() const { return _previousMoveCoverTo; }
-  int16_t    getCurrentPosition() const { return _lastPosition; }
+  int16_t    getCurrentPosition() const { return reportedPosition(); }
 
   // Configuration accessors (uint16_t for 270-degree servo support)
   void setServoOpenAngle(uint16_t angle)  { _openAngle = angle; }
@@ -43,6 +52,7 @@ public:
   void setMoveTime(uint32_t ms)           { _timeToMove = ms; }
   void setRangeMin(uint16_t angle)        { _rangeMin = angle; }
   void setRangeMax(uint16_t angle)        { _rangeMax = angle; }
+  void setEasing(EasingProfile profile);  // takes effect on the next move
 
   uint16_t getServoOpenAngle() const  { return _openAngle; }
   uint16_t getServoCloseAngle() const { return _closeAngle; }
@@ -51,13 +61,19 @@ public:
   uint32_t getMoveTime() const        { return _timeToMove; }
   uint16_t getRangeMin() const        { return _rangeMin; }
   uint16_t getRangeMax() const        { return _rangeMax; }
+  EasingProfile getEasing() const     { return _easing; }
 
   // Callbacks for cross-module coordination
-  using CoverCallback = void (*)();
+  using CoverCallback = void (*)(uint8_t device);
+  using CoverStateCallback = void (*)(uint8_t device, CoverState state);
   void setOnCloseComplete(CoverCallback cb) { _onCloseComplete = cb; }
   void setOnOpenStart(CoverCallback cb)     { _onOpenStart = cb; }
+  void setOnStateChange(CoverStateCallback cb) { _onStateChange = cb; }
 
 private:
+  uint8_t _device = 0;
+  uint8_t _pin = PIN_NONE;
+  StorageManager* _storage = nullptr;
   Servo _servo;
   CoverState _currentState = COVER_UNKNOWN;
   uint8_t  _moveCoverTo = 0;
@@ -71,6 +87,7 @@ private:
   uint32_t _timeToMove = DEFAULT_TIME_TO_MOVE;
   uint16_t _rangeMin   = DEFAULT_SERVO_RANGE_MIN;
   uint16_t _rangeMax   = DEFAULT_SERVO_RANGE_MAX;
+  EasingProfile _easing = DEFAULT_EASING;
 
   // Movement state (int16_t to handle negative intermediate values)
   uint32_t _startServoTimer = 0;
@@ -79,28 +96,49 @@ private:
   int16_t  _lastPosition = 0;
   int16_t  _remainingDistance = 0;
   int16_t  _previousWrittenAngle = -1; // tracks last angle sent to servo
+  int16_t  _movingPosition = -1;       // last angle published during a move or after a halt, -1 at rest
+  EasingProfile _moveEasing = DEFAULT_EASING; // profile latched for the current move
 
   // Detach state
   uint32_t _startDetachTimer = 0;
   bool     _detachPending = false;
 
+  // Trajectory executor (plan written by loop(), played by the servo task)
+  TaskHandle_t      _servoTask = nullptr;
+  SemaphoreHandle_t _servoMutex = nullptr;  // guards the plan and every servo write
+  int16_t  _plan[MAX_TRAJECTORY_FRAMES];
+  uint16_t _planFrames = 0;
+  uint32_t _planPeriod = SERVO_FRAME_MS;    // ms between planned angles
+  uint32_t _planDuration = 0;               // ms from _startServoTimer to the last angle
+  bool     _planActive = false;
+  bool     _planDone = false;               // last angle written, completion pending in loop()
+
   // Callbacks
   CoverCallback _onCloseComplete = nullptr;
   CoverCallback _onOpenStart = nullptr;
+  CoverStateCallback _onStateChange = nullptr;
 
+  void setState(CoverState state);
+  void publishState();
+  void publishMovingPosition();
+  int16_t reportedPosition() const { return (_movingPosition >= 0) ? _movingPosition : _lastPosition; }
   void attachServo();
   void setDetachTimer();
   void completeDetach();
   void setMovement();
+  void planTrajectory();
   void processCoverMovement();
+  void runTrajectoryFrame();
+  static void servoTask(void* param);
+  uint32_t moveProgress(uint32_t elapsed) const;
   void writeAngle(int16_t angle); // maps angle to microseconds and writes
   int  calculateServoPosition(uint32_t currentTime, uint32_t startTime,
-                              int lastPos, int targetPos, float progress,
+                              int lastPos, int targetPos, uint32_t progress,
                               int remainDist, int openAngle, int closeAngle);
-  float calculateEasedProgress(float progress);
 };
 
-extern CoverController cover;
+extern CoverController covers[DEVICE_COUNT];
+extern CoverController& cover;    // device 0: serial, button and Web UI
 
 #endif // COVER_INSTALLED
 #endif // COVER_CONTROLLER_H
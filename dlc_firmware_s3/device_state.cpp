@@ -0,0 +1,88 @@
+/*
+  device_state.cpp - Versioned snapshot of the controller state
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#include "device_state.h"
+
+DeviceState deviceState;
+
+// Retries before a reader yields, in case it preempted the publisher on its core
+static const uint8_t READ_SPIN_LIMIT = 16;
+
+void DeviceState::publishCover(uint8_t device, CoverState state, EasingProfile easing, int16_t position) {
+  CoverCalibratorSnapshot& shadow = _shadow.devices[device];
+  shadow.coverState = state;
+  shadow.easing = easing;
+  shadow.coverPosition = position;
+  commit();
+}
+
+void DeviceState::publishLight(uint8_t device, CalibratorState state, uint16_t brightness, uint16_t maxBrightness) {
+  CoverCalibratorSnapshot& shadow = _shadow.devices[device];
+  shadow.calibratorState = state;
+  shadow.brightness = brightness;
+  shadow.maxBrightness = maxBrightness;
+  commit();
+}
+
+void DeviceState::publishHeater(HeaterState state, const HeaterData& data) {
+  _shadow.heaterState = state;
+  _shadow.heater = data;
+  commit();
+}
+
+void DeviceState::publishBatch(BatchState state, uint8_t step, uint8_t steps) {
+  _shadow.batchState = state;
+  _shadow.batchStep = step;
+  _shadow.batchSteps = steps;
+  commit();
+}
+
+// Seqlock write: odd sequence, words, even sequence. The release fence keeps
+// the odd sequence ahead of the words; the release store keeps them ahead
+// of the even one.
+void DeviceState::commit() {
+  uint32_t words[WORDS] = {};
+  memcpy(words, &_shadow, sizeof(_shadow));
+
+  uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+  _sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t i = 0; i < WORDS; i++) {
+    _words[i].store(words[i], std::memory_order_relaxed);
+  }
+  _sequence.store(sequence + 2, std::memory_order_release);
+}
+
+// Seqlock read: copy the words and keep the copy only if the sequence was
+// even and unchanged across it
+DeviceSnapshot DeviceState::read() const {
+  uint32_t words[WORDS];
+  uint32_t before, after;
+  uint8_t spins = 0;
+
+  while (true) {
+    before = _sequence.load(std::memory_order_acquire);
+    if (!(before & 1)) {
+      for (size_t i = 0; i < WORDS; i++) {
+        words[i] = _words[i].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = _sequence.load(std::memory_order_relaxed);
+      if (before == after) break;
+    }
+    if (++spins >= READ_SPIN_LIMIT) {
+      vTaskDelay(1);
+      spins = 0;
+    }
+  }
+
+  DeviceSnapshot snapshot;
+  memcpy(&snapshot, words, sizeof(snapshot));
+  snapshot.version = before >> 1;
+  return snapshot;
+}
@@ -0,0 +1,79 @@
+/*
+  device_state.h - Versioned snapshot of the controller state
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  The controllers publish their state here whenever it changes, and every
+  front-end (serial, Alpaca, Web UI) reads it from here instead of calling
+  the controller getters. A seqlock makes the copy consistent: publishing
+  never waits, and a reader on any task or core only retries if it
+  overlapped a publish. Publishers must all run on the loop() task.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef DEVICE_STATE_H
+#define DEVICE_STATE_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "config.h"
+
+struct HeaterData {
+  float heaterTemp;
+  uint8_t heaterPWM;
+  float outsideTemp;
+  float humidity;
+  float dewPoint;
+};
+
+// One cover and panel (DEVICES entry in config.h)
+struct CoverCalibratorSnapshot {
+  CoverState coverState;
+  EasingProfile easing;
+  int16_t coverPosition;            // servo angle, followed while moving
+
+  CalibratorState calibratorState;
+  uint16_t brightness;
+  uint16_t maxBrightness;
+};
+
+// Fields of a controller that is not installed stay zero (NOT_PRESENT)
+struct DeviceSnapshot {
+  uint32_t version;                 // publish count, changes with every update
+
+  CoverCalibratorSnapshot devices[DEVICE_COUNT];
+
+  HeaterState heaterState;
+  HeaterData heater;
+
+  BatchState batchState;            // Alpaca "Batch" action, latest run
+  uint8_t batchStep;                // steps finished
+  uint8_t batchSteps;
+};
+
+class DeviceState {
+public:
+  // Publishers (loop() task only)
+  void publishCover(uint8_t device, CoverState state, EasingProfile easing, int16_t position);
+  void publishLight(uint8_t device, CalibratorState state, uint16_t brightness, uint16_t maxBrightness);
+  void publishHeater(HeaterState state, const HeaterData& data);
+  void publishBatch(BatchState state, uint8_t step, uint8_t steps);
+
+  // Readers (any task)
+  DeviceSnapshot read() const;
+  uint32_t version() const { return _sequence.load(std::memory_order_acquire) >> 1; }
+
+private:
+  static const size_t WORDS = (sizeof(DeviceSnapshot) + 3) / 4;
+
+  DeviceSnapshot _shadow = {};                // publisher's copy
+  std::atomic<uint32_t> _sequence{0};         // odd while a publish is in progress
+  std::atomic<uint32_t> _words[WORDS] = {};   // published copy, word by word
+
+  void commit();
+};
+
+extern DeviceState deviceState;
+
+#endif // DEVICE_STATE_H
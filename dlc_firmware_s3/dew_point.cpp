@@ -0,0 +1,36 @@
+/*
+  dew_point.cpp - August-Roche-Magnus dew point, float and fixed-point
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#include "dew_point.h"
+
+#ifdef HEATER_INSTALLED
+
+#include <dlcDewPoint.h>
+
+float DewPoint::calculate(float temp, float humidity) {
+  #ifdef ENABLE_FIXED_DEW_POINT
+    return fixed(temp, humidity);
+  #else
+    return magnus(temp, humidity);
+  #endif
+}
+
+float DewPoint::magnus(float temp, float humidity) {
+  float gamma = ((DEW_POINT_ALPHA * temp) / (DEW_POINT_BETA + temp)) + log(humidity / 100.0f);
+  return (DEW_POINT_BETA * gamma) / (DEW_POINT_ALPHA - gamma);
+}
+
+int16_t DewPoint::fixedCenti(int16_t tempCenti, uint16_t humidityCenti) {
+  return dewPointCenti(tempCenti, humidityCenti);
+}
+
+float DewPoint::fixed(float temp, float humidity) {
+  return dewPointFixed(temp, humidity);
+}
+
+#endif // HEATER_INSTALLED
@@ -0,0 +1,40 @@
+/*
+  dew_point.h - August-Roche-Magnus dew point, float and fixed-point
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  magnus() is the original formula. fixedCenti() gives the same result in
+  integer math with the kernel the AVR firmware uses, dlcDewPoint.h from
+  dlc_firmware/DLC_Library/dlcDewPoint. Over -40..85 C and 1..100 %RH it
+  stays within DEW_POINT_TOLERANCE of magnus() evaluated in double
+  precision, which dlc_dew_point_bench (sim, DLC_SIM_BENCHMARK) checks on
+  every 0.05 C and 0.05 %RH step. The ESP32-S3 has an FPU, so calculate()
+  only uses the fixed-point path with ENABLE_FIXED_DEW_POINT; the AVR
+  firmware always does.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef DEW_POINT_H
+#define DEW_POINT_H
+
+#include <Arduino.h>
+#include "config.h"
+
+#ifdef HEATER_INSTALLED
+
+class DewPoint {
+public:
+  // C from C and %RH, with the path chosen by ENABLE_FIXED_DEW_POINT
+  static float calculate(float temp, float humidity);
+
+  static float magnus(float temp, float humidity);
+
+  // 0.01 C from 0.01 C and 0.01 %RH, inputs clamped to -40..85 C and
+  // 1..100 %RH
+  static int16_t fixedCenti(int16_t tempCenti, uint16_t humidityCenti);
+  static float fixed(float temp, float humidity);
+};
+
+#endif // HEATER_INSTALLED
+#endif // DEW_POINT_H
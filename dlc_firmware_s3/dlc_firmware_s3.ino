@@ -4,7 +4,7 @@
   Contributors: Taylor J (Initial Dew Heater Integration)
   Date:         2/7/26
 
-  Version: 2.0.0
+  Version: 2.2.0
   *View GitHub Wiki for version change details
   https://github.com/10thTeeAstronomy/DarkLight_CoverCalibrator/wiki/Firmware-Version-History
 
@@ -29,9 +29,12 @@
 #include "config.h"
 #include "Debug.h"
 #include "storage_manager.h"
+#include "perf_monitor.h"
+#include "telemetry_history.h"
 
 #ifdef COVER_INSTALLED
   #include "cover_controller.h"
+  #include "easing.h"
 #endif
 
 #ifdef LIGHT_INSTALLED
@@ -50,25 +53,43 @@
   #include "button_handler.h"
 #endif
 
-#include <WiFi.h>
-#include <ESPmDNS.h>
-#include "alpaca_handler.h"
-#include "web_ui_handler.h"
-
-// WiFi state
-enum DLCWiFiMode : uint8_t { DLC_WIFI_STA, DLC_WIFI_AP };
-DLCWiFiMode wifiCurrentMode = DLC_WIFI_STA;
-uint32_t wifiConnectStartTime = 0;
-bool wifiConnected = false;
-uint32_t lastWifiCheck = 0;
-const uint32_t WIFI_CHECK_INTERVAL = 10000; // Check WiFi status every 10 seconds
+#ifdef ENABLE_WIFI
+  #include <WiFi.h>
+  #include <ESPmDNS.h>
+  #include "alpaca_handler.h"
+  #include "web_ui_handler.h"
+
+  // WiFi state
+  enum DLCWiFiMode : uint8_t { DLC_WIFI_STA, DLC_WIFI_AP };
+  DLCWiFiMode wifiCurrentMode = DLC_WIFI_STA;
+  uint32_t wifiConnectStartTime = 0;
+  bool wifiConnected = false;
+  uint32_t lastWifiCheck = 0;
+  const uint32_t WIFI_CHECK_INTERVAL = 10000; // Check WiFi status every 10 seconds
+#endif
 
 // Forward declarations
-void initializeWiFi();
-void handleWiFi();
-void startAPMode();
-void onCoverOpenStart();
-void onCoverCloseComplete();
+#ifdef ENABLE_WIFI
+  void initializeWiFi();
+  void handleWiFi();
+  void startAPMode();
+#endif
+void onCoverOpenStart(uint8_t device);
+void onCoverCloseComplete(uint8_t device);
+#ifdef COVER_INSTALLED
+  bool anyCoverMoving();
+#endif
+#ifdef ENABLE_SERIAL_CONTROL
+  #ifdef COVER_INSTALLED
+    void onCoverStateChange(uint8_t device, CoverState state);
+  #endif
+  #ifdef LIGHT_INSTALLED
+    void onLightStateChange(uint8_t device, CalibratorState state);
+  #endif
+  #ifdef HEATER_INSTALLED
+    void onHeaterStateChange(HeaterState state);
+  #endif
+#endif
 
 void setup() {
   // Initialize debug logging
@@ -84,7 +105,7 @@ void setup() {
 
   // Initialize storage (NVS)
   #ifdef ENABLE_SAVING_TO_MEMORY
-    storage.begin();
+    for (uint8_t d = 0; d < DEVICE_COUNT; d++) deviceStorage[d].begin(DEVICES[d].nvsNamespace);
   #endif
 
   // Initialize serial handler
@@ -92,76 +113,116 @@ void setup() {
     serialHandler.begin();
   #endif
 
-  // Initialize cover controller
+  // Initialize cover controllers (one per device)
   #ifdef COVER_INSTALLED
-    cover.setOnOpenStart(onCoverOpenStart);
-    cover.setOnCloseComplete(onCoverCloseComplete);
-    cover.begin();
+    Easing::begin();
+    for (uint8_t d = 0; d < DEVICE_COUNT; d++) {
+      covers[d].setOnOpenStart(onCoverOpenStart);
+      covers[d].setOnCloseComplete(onCoverCloseComplete);
+      #ifdef ENABLE_SERIAL_CONTROL
+        covers[d].setOnStateChange(onCoverStateChange);
+      #endif
+      covers[d].begin(d);
+    }
   #endif
 
-  // Initialize light controller
+  // Initialize light controllers (one per device)
   #ifdef LIGHT_INSTALLED
-    light.begin();
+    for (uint8_t d = 0; d < DEVICE_COUNT; d++) {
+      #ifdef ENABLE_SERIAL_CONTROL
+        lights[d].setOnStateChange(onLightStateChange);
+      #endif
+      lights[d].begin(d);
+    }
   #endif
 
   // Initialize heater controller
   #ifdef HEATER_INSTALLED
+    #ifdef ENABLE_SERIAL_CONTROL
+      heater.setOnStateChange(onHeaterStateChange);
+    #endif
     heater.begin();
   #endif
 
+  // Start sampling the telemetry history
+  #ifdef ENABLE_TELEMETRY_HISTORY
+    history.begin();
+  #endif
+
   // Initialize button handler
   #ifdef ENABLE_MANUAL_CONTROL
     button.begin();
   #endif
 
   // Initialize WiFi
-  initializeWiFi();
+  #ifdef ENABLE_WIFI
+    initializeWiFi();
+  #endif
 
   Debug::info("MAIN", "Setup complete");
 }
 
 void loop() {
+  #ifdef ENABLE_PERF_MONITOR
+    uint32_t loopStart = micros();
+  #endif
+
   // Handle serial commands
   #ifdef ENABLE_SERIAL_CONTROL
-    serialHandler.loop();
+    PERF_SECTION(PERF_SERIAL, serialHandler.loop());
   #endif
 
   // Handle button input
   #ifdef ENABLE_MANUAL_CONTROL
-    button.loop();
+    PERF_SECTION(PERF_BUTTON, button.loop());
   #endif
 
   // Process cover movement
   #ifdef COVER_INSTALLED
-    cover.loop();
+    PERF_SECTION(PERF_COVER, for (CoverController& unit : covers) unit.loop());
   #endif
 
   // Process light stabilization
   #ifdef LIGHT_INSTALLED
-    light.loop();
+    PERF_SECTION(PERF_LIGHT, for (LightController& unit : lights) unit.loop());
   #endif
 
   // Process heater control
   #ifdef HEATER_INSTALLED
     #ifdef COVER_INSTALLED
-      heater.loop(cover.getState() == COVER_MOVING);
+      PERF_SECTION(PERF_HEATER, heater.loop(anyCoverMoving()));
     #else
-      heater.loop(false);
+      PERF_SECTION(PERF_HEATER, heater.loop(false));
     #endif
   #endif
 
-  // Handle WiFi
-  handleWiFi();
+  // Sample the telemetry history
+  #ifdef ENABLE_TELEMETRY_HISTORY
+    PERF_SECTION(PERF_HISTORY, history.loop());
+  #endif
 
-  // Handle Alpaca server
-  if (wifiConnected) {
-    getAlpacaHandler().loop();
-    getWebUIHandler().loop();
-  }
+  #ifdef ENABLE_WIFI
+    // Handle WiFi
+    PERF_SECTION(PERF_WIFI, handleWiFi());
+
+    // Alpaca methods and discovery (requests are served by the httpd task), Web UI
+    if (wifiConnected) {
+      PERF_SECTION(PERF_ALPACA, getAlpacaHandler().loop());
+      PERF_SECTION(PERF_WEBUI, getWebUIHandler().loop());
+    }
+  #endif
+
+  // Drain queued debug output last so it never delays a reply
+  PERF_SECTION(PERF_DEBUG, Debug::loop());
+
+  #ifdef ENABLE_PERF_MONITOR
+    perf.endLoop(micros() - loopStart);
+  #endif
 }
 
 // --- WiFi Management ---
 
+#ifdef ENABLE_WIFI
 void initializeWiFi() {
   String ssid = storage.loadWifiSSID();
   String pass = storage.loadWifiPass();
@@ -174,6 +235,7 @@ void initializeWiFi() {
 
   Debug::infof("WIFI", "Connecting to: %s", ssid.c_str());
   WiFi.mode(WIFI_STA);
+  WiFi.enableIPv6();  // link-local address for IPv6 Alpaca discovery
   WiFi.begin(ssid.c_str(), pass.c_str());
   wifiCurrentMode = DLC_WIFI_STA;
   wifiConnectStartTime = millis();
@@ -200,11 +262,13 @@ void handleWiFi() {
         // Start Alpaca and Web servers
         getAlpacaHandler().begin();
         getWebUIHandler().begin();
+        Debug::setNetworkUp(true);
       }
     } else {
       if (wifiConnected) {
         // Lost connection
         wifiConnected = false;
+        Debug::setNetworkUp(false);
         Debug::warning("WIFI", "Connection lost, reconnecting...");
       }
 
@@ -234,34 +298,70 @@ void startAPMode() {
   // Start Alpaca and Web servers
   getAlpacaHandler().begin();
   getWebUIHandler().begin();
+  Debug::setNetworkUp(true);
 }
+#endif // ENABLE_WIFI
 
 // --- Cross-module callbacks ---
+// A cover drives the panel of its own device; the heater follows device 0
 
-void onCoverOpenStart() {
+void onCoverOpenStart(uint8_t device) {
   // Turn off light when cover opens
   #ifdef LIGHT_INSTALLED
-    if (light.getState() != CAL_NOT_PRESENT && light.getState() != CAL_OFF) {
-      light.turnPanelOff();
+    LightController& panel = lights[device];
+    if (panel.getState() != CAL_NOT_PRESENT && panel.getState() != CAL_OFF) {
+      panel.turnPanelOff();
     }
   #endif
 
   // Turn off heater if manually heating
   #ifdef HEATER_INSTALLED
-    if (heater.getState() == HEATER_ON) {
+    if (device == 0 && heater.getState() == HEATER_ON) {
       heater.setManualHeat(false);
     }
   #endif
 }
 
-void onCoverCloseComplete() {
+void onCoverCloseComplete(uint8_t device) {
   // Restore light if autoON
   #ifdef LIGHT_INSTALLED
-    light.restorePreviousLight();
+    lights[device].restorePreviousLight();
   #endif
 
   // Trigger heat-on-close
   #ifdef HEATER_INSTALLED
-    heater.triggerHeatOnClose();
+    if (device == 0) heater.triggerHeatOnClose();
   #endif
 }
+
+#ifdef COVER_INSTALLED
+  // The heater holds its output while any servo is drawing current
+  bool anyCoverMoving() {
+    for (const CoverController& unit : covers) {
+      if (unit.getState() == COVER_MOVING) return true;
+    }
+    return false;
+  }
+#endif
+
+// Push state changes to the host (only sent while event mode is on).
+// The serial protocol covers device 0.
+#ifdef ENABLE_SERIAL_CONTROL
+  #ifdef COVER_INSTALLED
+    void onCoverStateChange(uint8_t device, CoverState state) {
+      if (device == 0) serialHandler.sendEvent('P', state);
+    }
+  #endif
+
+  #ifdef LIGHT_INSTALLED
+    void onLightStateChange(uint8_t device, CalibratorState state) {
+      if (device == 0) serialHandler.sendEvent('L', state);
+    }
+  #endif
+
+  #ifdef HEATER_INSTALLED
+    void onHeaterStateChange(HeaterState state) {
+      serialHandler.sendEvent('R', state);
+    }
+  #endif
+#endif
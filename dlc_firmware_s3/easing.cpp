@@ -0,0 +1,98 @@
+/*
+  easing.cpp - Fixed-point easing lookup tables for cover movement
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Curves are the ones the AVR firmware evaluated per frame (easings.net,
+  in-out variants).
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#include "easing.h"
+
+#ifdef COVER_INSTALLED
+
+#include <math.h>
+
+static const uint8_t EASING_SEGMENT_BITS = 16 - EASING_TABLE_BITS;
+
+// Entry i holds f(i / EASING_TABLE_SIZE) in Q16, saturated to 65535
+static uint16_t _tables[EASE_PROFILE_COUNT][EASING_TABLE_SIZE + 1];
+
+static const char* const EASING_NAMES[EASE_PROFILE_COUNT] = {
+  "linear", "circular", "cubic", "expo", "quad", "quart", "quint", "sine"
+};
+
+void Easing::begin() {
+  for (uint8_t p = 0; p < EASE_PROFILE_COUNT; p++) {
+    for (uint16_t i = 0; i <= EASING_TABLE_SIZE; i++) {
+      float value = evaluate((EasingProfile)p, (float)i / EASING_TABLE_SIZE);
+      int32_t q = (int32_t)lroundf(value * EASING_ONE);
+      _tables[p][i] = (uint16_t)constrain(q, (int32_t)0, (int32_t)65535);
+    }
+  }
+}
+
+uint32_t Easing::apply(EasingProfile profile, uint32_t progress) {
+  if (progress >= EASING_ONE) return EASING_ONE;
+  if (profile >= EASE_PROFILE_COUNT) profile = EASE_LINEAR;
+
+  const uint16_t* table = _tables[profile];
+  uint32_t index = progress >> EASING_SEGMENT_BITS;
+  uint32_t frac  = progress & ((1u << EASING_SEGMENT_BITS) - 1);
+  int32_t  a = table[index];
+  int32_t  b = table[index + 1];
+  return (uint32_t)(a + (((b - a) * (int32_t)frac) >> EASING_SEGMENT_BITS));
+}
+
+const char* Easing::name(EasingProfile profile) {
+  return (profile < EASE_PROFILE_COUNT) ? EASING_NAMES[profile] : "unknown";
+}
+
+bool Easing::fromName(const char* name, EasingProfile& profile) {
+  if (name[0] >= '0' && name[0] <= '9') {
+    int value = atoi(name);
+    if (value >= EASE_PROFILE_COUNT) return false;
+    profile = (EasingProfile)value;
+    return true;
+  }
+
+  for (uint8_t p = 0; p < EASE_PROFILE_COUNT; p++) {
+    if (strcasecmp(name, EASING_NAMES[p]) == 0) {
+      profile = (EasingProfile)p;
+      return true;
+    }
+  }
+  return false;
+}
+
+float Easing::evaluate(EasingProfile profile, float progress) {
+  switch (profile) {
+    case EASE_CIRCULAR:
+      return (progress < 0.5f) ? 0.5f * (1.0f - sqrtf(1.0f - 4.0f * progress * progress))
+                               : 0.5f * (sqrtf(-((2.0f * progress) - 3.0f) * ((2.0f * progress) - 1.0f)) + 1.0f);
+    case EASE_CUBIC:
+      return (progress < 0.5f) ? 4.0f * progress * progress * progress
+                               : 1.0f - powf(-2.0f * progress + 2.0f, 3) / 2.0f;
+    case EASE_EXPO:
+      return (progress == 0.0f) ? 0.0f : (progress == 1.0f) ? 1.0f
+             : (progress < 0.5f) ? powf(2.0f, 20.0f * progress - 10.0f) / 2.0f
+                                 : (2.0f - powf(2.0f, -20.0f * progress + 10.0f)) / 2.0f;
+    case EASE_QUAD:
+      return (progress < 0.5f) ? 2.0f * progress * progress
+                               : 1.0f - powf(-2.0f * progress + 2.0f, 2) / 2.0f;
+    case EASE_QUART:
+      return (progress < 0.5f) ? 8.0f * progress * progress * progress * progress
+                               : 1.0f - powf(-2.0f * progress + 2.0f, 4) / 2.0f;
+    case EASE_QUINT:
+      return (progress < 0.5f) ? 16.0f * progress * progress * progress * progress * progress
+                               : 1.0f - powf(-2.0f * progress + 2.0f, 5) / 2.0f;
+    case EASE_SINE:
+      return -(cosf(M_PI * progress) - 1.0f) / 2.0f;
+    default:
+      return progress;
+  }
+}
+
+#endif // COVER_INSTALLED
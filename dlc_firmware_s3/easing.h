@@ -0,0 +1,38 @@
+/*
+  easing.h - Fixed-point easing lookup tables for cover movement
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Each profile is sampled once at boot into a Q16 table (1.0 = 65536) and
+  evaluated by linear interpolation in integer math, so a movement frame
+  costs the same for every profile and never touches pow/sqrt/cos.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef EASING_H
+#define EASING_H
+
+#include <Arduino.h>
+#include "config.h"
+
+#ifdef COVER_INSTALLED
+
+const uint32_t EASING_ONE = 65536;  // Q16 1.0
+
+class Easing {
+public:
+  static void begin();  // build the tables
+
+  // progress and result in Q16, progress clamped to [0, EASING_ONE]
+  static uint32_t apply(EasingProfile profile, uint32_t progress);
+
+  static const char* name(EasingProfile profile);
+  static bool fromName(const char* name, EasingProfile& profile);  // name or number
+
+private:
+  static float evaluate(EasingProfile profile, float progress);
+};
+
+#endif // COVER_INSTALLED
+#endif // EASING_H
@@ -0,0 +1,208 @@
+/*
+  heat_control.cpp - Control laws and autotune for the dew heater
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#include "heat_control.h"
+
+#ifdef HEATER_INSTALLED
+
+static const char* const LAW_NAMES[HEAT_LAW_COUNT] = {"proportional", "pid", "predictive"};
+
+void HeatControl::configure(HeatControlLaw law, const HeatTuning& tuning) {
+  _law = (law < HEAT_LAW_COUNT) ? law : DEFAULT_HEAT_LAW;
+  _tuning = tuning;
+  _primed = false;
+  _integral = 0.0f;
+}
+
+void HeatControl::reset() {
+  _primed = false;
+  _integral = 0.0f;
+  _slope = 0.0f;
+  _output = 0.0f;
+  if (_autotuneState == AUTOTUNE_RUNNING) _autotuneState = AUTOTUNE_FAILED;
+}
+
+uint8_t HeatControl::update(float target, float heaterTemp, float ambient, uint32_t now) {
+  // A long gap (cover moving, sensor errors) makes the slope and the
+  // integral step meaningless: start again from this reading
+  if (_primed && now - _lastUpdate > HEAT_CONTROL_STALE) _primed = false;
+  float dt = _primed ? (now - _lastUpdate) / 1000.0f : 0.0f;
+
+  if (_primed && dt > 0.0f) {
+    float slope = (heaterTemp - _lastTemp) / dt;
+    _slope += HEAT_DERIVATIVE_FILTER * (slope - _slope);
+  } else if (!_primed) {
+    _slope = 0.0f;
+  }
+
+  if (_autotuneState == AUTOTUNE_RUNNING) {
+    _output = autotune(target, heaterTemp, ambient, now);
+  } else if (_law == HEAT_LAW_PROPORTIONAL) {
+    _output = proportional(target - heaterTemp);
+  } else {
+    _output = pid(target, heaterTemp, ambient, dt);
+  }
+
+  _primed = true;
+  _lastTemp = heaterTemp;
+  _lastUpdate = now;
+  return (uint8_t)lroundf(_output);
+}
+
+float HeatControl::proportional(float error) const {
+  if (error <= 0.0f) return 0.0f;
+  long pwm = map((long)(error * PWM_MAP_MULTIPLIER), 0, (long)PWM_MAP_RANGE, 0, (long)MAX_HEATER_PWM);
+  return constrain((float)pwm, 0.0f, MAX_HEATER_PWM);
+}
+
+float HeatControl::pid(float target, float heaterTemp, float ambient, float dt) {
+  float measured = heaterTemp;
+  float feedforward = 0.0f;
+
+  if (_law == HEAT_LAW_PREDICTIVE && _tuning.modelRise > 0.0f && _tuning.modelTau > 0.0f) {
+    // First-order model: the heater moves towards ambient + rise x duty.
+    // Predict the reading after this one, which the output set now acts on.
+    float horizon = dt + HEAT_SENSOR_LAG / 1000.0f;
+    float settle = ambient + _tuning.modelRise * (_output / MAX_HEATER_PWM);
+    measured = heaterTemp + (settle - heaterTemp) * (1.0f - expf(-horizon / _tuning.modelTau));
+
+    feedforward = (target - ambient) / _tuning.modelRise * MAX_HEATER_PWM;
+    feedforward = constrain(feedforward, 0.0f, MAX_HEATER_PWM);
+  }
+
+  float error = target - measured;
+  float derivative = -_tuning.kd * _slope;
+  float integral = _integral + _tuning.ki * error * dt;
+  float output = feedforward + _tuning.kp * error + integral + derivative;
+
+  // Anti-windup: the integral only moves while it can change the output
+  if (!((output > MAX_HEATER_PWM && error > 0.0f) || (output < 0.0f && error < 0.0f))) {
+    _integral = constrain(integral, -MAX_HEATER_PWM, MAX_HEATER_PWM);
+  }
+
+  output = feedforward + _tuning.kp * error + _integral + derivative;
+  return constrain(output, 0.0f, MAX_HEATER_PWM);
+}
+
+// ============================================================
+// Autotune (relay feedback)
+// ============================================================
+
+void HeatControl::startAutotune() {
+  _tune = {};
+  _tune.setpoint = NAN;
+  _autotuneState = AUTOTUNE_RUNNING;
+}
+
+// Full power below setpoint - band, off above setpoint + band. The first
+// oscillation, from the start, is the warm-up and is not measured.
+float HeatControl::autotune(float target, float heaterTemp, float ambient, uint32_t now) {
+  Autotune& t = _tune;
+
+  if (isnan(t.setpoint)) {
+    t.setpoint = fmaxf(target, ambient + HEAT_AUTOTUNE_RISE);
+    t.heating = true;
+    t.start = now;
+    t.high = t.low = heaterTemp;
+  }
+  if (now - t.start > HEAT_AUTOTUNE_TIMEOUT) {
+    _autotuneState = AUTOTUNE_FAILED;
+    return 0.0f;
+  }
+
+  t.high = fmaxf(t.high, heaterTemp);
+  t.low = fminf(t.low, heaterTemp);
+  bool measuring = t.lastOn != 0;
+  if (measuring) {
+    t.sumRise += heaterTemp - ambient;
+    t.sumDuty += t.heating ? 1.0f : 0.0f;
+    t.sumAmbient += ambient;
+    t.samples++;
+  }
+
+  if (t.heating && heaterTemp > t.setpoint + HEAT_AUTOTUNE_BAND) {
+    t.heating = false;
+    if (measuring) t.sumOnTime += (now - t.lastOn) / 1000.0f;
+    t.lastOff = now;
+  } else if (!t.heating && heaterTemp < t.setpoint - HEAT_AUTOTUNE_BAND) {
+    t.heating = true;
+    if (measuring) {
+      t.sumPeriod += (now - t.lastOn) / 1000.0f;
+      t.sumSwing += t.high - t.low;
+      t.cycles++;
+    }
+    t.lastOn = now;
+    t.high = t.low = heaterTemp;
+
+    if (t.cycles == HEAT_AUTOTUNE_CYCLES) {
+      finishAutotune();
+      return 0.0f;
+    }
+  }
+  return t.heating ? MAX_HEATER_PWM : 0.0f;
+}
+
+void HeatControl::finishAutotune() {
+  const Autotune& t = _tune;
+  float period = t.sumPeriod / t.cycles;
+  float amplitude = t.sumSwing / t.cycles / 2.0f;
+  float duty = t.sumDuty / t.samples;
+
+  if (amplitude <= 0.0f || period <= 0.0f || duty <= 0.0f) {
+    _autotuneState = AUTOTUNE_FAILED;
+    return;
+  }
+
+  // Ultimate gain of a relay swinging the PWM by +/- MAX/2
+  float ultimateGain = 4.0f * (MAX_HEATER_PWM / 2.0f) / (M_PI * amplitude);
+  float kp = ultimateGain / 2.2f;
+  float ti = 2.2f * period;
+  float td = period / 6.3f;
+
+  // Average rise over average duty; heating from low to high took the
+  // mean on-time with the heater settling towards ambient + rise
+  float rise = (t.sumRise / t.samples) / duty;
+  float headroom = t.sumAmbient / t.samples + rise - t.setpoint;
+  float tau = headroom * (t.sumOnTime / t.cycles) / (2.0f * amplitude);
+
+  _tuning.kp = kp;
+  _tuning.ki = kp / ti;
+  _tuning.kd = kp * td;
+  _tuning.modelRise = rise;
+  _tuning.modelTau = constrain(tau, 10.0f, 3600.0f);
+  _primed = false;
+  _integral = 0.0f;
+  _autotuneState = AUTOTUNE_DONE;
+}
+
+// ============================================================
+// Names
+// ============================================================
+
+const char* HeatControl::name(HeatControlLaw law) {
+  return (law < HEAT_LAW_COUNT) ? LAW_NAMES[law] : "unknown";
+}
+
+bool HeatControl::fromName(const char* name, HeatControlLaw& law) {
+  if (name[0] >= '0' && name[0] <= '9') {
+    int value = atoi(name);
+    if (value >= HEAT_LAW_COUNT) return false;
+    law = (HeatControlLaw)value;
+    return true;
+  }
+
+  for (uint8_t l = 0; l < HEAT_LAW_COUNT; l++) {
+    if (strcasecmp(name, LAW_NAMES[l]) == 0) {
+      law = (HeatControlLaw)l;
+      return true;
+    }
+  }
+  return false;
+}
+
+#endif // HEATER_INSTALLED
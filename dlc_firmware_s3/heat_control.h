@@ -0,0 +1,101 @@
+/*
+  heat_control.h - Control laws and autotune for the dew heater
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  update() takes one sensor reading and returns the heater PWM for the
+  target temperature (dew point + delta). The laws:
+
+    proportional - the original firmware's map() of the shortfall
+    pid          - PID on the heater temperature; the integral stops
+                   growing while the output is saturated (anti-windup)
+                   and the derivative acts on the measurement, so a
+                   change of target does not kick the output
+    predictive   - the same PID on the temperature a first-order model
+                   predicts for the next reading, plus the model's
+                   steady-state PWM as feedforward
+
+  Autotune drives the heater as a relay around a setpoint and takes the
+  gains from the oscillation (Tyreus-Luyben, which favours little
+  overshoot) and the model from the average rise and heating time.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef HEAT_CONTROL_H
+#define HEAT_CONTROL_H
+
+#include <Arduino.h>
+#include "config.h"
+
+#ifdef HEATER_INSTALLED
+
+enum HeatAutotuneState : uint8_t {
+  AUTOTUNE_IDLE    = 0,
+  AUTOTUNE_RUNNING = 1,
+  AUTOTUNE_DONE    = 2,
+  AUTOTUNE_FAILED  = 3
+};
+
+class HeatControl {
+public:
+  void configure(HeatControlLaw law, const HeatTuning& tuning);
+  HeatControlLaw getLaw() const        { return _law; }
+  const HeatTuning& getTuning() const  { return _tuning; }
+
+  // PWM (0 to MAX_HEATER_PWM) for one reading, now in ms
+  uint8_t update(float target, float heaterTemp, float ambient, uint32_t now);
+
+  // Heater off: forgets the history and stops an autotune
+  void reset();
+
+  // Runs in place of the law from the next update(); the result replaces
+  // the tuning when the state goes to AUTOTUNE_DONE
+  void startAutotune();
+  HeatAutotuneState getAutotuneState() const { return _autotuneState; }
+  uint8_t getAutotuneCycles() const          { return _tune.cycles; }
+
+  static const char* name(HeatControlLaw law);
+  static bool fromName(const char* name, HeatControlLaw& law);  // name or number
+
+private:
+  struct Autotune {
+    float setpoint;          // NAN until the first reading
+    bool heating;
+    uint32_t start;
+    uint32_t lastOn;         // ms of the last switch to heating
+    uint32_t lastOff;
+    uint8_t cycles;          // whole oscillations measured
+    float high;              // extremes of the current oscillation
+    float low;
+    float sumPeriod;         // s
+    float sumSwing;          // high - low
+    float sumOnTime;         // s
+    float sumRise;           // heater over ambient, per reading
+    float sumDuty;           // 0-1, per reading
+    float sumAmbient;
+    uint32_t samples;
+  };
+
+  HeatControlLaw _law = DEFAULT_HEAT_LAW;
+  HeatTuning _tuning = {DEFAULT_HEAT_KP, DEFAULT_HEAT_KI, DEFAULT_HEAT_KD,
+                        DEFAULT_HEAT_MODEL_RISE, DEFAULT_HEAT_MODEL_TAU};
+
+  bool _primed = false;      // _lastTemp and _lastUpdate are valid
+  float _lastTemp = 0.0f;
+  uint32_t _lastUpdate = 0;
+  float _integral = 0.0f;    // PWM
+  float _slope = 0.0f;       // filtered heater temperature slope, degrees/s
+  float _output = 0.0f;      // last PWM
+
+  HeatAutotuneState _autotuneState = AUTOTUNE_IDLE;
+  Autotune _tune = {};
+
+  float proportional(float error) const;
+  float pid(float target, float heaterTemp, float ambient, float dt);
+  float autotune(float target, float heaterTemp, float ambient, uint32_t now);
+  void finishAutotune();
+};
+
+#endif // HEATER_INSTALLED
+#endif // HEAT_CONTROL_H
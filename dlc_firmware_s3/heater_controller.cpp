@@ -14,6 +14,7 @@
 
 #include "storage_manager.h"
 #include "Debug.h"
+#include "dew_point.h"
 
 HeaterController heater;
 
@@ -21,51 +22,25 @@ void HeaterController::begin() {
   pinMode(PIN_HEATER, OUTPUT);
   analogWrite(PIN_HEATER, 0);
 
-  // Initialize I2C on custom pins for BME280
-  #ifdef ENABLE_BME280
-    Wire.begin(PIN_I2C_SDA, PIN_I2C_SCL);
-  #endif
-
-  // Initialize DS18B20
-  _oneWire = OneWire(PIN_DS18B20);
-  _tempSensor = DallasTemperature(&_oneWire);
-  _tempSensor.begin();
-  _tempSensor.setWaitForConversion(false); // Non-blocking reads
-
-  #ifdef ENABLE_BME280
-    bool bmeStatus = _bme.begin(0x76, &Wire);
-    if (!bmeStatus) {
-      bmeStatus = _bme.begin(0x77, &Wire);
-      if (!bmeStatus) {
-        _heaterError = true;
-        Debug::error("HEATER", "BME280 not found at 0x76 or 0x77");
-      }
-    }
-  #endif
-
-  #ifdef ENABLE_DHT22
-    _dht = DHT(PIN_DHT, DHT22);
-    _dht.begin();
-  #endif
+  if (!_sensors.begin()) {
+    _heaterError = true;
+  }
 
   #ifdef ENABLE_SAVING_TO_MEMORY
     _deltaPoint = storage.loadDeltaPoint();
     _heaterShutoff = storage.loadShutoffTime();
+    _control.configure((HeatControlLaw)storage.loadHeatLaw(), storage.loadHeatTuning());
   #endif
 
   setHeaterState();
 
-  Debug::infof("HEATER", "Initialized: delta=%.1f, shutoff=%lu", _deltaPoint, _heaterShutoff);
+  Debug::infof("HEATER", "Initialized: delta=%.1f, shutoff=%lu, law=%s", _deltaPoint, _heaterShutoff,
+               HeatControl::name(_control.getLaw()));
 }
 
 void HeaterController::loop(bool coverMoving) {
-  // Don't run heater control while cover is moving or in error state
-  if (coverMoving || _heaterState == HEATER_ERROR) {
-    if (!coverMoving && (_heaterError || (_heaterUnknown && _heatOnClose))) {
-      readSensors();
-    }
-    return;
-  }
+  // Don't run heater control or the sensors while cover is moving
+  if (coverMoving) return;
 
   manageHeat();
 }
@@ -116,7 +91,9 @@ void HeaterController::setHeatOnClose(bool on) {
     _heatOnClose = true;
     _autoHeat = false;
     _manualHeat = false;
-    readSensors(); // Verify sensors work before event
+    // Verify sensors work before event
+    _checkSensors = true;
+    _sensors.requestCycle();
     Debug::info("HEATER", "Heat-on-close ON");
   } else {
     if (_heatOnClose) {
@@ -137,6 +114,14 @@ void HeaterController::turnOff() {
   Debug::info("HEATER", "All heating OFF");
 }
 
+bool HeaterController::startAutotune() {
+  if (_heaterError || _heaterUnknown) return false;
+  if (_heaterState != HEATER_AUTO && _heaterState != HEATER_ON) setAutoHeat(true);
+  _control.startAutotune();
+  Debug::info("HEATER", "Autotune started");
+  return true;
+}
+
 void HeaterController::triggerHeatOnClose() {
   if (_heatOnClose) {
     _manualHeat = true;
@@ -157,6 +142,8 @@ HeaterData HeaterController::getHeaterData() const {
 }
 
 void HeaterController::setHeaterState() {
+  HeaterState previousState = _heaterState;
+
   if (_heaterError) {
     _heaterState = HEATER_ERROR;
   } else if (_heaterUnknown) {
@@ -172,42 +159,36 @@ void HeaterController::setHeaterState() {
     resetErrorReadings();
   }
 
+  if (_heaterState != previousState && _onStateChange) {
+    _onStateChange(_heaterState);
+  }
+
   // SAFETY: ensure PWM is shut off unless heater is ON or AUTO
   if (_heaterState != HEATER_AUTO && _heaterState != HEATER_ON) {
     analogWrite(PIN_HEATER, 0);
     _heaterPWM = 0;
+    if (_control.getAutotuneState() == AUTOTUNE_RUNNING) Debug::warning("HEATER", "Autotune stopped");
+    _control.reset();
   }
-}
 
-void HeaterController::manageHeat() {
-  if (!_heaterError && (_autoHeat || _manualHeat)) {
-    uint32_t currentDewMillis = millis();
-
-    if (currentDewMillis - _previousDewMillis >= DEW_INTERVAL) {
-      _previousDewMillis = currentDewMillis;
-
-      // Handle async DS18B20 conversion
-      if (!_asyncConversionStarted) {
-        _tempSensor.requestTemperatures();
-        _asyncConversionStarted = true;
-        _conversionStartTime = millis();
-        return; // Wait for conversion
-      }
+  publishState();
+}
 
-      // Check if conversion is complete (750ms for 12-bit)
-      if (millis() - _conversionStartTime < 750) {
-        return; // Still converting
-      }
+void HeaterController::publishState() {
+  deviceState.publishHeater(_heaterState, getHeaterData());
+}
 
-      _asyncConversionStarted = false;
+void HeaterController::manageHeat() {
+  bool heating = !_heaterError && (_autoHeat || _manualHeat);
+  bool recovering = _heaterError || (_heaterUnknown && _heatOnClose);
 
-      if (readSensors()) {
-        return; // Skip if error
-      }
+  // One sensor step per pass; act when a reading cycle completes
+  if ((heating || recovering || _checkSensors) && _sensors.poll(millis())) {
+    _checkSensors = false;
 
+    if (!checkReadings() && heating) {
       // Calculate dew point (August-Roche-Magnus formula)
-      float temp = ((DEW_POINT_ALPHA * _outsideTemp) / (DEW_POINT_BETA + _outsideTemp)) + log(_humidityLevel / 100.0f);
-      _dewPoint = (DEW_POINT_BETA * temp) / (DEW_POINT_ALPHA - temp);
+      _dewPoint = DewPoint::calculate(_outsideTemp, _humidityLevel);
 
       activateHeater();
     }
@@ -219,39 +200,45 @@ void HeaterController::manageHeat() {
     setHeaterState();
     Debug::info("HEATER", "Manual heat timeout");
   }
-
-  // If reading issue, attempt to reset error state
-  if (_heaterError || (_heaterUnknown && _heatOnClose)) {
-    readSensors();
-  }
 }
 
 void HeaterController::activateHeater() {
-  if (_heaterTemp < _dewPoint + _deltaPoint) {
-    float tempDiff = (_dewPoint + _deltaPoint) - _heaterTemp;
-    _heaterPWM = map((long)(tempDiff * PWM_MAP_MULTIPLIER), 0, (long)PWM_MAP_RANGE, 0, (long)MAX_HEATER_PWM);
-    _heaterPWM = constrain(_heaterPWM, (uint8_t)0, (uint8_t)MAX_HEATER_PWM);
-    analogWrite(PIN_HEATER, _heaterPWM);
-  } else {
-    analogWrite(PIN_HEATER, 0);
-    _heaterPWM = 0;
+  bool tuning = _control.getAutotuneState() == AUTOTUNE_RUNNING;
+  _heaterPWM = _control.update(_dewPoint + _deltaPoint, _heaterTemp, _outsideTemp, millis());
+  analogWrite(PIN_HEATER, _heaterPWM);
+  if (tuning && _control.getAutotuneState() != AUTOTUNE_RUNNING) finishAutotune();
+  publishState();
+}
+
+void HeaterController::finishAutotune() {
+  if (_control.getAutotuneState() != AUTOTUNE_DONE) {
+    Debug::warning("HEATER", "Autotune failed");
+    return;
   }
+
+  const HeatTuning& tuning = _control.getTuning();
+  #ifdef ENABLE_SAVING_TO_MEMORY
+    storage.saveHeatTuning(tuning);
+  #endif
+  Debug::infof("HEATER", "Autotune done: kp=%.2f ki=%.4f kd=%.1f rise=%.1f tau=%.0f",
+               tuning.kp, tuning.ki, tuning.kd, tuning.modelRise, tuning.modelTau);
 }
 
-bool HeaterController::readSensors() {
+// Takes the cycle's readings; true (and the error count raised) if any is bad
+bool HeaterController::checkReadings() {
   bool errorReading = false;
   static bool lastErrorReading = true;
+  const SensorReadings& readings = _sensors.getReadings();
 
-  // Read DS18B20 heater temperature
-  _heaterTemp = _tempSensor.getTempCByIndex(0);
+  _heaterTemp = readings.heaterTemp;
   if (_heaterTemp == DEVICE_DISCONNECTED_C) {
     errorReading = true;
   }
 
-  #ifdef ENABLE_BME280
-    _outsideTemp = _bme.readTemperature();
-    _humidityLevel = _bme.readHumidity();
+  _outsideTemp = readings.outsideTemp;
+  _humidityLevel = readings.humidity;
 
+  #ifdef ENABLE_BME280
     if (isnan(_outsideTemp) || isnan(_humidityLevel) ||
         _humidityLevel < 0 || _humidityLevel > 100 ||
         _outsideTemp < -40 || _outsideTemp > 85) {
@@ -260,9 +247,6 @@ bool HeaterController::readSensors() {
   #endif
 
   #ifdef ENABLE_DHT22
-    _outsideTemp = _dht.readTemperature();
-    _humidityLevel = _dht.readHumidity();
-
     if (isnan(_outsideTemp) || isnan(_humidityLevel)) {
       errorReading = true;
     }
@@ -286,6 +270,7 @@ bool HeaterController::readSensors() {
   }
 
   lastErrorReading = errorReading;
+  publishState();
   return errorReading;
 }
 
@@ -11,28 +11,12 @@
 
 #include <Arduino.h>
 #include "config.h"
+#include "device_state.h"
 
 #ifdef HEATER_INSTALLED
 
-#include <Wire.h>
-#include <OneWire.h>
-#include <DallasTemperature.h>
-
-#ifdef ENABLE_BME280
-  #include <Adafruit_BME280.h>
-#endif
-
-#ifdef ENABLE_DHT22
-  #include <DHT.h>
-#endif
-
-struct HeaterData {
-  float heaterTemp;
-  uint8_t heaterPWM;
-  float outsideTemp;
-  float humidity;
-  float dewPoint;
-};
+#include "heat_control.h"
+#include "heater_sensors.h"
 
 class HeaterController {
 public:
@@ -56,9 +40,25 @@ public:
   uint32_t getShutoffTime() const   { return _heaterShutoff; }
   void  setShutoffTime(uint32_t ms) { _heaterShutoff = ms; }
 
+  // Control law and gains (heat_control.h); callers save them
+  HeatControlLaw getControlLaw() const     { return _control.getLaw(); }
+  const HeatTuning& getTuning() const      { return _control.getTuning(); }
+  void setControl(HeatControlLaw law, const HeatTuning& tuning) { _control.configure(law, tuning); }
+
+  // Relay autotune at the current target (auto heat is turned on if the
+  // heater is off); the gains are saved when it completes. False on a
+  // sensor error.
+  bool startAutotune();
+  HeatAutotuneState getAutotuneState() const { return _control.getAutotuneState(); }
+  uint8_t getAutotuneCycles() const          { return _control.getAutotuneCycles(); }
+
   // Called by cover controller when close completes and heatOnClose is armed
   void triggerHeatOnClose();
 
+  // Callback for cross-module coordination
+  using HeaterStateCallback = void (*)(HeaterState state);
+  void setOnStateChange(HeaterStateCallback cb) { _onStateChange = cb; }
+
 private:
   HeaterState _heaterState = HEATER_OFF;
   bool _autoHeat = false;
@@ -67,6 +67,7 @@ private:
   bool _heaterError = false;
   bool _heaterUnknown = false;
   uint8_t _errorCounter = 0;
+  HeaterStateCallback _onStateChange = nullptr;
 
   float _deltaPoint = DEFAULT_DELTA_POINT;
   uint32_t _heaterShutoff = DEFAULT_HEATER_SHUTOFF;
@@ -77,29 +78,21 @@ private:
   float _dewPoint = 0.0f;
   float _heaterTemp = 0.0f;
   uint8_t _heaterPWM = 0;
+  HeatControl _control;
 
   // Timing
-  uint32_t _previousDewMillis = 0;
   uint32_t _startHeaterTimer = 0;
 
-  // Sensor objects
-  OneWire _oneWire;
-  DallasTemperature _tempSensor;
-  bool _asyncConversionStarted = false;
-  uint32_t _conversionStartTime = 0;
-
-  #ifdef ENABLE_BME280
-    Adafruit_BME280 _bme;
-  #endif
-
-  #ifdef ENABLE_DHT22
-    DHT _dht;
-  #endif
+  // Sensors, read a step per loop() pass
+  HeaterSensors _sensors;
+  bool _checkSensors = false;  // one cycle wanted with the heater off (heat-on-close armed)
 
   void setHeaterState();
+  void publishState();
   void manageHeat();
   void activateHeater();
-  bool readSensors();
+  void finishAutotune();
+  bool checkReadings();
   void resetErrorReadings();
 };
 
@@ -0,0 +1,186 @@
+/*
+  heater_sensors.cpp - Non-blocking DS18B20 + BME280/DHT22 acquisition
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#include "heater_sensors.h"
+
+#ifdef HEATER_INSTALLED
+
+#include "Debug.h"
+
+bool HeaterSensors::begin() {
+  bool ambientFound = true;
+
+  // Initialize I2C on custom pins for BME280
+  #ifdef ENABLE_BME280
+    Wire.begin(PIN_I2C_SDA, PIN_I2C_SCL, I2C_CLOCK);
+  #endif
+
+  // Initialize DS18B20
+  _oneWire = OneWire(PIN_DS18B20);
+  _tempSensor = DallasTemperature(&_oneWire);
+  _tempSensor.begin();
+  _tempSensor.setWaitForConversion(false); // Non-blocking reads
+  findHeaterSensor();
+
+  #ifdef ENABLE_BME280
+    if (!_bme.begin(0x76, &Wire) && !_bme.begin(0x77, &Wire)) {
+      ambientFound = false;
+      Debug::error("HEATER", "BME280 not found at 0x76 or 0x77");
+    }
+  #endif
+
+  #ifdef ENABLE_DHT22
+    _dht = DHT(PIN_DHT, DHT22);
+    _dht.begin();
+  #endif
+
+  return ambientFound;
+}
+
+bool HeaterSensors::poll(uint32_t now) {
+  // Paused part way (cover moving, heater off): the conversion is too old
+  if (_stage != SENSOR_IDLE && now - _cycleStart > 2 * DEW_INTERVAL) _stage = SENSOR_IDLE;
+
+  switch (_stage) {
+    case SENSOR_IDLE:
+      if (_cycled && now - _cycleStart < DEW_INTERVAL) return false;
+      _cycled = true;
+      _cycleStart = now;
+      if (_addressValid) {
+        startConversion(now);
+        _stage = SENSOR_AMBIENT;
+      } else {
+        findHeaterSensor();
+        _stage = SENSOR_CONVERT;
+      }
+      return false;
+
+    case SENSOR_CONVERT:
+      if (_addressValid) startConversion(now);
+      _stage = SENSOR_AMBIENT;
+      return false;
+
+    case SENSOR_AMBIENT:
+      readAmbient();
+      _stage = SENSOR_HEATER;
+      return false;
+
+    case SENSOR_HEATER:
+      if (_addressValid && now - _conversionStart < _conversionTime) return false;
+      readHeater();
+      _stage = SENSOR_IDLE;
+      return true;
+  }
+  return false;
+}
+
+void HeaterSensors::findHeaterSensor() {
+  _addressValid = _tempSensor.getAddress(_address, 0);
+  if (_addressValid) {
+    _conversionTime = _tempSensor.millisToWaitForConversion(_tempSensor.getResolution(_address));
+    Debug::infof("HEATER", "DS18B20 %02X%02X%02X%02X%02X%02X%02X%02X, %u ms conversion",
+                 _address[0], _address[1], _address[2], _address[3],
+                 _address[4], _address[5], _address[6], _address[7], _conversionTime);
+  }
+}
+
+// Broadcast (skip ROM): the DS18B20 is the only device on its bus
+void HeaterSensors::startConversion(uint32_t now) {
+  _tempSensor.requestTemperatures();
+  _conversionStart = now;
+}
+
+void HeaterSensors::readAmbient() {
+  #ifdef ENABLE_BME280
+    _bme.readBurst(_readings.outsideTemp, _readings.pressure, _readings.humidity);
+  #endif
+
+  #ifdef ENABLE_DHT22
+    // One DHT transfer; readHumidity() returns the value it brought
+    _readings.outsideTemp = _dht.readTemperature();
+    _readings.humidity = _dht.readHumidity();
+  #endif
+}
+
+void HeaterSensors::readHeater() {
+  if (!_addressValid) {
+    _readings.heaterTemp = DEVICE_DISCONNECTED_C;
+    return;
+  }
+
+  _readings.heaterTemp = _tempSensor.getTempC(_address);
+  if (_readings.heaterTemp == DEVICE_DISCONNECTED_C) _addressValid = false;
+}
+
+// ============================================================
+// BME280 burst read (datasheet section 4.2.3, integer compensation)
+// ============================================================
+
+#ifdef ENABLE_BME280
+
+bool BME280Burst::readBurst(float& temperature, float& pressure, float& humidity) {
+  temperature = pressure = humidity = NAN;
+
+  uint8_t data[8];
+  uint8_t reg = 0xF7;  // press_msb; temp_msb at 0xFA, hum_msb at 0xFD
+  if (!i2c_dev || !i2c_dev->write_then_read(&reg, 1, data, sizeof(data))) return false;
+
+  int32_t adcP = ((uint32_t)data[0] << 12) | ((uint32_t)data[1] << 4) | (data[2] >> 4);
+  int32_t adcT = ((uint32_t)data[3] << 12) | ((uint32_t)data[4] << 4) | (data[5] >> 4);
+  int32_t adcH = ((uint32_t)data[6] << 8) | data[7];
+
+  // 0x80000 / 0x8000: measurement skipped (or the chip has just reset)
+  if (adcT == 0x80000) return false;
+  temperature = compensateTemperature(adcT);
+  if (adcP != 0x80000) pressure = compensatePressure(adcP);
+  if (adcH != 0x8000) humidity = compensateHumidity(adcH);
+  return !isnan(pressure) && !isnan(humidity);
+}
+
+float BME280Burst::compensateTemperature(int32_t adc) {
+  const bme280_calib_data& c = _bme280_calib;
+  int32_t var1 = ((((adc >> 3) - ((int32_t)c.dig_T1 << 1))) * ((int32_t)c.dig_T2)) >> 11;
+  int32_t var2 = (((((adc >> 4) - ((int32_t)c.dig_T1)) * ((adc >> 4) - ((int32_t)c.dig_T1))) >> 12) *
+                  ((int32_t)c.dig_T3)) >> 14;
+  t_fine = var1 + var2 + t_fine_adjust;
+  return ((t_fine * 5 + 128) >> 8) / 100.0f;
+}
+
+float BME280Burst::compensatePressure(int32_t adc) const {
+  const bme280_calib_data& c = _bme280_calib;
+  int64_t var1 = (int64_t)t_fine - 128000;
+  int64_t var2 = var1 * var1 * (int64_t)c.dig_P6;
+  var2 = var2 + ((var1 * (int64_t)c.dig_P5) * 131072);
+  var2 = var2 + (((int64_t)c.dig_P4) * 34359738368);
+  var1 = ((var1 * var1 * (int64_t)c.dig_P3) / 256) + ((var1 * ((int64_t)c.dig_P2) * 4096));
+  var1 = ((((int64_t)1) * 140737488355328) + var1) * ((int64_t)c.dig_P1) / 8589934592;
+  if (var1 == 0) return NAN;  // avoid a division by zero
+
+  int64_t p = 1048576 - adc;
+  p = (((p * 2147483648) - var2) * 3125) / var1;
+  var1 = (((int64_t)c.dig_P9) * (p / 8192) * (p / 8192)) / 33554432;
+  var2 = (((int64_t)c.dig_P8) * p) / 524288;
+  p = ((p + var1 + var2) / 256) + (((int64_t)c.dig_P7) * 16);
+  return p / 256.0f / 100.0f;
+}
+
+float BME280Burst::compensateHumidity(int32_t adc) const {
+  const bme280_calib_data& c = _bme280_calib;
+  int32_t v = t_fine - 76800;
+  v = (((((adc << 14) - (((int32_t)c.dig_H4) << 20) - (((int32_t)c.dig_H5) * v)) + 16384) >> 15) *
+       (((((((v * ((int32_t)c.dig_H6)) >> 10) * (((v * ((int32_t)c.dig_H3)) >> 11) + 32768)) >> 10) +
+          2097152) * ((int32_t)c.dig_H2) + 8192) >> 14));
+  v = v - (((((v >> 15) * (v >> 15)) >> 7) * ((int32_t)c.dig_H1)) >> 4);
+  if (v < 0) v = 0;
+  if (v > 419430400) v = 419430400;
+  return (v >> 12) / 1024.0f;
+}
+
+#endif // ENABLE_BME280
+
+#endif // HEATER_INSTALLED
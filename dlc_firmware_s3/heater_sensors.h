@@ -0,0 +1,119 @@
+/*
+  heater_sensors.h - Non-blocking DS18B20 + BME280/DHT22 acquisition
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  poll() does at most one bus transaction per call, so a reading cycle is
+  spread over several loop() passes:
+
+    SENSOR_IDLE     waiting for DEW_INTERVAL; then starts the DS18B20
+                    conversion (broadcast), or searches the bus first if
+                    there is no address yet
+    SENSOR_CONVERT  starts the conversion after a search
+    SENSOR_AMBIENT  reads the BME280 (one burst) or DHT22 while the
+                    DS18B20 converts
+    SENSOR_HEATER   once the conversion time has passed, reads the DS18B20
+                    scratchpad by its address; the cycle is complete
+
+  The DS18B20's address is found once and kept: getTempCByIndex() searches
+  the whole bus on every call, which costs more than the read itself. A
+  failed read forgets the address, so a replaced sensor is found again.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef HEATER_SENSORS_H
+#define HEATER_SENSORS_H
+
+#include <Arduino.h>
+#include "config.h"
+
+#ifdef HEATER_INSTALLED
+
+#include <Wire.h>
+#include <OneWire.h>
+#include <DallasTemperature.h>
+
+#ifdef ENABLE_BME280
+  #include <Adafruit_BME280.h>
+#endif
+
+#ifdef ENABLE_DHT22
+  #include <DHT.h>
+#endif
+
+#ifdef ENABLE_BME280
+// Adafruit_BME280 reads each value in a transaction of its own, and
+// readHumidity() and readPressure() read the temperature again for the
+// compensation. readBurst() takes the data registers (0xF7-0xFE) in one
+// transaction, which the chip answers from a single measurement.
+class BME280Burst : public Adafruit_BME280 {
+public:
+  // C, hPa and %RH; false (values NAN) if the bus or the chip fails
+  bool readBurst(float& temperature, float& pressure, float& humidity);
+
+private:
+  float compensateTemperature(int32_t adc);  // sets t_fine for the others
+  float compensatePressure(int32_t adc) const;
+  float compensateHumidity(int32_t adc) const;
+};
+#endif
+
+enum SensorStage : uint8_t {
+  SENSOR_IDLE    = 0,
+  SENSOR_CONVERT = 1,
+  SENSOR_AMBIENT = 2,
+  SENSOR_HEATER  = 3
+};
+
+struct SensorReadings {
+  float heaterTemp;    // DEVICE_DISCONNECTED_C on a failed read
+  float outsideTemp;   // NAN on a failed read
+  float humidity;      // NAN on a failed read
+  float pressure;      // hPa, NAN without a BME280
+};
+
+class HeaterSensors {
+public:
+  // False if the ambient sensor does not answer
+  bool begin();
+
+  // One step of the cycle; true when a cycle has just completed
+  bool poll(uint32_t now);
+
+  // Start the next cycle without waiting for DEW_INTERVAL (no effect
+  // while one is running)
+  void requestCycle()                     { _cycled = false; }
+
+  const SensorReadings& getReadings() const { return _readings; }
+  SensorStage getStage() const              { return _stage; }
+
+private:
+  OneWire _oneWire;
+  DallasTemperature _tempSensor;
+  DeviceAddress _address = {};
+  bool _addressValid = false;
+  uint16_t _conversionTime = HEAT_SENSOR_LAG;  // ms, from the sensor's resolution
+
+  #ifdef ENABLE_BME280
+    BME280Burst _bme;
+  #endif
+
+  #ifdef ENABLE_DHT22
+    DHT _dht;
+  #endif
+
+  SensorStage _stage = SENSOR_IDLE;
+  bool _cycled = false;          // _cycleStart is valid
+  uint32_t _cycleStart = 0;
+  uint32_t _conversionStart = 0;
+  SensorReadings _readings = {DEVICE_DISCONNECTED_C, NAN, NAN, NAN};
+
+  void findHeaterSensor();
+  void startConversion(uint32_t now);
+  void readAmbient();
+  void readHeater();
+};
+
+#endif // HEATER_INSTALLED
+#endif // HEATER_SENSORS_H
@@ -0,0 +1,150 @@
+/*
+  json_writer.cpp - Allocation-free JSON writer
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#include "json_writer.h"
+
+JsonWriter::JsonWriter(char* buffer, size_t size) : _buffer(buffer), _size(size) {
+  if (_size > 0) _buffer[0] = '\0';
+}
+
+void JsonWriter::beginObject() {
+  separate();
+  put('{');
+  _comma = false;
+}
+
+void JsonWriter::endObject() {
+  put('}');
+  _comma = true;
+}
+
+void JsonWriter::beginArray() {
+  separate();
+  put('[');
+  _comma = false;
+}
+
+void JsonWriter::endArray() {
+  put(']');
+  _comma = true;
+}
+
+void JsonWriter::key(const char* name) {
+  separate();
+  putString(name);
+  put(':');
+  _comma = false;
+}
+
+void JsonWriter::value(const char* str) {
+  separate();
+  if (str) {
+    putString(str);
+  } else {
+    put("null", 4);
+  }
+  _comma = true;
+}
+
+void JsonWriter::value(bool b) {
+  separate();
+  if (b) {
+    put("true", 4);
+  } else {
+    put("false", 5);
+  }
+  _comma = true;
+}
+
+void JsonWriter::valueNull() {
+  separate();
+  put("null", 4);
+  _comma = true;
+}
+
+void JsonWriter::valueRaw(const char* json) {
+  separate();
+  put(json, strlen(json));
+  _comma = true;
+}
+
+void JsonWriter::separate() {
+  if (_comma) {
+    put(',');
+    _comma = false;
+  }
+}
+
+void JsonWriter::put(char c) {
+  put(&c, 1);
+}
+
+// Copies what fits, keeping the last byte for the terminator
+void JsonWriter::put(const char* str, size_t len) {
+  size_t room = (_size > _length + 1) ? _size - _length - 1 : 0;
+  if (len > room) {
+    len = room;
+    _overflow = true;
+  }
+  memcpy(_buffer + _length, str, len);
+  _length += len;
+  if (_size > 0) _buffer[_length] = '\0';
+}
+
+void JsonWriter::putInteger(long long n) {
+  if (n < 0) {
+    putUnsigned(0ULL - (unsigned long long)n, true);
+  } else {
+    putUnsigned((unsigned long long)n, false);
+  }
+}
+
+void JsonWriter::putUnsigned(unsigned long long n, bool negative) {
+  char text[21];
+  char* p = text + sizeof(text);
+  do {
+    *--p = '0' + (n % 10);
+    n /= 10;
+  } while (n > 0);
+  if (negative) *--p = '-';
+
+  separate();
+  put(p, text + sizeof(text) - p);
+  _comma = true;
+}
+
+// Quoted, with the escapes JSON requires. Runs of plain characters are
+// copied in one go.
+void JsonWriter::putString(const char* str) {
+  static const char HEX_DIGITS[] = "0123456789abcdef";
+
+  put('"');
+  const char* run = str;
+  for (const char* p = str; ; p++) {
+    unsigned char c = (unsigned char)*p;
+    if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+    put(run, p - run);
+    if (c == '\0') break;
+    run = p + 1;
+
+    switch (c) {
+      case '"':  put("\\\"", 2); break;
+      case '\\': put("\\\\", 2); break;
+      case '\n': put("\\n", 2); break;
+      case '\r': put("\\r", 2); break;
+      case '\t': put("\\t", 2); break;
+      default: {
+        char escape[6] = {'\\', 'u', '0', '0', HEX_DIGITS[c >> 4], HEX_DIGITS[c & 0x0F]};
+        put(escape, sizeof(escape));
+        break;
+      }
+    }
+  }
+  put('"');
+}
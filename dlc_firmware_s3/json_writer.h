@@ -0,0 +1,63 @@
+/*
+  json_writer.h - Allocation-free JSON writer
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Writes compact JSON straight into a caller-owned buffer, in call order,
+  with no heap and no String temporaries. Used for the fixed Alpaca reply
+  envelope, where a JsonDocument would be built, serialised and freed on
+  every request. Output past the buffer is dropped and sets overflowed().
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <Arduino.h>
+
+class JsonWriter {
+public:
+  JsonWriter(char* buffer, size_t size);
+
+  void beginObject();
+  void endObject();
+  void beginArray();
+  void endArray();
+
+  // Object member name; the next value or begin*() is its value
+  void key(const char* name);
+
+  void value(const char* str);
+  void value(bool b);
+  void value(int n)           { putInteger(n); }
+  void value(long n)          { putInteger(n); }
+  void value(unsigned int n)  { putUnsigned(n, false); }
+  void value(unsigned long n) { putUnsigned(n, false); }
+  void valueNull();
+  void valueRaw(const char* json);  // pre-formatted number, true/false or null
+
+  // key() + value()
+  template <typename T>
+  void field(const char* name, T v) { key(name); value(v); }
+
+  const char* c_str() const { return _buffer; }
+  size_t length() const     { return _length; }
+  bool overflowed() const   { return _overflow; }
+
+private:
+  char*  _buffer;
+  size_t _size;
+  size_t _length = 0;
+  bool   _overflow = false;
+  bool   _comma = false;   // a value precedes at this level
+
+  void separate();
+  void put(char c);
+  void put(const char* str, size_t len);
+  void putString(const char* str);
+  void putInteger(long long n);
+  void putUnsigned(unsigned long long n, bool negative);
+};
+
+#endif // JSON_WRITER_H
@@ -13,22 +13,38 @@
 #ifdef LIGHT_INSTALLED
 
 #include "storage_manager.h"
+#include "device_state.h"
 #include "Debug.h"
 
-LightController light;
+LightController lights[DEVICE_COUNT];
+LightController& light = lights[0];
 
-void LightController::begin() {
-  pinMode(PIN_LIGHT, OUTPUT);
-  pinMode(PIN_RELAY_K1, OUTPUT);
-  digitalWrite(PIN_RELAY_K1, LOW); // Relay off at startup
+void LightController::begin(uint8_t device) {
+  _device = device;
+  _pin = DEVICES[device].lightPin;
+  _relayPin = DEVICES[device].relayPin;
+  _storage = &deviceStorage[device];
+
+  // No panel on this device: stays NotPresent and ignores every command
+  if (_pin == PIN_NONE) {
+    _calibratorState = CAL_NOT_PRESENT;
+    publishState();
+    return;
+  }
+
+  pinMode(_pin, OUTPUT);
+  if (_relayPin != PIN_NONE) {
+    pinMode(_relayPin, OUTPUT);
+    digitalWrite(_relayPin, LOW); // Relay off at startup
+  }
   analogWriteResolution(LIGHT_PWM_BITS);
 
   #ifdef ENABLE_SAVING_TO_MEMORY
-    _previousLightPanelValue = storage.loadPanelValue();
-    _broadbandValue = storage.loadBroadband();
-    _narrowbandValue = storage.loadNarrowband();
-    _maxBrightness = storage.loadMaxBrightness();
-    _stabilizeTime = storage.loadStabilizeTime();
+    _previousLightPanelValue = _storage->loadPanelValue();
+    _broadbandValue = _storage->loadBroadband();
+    _narrowbandValue = _storage->loadNarrowband();
+    _maxBrightness = _storage->loadMaxBrightness();
+    _stabilizeTime = _storage->loadStabilizeTime();
 
     if (_previousLightPanelValue == 0) _previousLightPanelValue = LIGHT_PWM_MAX;
     if (_broadbandValue == 0) _broadbandValue = 25;
@@ -40,9 +56,10 @@ void LightController::begin() {
   #endif
 
   _calibratorState = CAL_OFF;
+  publishState();
 
-  Debug::infof("LIGHT", "Initialized: maxBright=%d, pwmMax=%d, stabilize=%lu",
-               _maxBrightness, LIGHT_PWM_MAX, _stabilizeTime);
+  Debug::infof("LIGHT", "Device %d initialized: maxBright=%d, pwmMax=%d, stabilize=%lu",
+               _device, _maxBrightness, LIGHT_PWM_MAX, _stabilizeTime);
 }
 
 void LightController::loop() {
@@ -50,22 +67,26 @@ void LightController::loop() {
 }
 
 void LightController::turnPanelTo(uint16_t value) {
+  if (_calibratorState == CAL_NOT_PRESENT) return;
   value = constrain(value, (uint16_t)0, _maxBrightness);
   _lightValue = map(value, 0, _maxBrightness, 0, LIGHT_PWM_MAX);
-  _calibratorState = CAL_NOT_READY;
+  setState(CAL_NOT_READY);
+  publishState(); // brightness changes even if the state does not
 
   // Power-gate: energize relay before PWM
   setRelay(true);
-  analogWrite(PIN_LIGHT, _lightValue);
+  analogWrite(_pin, _lightValue);
   _startLightTimer = millis();
 
   Debug::infof("LIGHT", "Panel set to step=%d, PWM=%d", value, _lightValue);
 }
 
 void LightController::turnPanelOff() {
-  analogWrite(PIN_LIGHT, 0);
+  if (_calibratorState == CAL_NOT_PRESENT) return;
+  analogWrite(_pin, 0);
   _lightValue = 0;
-  _calibratorState = CAL_OFF;
+  setState(CAL_OFF);
+  publishState();
 
   // Power-gate: de-energize relay after PWM off
   setRelay(false);
@@ -75,8 +96,9 @@ void LightController::turnPanelOff() {
 
 void LightController::setMaxBrightness(uint16_t value) {
   _maxBrightness = value;
+  publishState();
   #ifdef ENABLE_SAVING_TO_MEMORY
-    storage.saveMaxBrightness(value);
+    _storage->saveMaxBrightness(value);
   #endif
 }
 
@@ -98,7 +120,7 @@ uint16_t LightController::getNarrowbandStep() const {
 void LightController::saveBroadband() {
   _broadbandValue = _lightValue;
   #ifdef ENABLE_SAVING_TO_MEMORY
-    storage.saveBroadband(_broadbandValue);
+    _storage->saveBroadband(_broadbandValue);
   #endif
   Debug::infof("LIGHT", "Broadband saved: %d", _broadbandValue);
 }
@@ -106,7 +128,7 @@ void LightController::saveBroadband() {
 void LightController::saveNarrowband() {
   _narrowbandValue = _lightValue;
   #ifdef ENABLE_SAVING_TO_MEMORY
-    storage.saveNarrowband(_narrowbandValue);
+    _storage->saveNarrowband(_narrowbandValue);
   #endif
   Debug::infof("LIGHT", "Narrowband saved: %d", _narrowbandValue);
 }
@@ -119,18 +141,30 @@ void LightController::restorePreviousLight() {
   }
 }
 
+void LightController::setState(CalibratorState state) {
+  if (state == _calibratorState) return;
+  _calibratorState = state;
+  publishState();
+  if (_onStateChange) _onStateChange(_device, state);
+}
+
+void LightController::publishState() {
+  deviceState.publishLight(_device, _calibratorState, getCurrentBrightness(), _maxBrightness);
+}
+
 void LightController::setRelay(bool on) {
-  digitalWrite(PIN_RELAY_K1, on ? HIGH : LOW);
-  Debug::debugf("LIGHT", "Relay K1 %s", on ? "ON" : "OFF");
+  if (_relayPin == PIN_NONE) return;
+  digitalWrite(_relayPin, on ? HIGH : LOW);
+  Debug::debugf("LIGHT", "Relay on pin %d %s", _relayPin, on ? "ON" : "OFF");
 }
 
 void LightController::processLightStabilization() {
   if (_calibratorState == CAL_NOT_READY) {
     if (millis() - _startLightTimer >= _stabilizeTime) {
-      _calibratorState = CAL_READY;
+      setState(CAL_READY);
       _previousLightPanelValue = _lightValue;
       #ifdef ENABLE_SAVING_TO_MEMORY
-        storage.savePanelValue(_previousLightPanelValue);
+        _storage->savePanelValue(_previousLightPanelValue);
       #endif
       Debug::info("LIGHT", "Stabilized - Ready");
     }
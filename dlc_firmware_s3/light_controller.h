@@ -2,6 +2,9 @@
   light_controller.h - PWM light panel control with K1 relay power-gating
   DarkLight Cover Calibrator - ESP32-S3 Port
 
+  There is one controller per DEVICES entry (config.h), with its own PWM
+  pin, relay pin and settings namespace.
+
   (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
   Creative Commons Attribution-NonCommercial 4.0 International License
 */
@@ -14,9 +17,11 @@
 
 #ifdef LIGHT_INSTALLED
 
+class StorageManager;
+
 class LightController {
 public:
-  void begin();
+  void begin(uint8_t device);   // index into DEVICES
   void loop();
 
   void turnPanelTo(uint16_t value);
@@ -46,7 +51,15 @@ public:
   // Called when cover closes with autoON
   void restorePreviousLight();
 
+  // Callback for cross-module coordination
+  using LightStateCallback = void (*)(uint8_t device, CalibratorState state);
+  void setOnStateChange(LightStateCallback cb) { _onStateChange = cb; }
+
 private:
+  uint8_t _device = 0;
+  uint8_t _pin = PIN_NONE;
+  uint8_t _relayPin = PIN_NONE;
+  StorageManager* _storage = nullptr;
   CalibratorState _calibratorState = CAL_OFF;
   uint16_t _maxBrightness = DEFAULT_MAX_BRIGHTNESS;
   uint32_t _stabilizeTime = DEFAULT_STABILIZE_TIME;
@@ -56,12 +69,16 @@ private:
   uint16_t _previousLightPanelValue = LIGHT_PWM_MAX;
   bool     _autoON = false;
   uint32_t _startLightTimer = 0;
+  LightStateCallback _onStateChange = nullptr;
 
+  void setState(CalibratorState state);
+  void publishState();
   void setRelay(bool on);
   void processLightStabilization();
 };
 
-extern LightController light;
+extern LightController lights[DEVICE_COUNT];
+extern LightController& light;    // device 0: serial, button and Web UI
 
 #endif // LIGHT_INSTALLED
 #endif // LIGHT_CONTROLLER_H
@@ -0,0 +1,92 @@
+/*
+  perf_monitor.cpp - Main loop profiler
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#include "perf_monitor.h"
+
+#ifdef ENABLE_PERF_MONITOR
+
+PerfMonitor perf;
+
+static const char* const PERF_NAMES[PERF_SECTION_COUNT] = {
+  "loop", "serial", "button", "cover", "light", "heater", "wifi", "alpaca", "webui", "debug", "history"
+};
+
+void PerfMonitor::record(PerfSection section, uint32_t micros) {
+  Section& s = _sections[section];
+  if (s.count == 0 || micros < s.minMicros) s.minMicros = micros;
+  if (micros > s.maxMicros) s.maxMicros = micros;
+  s.count++;
+  s.totalMicros += micros;
+  s.buckets[bucketOf(micros)]++;
+}
+
+void PerfMonitor::endLoop(uint32_t loopMicros) {
+  record(PERF_LOOP, loopMicros);
+
+  _windowLoops++;
+  uint32_t now = millis();
+  if (now - _windowStart >= 1000) {
+    _loopRate = _windowLoops * 1000 / (now - _windowStart);
+    _windowLoops = 0;
+    _windowStart = now;
+  }
+}
+
+void PerfMonitor::reset() {
+  memset(_sections, 0, sizeof(_sections));
+  _resetTime = millis();
+}
+
+PerfStats PerfMonitor::getStats(PerfSection section) const {
+  const Section& s = _sections[section];
+  PerfStats stats = {};
+  if (s.count == 0) return stats;
+
+  stats.count = s.count;
+  stats.minMicros = s.minMicros;
+  stats.maxMicros = s.maxMicros;
+  stats.avgMicros = (uint32_t)(s.totalMicros / s.count);
+
+  // Smallest bucket limit covering 99% of samples, never above the true max
+  uint32_t target = s.count - s.count / 100;
+  uint32_t seen = 0;
+  for (uint8_t b = 0; b < PERF_BUCKETS; b++) {
+    seen += s.buckets[b];
+    if (seen >= target) {
+      stats.p99Micros = bucketLimit(b);
+      break;
+    }
+  }
+  if (stats.p99Micros > stats.maxMicros) stats.p99Micros = stats.maxMicros;
+  return stats;
+}
+
+const char* PerfMonitor::name(PerfSection section) {
+  return (section < PERF_SECTION_COUNT) ? PERF_NAMES[section] : "unknown";
+}
+
+// 0-3 us map 1:1, above that each power of two is split into 4 buckets
+uint8_t PerfMonitor::bucketOf(uint32_t micros) {
+  if (micros < (1u << PERF_SUB_BITS)) return micros;
+  uint8_t msb = 31 - __builtin_clz(micros);
+  if (msb >= PERF_MAX_BITS) return PERF_BUCKETS - 1;
+  uint8_t sub = (micros >> (msb - PERF_SUB_BITS)) & ((1u << PERF_SUB_BITS) - 1);
+  return ((msb - PERF_SUB_BITS + 1) << PERF_SUB_BITS) + sub;
+}
+
+// Largest value that falls in the bucket
+uint32_t PerfMonitor::bucketLimit(uint8_t bucket) {
+  if (bucket < (1u << PERF_SUB_BITS)) return bucket;
+  if (bucket >= PERF_BUCKETS - 1) return UINT32_MAX;
+  uint8_t msb = (bucket >> PERF_SUB_BITS) + PERF_SUB_BITS - 1;
+  uint32_t sub = bucket & ((1u << PERF_SUB_BITS) - 1);
+  uint32_t base = (1u << msb) + (sub << (msb - PERF_SUB_BITS));
+  return base + (1u << (msb - PERF_SUB_BITS)) - 1;
+}
+
+#endif // ENABLE_PERF_MONITOR
@@ -0,0 +1,95 @@
+/*
+  perf_monitor.h - Main loop profiler
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Times each subsystem call in loop() and keeps count/min/avg/max and a
+  log-linear histogram (for p99) per section, plus the loop rate. Read
+  with the <I> serial command or GET /api/perf. Without ENABLE_PERF_MONITOR
+  PERF_SECTION() expands to the bare call and nothing here is compiled.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef PERF_MONITOR_H
+#define PERF_MONITOR_H
+
+#include <Arduino.h>
+#include "config.h"
+
+#ifdef ENABLE_PERF_MONITOR
+
+enum PerfSection : uint8_t {
+  PERF_LOOP = 0,  // whole loop() pass
+  PERF_SERIAL,
+  PERF_BUTTON,
+  PERF_COVER,
+  PERF_LIGHT,
+  PERF_HEATER,
+  PERF_WIFI,
+  PERF_ALPACA,
+  PERF_WEBUI,
+  PERF_DEBUG,
+  PERF_HISTORY,
+  PERF_SECTION_COUNT
+};
+
+struct PerfStats {
+  uint32_t count;
+  uint32_t minMicros;
+  uint32_t avgMicros;
+  uint32_t maxMicros;
+  uint32_t p99Micros;  // upper bound of the bucket holding the 99th percentile
+};
+
+class PerfMonitor {
+public:
+  void record(PerfSection section, uint32_t micros);
+  void endLoop(uint32_t loopMicros);  // once per loop() pass
+  void reset();
+
+  PerfStats getStats(PerfSection section) const;
+  uint32_t getLoopRate() const { return _loopRate; }  // passes in the last full second
+  uint32_t getUptime() const   { return millis() - _resetTime; }
+
+  static const char* name(PerfSection section);
+
+private:
+  // Log-linear buckets: 4 per power of two from 4 us, 2^PERF_MAX_BITS us and up share the last
+  static const uint8_t PERF_SUB_BITS = 2;
+  static const uint8_t PERF_MAX_BITS = 20;
+  static const uint8_t PERF_BUCKETS = (PERF_MAX_BITS - PERF_SUB_BITS + 1) << PERF_SUB_BITS;
+
+  struct Section {
+    uint32_t count;
+    uint32_t minMicros;
+    uint32_t maxMicros;
+    uint64_t totalMicros;
+    uint32_t buckets[PERF_BUCKETS];
+  };
+
+  Section  _sections[PERF_SECTION_COUNT] = {};
+  uint32_t _resetTime = 0;
+  uint32_t _windowStart = 0;
+  uint32_t _windowLoops = 0;
+  uint32_t _loopRate = 0;
+
+  static uint8_t bucketOf(uint32_t micros);
+  static uint32_t bucketLimit(uint8_t bucket);
+};
+
+extern PerfMonitor perf;
+
+#define PERF_SECTION(section, call) \
+  do { \
+    uint32_t _perfStart = micros(); \
+    call; \
+    perf.record(section, micros() - _perfStart); \
+  } while (0)
+
+#else
+
+#define PERF_SECTION(section, call) call
+
+#endif // ENABLE_PERF_MONITOR
+#endif // PERF_MONITOR_H
@@ -13,15 +13,20 @@
 #ifdef ENABLE_SERIAL_CONTROL
 
 #include "Debug.h"
+#include "perf_monitor.h"
+#include "device_state.h"
 
 #ifdef COVER_INSTALLED
   #include "cover_controller.h"
+  #include "easing.h"
+  #include "storage_manager.h"
 #endif
 #ifdef LIGHT_INSTALLED
   #include "light_controller.h"
 #endif
 #ifdef HEATER_INSTALLED
   #include "heater_controller.h"
+  #include "storage_manager.h"
 #endif
 
 SerialHandler serialHandler;
@@ -33,6 +38,14 @@ void SerialHandler::begin() {
 }
 
 void SerialHandler::loop() {
+  // Commands wait in the receive buffer until an export has finished
+  #ifdef ENABLE_TELEMETRY_HISTORY
+    if (_exportRows > 0) {
+      exportRows();
+      return;
+    }
+  #endif
+
   checkSerial();
   if (_commandComplete) {
     processCommand();
@@ -80,11 +93,7 @@ void SerialHandler::processCommand() {
 
     // Cover state: 0:NotPresent, 1:Closed, 2:Moving, 3:Open, 4:Unknown, 5:Error
     case 'P': {
-      #ifdef COVER_INSTALLED
-        itoa(cover.getState(), _response, 10);
-      #else
-        itoa(COVER_NOT_PRESENT, _response, 10);
-      #endif
+      itoa(deviceState.read().devices[0].coverState, _response, 10);
       respondToCommand(_response);
       break;
     }
@@ -104,27 +113,44 @@ void SerialHandler::processCommand() {
         cover.haltCover();
         respondToCommand(_receivedChars);
         break;
+
+      // Easing profile: <K> returns 0-7, <Kn> selects one (applies from the next move)
+      case 'K': {
+        if (cmdParameter[0] == '\0') {
+          itoa(deviceState.read().devices[0].easing, _response, 10);
+          respondToCommand(_response);
+          break;
+        }
+
+        EasingProfile profile;
+        if (!Easing::fromName(cmdParameter, profile)) {
+          respondToCommand("?");
+          break;
+        }
+        cover.setEasing(profile);
+        #ifdef ENABLE_SAVING_TO_MEMORY
+          storage.saveEasing(profile);
+        #endif
+        respondToCommand(_receivedChars);
+        break;
+      }
     #endif
 
     // Calibrator state: 0:NotPresent, 1:Off, 2:NotReady, 3:Ready, 4:Unknown, 5:Error
     case 'L': {
-      #ifdef LIGHT_INSTALLED
-        itoa(light.getState(), _response, 10);
-      #else
-        itoa(CAL_NOT_PRESENT, _response, 10);
-      #endif
+      itoa(deviceState.read().devices[0].calibratorState, _response, 10);
       respondToCommand(_response);
       break;
     }
 
     #ifdef LIGHT_INSTALLED
       case 'B':
-        itoa(light.getCurrentBrightness(), _response, 10);
+        itoa(deviceState.read().devices[0].brightness, _response, 10);
         respondToCommand(_response);
         break;
 
       case 'M':
-        itoa(light.getMaxBrightness(), _response, 10);
+        itoa(deviceState.read().devices[0].maxBrightness, _response, 10);
         respondToCommand(_response);
         break;
 
@@ -177,11 +203,7 @@ void SerialHandler::processCommand() {
 
     // Heater state: 0:NotPresent, 1:Off, 2:Auto, 3:On, 4:Unknown, 5:Error, 6:Set
     case 'R': {
-      #ifdef HEATER_INSTALLED
-        itoa(heater.getState(), _response, 10);
-      #else
-        itoa(HEATER_NOT_PRESENT, _response, 10);
-      #endif
+      itoa(deviceState.read().heaterState, _response, 10);
       respondToCommand(_response);
       break;
     }
@@ -190,7 +212,7 @@ void SerialHandler::processCommand() {
       case 'Y': {
         // Send all current heater data values
         // Format: h1t:<temp>:h1p:<pwm>|h2t:na:h2p:na|o:<temp>:h:<humidity>:d:<dewpoint>
-        HeaterData data = heater.getHeaterData();
+        HeaterData data = deviceState.read().heater;
         char tempBuf[10];
         _response[0] = '\0';
 
@@ -250,8 +272,115 @@ void SerialHandler::processCommand() {
         heater.setManualHeat(false);
         respondToCommand(_receivedChars);
         break;
+
+      // Control law: <J> law:kp:ki:kd:autotune (0:Idle, 1:Running, 2:Done, 3:Failed),
+      // <Jn> selects law n (0:Proportional, 1:PID, 2:Predictive), <JA> starts autotune
+      case 'J': {
+        if (cmdParameter[0] == '\0') {
+          const HeatTuning& tuning = heater.getTuning();
+          snprintf(_response, MAX_SEND_CHARS, "%d:%.2f:%.4f:%.1f:%d", (int)heater.getControlLaw(),
+                   tuning.kp, tuning.ki, tuning.kd, (int)heater.getAutotuneState());
+          respondToCommand(_response);
+          break;
+        }
+
+        if (cmdParameter[0] == 'A') {
+          respondToCommand(heater.startAutotune() ? _receivedChars : "?");
+          break;
+        }
+
+        HeatControlLaw law;
+        if (!HeatControl::fromName(cmdParameter, law)) {
+          respondToCommand("?");
+          break;
+        }
+        heater.setControl(law, heater.getTuning());
+        #ifdef ENABLE_SAVING_TO_MEMORY
+          storage.saveHeatLaw(law);
+        #endif
+        respondToCommand(_receivedChars);
+        break;
+      }
     #endif // HEATER_INSTALLED
 
+    // Aggregated status, one frame per host poll
+    // Format: P:L:R:B:S:h1t:h1p:h2t:h2p:o:h:d (fields not installed report "na")
+    case 'U':
+      buildStatus();
+      respondToCommand(_response);
+      break;
+
+    // Event mode: <N1> push state changes as <!Xn> and log lines as <#...>
+    // (LOG_TO_USB), <N0> polling only
+    case 'N':
+      _eventMode = (cmdParameter[0] == '1');
+      Debug::setUsbFrames(_eventMode);
+      Debug::infof("SERIAL", "Event mode %s", _eventMode ? "ON" : "OFF");
+      respondToCommand(_receivedChars);
+      break;
+
+    #ifdef ENABLE_PERF_MONITOR
+      // Loop profiler: <I> loopsPerSec:avg:p99:max (us), <In> section n as
+      // name:count:min:avg:max:p99, <IR> reset
+      case 'I': {
+        if (cmdParameter[0] == 'R') {
+          perf.reset();
+          respondToCommand(_receivedChars);
+          break;
+        }
+
+        if (cmdParameter[0] == '\0') {
+          PerfStats loopStats = perf.getStats(PERF_LOOP);
+          snprintf(_response, MAX_SEND_CHARS, "%lu:%lu:%lu:%lu", (unsigned long)perf.getLoopRate(),
+                   (unsigned long)loopStats.avgMicros, (unsigned long)loopStats.p99Micros,
+                   (unsigned long)loopStats.maxMicros);
+          respondToCommand(_response);
+          break;
+        }
+
+        int section = atoi(cmdParameter);
+        if (section < 0 || section >= PERF_SECTION_COUNT) {
+          respondToCommand("?");
+          break;
+        }
+        PerfStats stats = perf.getStats((PerfSection)section);
+        snprintf(_response, MAX_SEND_CHARS, "%s:%lu:%lu:%lu:%lu:%lu", PerfMonitor::name((PerfSection)section),
+                 (unsigned long)stats.count, (unsigned long)stats.minMicros, (unsigned long)stats.avgMicros,
+                 (unsigned long)stats.maxMicros, (unsigned long)stats.p99Micros);
+        respondToCommand(_response);
+        break;
+      }
+    #endif
+
+    #ifdef ENABLE_TELEMETRY_HISTORY
+      // Telemetry history: <X> fineCount:coarseCount:now (s), <XF[since]> /
+      // <XC[since]> the 1 s / 1 min samples later than since as <XF:count>
+      // then count <time,heaterTemp,...> rows (TelemetryHistory::formatRow)
+      case 'X': {
+        if (cmdParameter[0] == '\0') {
+          snprintf(_response, MAX_SEND_CHARS, "%u:%u:%lu", history.getCount(HISTORY_FINE),
+                   history.getCount(HISTORY_COARSE), (unsigned long)history.getUptime());
+          respondToCommand(_response);
+          break;
+        }
+
+        char* end;
+        uint32_t since = strtoul(cmdParameter + 1, &end, 10);
+        if ((cmdParameter[0] != 'F' && cmdParameter[0] != 'C') || *end != '\0') {
+          respondToCommand("?");
+          break;
+        }
+        _exportRes = cmdParameter[0] == 'F' ? HISTORY_FINE : HISTORY_COARSE;
+        uint16_t first = history.firstAfter(_exportRes, since);
+        _exportRows = history.getCount(_exportRes) - first;
+        if (_exportRows > 0) _exportTime = history.getTime(_exportRes, first);
+
+        snprintf(_response, MAX_SEND_CHARS, "X%c:%u", cmdParameter[0], _exportRows);
+        respondToCommand(_response);
+        break;
+      }
+    #endif
+
     // Firmware version
     case 'V':
       respondToCommand(DLC_VERSION);
@@ -269,6 +398,98 @@ void SerialHandler::processCommand() {
   }
 }
 
+void SerialHandler::buildStatus() {
+  char field[12];
+  _response[0] = '\0';
+
+  // One snapshot, so the fields all come from the same instant
+  DeviceSnapshot snapshot = deviceState.read();
+  const CoverCalibratorSnapshot& device = snapshot.devices[0];
+
+  itoa(device.coverState, field, 10);
+  appendField(field);
+
+  itoa(device.calibratorState, field, 10);
+  appendField(field);
+
+  itoa(snapshot.heaterState, field, 10);
+  appendField(field);
+
+  #ifdef LIGHT_INSTALLED
+    itoa(device.brightness, field, 10);
+    appendField(field);
+  #else
+    appendField("na");
+  #endif
+
+  #ifdef COVER_INSTALLED
+    itoa(device.coverPosition, field, 10);
+    appendField(field);
+  #else
+    appendField("na");
+  #endif
+
+  // Heater telemetry, same values and order as 'Y'
+  #ifdef HEATER_INSTALLED
+    const HeaterData& data = snapshot.heater;
+    dtostrf(data.heaterTemp, 0, 1, field);
+    appendField(field);
+    itoa(data.heaterPWM, field, 10);
+    appendField(field);
+    appendField("na");
+    appendField("na");
+    dtostrf(data.outsideTemp, 0, 1, field);
+    appendField(field);
+    dtostrf(data.humidity, 0, 1, field);
+    appendField(field);
+    dtostrf(data.dewPoint, 0, 1, field);
+    appendField(field);
+  #else
+    for (uint8_t i = 0; i < 7; i++) {
+      appendField("na");
+    }
+  #endif
+}
+
+void SerialHandler::appendField(const char* value) {
+  size_t len = strlen(_response);
+  snprintf(_response + len, MAX_SEND_CHARS - len, "%s%s", len > 0 ? ":" : "", value);
+}
+
+void SerialHandler::sendEvent(char type, uint8_t state) {
+  if (!_eventMode) return;
+
+  char buffer[8];
+  snprintf(buffer, sizeof(buffer), "%c%c%c%u%c", SERIAL_START_MARKER, SERIAL_EVENT_MARKER, type, state, SERIAL_END_MARKER);
+  Serial.print(buffer);
+}
+
+#ifdef ENABLE_TELEMETRY_HISTORY
+// Rows are found by time, as the ring moves on while they are written. One
+// that has already been overwritten keeps its time and loses its values.
+void SerialHandler::exportRows() {
+  uint16_t count = history.getCount(_exportRes);
+  uint32_t interval = history.getInterval(_exportRes);
+  uint32_t newest = history.getNewestTime(_exportRes);
+
+  for (uint8_t n = 0; n < HISTORY_SERIAL_ROWS && _exportRows > 0; n++) {
+    if (Serial.availableForWrite() < MAX_SEND_CHARS) break;
+
+    uint32_t back = (newest - _exportTime) / interval;
+    if (back < count) {
+      TelemetryHistory::formatRow(_exportTime, history.getSample(_exportRes, count - 1 - back), _response,
+                                  MAX_SEND_CHARS);
+    } else {
+      snprintf(_response, MAX_SEND_CHARS, "%lu,,,,,,,,,", (unsigned long)_exportTime);
+    }
+    respondToCommand(_response);
+
+    _exportTime += interval;
+    _exportRows--;
+  }
+}
+#endif
+
 void SerialHandler::respondToCommand(const char* resp) {
   char buffer[MAX_SEND_CHARS];
   snprintf(buffer, sizeof(buffer), "%c%s%c", SERIAL_START_MARKER, resp, SERIAL_END_MARKER);
@@ -11,6 +11,7 @@
 
 #include <Arduino.h>
 #include "config.h"
+#include "telemetry_history.h"
 
 #ifdef ENABLE_SERIAL_CONTROL
 
@@ -19,14 +20,30 @@ public:
   void begin();
   void loop();
 
+  // Unsolicited <!Xn> state events, enabled by the host with <N1>
+  void sendEvent(char type, uint8_t state);
+  bool isEventMode() const { return _eventMode; }
+
 private:
   char _receivedChars[MAX_RECV_CHARS];
   char _response[MAX_SEND_CHARS];
   bool _commandComplete = false;
+  bool _eventMode = false;
+
+  #ifdef ENABLE_TELEMETRY_HISTORY
+    // <XF>/<XC> export: rows still to write, a few per loop() pass
+    HistoryResolution _exportRes = HISTORY_FINE;
+    uint32_t _exportTime = 0;       // time of the next row
+    uint16_t _exportRows = 0;
+
+    void exportRows();
+  #endif
 
   void checkSerial();
   void processCommand();
   void respondToCommand(const char* resp);
+  void buildStatus();
+  void appendField(const char* value);
 };
 
 extern SerialHandler serialHandler;
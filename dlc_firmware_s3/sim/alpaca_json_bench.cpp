@@ -0,0 +1,353 @@
+/*
+  alpaca_json_bench.cpp - Alpaca reply serialisation benchmark
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Builds the common Alpaca replies two ways and reports ns, heap
+  allocations and heap bytes per reply as JSON on stdout:
+    document - the previous path: ArduinoJson JsonDocument, serializeJson()
+               into a stack buffer, ClientTransactionID found and decoded
+               through String
+    writer   - JsonWriter into a fixed buffer, ClientTransactionID parsed
+               in place
+  Both must produce the same bytes; the exit code is non-zero otherwise.
+  Host numbers only rank the two paths. Arduino's String allocates for
+  every value where the host's std::string does not, so the document
+  path costs more on the ESP32 than shown here.
+
+    dlc_alpaca_json_bench --iterations 200000
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "json_writer.h"
+#include "config.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+// ============================================================
+// Heap accounting
+// ============================================================
+
+static std::atomic<uint64_t> g_allocations{0};
+static std::atomic<uint64_t> g_allocatedBytes{0};
+
+void* operator new(size_t size) {
+  g_allocations++;
+  g_allocatedBytes += size;
+  void* p = malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+// ============================================================
+// Requests
+// ============================================================
+
+// Arguments as conformance tools and ASCOM clients send them
+struct BenchRequest {
+  const char* query;
+  const char* body;
+};
+
+static const BenchRequest GET_REQUEST = {"ClientID=1&ClientTransactionID=123456", ""};
+static const BenchRequest PUT_REQUEST = {"", "Connected=True&ClientID=1&ClientTransactionID=123456"};
+
+static uint32_t g_serverTransactionID = 0;
+
+// ============================================================
+// Document path (as alpaca_handler.cpp did before JsonWriter)
+// ============================================================
+
+static String decodeArg(const char* begin, const char* end) {
+  char decoded[ALPACA_MAX_ARGS_LEN];
+  size_t len = 0;
+  for (const char* p = begin; p < end && len < sizeof(decoded) - 1; p++) {
+    if (*p == '+') {
+      decoded[len++] = ' ';
+    } else if (*p == '%' && end - p > 2 && isxdigit((unsigned char)p[1]) && isxdigit((unsigned char)p[2])) {
+      char hex[3] = {p[1], p[2], '\0'};
+      decoded[len++] = (char)strtol(hex, nullptr, 16);
+      p += 2;
+    } else {
+      decoded[len++] = *p;
+    }
+  }
+  decoded[len] = '\0';
+  return String(decoded);
+}
+
+static String findArgCaseInsensitive(const BenchRequest& request, const char* name) {
+  const char* sources[] = {request.query, request.body};
+  size_t nameLen = strlen(name);
+
+  for (const char* p : sources) {
+    while (*p) {
+      const char* end = strchr(p, '&');
+      if (!end) end = p + strlen(p);
+      const char* eq = (const char*)memchr(p, '=', end - p);
+      const char* nameEnd = eq ? eq : end;
+
+      if ((size_t)(nameEnd - p) == nameLen && strncasecmp(p, name, nameLen) == 0) {
+        return eq ? decodeArg(eq + 1, end) : String();
+      }
+      p = *end ? end + 1 : end;
+    }
+  }
+  return String();
+}
+
+static int32_t documentClientTransactionID(const BenchRequest& request) {
+  String val = findArgCaseInsensitive(request, "ClientTransactionID");
+  if (val.length() > 0) {
+    int32_t id = (int32_t)val.toInt();
+    return (id >= 0) ? id : 0;
+  }
+  return 0;
+}
+
+static size_t documentEnvelope(const BenchRequest& request, JsonDocument& doc, char* out) {
+  char buffer[1024];
+  doc["ClientTransactionID"] = documentClientTransactionID(request);
+  doc["ServerTransactionID"] = ++g_serverTransactionID;
+  doc["ErrorNumber"] = 0;
+  doc["ErrorMessage"] = "";
+  size_t len = serializeJson(doc, buffer, sizeof(buffer));
+  memcpy(out, buffer, len + 1);  // stands in for httpd_resp_send()
+  return len;
+}
+
+static size_t documentIntValue(const BenchRequest& request, char* out) {
+  JsonDocument doc;
+  doc["Value"] = 1;
+  return documentEnvelope(request, doc, out);
+}
+
+static size_t documentStringValue(const BenchRequest& request, char* out) {
+  JsonDocument doc;
+  doc["Value"] = "DarkLight Cover Calibrator - ESP32-S3";
+  return documentEnvelope(request, doc, out);
+}
+
+static size_t documentMethod(const BenchRequest& request, char* out) {
+  JsonDocument doc;
+  return documentEnvelope(request, doc, out);
+}
+
+static size_t documentDeviceState(const BenchRequest& request, char* out) {
+  JsonDocument doc;
+  JsonArray stateArr = doc["Value"].to<JsonArray>();
+  const char* names[] = {"CoverState", "CalibratorState", "Brightness"};
+  for (uint8_t i = 0; i < 3; i++) {
+    JsonObject item = stateArr.add<JsonObject>();
+    item["Name"] = names[i];
+    item["Value"] = (int)i + 1;
+  }
+  JsonObject cm = stateArr.add<JsonObject>();
+  cm["Name"] = "CoverMoving";
+  cm["Value"] = false;
+  JsonObject cc = stateArr.add<JsonObject>();
+  cc["Name"] = "CalibratorChanging";
+  cc["Value"] = false;
+  return documentEnvelope(request, doc, out);
+}
+
+// ============================================================
+// Writer path (as alpaca_handler.cpp does now)
+// ============================================================
+
+static char g_response[ALPACA_RESPONSE_LEN];
+
+static uint32_t writerClientTransactionID(const BenchRequest& request) {
+  static const char NAME[] = "ClientTransactionID";
+  const char* sources[] = {request.query, request.body};
+
+  for (const char* p : sources) {
+    while (*p) {
+      const char* end = strchr(p, '&');
+      if (!end) end = p + strlen(p);
+      const char* eq = (const char*)memchr(p, '=', end - p);
+      const char* nameEnd = eq ? eq : end;
+
+      if ((size_t)(nameEnd - p) == sizeof(NAME) - 1 && strncasecmp(p, NAME, sizeof(NAME) - 1) == 0) {
+        uint32_t id = 0;
+        for (const char* d = eq ? eq + 1 : end; d < end && *d >= '0' && *d <= '9'; d++) {
+          uint32_t digit = *d - '0';
+          if (id > (UINT32_MAX - digit) / 10) return 0;
+          id = id * 10 + digit;
+        }
+        return id;
+      }
+      p = *end ? end + 1 : end;
+    }
+  }
+  return 0;
+}
+
+static size_t writerEnvelope(const BenchRequest& request, JsonWriter& json, char* out) {
+  json.field("ClientTransactionID", writerClientTransactionID(request));
+  json.field("ServerTransactionID", ++g_serverTransactionID);
+  json.field("ErrorNumber", 0);
+  json.field("ErrorMessage", "");
+  json.endObject();
+  memcpy(out, json.c_str(), json.length() + 1);
+  return json.length();
+}
+
+static size_t writerIntValue(const BenchRequest& request, char* out) {
+  JsonWriter json(g_response, sizeof(g_response));
+  json.beginObject();
+  json.field("Value", 1);
+  return writerEnvelope(request, json, out);
+}
+
+static size_t writerStringValue(const BenchRequest& request, char* out) {
+  JsonWriter json(g_response, sizeof(g_response));
+  json.beginObject();
+  json.field("Value", "DarkLight Cover Calibrator - ESP32-S3");
+  return writerEnvelope(request, json, out);
+}
+
+static size_t writerMethod(const BenchRequest& request, char* out) {
+  JsonWriter json(g_response, sizeof(g_response));
+  json.beginObject();
+  return writerEnvelope(request, json, out);
+}
+
+static void addStateItem(JsonWriter& json, const char* name, int value) {
+  json.beginObject();
+  json.field("Name", name);
+  json.field("Value", value);
+  json.endObject();
+}
+
+static void addStateItem(JsonWriter& json, const char* name, bool value) {
+  json.beginObject();
+  json.field("Name", name);
+  json.field("Value", value);
+  json.endObject();
+}
+
+static size_t writerDeviceState(const BenchRequest& request, char* out) {
+  JsonWriter json(g_response, sizeof(g_response));
+  json.beginObject();
+  json.key("Value");
+  json.beginArray();
+  addStateItem(json, "CoverState", 1);
+  addStateItem(json, "CalibratorState", 2);
+  addStateItem(json, "Brightness", 3);
+  addStateItem(json, "CoverMoving", false);
+  addStateItem(json, "CalibratorChanging", false);
+  json.endArray();
+  return writerEnvelope(request, json, out);
+}
+
+// ============================================================
+// Runner
+// ============================================================
+
+typedef size_t (*ReplyBuilder)(const BenchRequest& request, char* out);
+
+struct BenchCase {
+  const char* name;
+  const BenchRequest* request;
+  ReplyBuilder document;
+  ReplyBuilder writer;
+};
+
+static const BenchCase CASES[] = {
+  {"value_int",    &GET_REQUEST, documentIntValue,    writerIntValue},
+  {"value_string", &GET_REQUEST, documentStringValue, writerStringValue},
+  {"method",       &PUT_REQUEST, documentMethod,      writerMethod},
+  {"devicestate",  &GET_REQUEST, documentDeviceState, writerDeviceState},
+};
+
+struct BenchResult {
+  double nsPerReply;
+  double allocationsPerReply;
+  double bytesPerReply;
+};
+
+static BenchResult run(ReplyBuilder build, const BenchRequest& request, uint32_t iterations) {
+  char out[ALPACA_RESPONSE_LEN];
+  volatile size_t sink = 0;
+
+  // Warm up caches and the allocator
+  for (uint32_t i = 0; i < iterations / 10 + 1; i++) sink = sink + build(request, out);
+
+  uint64_t allocations = g_allocations;
+  uint64_t bytes = g_allocatedBytes;
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < iterations; i++) sink = sink + build(request, out);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  BenchResult result;
+  result.nsPerReply = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+  result.allocationsPerReply = (double)(g_allocations - allocations) / iterations;
+  result.bytesPerReply = (double)(g_allocatedBytes - bytes) / iterations;
+  return result;
+}
+
+// Same ServerTransactionID for both, so the bytes can be compared
+static bool sameOutput(const BenchCase& benchCase) {
+  char document[ALPACA_RESPONSE_LEN];
+  char writer[ALPACA_RESPONSE_LEN];
+
+  uint32_t transactionID = g_serverTransactionID;
+  benchCase.document(*benchCase.request, document);
+  g_serverTransactionID = transactionID;
+  benchCase.writer(*benchCase.request, writer);
+
+  if (strcmp(document, writer) != 0) {
+    fprintf(stderr, "%s: outputs differ\n  document: %s\n  writer:   %s\n", benchCase.name, document, writer);
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char** argv) {
+  uint32_t iterations = 200000;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+      iterations = strtoul(argv[++i], nullptr, 10);
+    } else {
+      fprintf(stderr, "Usage: %s [--iterations <n>]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (iterations == 0) iterations = 1;
+
+  bool identical = true;
+  printf("{\n  \"iterations\": %u,\n  \"cases\": {\n", iterations);
+
+  size_t caseCount = sizeof(CASES) / sizeof(CASES[0]);
+  for (size_t i = 0; i < caseCount; i++) {
+    const BenchCase& benchCase = CASES[i];
+    identical &= sameOutput(benchCase);
+
+    BenchResult document = run(benchCase.document, *benchCase.request, iterations);
+    BenchResult writer = run(benchCase.writer, *benchCase.request, iterations);
+
+    printf("    \"%s\": {\n", benchCase.name);
+    printf("      \"document\": {\"ns\": %.1f, \"allocs\": %.2f, \"bytes\": %.1f},\n",
+           document.nsPerReply, document.allocationsPerReply, document.bytesPerReply);
+    printf("      \"writer\": {\"ns\": %.1f, \"allocs\": %.2f, \"bytes\": %.1f},\n",
+           writer.nsPerReply, writer.allocationsPerReply, writer.bytesPerReply);
+    printf("      \"speedup\": %.2f\n", document.nsPerReply / writer.nsPerReply);
+    printf("    }%s\n", i + 1 < caseCount ? "," : "");
+  }
+
+  printf("  },\n  \"identical\": %s\n}\n", identical ? "true" : "false");
+  return identical ? 0 : 1;
+}
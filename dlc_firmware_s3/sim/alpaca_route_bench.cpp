@@ -0,0 +1,222 @@
+/*
+  alpaca_route_bench.cpp - Alpaca URL dispatch benchmark
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Finds the handler for common Alpaca URLs two ways and reports ns per
+  lookup as JSON on stdout:
+    list - the previous path: every URL registered with httpd as an
+           exact-match route, members repeated for each device number,
+           and walked in order with string compares (as httpd does)
+    hash - alpaca_router.h: one hash of a few path features, then one
+           route compared with memcmp()
+  Both must find the same route and device number for every URL; the exit
+  code is non-zero otherwise. --devices sets how many device numbers the
+  list holds; the hash table does not depend on it. Build with
+  CMAKE_BUILD_TYPE=Release for numbers close to the firmware's -Os.
+
+    dlc_alpaca_route_bench --iterations 1000000 --devices 2
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#include <Arduino.h>
+#include "alpaca_router.h"
+#include "config.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// ============================================================
+// Routes (the paths and methods of AlpacaHandler::_routes)
+// ============================================================
+
+static constexpr AlpacaRoute<int> ROUTES[] = {
+  {"/management/apiversions", HTTP_GET, 0},
+  {"/management/v1/description", HTTP_GET, 0},
+  {"/management/v1/configureddevices", HTTP_GET, 0},
+  {"/setup", HTTP_GET, 0},
+  {"/setup/v1/covercalibrator/#/setup", HTTP_GET, 0},
+  {"/api/v1/covercalibrator/#/action", HTTP_PUT, 0},
+  {"/api/v1/covercalibrator/#/brightness", HTTP_GET, 0},
+  {"/api/v1/covercalibrator/#/calibratorchanging", HTTP_GET, 0},
+  {"/api/v1/covercalibrator/#/calibratoroff", HTTP_PUT, 0},
+  {"/api/v1/covercalibrator/#/calibratoron", HTTP_PUT, 0},
+  {"/api/v1/covercalibrator/#/calibratorstate", HTTP_GET, 0},
+  {"/api/v1/covercalibrator/#/closecover", HTTP_PUT, 0},
+  {"/api/v1/covercalibrator/#/commandblind", HTTP_PUT, 0},
+  {"/api/v1/covercalibrator/#/commandbool", HTTP_PUT, 0},
+  {"/api/v1/covercalibrator/#/commandstring", HTTP_PUT, 0},
+  {"/api/v1/covercalibrator/#/connect", HTTP_PUT, 0},
+  {"/api/v1/covercalibrator/#/connected", HTTP_GET, 0},
+  {"/api/v1/covercalibrator/#/connected", HTTP_PUT, 0},
+  {"/api/v1/covercalibrator/#/connecting", HTTP_GET, 0},
+  {"/api/v1/covercalibrator/#/covermoving", HTTP_GET, 0},
+  {"/api/v1/covercalibrator/#/coverstate", HTTP_GET, 0},
+  {"/api/v1/covercalibrator/#/description", HTTP_GET, 0},
+  {"/api/v1/covercalibrator/#/devicestate", HTTP_GET, 0},
+  {"/api/v1/covercalibrator/#/disconnect", HTTP_PUT, 0},
+  {"/api/v1/covercalibrator/#/driverinfo", HTTP_GET, 0},
+  {"/api/v1/covercalibrator/#/driverversion", HTTP_GET, 0},
+  {"/api/v1/covercalibrator/#/haltcover", HTTP_PUT, 0},
+  {"/api/v1/covercalibrator/#/interfaceversion", HTTP_GET, 0},
+  {"/api/v1/covercalibrator/#/maxbrightness", HTTP_GET, 0},
+  {"/api/v1/covercalibrator/#/name", HTTP_GET, 0},
+  {"/api/v1/covercalibrator/#/opencover", HTTP_PUT, 0},
+  {"/api/v1/covercalibrator/#/supportedactions", HTTP_GET, 0},
+};
+
+static constexpr AlpacaRouteTable ROUTE_TABLE = buildAlpacaRouteTable(ROUTES);
+static_assert(ROUTE_TABLE.valid, "No hash seed separates the routes");
+
+static const size_t ROUTE_COUNT = sizeof(ROUTES) / sizeof(ROUTES[0]);
+
+// ============================================================
+// List path (as alpaca_handler.cpp registered routes before)
+// ============================================================
+
+struct ListEntry {
+  std::string uri;
+  httpd_method_t method;
+  int route;
+  uint32_t device;
+};
+
+static std::vector<ListEntry> g_list;
+
+// Fixed routes first, then the members of each device number in turn
+static void buildList(uint32_t devices) {
+  for (size_t i = 0; i < ROUTE_COUNT; i++) {
+    if (!strchr(ROUTES[i].path, '#')) g_list.push_back({ROUTES[i].path, ROUTES[i].method, (int)i, ALPACA_ROUTE_NO_DEVICE});
+  }
+  for (uint32_t d = 0; d < devices; d++) {
+    for (size_t i = 0; i < ROUTE_COUNT; i++) {
+      const char* mark = strchr(ROUTES[i].path, '#');
+      if (!mark) continue;
+      std::string uri(ROUTES[i].path, mark - ROUTES[i].path);
+      uri += std::to_string(d);
+      uri += mark + 1;
+      g_list.push_back({uri, ROUTES[i].method, (int)i, d});
+    }
+  }
+}
+
+// httpd's default matcher (httpd_uri_match_simple): strlen() of each
+// registered URI against the path up to '?', strncmp(), then the method
+static int listFind(const char* uri, httpd_method_t method, uint32_t& device) {
+  size_t length = strcspn(uri, "?");
+  for (const ListEntry& entry : g_list) {
+    const char* registered = entry.uri.c_str();
+    if (strlen(registered) == length && strncmp(registered, uri, length) == 0 && entry.method == method) {
+      device = entry.device;
+      return entry.route;
+    }
+  }
+  device = ALPACA_ROUTE_NO_DEVICE;
+  return -1;
+}
+
+// ============================================================
+// Hash path (as alpaca_handler.cpp does now)
+// ============================================================
+
+static int hashFind(const char* uri, httpd_method_t method, uint32_t& device) {
+  int route = findAlpacaRoute(ROUTES, ROUTE_TABLE, uri, method, device);
+  if (route < 0) device = ALPACA_ROUTE_NO_DEVICE;
+  return route;
+}
+
+// ============================================================
+// Runner
+// ============================================================
+
+typedef int (*RouteFinder)(const char* uri, httpd_method_t method, uint32_t& device);
+
+struct BenchCase {
+  const char* name;
+  const char* uri;
+  httpd_method_t method;
+};
+
+// Early, middle and late in the list, the last device and a miss
+static const BenchCase CASES[] = {
+  {"apiversions",      "/management/apiversions?ClientID=1&ClientTransactionID=123456", HTTP_GET},
+  {"connected_put",    "/api/v1/covercalibrator/0/connected", HTTP_PUT},
+  {"coverstate",       "/api/v1/covercalibrator/0/coverstate?ClientID=1&ClientTransactionID=123456", HTTP_GET},
+  {"supportedactions", "/api/v1/covercalibrator/0/supportedactions?ClientID=1&ClientTransactionID=123456", HTTP_GET},
+  {"last_device",      nullptr, HTTP_GET},
+  {"not_found",        "/api/v1/covercalibrator/0/nosuchmember?ClientID=1", HTTP_GET},
+};
+
+static double run(RouteFinder find, const char* uri, httpd_method_t method, uint32_t iterations) {
+  volatile int sink = 0;
+  uint32_t device;
+
+  for (uint32_t i = 0; i < iterations / 10 + 1; i++) sink = sink + find(uri, method, device);
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < iterations; i++) sink = sink + find(uri, method, device);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+}
+
+static bool sameRoute(const char* name, const char* uri, httpd_method_t method) {
+  uint32_t listDevice, hashDevice;
+  int list = listFind(uri, method, listDevice);
+  int hash = hashFind(uri, method, hashDevice);
+  if (list != hash || listDevice != hashDevice) {
+    fprintf(stderr, "%s: routes differ for %s\n  list: %d (device %u)\n  hash: %d (device %u)\n",
+            name, uri, list, listDevice, hash, hashDevice);
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char** argv) {
+  uint32_t iterations = 1000000;
+  uint32_t devices = 1;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+      iterations = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--devices") == 0 && i + 1 < argc) {
+      devices = strtoul(argv[++i], nullptr, 10);
+    } else {
+      fprintf(stderr, "Usage: %s [--iterations <n>] [--devices <1-16>]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (iterations == 0) iterations = 1;
+  if (devices == 0 || devices > 16) devices = 1;
+  buildList(devices);
+
+  char lastDevice[96];
+  snprintf(lastDevice, sizeof(lastDevice), "/api/v1/covercalibrator/%u/coverstate?ClientID=1", devices - 1);
+
+  // Every list entry must resolve the same way, not just the timed cases
+  bool identical = true;
+  for (const ListEntry& entry : g_list) identical &= sameRoute("route", entry.uri.c_str(), entry.method);
+
+  printf("{\n  \"iterations\": %u,\n  \"devices\": %u,\n  \"list_routes\": %u,\n  \"hash_slots\": %u,\n  \"cases\": {\n",
+         iterations, devices, (unsigned)g_list.size(), (unsigned)ALPACA_ROUTE_SLOTS);
+
+  size_t caseCount = sizeof(CASES) / sizeof(CASES[0]);
+  for (size_t i = 0; i < caseCount; i++) {
+    const BenchCase& benchCase = CASES[i];
+    const char* uri = benchCase.uri ? benchCase.uri : lastDevice;
+    identical &= sameRoute(benchCase.name, uri, benchCase.method);
+
+    double list = run(listFind, uri, benchCase.method, iterations);
+    double hash = run(hashFind, uri, benchCase.method, iterations);
+
+    printf("    \"%s\": {\"list_ns\": %.1f, \"hash_ns\": %.1f, \"speedup\": %.2f}%s\n",
+           benchCase.name, list, hash, list / hash, i + 1 < caseCount ? "," : "");
+  }
+
+  printf("  },\n  \"identical\": %s\n}\n", identical ? "true" : "false");
+  return identical ? 0 : 1;
+}
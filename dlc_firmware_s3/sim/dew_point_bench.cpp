@@ -0,0 +1,121 @@
+/*
+  dew_point_bench.cpp - Dew point accuracy check and benchmark
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Evaluates the dew point on every 0.05 C and 0.05 %RH step over -40..85 C
+  and 1..100 %RH three ways:
+    reference - the August-Roche-Magnus formula in double precision
+    magnus    - DewPoint::magnus(), the float formula (ENABLE_FIXED_DEW_POINT off)
+    fixed     - DewPoint::fixed(), the dlcDewPoint kernel both firmwares use
+  and reports the largest error of each against the reference, where it
+  occurs, and ns per call, as JSON. The exit code is non-zero if fixed is
+  off by more than DEW_POINT_TOLERANCE anywhere. Host timings only rank
+  the paths; the AVR's float log() is far slower than the host's.
+
+    dlc_dew_point_bench --step 0.05
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#include <Arduino.h>
+#include "dew_point.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+typedef float (*DewPointPath)(float temp, float humidity);
+
+static float magnusPath(float temp, float humidity) { return DewPoint::magnus(temp, humidity); }
+static float fixedPath(float temp, float humidity)  { return DewPoint::fixed(temp, humidity); }
+
+static double reference(double temp, double humidity) {
+  double a = 17.27, b = 237.7;
+  double gamma = a * temp / (b + temp) + std::log(humidity / 100.0);
+  return b * gamma / (a - gamma);
+}
+
+struct Point {
+  float temp;
+  float humidity;
+  double expected;
+};
+
+struct Result {
+  const char* name;
+  double maxError;
+  float worstTemp;
+  float worstHumidity;
+  double ns;
+};
+
+static Result measure(const char* name, DewPointPath path, const std::vector<Point>& points, uint32_t rounds) {
+  Result result = {name, 0.0, 0.0f, 0.0f, 0.0};
+  for (const Point& point : points) {
+    double error = std::fabs(path(point.temp, point.humidity) - point.expected);
+    if (error > result.maxError) {
+      result.maxError = error;
+      result.worstTemp = point.temp;
+      result.worstHumidity = point.humidity;
+    }
+  }
+
+  volatile float sink = 0.0f;
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t r = 0; r < rounds; r++) {
+    for (const Point& point : points) sink = sink + path(point.temp, point.humidity);
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  result.ns = std::chrono::duration<double, std::nano>(elapsed).count() / ((double)points.size() * rounds);
+  return result;
+}
+
+int main(int argc, char** argv) {
+  double step = 0.05;
+  uint32_t rounds = 1;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--step") == 0 && i + 1 < argc) {
+      step = strtod(argv[++i], nullptr);
+    } else if (strcmp(argv[i], "--rounds") == 0 && i + 1 < argc) {
+      rounds = strtoul(argv[++i], nullptr, 10);
+    } else {
+      fprintf(stderr, "Usage: %s [--step <C and %%RH>] [--rounds <n>]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (step <= 0.0) step = 0.05;
+  if (rounds == 0) rounds = 1;
+
+  // Steps counted in integers, so both ends are always included
+  std::vector<Point> points;
+  long tempSteps = lround(125.0 / step), humiditySteps = lround(99.0 / step);
+  for (long t = 0; t <= tempSteps; t++) {
+    for (long h = 0; h <= humiditySteps; h++) {
+      float temp = (float)(-40.0 + 125.0 * t / tempSteps);
+      float humidity = (float)(1.0 + 99.0 * h / humiditySteps);
+      points.push_back({temp, humidity, reference(temp, humidity)});
+    }
+  }
+
+  Result results[] = {
+    measure("magnus", magnusPath, points, rounds),
+    measure("fixed", fixedPath, points, rounds),
+  };
+
+  bool within = results[1].maxError <= DEW_POINT_TOLERANCE;
+
+  printf("{\n  \"points\": %u,\n  \"tolerance\": %.2f,\n  \"paths\": {\n", (unsigned)points.size(), DEW_POINT_TOLERANCE);
+  size_t count = sizeof(results) / sizeof(results[0]);
+  for (size_t i = 0; i < count; i++) {
+    const Result& r = results[i];
+    printf("    \"%s\": {\"max_error\": %.4f, \"at_temp\": %.2f, \"at_humidity\": %.2f, \"ns\": %.1f}%s\n",
+           r.name, r.maxError, r.worstTemp, r.worstHumidity, r.ns, i + 1 < count ? "," : "");
+  }
+  printf("  },\n  \"within_tolerance\": %s\n}\n", within ? "true" : "false");
+  return within ? 0 : 1;
+}
@@ -0,0 +1,78 @@
+/*
+  Adafruit_BME280.h - Host HAL: BME280 ambient sensor for the Linux simulator
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Readings come from the environment model in sim_world.cpp. The simulated
+  part answers at address 0x76 only. The protected members match the
+  library's, so subclasses can read the data registers through i2c_dev;
+  sim_sensors.cpp answers with raw values for SIM_BME280_CALIB.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef ADAFRUIT_BME280_H
+#define ADAFRUIT_BME280_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <Adafruit_I2CDevice.h>
+#include "sim_world.h"
+
+typedef struct {
+  uint16_t dig_T1;
+  int16_t dig_T2;
+  int16_t dig_T3;
+
+  uint16_t dig_P1;
+  int16_t dig_P2;
+  int16_t dig_P3;
+  int16_t dig_P4;
+  int16_t dig_P5;
+  int16_t dig_P6;
+  int16_t dig_P7;
+  int16_t dig_P8;
+  int16_t dig_P9;
+
+  uint8_t dig_H1;
+  int16_t dig_H2;
+  uint8_t dig_H3;
+  int16_t dig_H4;
+  int16_t dig_H5;
+  int8_t dig_H6;
+} bme280_calib_data;
+
+// Trimming values of a real part (datasheet example for T and P)
+const bme280_calib_data SIM_BME280_CALIB = {
+  27504, 26435, -1000,
+  36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000,
+  75, 362, 0, 313, 50, 30
+};
+
+class Adafruit_BME280 {
+public:
+  ~Adafruit_BME280() { delete i2c_dev; }
+
+  bool begin(uint8_t address = 0x77, TwoWire* wire = &Wire) {
+    delete i2c_dev;
+    i2c_dev = new Adafruit_I2CDevice(address, wire);
+    _bme280_calib = SIM_BME280_CALIB;
+    _present = (address == 0x76) && SimWorld::ambientSensorPresent();
+    return _present;
+  }
+
+  float readTemperature() { return _present ? SimWorld::ambientTemp() : NAN; }
+  float readHumidity() { return _present ? SimWorld::humidity() : NAN; }
+  float readPressure() { return _present ? 101325.0f : NAN; }
+
+protected:
+  Adafruit_I2CDevice* i2c_dev = nullptr;
+  int32_t t_fine = 0;
+  int32_t t_fine_adjust = 0;
+  bme280_calib_data _bme280_calib = {};
+
+private:
+  bool _present = false;
+};
+
+#endif // ADAFRUIT_BME280_H
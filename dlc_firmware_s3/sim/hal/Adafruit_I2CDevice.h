@@ -0,0 +1,32 @@
+/*
+  Adafruit_I2CDevice.h - Host HAL: Adafruit BusIO I2C device for the Linux simulator
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Transactions go to the register models in sim_sensors.cpp and take the
+  time the bytes would take on the bus at the Wire clock.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef ADAFRUIT_I2C_DEVICE_H
+#define ADAFRUIT_I2C_DEVICE_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+class Adafruit_I2CDevice {
+public:
+  Adafruit_I2CDevice(uint8_t address, TwoWire* wire = &Wire) : _address(address), _wire(wire) {}
+
+  uint8_t address() const { return _address; }
+
+  bool write_then_read(const uint8_t* writeBuffer, size_t writeLength, uint8_t* readBuffer, size_t readLength,
+                       bool stop = false);
+
+private:
+  uint8_t _address;
+  TwoWire* _wire;
+};
+
+#endif // ADAFRUIT_I2C_DEVICE_H
@@ -0,0 +1,188 @@
+/*
+  Arduino.h - Host HAL: core Arduino API for the Linux simulator
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Provides the subset of the Arduino/ESP32 core the firmware uses: virtual
+  time, pin I/O, String, a pty-backed Serial and ESP.restart().
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+
+// The ESP32 core pulls FreeRTOS in with Arduino.h
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
+
+// ============================================================
+// Core definitions
+// ============================================================
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x01
+#define OUTPUT       0x03
+#define INPUT_PULLUP 0x05
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+// Flash and RAM share one address space on the ESP32, as on the host
+#define PROGMEM
+typedef const char* PGM_P;
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+
+// ============================================================
+// Time and pin I/O (virtual clock, see sim_hal.cpp)
+// ============================================================
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int  digitalRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+void analogWriteResolution(uint8_t bits);
+
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+
+char* itoa(int value, char* str, int base);
+char* dtostrf(double value, signed char width, unsigned char precision, char* str);
+
+// ============================================================
+// String
+// ============================================================
+
+class String {
+public:
+  String() {}
+  String(const char* s) : _s(s ? s : "") {}
+  String(const std::string& s) : _s(s) {}
+  String(char c) : _s(1, c) {}
+  explicit String(int value, unsigned char base = 10);
+  explicit String(unsigned int value, unsigned char base = 10);
+  explicit String(long value, unsigned char base = 10);
+  explicit String(unsigned long value, unsigned char base = 10);
+  explicit String(float value, unsigned char decimals = 2);
+  explicit String(double value, unsigned char decimals = 2);
+
+  const char* c_str() const { return _s.c_str(); }
+  unsigned int length() const { return _s.length(); }
+  bool isEmpty() const { return _s.empty(); }
+  void reserve(unsigned int size) { _s.reserve(size); }
+
+  char charAt(unsigned int index) const { return index < _s.length() ? _s[index] : 0; }
+  char operator[](unsigned int index) const { return charAt(index); }
+
+  String& operator+=(const String& rhs) { _s += rhs._s; return *this; }
+  String& operator+=(const char* rhs) { _s += rhs ? rhs : ""; return *this; }
+  String& operator+=(char rhs) { _s += rhs; return *this; }
+  bool concat(const String& rhs) { _s += rhs._s; return true; }
+
+  bool operator==(const String& rhs) const { return _s == rhs._s; }
+  bool operator==(const char* rhs) const { return _s == (rhs ? rhs : ""); }
+  bool operator!=(const String& rhs) const { return _s != rhs._s; }
+  bool operator!=(const char* rhs) const { return !(*this == rhs); }
+  bool equals(const String& rhs) const { return _s == rhs._s; }
+  bool equalsIgnoreCase(const String& rhs) const;
+  bool startsWith(const String& prefix) const { return _s.compare(0, prefix._s.length(), prefix._s) == 0; }
+  bool endsWith(const String& suffix) const;
+
+  int indexOf(char c, unsigned int from = 0) const;
+  int indexOf(const String& s, unsigned int from = 0) const;
+  int lastIndexOf(char c) const;
+  String substring(unsigned int from) const;
+  String substring(unsigned int from, unsigned int to) const;
+  void replace(const String& find, const String& replacement);
+  void toLowerCase();
+  void toUpperCase();
+  void trim();
+
+  long toInt() const { return strtol(_s.c_str(), nullptr, 10); }
+  float toFloat() const { return strtof(_s.c_str(), nullptr); }
+
+  const std::string& str() const { return _s; }
+
+private:
+  std::string _s;
+};
+
+String operator+(const String& lhs, const String& rhs);
+String operator+(const String& lhs, const char* rhs);
+String operator+(const char* lhs, const String& rhs);
+
+// ============================================================
+// Serial (pseudo-terminal, see sim_hal.cpp)
+// ============================================================
+
+class HardwareSerial {
+public:
+  explicit HardwareSerial(int port) : _port(port) {}
+
+  void begin(unsigned long baud) { (void)baud; }
+  void end() {}
+  int available();
+  int read();
+  int peek();
+  void flush() {}
+
+  size_t write(uint8_t c) { return write(&c, 1); }
+  size_t write(const uint8_t* buffer, size_t size);
+  int availableForWrite();
+
+  size_t print(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+  size_t print(const String& s) { return print(s.c_str()); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int value) { return printf("%d", value); }
+  size_t print(unsigned int value) { return printf("%u", value); }
+  size_t print(long value) { return printf("%ld", value); }
+  size_t print(unsigned long value) { return printf("%lu", value); }
+  size_t print(double value, int digits = 2) { return printf("%.*f", digits, value); }
+
+  size_t println() { return print("\r\n"); }
+  template <typename T> size_t println(const T& value) { size_t n = print(value); return n + println(); }
+
+  size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+  operator bool() const { return true; }
+
+private:
+  int _port;
+  int _peeked = -1;
+};
+
+extern HardwareSerial Serial;   // USB CDC (pty)
+extern HardwareSerial Serial0;  // UART0 (stderr)
+
+// ============================================================
+// ESP
+// ============================================================
+
+class EspClass {
+public:
+  void restart();
+};
+
+extern EspClass ESP;
+
+#endif // ARDUINO_H
@@ -0,0 +1,55 @@
+/*
+  DHT.h - Host HAL: DHT22 ambient sensor for the Linux simulator
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Readings come from the environment model in sim_world.cpp.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef DHT_H
+#define DHT_H
+
+#include <Arduino.h>
+#include "sim_world.h"
+
+#define DHT11 11
+#define DHT22 22
+
+class DHT {
+public:
+  DHT() {}
+  DHT(uint8_t pin, uint8_t type) : _pin(pin), _type(type) {}
+
+  void begin() {}
+
+  float readTemperature(bool fahrenheit = false, bool force = false) {
+    if (!read(force)) return NAN;
+    float c = SimWorld::ambientTemp();
+    return fahrenheit ? c * 1.8f + 32.0f : c;
+  }
+
+  float readHumidity(bool force = false) {
+    return read(force) ? SimWorld::humidity() : NAN;
+  }
+
+private:
+  uint8_t _pin = 0;
+  uint8_t _type = DHT22;
+  uint32_t _lastRead = 0;
+  bool _lastResult = false;
+
+  // As the library: one transfer (1.1 ms start, ~4 ms of data) at most
+  // every 2 s, the result kept for the calls in between
+  bool read(bool force) {
+    uint32_t now = millis();
+    if (!force && _lastRead != 0 && now - _lastRead < 2000) return _lastResult;
+    _lastRead = now ? now : 1;
+    delayMicroseconds(5100);
+    _lastResult = SimWorld::ambientSensorPresent();
+    return _lastResult;
+  }
+};
+
+#endif // DHT_H
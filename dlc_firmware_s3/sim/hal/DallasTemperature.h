@@ -0,0 +1,94 @@
+/*
+  DallasTemperature.h - Host HAL: DS18B20 heater sensor for the Linux simulator
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Readings come from the heater thermal model in sim_world.cpp. Each call
+  takes the time its 1-Wire traffic would at standard speed (OneWire.h),
+  so the loop profiler sees the real cost of a search or a read.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef DALLAS_TEMPERATURE_H
+#define DALLAS_TEMPERATURE_H
+
+#include <Arduino.h>
+#include <OneWire.h>
+#include "sim_world.h"
+
+#define DEVICE_DISCONNECTED_C -127
+
+typedef uint8_t DeviceAddress[8];
+
+// Family 0x28 (DS18B20), serial, CRC
+const DeviceAddress SIM_DS18B20_ADDRESS = {0x28, 0xFF, 0x4C, 0x19, 0x61, 0x16, 0x04, 0x5E};
+
+class DallasTemperature {
+public:
+  DallasTemperature() {}
+  explicit DallasTemperature(OneWire* bus) : _bus(bus) {}
+
+  void begin() {}
+  void setWaitForConversion(bool wait) { _waitForConversion = wait; }
+  uint8_t getDeviceCount() { return SimWorld::heaterSensorPresent() ? 1 : 0; }
+
+  // Search ROM from the start of the bus up to device index
+  bool getAddress(uint8_t* address, uint8_t index) {
+    if (!SimWorld::heaterSensorPresent()) {
+      OneWire::busTime(1, 0);  // no presence pulse after the reset
+      return false;
+    }
+    OneWire::busTime(1, 1, 8 * 3 * 8);  // every bit: two reads and a write
+    if (index != 0) return false;
+    memcpy(address, SIM_DS18B20_ADDRESS, sizeof(DeviceAddress));
+    return true;
+  }
+
+  // Reads the scratchpad for the configuration byte
+  uint8_t getResolution(const uint8_t* address) {
+    return readScratchPad(address) ? 12 : 0;
+  }
+
+  static uint16_t millisToWaitForConversion(uint8_t bitResolution) {
+    switch (bitResolution) {
+      case 9:  return 94;
+      case 10: return 188;
+      case 11: return 375;
+      default: return 750;
+    }
+  }
+
+  // Skip ROM + Convert T to every sensor
+  void requestTemperatures() {
+    OneWire::busTime(1, 2);
+    _reading = SimWorld::heaterSensorPresent() ? SimWorld::heaterTemp() : DEVICE_DISCONNECTED_C;
+    if (_waitForConversion) delay(millisToWaitForConversion(12));
+  }
+
+  float getTempC(const uint8_t* address) {
+    return readScratchPad(address) ? _reading : DEVICE_DISCONNECTED_C;
+  }
+
+  float getTempCByIndex(uint8_t index) {
+    DeviceAddress address;
+    return getAddress(address, index) ? getTempC(address) : DEVICE_DISCONNECTED_C;
+  }
+
+private:
+  OneWire* _bus = nullptr;
+  bool _waitForConversion = true;
+  float _reading = DEVICE_DISCONNECTED_C;
+
+  // Match ROM, Read Scratchpad, 9 bytes and a closing reset
+  bool readScratchPad(const uint8_t* address) {
+    if (!SimWorld::heaterSensorPresent()) {
+      OneWire::busTime(1, 0);
+      return false;
+    }
+    OneWire::busTime(2, 1 + 8 + 1 + 9);
+    return memcmp(address, SIM_DS18B20_ADDRESS, sizeof(DeviceAddress)) == 0;
+  }
+};
+
+#endif // DALLAS_TEMPERATURE_H
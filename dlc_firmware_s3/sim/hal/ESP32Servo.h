@@ -0,0 +1,32 @@
+/*
+  ESP32Servo.h - Host HAL: servo output for the Linux simulator
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Pulses are recorded as the pin value (see SimHal::pinValue) so the
+  simulator can report the shaft position.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef ESP32_SERVO_H
+#define ESP32_SERVO_H
+
+#include <Arduino.h>
+
+class Servo {
+public:
+  int attach(int pin, int minPulse = 544, int maxPulse = 2400);
+  void detach();
+  bool attached() const { return _pin >= 0; }
+  void writeMicroseconds(int value);
+  int readMicroseconds() const { return _pulse; }
+
+private:
+  int _pin = -1;
+  int _minPulse = 544;
+  int _maxPulse = 2400;
+  int _pulse = 0;
+};
+
+#endif // ESP32_SERVO_H
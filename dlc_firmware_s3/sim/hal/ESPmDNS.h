@@ -0,0 +1,27 @@
+/*
+  ESPmDNS.h - Host HAL: mDNS responder for the Linux simulator
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Host name advertisement is left to the host; begin() always succeeds.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef ESP_MDNS_H
+#define ESP_MDNS_H
+
+#include <Arduino.h>
+
+class MDNSResponder {
+public:
+  bool begin(const char* hostName) { (void)hostName; return true; }
+  void end() {}
+  void addService(const char* service, const char* proto, uint16_t port) {
+    (void)service; (void)proto; (void)port;
+  }
+};
+
+extern MDNSResponder MDNS;
+
+#endif // ESP_MDNS_H
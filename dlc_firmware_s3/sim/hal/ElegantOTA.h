@@ -0,0 +1,32 @@
+/*
+  ElegantOTA.h - Host HAL: OTA update endpoint for the Linux simulator
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Registers /update so the Web UI link resolves, but firmware images are
+  not accepted by the simulator.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef ELEGANT_OTA_H
+#define ELEGANT_OTA_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+
+class ElegantOTAClass {
+public:
+  void begin(WebServer* server, const char* username = "", const char* password = "") {
+    (void)username; (void)password;
+    server->on("/update", [server]() {
+      server->send(501, "text/plain", "OTA updates are not available in the simulator");
+    });
+  }
+
+  void loop() {}
+};
+
+extern ElegantOTAClass ElegantOTA;
+
+#endif // ELEGANT_OTA_H
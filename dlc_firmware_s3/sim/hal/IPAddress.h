@@ -0,0 +1,41 @@
+/*
+  IPAddress.h - Host HAL: IPv4 address for the Linux simulator
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef IP_ADDRESS_H
+#define IP_ADDRESS_H
+
+#include <Arduino.h>
+
+class IPAddress {
+public:
+  IPAddress() {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _octets{a, b, c, d} {}
+
+  uint8_t operator[](int index) const { return _octets[index]; }
+  uint8_t& operator[](int index) { return _octets[index]; }
+
+  bool fromString(const char* address) {
+    unsigned a, b, c, d;
+    char extra;
+    if (sscanf(address, "%u.%u.%u.%u%c", &a, &b, &c, &d, &extra) != 4) return false;
+    if (a > 255 || b > 255 || c > 255 || d > 255) return false;
+    _octets[0] = a; _octets[1] = b; _octets[2] = c; _octets[3] = d;
+    return true;
+  }
+
+  String toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", _octets[0], _octets[1], _octets[2], _octets[3]);
+    return String(buf);
+  }
+
+private:
+  uint8_t _octets[4] = {0, 0, 0, 0};
+};
+
+#endif // IP_ADDRESS_H
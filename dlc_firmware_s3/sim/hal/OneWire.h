@@ -0,0 +1,30 @@
+/*
+  OneWire.h - Host HAL: 1-Wire bus for the Linux simulator
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef ONE_WIRE_H
+#define ONE_WIRE_H
+
+#include <Arduino.h>
+
+class OneWire {
+public:
+  OneWire() {}
+  explicit OneWire(uint8_t pin) : _pin(pin) {}
+  uint8_t pin() const { return _pin; }
+
+  // Standard speed: a reset is 480 us low and 480 us of presence window,
+  // a bit is a 70 us slot. Blocks for the time the traffic would take.
+  static void busTime(uint8_t resets, uint16_t bytes, uint16_t extraBits = 0) {
+    delayMicroseconds(resets * 960u + (bytes * 8u + extraBits) * 70u);
+  }
+
+private:
+  uint8_t _pin = 0;
+};
+
+#endif // ONE_WIRE_H
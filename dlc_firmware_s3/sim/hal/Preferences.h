@@ -0,0 +1,52 @@
+/*
+  Preferences.h - Host HAL: NVS key/value storage for the Linux simulator
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Keeps each namespace in memory and, when the simulator is started with
+  --nvs <dir>, persists it to <dir>/<namespace>.nvs as key=value lines.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef PREFERENCES_H
+#define PREFERENCES_H
+
+#include <Arduino.h>
+#include <map>
+
+class Preferences {
+public:
+  bool begin(const char* name, bool readOnly = false);
+  void end();
+  bool clear();
+  bool remove(const char* key);
+  bool isKey(const char* key);
+
+  uint8_t  getUChar(const char* key, uint8_t defaultValue = 0);
+  uint16_t getUShort(const char* key, uint16_t defaultValue = 0);
+  uint32_t getULong(const char* key, uint32_t defaultValue = 0);
+  float    getFloat(const char* key, float defaultValue = NAN);
+  bool     getBool(const char* key, bool defaultValue = false);
+  String   getString(const char* key, const String& defaultValue = String());
+
+  size_t putUChar(const char* key, uint8_t value);
+  size_t putUShort(const char* key, uint16_t value);
+  size_t putULong(const char* key, uint32_t value);
+  size_t putFloat(const char* key, float value);
+  size_t putBool(const char* key, bool value);
+  size_t putString(const char* key, const String& value);
+
+private:
+  std::string _name;
+  bool _open = false;
+  bool _readOnly = false;
+  std::map<std::string, std::string> _values;
+
+  bool lookup(const char* key, std::string& value);
+  size_t store(const char* key, const std::string& value, size_t size);
+  void load();
+  void save();
+};
+
+#endif // PREFERENCES_H
@@ -0,0 +1,99 @@
+/*
+  WebServer.h - Host HAL: synchronous HTTP/1.1 server for the Linux simulator
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Mirrors the ESP32 WebServer contract: handleClient() serves at most one
+  request per call, query and form-encoded body parameters are exposed as
+  args, and any other body is exposed as arg("plain"). Listening ports are
+  shifted by the simulator's --port-offset so port 80 needs no privileges.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef WEB_SERVER_H
+#define WEB_SERVER_H
+
+#include <Arduino.h>
+#include <http_parser.h>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// As in the ESP32 core, HTTPMethod is http_parser's enum (shared with esp_http_server)
+typedef enum http_method HTTPMethod;
+#define HTTP_ANY (HTTPMethod)(255)
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+
+class WebServer {
+public:
+  typedef std::function<void(void)> THandlerFunction;
+
+  explicit WebServer(int port = 80) : _port(port) {}
+  ~WebServer() { close(); }
+
+  void begin();
+  void close();
+  void handleClient();
+
+  void on(const String& uri, THandlerFunction handler) { on(uri, HTTP_ANY, handler); }
+  void on(const String& uri, HTTPMethod method, THandlerFunction handler);
+  void onNotFound(THandlerFunction handler) { _notFound = handler; }
+
+  String uri() const { return _uri; }
+  HTTPMethod method() const { return _method; }
+
+  int args() const { return (int)_args.size(); }
+  String arg(int index) const;
+  String argName(int index) const;
+  String arg(const String& name) const;
+  bool hasArg(const String& name) const;
+  String header(const String& name) const;
+  String hostHeader() const { return header("Host"); }
+  void collectHeaders(const char* headerKeys[], size_t headerKeysCount) {  // all headers are kept
+    (void)headerKeys; (void)headerKeysCount;
+  }
+
+  void sendHeader(const String& name, const String& value, bool first = false);
+  void send(int code, const char* contentType = nullptr, const String& content = String());
+  void send(int code, const String& contentType, const String& content) {
+    send(code, contentType.c_str(), content);
+  }
+  void send_P(int code, PGM_P contentType, PGM_P content, size_t contentLength);
+
+  // Streamed body: setContentLength(CONTENT_LENGTH_UNKNOWN), send() with an
+  // empty body, then sendContent() chunks and an empty one to finish
+  void setContentLength(size_t contentLength) { _contentLength = contentLength; }
+  void sendContent(const char* content, size_t contentLength);
+  void sendContent(const String& content) { sendContent(content.c_str(), content.length()); }
+
+private:
+  struct Route {
+    String uri;
+    HTTPMethod method;
+    THandlerFunction handler;
+  };
+
+  int _port;
+  int _listenFD = -1;
+  int _clientFD = -1;
+  std::vector<Route> _routes;
+  THandlerFunction _notFound;
+
+  // Current request
+  HTTPMethod _method = HTTP_ANY;
+  String _uri;
+  std::vector<std::pair<String, String>> _args;
+  std::vector<std::pair<String, String>> _requestHeaders;
+  std::vector<std::pair<String, String>> _responseHeaders;
+  bool _responded = false;
+  size_t _contentLength = 0;        // CONTENT_LENGTH_UNKNOWN: chunked
+  bool _chunked = false;            // a chunked body is open
+
+  bool readRequest();
+  void parseArgs(const std::string& encoded);
+  void sendResponse(int code, const char* contentType, const char* content, size_t contentLength);
+  void writeAll(const std::string& data);
+};
+
+#endif // WEB_SERVER_H
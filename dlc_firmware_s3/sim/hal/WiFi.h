@@ -0,0 +1,48 @@
+/*
+  WiFi.h - Host HAL: WiFi station/AP for the Linux simulator
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  The simulated radio joins any network instantly and uses the host's
+  loopback address, so the Alpaca and Web UI servers listen on localhost.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef WIFI_H
+#define WIFI_H
+
+#include <Arduino.h>
+#include <IPAddress.h>
+
+typedef enum { WIFI_OFF, WIFI_STA, WIFI_AP, WIFI_AP_STA } wifi_mode_t;
+
+typedef enum {
+  WL_IDLE_STATUS    = 0,
+  WL_NO_SSID_AVAIL  = 1,
+  WL_CONNECTED      = 3,
+  WL_CONNECT_FAILED = 4,
+  WL_DISCONNECTED   = 6
+} wl_status_t;
+
+class WiFiClass {
+public:
+  bool mode(wifi_mode_t mode) { _mode = mode; return true; }
+  bool enableIPv6(bool enable = true) { (void)enable; return true; }
+  wl_status_t begin(const char* ssid, const char* pass);
+  wl_status_t status() const { return _status; }
+  bool softAP(const char* ssid, const char* pass);
+
+  IPAddress localIP() const { return IPAddress(127, 0, 0, 1); }
+  IPAddress softAPIP() const { return IPAddress(127, 0, 0, 1); }
+  uint8_t* macAddress(uint8_t* mac) const;
+  String macAddress() const;
+
+private:
+  wifi_mode_t _mode = WIFI_OFF;
+  wl_status_t _status = WL_DISCONNECTED;
+};
+
+extern WiFiClass WiFi;
+
+#endif // WIFI_H
@@ -0,0 +1,47 @@
+/*
+  WiFiUdp.h - Host HAL: UDP socket for the Linux simulator
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef WIFI_UDP_H
+#define WIFI_UDP_H
+
+#include <Arduino.h>
+#include <IPAddress.h>
+
+class WiFiUDP {
+public:
+  ~WiFiUDP() { stop(); }
+
+  uint8_t begin(uint16_t port);
+  void stop();
+
+  int parsePacket();
+  int available() const { return (int)(_rxLength - _rxPos); }
+  int read(uint8_t* buffer, size_t length);
+  int read(char* buffer, size_t length) { return read((uint8_t*)buffer, length); }
+  IPAddress remoteIP() const { return _remoteIP; }
+  uint16_t remotePort() const { return _remotePort; }
+
+  int beginPacket(IPAddress ip, uint16_t port);
+  size_t write(const uint8_t* buffer, size_t size);
+  size_t print(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+  size_t print(const String& s) { return print(s.c_str()); }
+  int endPacket();
+
+private:
+  int _fd = -1;
+  uint8_t _rx[1472];
+  size_t _rxLength = 0;
+  size_t _rxPos = 0;
+  IPAddress _remoteIP;
+  uint16_t _remotePort = 0;
+  IPAddress _txIP;
+  uint16_t _txPort = 0;
+  std::string _tx;
+};
+
+#endif // WIFI_UDP_H
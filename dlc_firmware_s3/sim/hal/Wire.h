@@ -0,0 +1,30 @@
+/*
+  Wire.h - Host HAL: I2C bus for the Linux simulator
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef WIRE_H
+#define WIRE_H
+
+#include <Arduino.h>
+
+class TwoWire {
+public:
+  bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0) {
+    (void)sda; (void)scl;
+    _frequency = frequency ? frequency : 100000;
+    return true;
+  }
+
+  uint32_t getClock() const { return _frequency; }
+
+private:
+  uint32_t _frequency = 100000;
+};
+
+extern TwoWire Wire;
+
+#endif // WIRE_H
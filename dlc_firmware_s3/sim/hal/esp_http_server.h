@@ -0,0 +1,151 @@
+/*
+  esp_http_server.h - Host HAL: ESP-IDF HTTP server for the Linux simulator
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Mirrors the esp_http_server contract: one server thread multiplexes up to
+  max_open_sockets persistent (keep-alive) connections with poll() and runs
+  the URI handlers one request at a time, as the httpd task does on the
+  ESP32. Task priority and core are accepted and ignored. Listening ports
+  are shifted by the simulator's --port-offset. Async requests (IDF 5.1+)
+  leave the poll set and may be answered from any thread; completing one
+  closes its socket instead of handing it back to the server.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef ESP_HTTP_SERVER_H
+#define ESP_HTTP_SERVER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <esp_err.h>
+#include <http_parser.h>
+#include "freertos/FreeRTOS.h"
+
+#define ESP_ERR_HTTPD_BASE          0xb000
+#define ESP_ERR_HTTPD_HANDLERS_FULL (ESP_ERR_HTTPD_BASE + 1)
+#define ESP_ERR_HTTPD_HANDLER_EXISTS (ESP_ERR_HTTPD_BASE + 2)
+#define ESP_ERR_HTTPD_INVALID_REQ   (ESP_ERR_HTTPD_BASE + 3)
+#define ESP_ERR_HTTPD_RESULT_TRUNC  (ESP_ERR_HTTPD_BASE + 4)
+#define ESP_ERR_HTTPD_RESP_SEND     (ESP_ERR_HTTPD_BASE + 6)
+#define ESP_ERR_HTTPD_TASK          (ESP_ERR_HTTPD_BASE + 8)
+
+#define HTTPD_MAX_URI_LEN     512
+#define HTTPD_RESP_USE_STRLEN -1
+#define HTTPD_SOCK_ERR_FAIL    -1
+#define HTTPD_SOCK_ERR_TIMEOUT -3
+
+#define HTTPD_200 "200 OK"
+#define HTTPD_204 "204 No Content"
+#define HTTPD_400 "400 Bad Request"
+#define HTTPD_404 "404 Not Found"
+#define HTTPD_500 "500 Internal Server Error"
+#define HTTPD_503 "503 Service Unavailable"
+
+#define HTTPD_TYPE_JSON "application/json"
+#define HTTPD_TYPE_TEXT "text/html"
+
+typedef void* httpd_handle_t;
+typedef enum http_method httpd_method_t;
+
+typedef enum {
+  HTTPD_500_INTERNAL_SERVER_ERROR = 0,
+  HTTPD_501_METHOD_NOT_IMPLEMENTED,
+  HTTPD_505_VERSION_NOT_SUPPORTED,
+  HTTPD_400_BAD_REQUEST,
+  HTTPD_401_UNAUTHORIZED,
+  HTTPD_403_FORBIDDEN,
+  HTTPD_404_NOT_FOUND,
+  HTTPD_405_METHOD_NOT_ALLOWED,
+  HTTPD_408_REQ_TIMEOUT,
+  HTTPD_411_LENGTH_REQUIRED,
+  HTTPD_414_URI_TOO_LONG,
+  HTTPD_431_REQ_HDR_FIELDS_TOO_LARGE,
+  HTTPD_ERR_CODE_MAX
+} httpd_err_code_t;
+
+typedef struct httpd_req {
+  httpd_handle_t handle;
+  int method;
+  char uri[HTTPD_MAX_URI_LEN + 1];  // path and query, as received
+  size_t content_len;
+  void* aux;                        // server-private request state
+  void* user_ctx;                   // from the matched httpd_uri_t
+  void* sess_ctx;
+} httpd_req_t;
+
+typedef struct httpd_uri {
+  const char* uri;
+  httpd_method_t method;
+  esp_err_t (*handler)(httpd_req_t* r);
+  void* user_ctx;
+} httpd_uri_t;
+
+typedef bool (*httpd_uri_match_func_t)(const char* reference_uri, const char* uri_to_match, size_t match_upto);
+
+typedef struct httpd_config {
+  unsigned task_priority;
+  size_t stack_size;
+  BaseType_t core_id;
+  uint16_t server_port;
+  uint16_t ctrl_port;
+  uint16_t max_open_sockets;
+  uint16_t max_uri_handlers;
+  uint16_t max_resp_headers;
+  uint16_t backlog_conn;
+  bool lru_purge_enable;
+  uint16_t recv_wait_timeout;   // seconds
+  uint16_t send_wait_timeout;   // seconds
+  httpd_uri_match_func_t uri_match_fn;
+} httpd_config_t;
+
+#define HTTPD_DEFAULT_CONFIG() {  \
+  .task_priority = 5,             \
+  .stack_size = 4096,             \
+  .core_id = tskNO_AFFINITY,      \
+  .server_port = 80,              \
+  .ctrl_port = 32768,             \
+  .max_open_sockets = 7,          \
+  .max_uri_handlers = 8,          \
+  .max_resp_headers = 8,          \
+  .backlog_conn = 5,              \
+  .lru_purge_enable = false,      \
+  .recv_wait_timeout = 5,         \
+  .send_wait_timeout = 5,         \
+  .uri_match_fn = nullptr         \
+}
+
+esp_err_t httpd_start(httpd_handle_t* handle, const httpd_config_t* config);
+esp_err_t httpd_stop(httpd_handle_t handle);
+esp_err_t httpd_register_uri_handler(httpd_handle_t handle, const httpd_uri_t* uri_handler);
+bool httpd_uri_match_wildcard(const char* uri_template, const char* uri_to_match, size_t match_upto);
+
+size_t httpd_req_get_url_query_len(httpd_req_t* r);
+esp_err_t httpd_req_get_url_query_str(httpd_req_t* r, char* buf, size_t buf_len);
+esp_err_t httpd_query_key_value(const char* qry, const char* key, char* val, size_t val_size);
+size_t httpd_req_get_hdr_value_len(httpd_req_t* r, const char* field);
+esp_err_t httpd_req_get_hdr_value_str(httpd_req_t* r, const char* field, char* val, size_t val_size);
+int httpd_req_recv(httpd_req_t* r, char* buf, size_t buf_len);
+int httpd_req_to_sockfd(httpd_req_t* r);
+
+esp_err_t httpd_resp_set_status(httpd_req_t* r, const char* status);
+esp_err_t httpd_resp_set_type(httpd_req_t* r, const char* type);
+esp_err_t httpd_resp_set_hdr(httpd_req_t* r, const char* field, const char* value);
+esp_err_t httpd_resp_send(httpd_req_t* r, const char* buf, ssize_t buf_len);
+esp_err_t httpd_resp_send_chunk(httpd_req_t* r, const char* buf, ssize_t buf_len);
+esp_err_t httpd_resp_send_err(httpd_req_t* r, httpd_err_code_t error, const char* msg);
+
+esp_err_t httpd_req_async_handler_begin(httpd_req_t* r, httpd_req_t** out);
+esp_err_t httpd_req_async_handler_complete(httpd_req_t* r);
+
+inline esp_err_t httpd_resp_sendstr(httpd_req_t* r, const char* str) {
+  return httpd_resp_send(r, str, HTTPD_RESP_USE_STRLEN);
+}
+
+inline esp_err_t httpd_resp_send_404(httpd_req_t* r) {
+  return httpd_resp_send_err(r, HTTPD_404_NOT_FOUND, nullptr);
+}
+
+#endif // ESP_HTTP_SERVER_H
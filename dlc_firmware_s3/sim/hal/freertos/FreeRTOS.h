@@ -0,0 +1,32 @@
+/*
+  FreeRTOS.h - Host HAL: FreeRTOS types for the Linux simulator
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Tasks are std::threads and ticks are virtual milliseconds (see
+  sim_rtos.cpp). Priorities and core affinity are accepted and ignored.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef FREERTOS_H
+#define FREERTOS_H
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define pdTRUE  1
+#define pdFALSE 0
+#define pdPASS  pdTRUE
+#define pdFAIL  pdFALSE
+
+#define portMAX_DELAY        ((TickType_t)0xFFFFFFFF)
+#define portTICK_PERIOD_MS   1
+#define pdMS_TO_TICKS(ms)    ((TickType_t)(ms))
+#define configMAX_PRIORITIES 25
+#define tskNO_AFFINITY       0x7FFFFFFF
+
+#endif // FREERTOS_H
@@ -0,0 +1,27 @@
+/*
+  http_parser.h - Host HAL: HTTP method enum for the Linux simulator
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Same values as the http_parser bundled with ESP-IDF, which both the
+  Arduino WebServer (HTTPMethod) and esp_http_server (httpd_method_t) use.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef HTTP_PARSER_H
+#define HTTP_PARSER_H
+
+enum http_method {
+  HTTP_DELETE  = 0,
+  HTTP_GET     = 1,
+  HTTP_HEAD    = 2,
+  HTTP_POST    = 3,
+  HTTP_PUT     = 4,
+  HTTP_CONNECT = 5,
+  HTTP_OPTIONS = 6,
+  HTTP_TRACE   = 7,
+  HTTP_PATCH   = 28
+};
+
+#endif // HTTP_PARSER_H
@@ -0,0 +1,27 @@
+/*
+  lwip/sockets.h - Host HAL: lwIP BSD sockets for the Linux simulator
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  The host's sockets stand in for lwIP's, which share the BSD API. bind()
+  goes through simBind() so that, as for every other listening socket in
+  the simulator, the port is shifted by --port-offset.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef LWIP_SOCKETS_H
+#define LWIP_SOCKETS_H
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+int simBind(int fd, const struct sockaddr* addr, socklen_t length);
+
+#define bind simBind
+
+#endif // LWIP_SOCKETS_H
@@ -0,0 +1,16 @@
+/*
+  sdkconfig.h - Host HAL: ESP-IDF build configuration for the Linux simulator
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Only the options the firmware reads, at the Arduino core's values.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef SDKCONFIG_H
+#define SDKCONFIG_H
+
+#define CONFIG_LWIP_MAX_SOCKETS 16
+
+#endif // SDKCONFIG_H
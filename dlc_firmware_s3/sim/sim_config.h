@@ -0,0 +1,57 @@
+/*
+  sim_config.h - Feature set for the Linux simulator build
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Included by config.h when DLC_SIMULATOR is defined. Replaces the (UA)
+  install options with the SIM_* flags chosen by the DLC_SIM_* CMake
+  options, so config.h never needs editing to simulate a given build.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef SIM_CONFIG_H
+#define SIM_CONFIG_H
+
+#undef COVER_INSTALLED
+#undef LIGHT_INSTALLED
+#undef HEATER_INSTALLED
+#undef ENABLE_WIFI
+#undef ENABLE_PERF_MONITOR
+#undef ENABLE_TELEMETRY_HISTORY
+#undef ENABLE_FIXED_DEW_POINT
+#undef SECOND_DEVICE_INSTALLED
+
+#ifdef SIM_COVER
+  #define COVER_INSTALLED
+#endif
+
+#ifdef SIM_LIGHT
+  #define LIGHT_INSTALLED
+#endif
+
+#ifdef SIM_HEATER
+  #define HEATER_INSTALLED
+#endif
+
+#ifdef SIM_WIFI
+  #define ENABLE_WIFI
+#endif
+
+#ifdef SIM_PERF
+  #define ENABLE_PERF_MONITOR
+#endif
+
+#ifdef SIM_HISTORY
+  #define ENABLE_TELEMETRY_HISTORY
+#endif
+
+#ifdef SIM_FIXED_DEW_POINT
+  #define ENABLE_FIXED_DEW_POINT
+#endif
+
+#ifdef SIM_SECOND_DEVICE
+  #define SECOND_DEVICE_INSTALLED
+#endif
+
+#endif // SIM_CONFIG_H
@@ -0,0 +1,604 @@
+/*
+  sim_hal.cpp - Linux simulator runtime and Arduino core HAL
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Implements the hal/ headers that do not need the network: virtual clock,
+  pins, String, Serial over a pseudo-terminal, Preferences, Servo and ESP.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#include "sim_hal.h"
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <ESP32Servo.h>
+#include <Wire.h>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <strings.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+
+HardwareSerial Serial(0);
+HardwareSerial Serial0(1);
+EspClass ESP;
+TwoWire Wire;
+
+// ============================================================
+// Runtime state
+// ============================================================
+
+namespace {
+
+SimHal::Options g_options;
+char** g_argv = nullptr;
+std::chrono::steady_clock::time_point g_start;
+volatile sig_atomic_t g_running = 0;
+
+int g_masterFD = -1;
+int g_slaveFD = -1;
+const int SERIAL_TX_BUFFER = 4096;
+std::string g_slavePath;
+
+std::string g_rx;
+size_t g_rxPos = 0;
+
+std::atomic<float> g_pins[256];  // written by loop() and the servo task
+uint8_t g_pwmBits = 8;
+
+void onSignal(int) {
+  g_running = 0;
+}
+
+bool openPty() {
+  g_masterFD = posix_openpt(O_RDWR | O_NOCTTY);
+  if (g_masterFD < 0 || grantpt(g_masterFD) != 0 || unlockpt(g_masterFD) != 0) {
+    perror("[SIM] posix_openpt");
+    return false;
+  }
+  g_slavePath = ptsname(g_masterFD);
+
+  // Hold the slave open so the master never sees a hangup between client
+  // connections, and make it raw so our own output is never echoed back
+  // into the command parser.
+  g_slaveFD = open(g_slavePath.c_str(), O_RDWR | O_NOCTTY);
+  if (g_slaveFD < 0) {
+    perror("[SIM] open pty slave");
+    return false;
+  }
+  struct termios tio;
+  tcgetattr(g_slaveFD, &tio);
+  cfmakeraw(&tio);
+  tcsetattr(g_slaveFD, TCSANOW, &tio);
+
+  fcntl(g_masterFD, F_SETFL, fcntl(g_masterFD, F_GETFL) | O_NONBLOCK);
+  fcntl(g_masterFD, F_SETFD, FD_CLOEXEC);
+  fcntl(g_slaveFD, F_SETFD, FD_CLOEXEC);
+
+  if (!g_options.ttyLink.empty()) {
+    unlink(g_options.ttyLink.c_str());
+    if (symlink(g_slavePath.c_str(), g_options.ttyLink.c_str()) != 0) {
+      perror("[SIM] symlink");
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+// ============================================================
+// Runtime control
+// ============================================================
+
+namespace SimHal {
+
+bool begin(const Options& options, char** argv) {
+  g_options = options;
+  g_argv = argv;
+  if (g_options.speed <= 0.0) g_options.speed = 1.0;
+  g_start = std::chrono::steady_clock::now();
+
+  signal(SIGINT, onSignal);
+  signal(SIGTERM, onSignal);
+  signal(SIGPIPE, SIG_IGN);
+
+  if (!openPty()) return false;
+
+  fprintf(stderr, "[SIM] Serial port: %s%s%s\n", g_slavePath.c_str(),
+          g_options.ttyLink.empty() ? "" : " -> ", g_options.ttyLink.c_str());
+  fprintf(stderr, "[SIM] Speed: %.2fx real time\n", g_options.speed);
+  g_running = 1;
+  return true;
+}
+
+void end() {
+  if (!g_options.ttyLink.empty()) unlink(g_options.ttyLink.c_str());
+  if (g_slaveFD >= 0) close(g_slaveFD);
+  if (g_masterFD >= 0) close(g_masterFD);
+  g_slaveFD = g_masterFD = -1;
+}
+
+const Options& options() {
+  return g_options;
+}
+
+bool running() {
+  return g_running != 0;
+}
+
+void stop() {
+  g_running = 0;
+}
+
+void idle() {
+  if (g_options.idleMicros > 0) {
+    std::this_thread::sleep_for(std::chrono::microseconds(g_options.idleMicros));
+  }
+}
+
+const char* serialPath() {
+  return g_slavePath.c_str();
+}
+
+float pinValue(uint8_t pin) {
+  return g_pins[pin];
+}
+
+void setPinValue(uint8_t pin, float value) {
+  g_pins[pin] = value;
+}
+
+uint64_t clockMicros() {
+  auto real = std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - g_start).count();
+  return (uint64_t)((double)real * g_options.speed);
+}
+
+} // namespace SimHal
+
+// ============================================================
+// Time and pin I/O
+// ============================================================
+
+uint32_t millis() {
+  return (uint32_t)(SimHal::clockMicros() / 1000);
+}
+
+uint32_t micros() {
+  return (uint32_t)SimHal::clockMicros();
+}
+
+void delay(uint32_t ms) {
+  delayMicroseconds(ms * 1000);
+}
+
+void delayMicroseconds(uint32_t us) {
+  std::this_thread::sleep_for(std::chrono::microseconds((uint64_t)(us / g_options.speed)));
+}
+
+void yield() {
+  std::this_thread::yield();
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  // Inputs float high through the pull-up (button released)
+  if (mode == INPUT_PULLUP) g_pins[pin] = HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  g_pins[pin] = value ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin) {
+  return g_pins[pin] != 0.0f ? HIGH : LOW;
+}
+
+void analogWrite(uint8_t pin, int value) {
+  g_pins[pin] = (float)value / (float)((1u << g_pwmBits) - 1);
+}
+
+void analogWriteResolution(uint8_t bits) {
+  g_pwmBits = bits;
+}
+
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  // Matches the ESP32 core, including its guard against an empty input range
+  const long run = inMax - inMin;
+  if (run == 0) return -1;
+  return ((x - inMin) * (outMax - outMin)) / run + outMin;
+}
+
+char* itoa(int value, char* str, int base) {
+  if (base == 10) {
+    sprintf(str, "%d", value);
+    return str;
+  }
+  char tmp[33];
+  unsigned int v = (unsigned int)value;
+  int i = 0;
+  do {
+    int digit = v % base;
+    tmp[i++] = (char)(digit < 10 ? '0' + digit : 'a' + digit - 10);
+    v /= base;
+  } while (v && i < 32);
+  for (int j = 0; j < i; j++) str[j] = tmp[i - 1 - j];
+  str[i] = '\0';
+  return str;
+}
+
+char* dtostrf(double value, signed char width, unsigned char precision, char* str) {
+  sprintf(str, "%*.*f", width, precision, value);
+  return str;
+}
+
+// ============================================================
+// String
+// ============================================================
+
+static std::string numberToString(unsigned long value, bool negative, unsigned char base) {
+  char buf[70];
+  int i = 0;
+  do {
+    int digit = value % base;
+    buf[i++] = (char)(digit < 10 ? '0' + digit : 'a' + digit - 10);
+    value /= base;
+  } while (value);
+  if (negative) buf[i++] = '-';
+  std::string reversed(buf, i);
+  return std::string(reversed.rbegin(), reversed.rend());
+}
+
+String::String(int value, unsigned char base) : String((long)value, base) {}
+String::String(unsigned int value, unsigned char base) : String((unsigned long)value, base) {}
+
+String::String(long value, unsigned char base) {
+  if (base == 10 && value < 0) {
+    _s = numberToString(0UL - (unsigned long)value, true, base);
+  } else {
+    _s = numberToString((unsigned long)value, false, base);
+  }
+}
+
+String::String(unsigned long value, unsigned char base) : _s(numberToString(value, false, base)) {}
+
+String::String(float value, unsigned char decimals) : String((double)value, decimals) {}
+
+String::String(double value, unsigned char decimals) {
+  char buf[40];
+  _s = dtostrf(value, 0, decimals, buf);
+}
+
+bool String::equalsIgnoreCase(const String& rhs) const {
+  return strcasecmp(_s.c_str(), rhs._s.c_str()) == 0;
+}
+
+bool String::endsWith(const String& suffix) const {
+  return _s.length() >= suffix._s.length() &&
+         _s.compare(_s.length() - suffix._s.length(), suffix._s.length(), suffix._s) == 0;
+}
+
+int String::indexOf(char c, unsigned int from) const {
+  size_t pos = _s.find(c, from);
+  return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::indexOf(const String& s, unsigned int from) const {
+  size_t pos = _s.find(s._s, from);
+  return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::lastIndexOf(char c) const {
+  size_t pos = _s.rfind(c);
+  return pos == std::string::npos ? -1 : (int)pos;
+}
+
+String String::substring(unsigned int from) const {
+  return from < _s.length() ? String(_s.substr(from)) : String();
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+  if (from > to) std::swap(from, to);
+  if (from >= _s.length()) return String();
+  return String(_s.substr(from, to - from));
+}
+
+void String::replace(const String& find, const String& replacement) {
+  if (find._s.empty()) return;
+  size_t pos = 0;
+  while ((pos = _s.find(find._s, pos)) != std::string::npos) {
+    _s.replace(pos, find._s.length(), replacement._s);
+    pos += replacement._s.length();
+  }
+}
+
+void String::toLowerCase() {
+  for (char& c : _s) c = (char)tolower((unsigned char)c);
+}
+
+void String::toUpperCase() {
+  for (char& c : _s) c = (char)toupper((unsigned char)c);
+}
+
+void String::trim() {
+  size_t first = _s.find_first_not_of(" \t\r\n");
+  size_t last = _s.find_last_not_of(" \t\r\n");
+  _s = (first == std::string::npos) ? std::string() : _s.substr(first, last - first + 1);
+}
+
+String operator+(const String& lhs, const String& rhs) {
+  String result(lhs);
+  result += rhs;
+  return result;
+}
+
+String operator+(const String& lhs, const char* rhs) {
+  String result(lhs);
+  result += rhs;
+  return result;
+}
+
+String operator+(const char* lhs, const String& rhs) {
+  String result(lhs);
+  result += rhs;
+  return result;
+}
+
+// ============================================================
+// Serial
+// ============================================================
+
+int HardwareSerial::available() {
+  if (_port != 0) return 0;
+  if (g_rxPos >= g_rx.size() && g_masterFD >= 0) {
+    char buf[256];
+    ssize_t n = ::read(g_masterFD, buf, sizeof(buf));
+    if (n > 0) {
+      g_rx.assign(buf, (size_t)n);
+      g_rxPos = 0;
+    }
+  }
+  return (int)(g_rx.size() - g_rxPos);
+}
+
+int HardwareSerial::read() {
+  if (available() <= 0) return -1;
+  return (uint8_t)g_rx[g_rxPos++];
+}
+
+int HardwareSerial::peek() {
+  if (available() <= 0) return -1;
+  return (uint8_t)g_rx[g_rxPos];
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+  if (_port != 0) {
+    fwrite(buffer, 1, size, stderr);
+    return size;
+  }
+
+  if (g_options.echo) fwrite(buffer, 1, size, stdout);
+
+  // Nobody reading the pty: drop rather than stall the loop, like USB CDC
+  // with no host attached.
+  size_t sent = 0;
+  while (g_masterFD >= 0 && sent < size) {
+    ssize_t n = ::write(g_masterFD, buffer + sent, size - sent);
+    if (n <= 0) break;
+    sent += (size_t)n;
+  }
+  return size;
+}
+
+// Room left in the pty, standing in for the USB CDC transmit buffer
+int HardwareSerial::availableForWrite() {
+  if (_port != 0) return SERIAL_TX_BUFFER;
+  int pending = 0;
+  if (g_slaveFD < 0 || ioctl(g_slaveFD, FIONREAD, &pending) != 0) return 0;
+  return pending < SERIAL_TX_BUFFER ? SERIAL_TX_BUFFER - pending : 0;
+}
+
+size_t HardwareSerial::printf(const char* fmt, ...) {
+  char buf[512];
+  va_list args;
+  va_start(args, fmt);
+  int len = vsnprintf(buf, sizeof(buf), fmt, args);
+  va_end(args);
+  if (len < 0) return 0;
+  return write((const uint8_t*)buf, (size_t)len < sizeof(buf) ? (size_t)len : sizeof(buf) - 1);
+}
+
+// ============================================================
+// ESP
+// ============================================================
+
+void EspClass::restart() {
+  // Re-exec the simulator: the pty disappears and comes back like a
+  // USB re-enumeration, and Preferences reload from --nvs.
+  fprintf(stderr, "[SIM] Restart requested\n");
+  fflush(stdout);
+  SimHal::end();
+  execv("/proc/self/exe", g_argv);
+  perror("[SIM] execv");
+  exit(1);
+}
+
+// ============================================================
+// Servo
+// ============================================================
+
+int Servo::attach(int pin, int minPulse, int maxPulse) {
+  _pin = pin;
+  _minPulse = minPulse;
+  _maxPulse = maxPulse;
+  return pin;
+}
+
+void Servo::detach() {
+  _pin = -1;
+}
+
+void Servo::writeMicroseconds(int value) {
+  if (_pin < 0) return;
+  _pulse = constrain(value, _minPulse, _maxPulse);
+  SimHal::setPinValue((uint8_t)_pin, (float)_pulse);
+}
+
+// ============================================================
+// Preferences
+// ============================================================
+
+static std::string escapeValue(const std::string& value) {
+  std::string out;
+  for (char c : value) {
+    if (c == '\\') out += "\\\\";
+    else if (c == '\n') out += "\\n";
+    else out += c;
+  }
+  return out;
+}
+
+static std::string unescapeValue(const std::string& value) {
+  std::string out;
+  for (size_t i = 0; i < value.size(); i++) {
+    if (value[i] == '\\' && i + 1 < value.size()) {
+      out += (value[++i] == 'n') ? '\n' : value[i];
+    } else {
+      out += value[i];
+    }
+  }
+  return out;
+}
+
+bool Preferences::begin(const char* name, bool readOnly) {
+  _name = name;
+  _readOnly = readOnly;
+  _open = true;
+  load();
+  return true;
+}
+
+void Preferences::end() {
+  _open = false;
+}
+
+bool Preferences::clear() {
+  if (!_open || _readOnly) return false;
+  _values.clear();
+  save();
+  return true;
+}
+
+bool Preferences::remove(const char* key) {
+  if (!_open || _readOnly) return false;
+  bool removed = _values.erase(key) > 0;
+  save();
+  return removed;
+}
+
+bool Preferences::isKey(const char* key) {
+  return _values.count(key) > 0;
+}
+
+bool Preferences::lookup(const char* key, std::string& value) {
+  auto it = _values.find(key);
+  if (!_open || it == _values.end()) return false;
+  value = it->second;
+  return true;
+}
+
+size_t Preferences::store(const char* key, const std::string& value, size_t size) {
+  if (!_open || _readOnly) return 0;
+  _values[key] = value;
+  save();
+  return size;
+}
+
+void Preferences::load() {
+  _values.clear();
+  const std::string& dir = SimHal::options().nvsDir;
+  if (dir.empty()) return;
+
+  std::ifstream in(dir + "/" + _name + ".nvs");
+  std::string line;
+  while (std::getline(in, line)) {
+    size_t eq = line.find('=');
+    if (eq == std::string::npos) continue;
+    _values[line.substr(0, eq)] = unescapeValue(line.substr(eq + 1));
+  }
+}
+
+void Preferences::save() {
+  const std::string& dir = SimHal::options().nvsDir;
+  if (dir.empty()) return;
+
+  std::ofstream out(dir + "/" + _name + ".nvs", std::ios::trunc);
+  for (const auto& kv : _values) {
+    out << kv.first << '=' << escapeValue(kv.second) << '\n';
+  }
+}
+
+uint8_t Preferences::getUChar(const char* key, uint8_t defaultValue) {
+  std::string v;
+  return lookup(key, v) ? (uint8_t)strtoul(v.c_str(), nullptr, 10) : defaultValue;
+}
+
+uint16_t Preferences::getUShort(const char* key, uint16_t defaultValue) {
+  std::string v;
+  return lookup(key, v) ? (uint16_t)strtoul(v.c_str(), nullptr, 10) : defaultValue;
+}
+
+uint32_t Preferences::getULong(const char* key, uint32_t defaultValue) {
+  std::string v;
+  return lookup(key, v) ? (uint32_t)strtoul(v.c_str(), nullptr, 10) : defaultValue;
+}
+
+float Preferences::getFloat(const char* key, float defaultValue) {
+  std::string v;
+  return lookup(key, v) ? strtof(v.c_str(), nullptr) : defaultValue;
+}
+
+bool Preferences::getBool(const char* key, bool defaultValue) {
+  std::string v;
+  return lookup(key, v) ? v == "1" : defaultValue;
+}
+
+String Preferences::getString(const char* key, const String& defaultValue) {
+  std::string v;
+  return lookup(key, v) ? String(v) : defaultValue;
+}
+
+size_t Preferences::putUChar(const char* key, uint8_t value) {
+  return store(key, std::to_string(value), sizeof(value));
+}
+
+size_t Preferences::putUShort(const char* key, uint16_t value) {
+  return store(key, std::to_string(value), sizeof(value));
+}
+
+size_t Preferences::putULong(const char* key, uint32_t value) {
+  return store(key, std::to_string(value), sizeof(value));
+}
+
+size_t Preferences::putFloat(const char* key, float value) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%.9g", value);
+  return store(key, buf, sizeof(value));
+}
+
+size_t Preferences::putBool(const char* key, bool value) {
+  return store(key, value ? "1" : "0", sizeof(value));
+}
+
+size_t Preferences::putString(const char* key, const String& value) {
+  return store(key, value.str(), value.length());
+}
@@ -0,0 +1,51 @@
+/*
+  sim_hal.h - Linux simulator runtime: options, virtual clock, serial pty
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Backs the Arduino API in hal/. Time runs at --speed times real time, so a
+  5 s cover move takes 0.5 s at --speed 10. Serial is a pseudo-terminal the
+  INDI driver (or any terminal program) opens like the real USB CDC port.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef SIM_HAL_H
+#define SIM_HAL_H
+
+#include <stdint.h>
+#include <string>
+
+namespace SimHal {
+
+struct Options {
+  double speed = 1.0;          // virtual time multiplier
+  uint32_t idleMicros = 200;   // real-time sleep between loop() passes
+  std::string ttyLink;         // optional symlink to the pty slave
+  std::string nvsDir;          // persist Preferences here (empty = in memory)
+  int portOffset = 0;          // added to every TCP/UDP listen port
+  bool echo = false;           // copy serial output to stdout
+};
+
+bool begin(const Options& options, char** argv);
+void end();
+const Options& options();
+
+// Main loop control
+bool running();
+void stop();
+void idle();
+
+// Serial pty
+const char* serialPath();
+
+// Last value driven on a pin: digital level, PWM duty (0.0-1.0) or servo pulse (us)
+float pinValue(uint8_t pin);
+void setPinValue(uint8_t pin, float value);
+
+// Virtual clock in microseconds since begin()
+uint64_t clockMicros();
+
+} // namespace SimHal
+
+#endif // SIM_HAL_H
@@ -0,0 +1,527 @@
+/*
+  sim_httpd.cpp - Linux simulator: esp_http_server on a poll() thread
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Built only with DLC_SIM_WIFI. One thread per server accepts up to
+  max_open_sockets connections, keeps them open between requests (HTTP/1.1
+  keep-alive, pipelining included) and dispatches complete requests to the
+  registered URI handlers in arrival order. With lru_purge_enable a new
+  connection closes the least recently used one when all slots are taken.
+  A handler that calls httpd_req_async_handler_begin() takes the socket out
+  of the poll set; it still counts as open until the request is completed,
+  and like ESP-IDF's for_async_req sessions it is never LRU purged.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#include <Arduino.h>
+#include <esp_http_server.h>
+#include "sim_hal.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+static const int HTTPD_POLL_MS = 50;            // real time between stop checks
+static const size_t HTTPD_MAX_REQUEST = 16384;  // header block plus body
+
+struct SimHttpdConn {
+  int fd;
+  std::string input;
+  uint64_t lastUsed;
+  bool detached = false;  // handed to an async request, not closed here
+};
+
+// Per-request state behind httpd_req_t::aux
+struct SimHttpdRequest {
+  int fd;
+  std::vector<std::pair<std::string, std::string>> headers;
+  std::string body;
+  size_t bodyRead = 0;
+  std::string status = HTTPD_200;
+  std::string type = HTTPD_TYPE_TEXT;
+  std::vector<std::pair<std::string, std::string>> responseHeaders;
+  bool sent = false;
+  bool chunked = false;
+  bool async = false;
+  bool failed = false;
+};
+
+struct SimHttpd {
+  httpd_config_t config;
+  int listenFD = -1;
+  std::vector<httpd_uri_t> handlers;
+  std::vector<SimHttpdConn> conns;
+  std::thread thread;
+  std::atomic<bool> stopping{false};
+  std::atomic<uint16_t> asyncOpen{0};  // detached sockets of async requests
+  uint64_t useCounter = 0;
+};
+
+static httpd_method_t parseMethod(const std::string& method) {
+  if (method == "GET")     return HTTP_GET;
+  if (method == "HEAD")    return HTTP_HEAD;
+  if (method == "POST")    return HTTP_POST;
+  if (method == "PUT")     return HTTP_PUT;
+  if (method == "PATCH")   return HTTP_PATCH;
+  if (method == "DELETE")  return HTTP_DELETE;
+  if (method == "OPTIONS") return HTTP_OPTIONS;
+  return (httpd_method_t)-1;
+}
+
+static bool writeAll(int fd, const std::string& data) {
+  size_t sent = 0;
+  while (sent < data.size()) {
+    ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+    if (n <= 0) return false;
+    sent += (size_t)n;
+  }
+  return true;
+}
+
+static size_t openSockets(SimHttpd* server) {
+  return server->conns.size() + server->asyncOpen;
+}
+
+static void closeConn(SimHttpd* server, size_t index) {
+  if (!server->conns[index].detached) ::close(server->conns[index].fd);
+  server->conns.erase(server->conns.begin() + index);
+}
+
+// ============================================================
+// Request dispatch
+// ============================================================
+
+static const httpd_uri_t* findHandler(SimHttpd* server, const char* uri, httpd_method_t method, bool& uriMatched) {
+  size_t pathLen = strcspn(uri, "?");
+  uriMatched = false;
+
+  for (const httpd_uri_t& handler : server->handlers) {
+    bool match = server->config.uri_match_fn
+      ? server->config.uri_match_fn(handler.uri, uri, pathLen)
+      : (strlen(handler.uri) == pathLen && strncmp(handler.uri, uri, pathLen) == 0);
+    if (!match) continue;
+    uriMatched = true;
+    if (handler.method == method) return &handler;
+  }
+  return nullptr;
+}
+
+// Parses one complete request from conn.input and runs its handler.
+// Returns false when the request is incomplete (need more data).
+static bool serveRequest(SimHttpd* server, SimHttpdConn& conn, bool& keepAlive) {
+  size_t headerEnd = conn.input.find("\r\n\r\n");
+  if (headerEnd == std::string::npos) return false;
+
+  SimHttpdRequest state;
+  state.fd = conn.fd;
+
+  size_t lineStart = conn.input.find("\r\n") + 2;
+  while (lineStart < headerEnd) {
+    size_t lineEnd = conn.input.find("\r\n", lineStart);
+    std::string line = conn.input.substr(lineStart, lineEnd - lineStart);
+    size_t colon = line.find(':');
+    if (colon != std::string::npos) {
+      size_t valueStart = line.find_first_not_of(' ', colon + 1);
+      state.headers.push_back({line.substr(0, colon),
+                               valueStart == std::string::npos ? "" : line.substr(valueStart)});
+    }
+    lineStart = lineEnd + 2;
+  }
+
+  size_t contentLength = 0;
+  std::string connection;
+  for (const auto& h : state.headers) {
+    if (strcasecmp(h.first.c_str(), "Content-Length") == 0) contentLength = strtoul(h.second.c_str(), nullptr, 10);
+    if (strcasecmp(h.first.c_str(), "Connection") == 0) connection = h.second;
+  }
+  if (conn.input.size() < headerEnd + 4 + contentLength) return false;
+
+  // Request line: METHOD /path?query HTTP/1.1
+  std::string requestLine = conn.input.substr(0, conn.input.find("\r\n"));
+  state.body = conn.input.substr(headerEnd + 4, contentLength);
+  conn.input.erase(0, headerEnd + 4 + contentLength);
+
+  size_t sp1 = requestLine.find(' ');
+  size_t sp2 = requestLine.find(' ', sp1 + 1);
+  if (sp1 == std::string::npos || sp2 == std::string::npos) {
+    keepAlive = false;
+    return true;
+  }
+  std::string target = requestLine.substr(sp1 + 1, sp2 - sp1 - 1);
+  std::string version = requestLine.substr(sp2 + 1);
+  keepAlive = version == "HTTP/1.1" ? strcasecmp(connection.c_str(), "close") != 0
+                                    : strcasecmp(connection.c_str(), "keep-alive") == 0;
+
+  httpd_req_t req = {};
+  req.handle = server;
+  req.method = parseMethod(requestLine.substr(0, sp1));
+  req.content_len = contentLength;
+  req.aux = &state;
+
+  if (target.size() > HTTPD_MAX_URI_LEN) {
+    httpd_resp_send_err(&req, HTTPD_414_URI_TOO_LONG, nullptr);
+    keepAlive = false;
+    return true;
+  }
+  memcpy(req.uri, target.c_str(), target.size() + 1);
+
+  bool uriMatched = false;
+  const httpd_uri_t* handler = findHandler(server, req.uri, (httpd_method_t)req.method, uriMatched);
+  if (handler) {
+    req.user_ctx = handler->user_ctx;
+    // A handler that fails has the connection closed, as on the ESP32
+    if (handler->handler(&req) != ESP_OK) keepAlive = false;
+  } else if (uriMatched) {
+    httpd_resp_send_err(&req, HTTPD_405_METHOD_NOT_ALLOWED, nullptr);
+  } else {
+    httpd_resp_send_err(&req, HTTPD_404_NOT_FOUND, nullptr);
+  }
+  if (state.failed) keepAlive = false;
+  if (state.async) {
+    // The async copy owns the socket now; stop reading from it
+    conn.detached = true;
+    keepAlive = false;
+  }
+  return true;
+}
+
+// ============================================================
+// Server thread
+// ============================================================
+
+static void acceptClient(SimHttpd* server) {
+  int fd = accept4(server->listenFD, nullptr, nullptr, SOCK_CLOEXEC);
+  if (fd < 0) return;
+
+  if (openSockets(server) >= server->config.max_open_sockets) {
+    // Only polled for accept when full if LRU purge is enabled
+    if (server->conns.empty()) {
+      ::close(fd);
+      return;
+    }
+    size_t oldest = 0;
+    for (size_t i = 1; i < server->conns.size(); i++) {
+      if (server->conns[i].lastUsed < server->conns[oldest].lastUsed) oldest = i;
+    }
+    closeConn(server, oldest);
+  }
+  // Bounds how long a handler (or an async sender) blocks on a stalled client
+  timeval timeout = {(time_t)server->config.send_wait_timeout, 0};
+  setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+  server->conns.push_back({fd, std::string(), ++server->useCounter});
+}
+
+static void serverThread(SimHttpd* server) {
+  std::vector<pollfd> fds;
+
+  while (!server->stopping) {
+    bool canAccept = openSockets(server) < server->config.max_open_sockets || server->config.lru_purge_enable;
+
+    fds.clear();
+    fds.push_back({canAccept ? server->listenFD : -1, POLLIN, 0});
+    for (const SimHttpdConn& conn : server->conns) fds.push_back({conn.fd, POLLIN, 0});
+
+    if (poll(fds.data(), fds.size(), HTTPD_POLL_MS) <= 0) continue;
+
+    // Once the simulator is stopping, handlers must not run against a half torn-down firmware
+    if (!SimHal::running()) break;
+
+    // Walk backwards so closing a connection does not shift the ones still to visit
+    for (size_t i = fds.size() - 1; i >= 1; i--) {
+      if (!fds[i].revents) continue;
+      SimHttpdConn& conn = server->conns[i - 1];
+
+      char buf[2048];
+      ssize_t n = recv(conn.fd, buf, sizeof(buf), 0);
+      if (n <= 0 || conn.input.size() + (size_t)n > HTTPD_MAX_REQUEST) {
+        closeConn(server, i - 1);
+        continue;
+      }
+      conn.input.append(buf, (size_t)n);
+      conn.lastUsed = ++server->useCounter;
+
+      bool keepAlive = true;
+      while (keepAlive && serveRequest(server, conn, keepAlive)) {}
+      if (!keepAlive) closeConn(server, i - 1);
+    }
+
+    if (fds[0].revents & POLLIN) acceptClient(server);
+  }
+}
+
+// ============================================================
+// Server API
+// ============================================================
+
+esp_err_t httpd_start(httpd_handle_t* handle, const httpd_config_t* config) {
+  if (!handle || !config) return ESP_ERR_INVALID_ARG;
+
+  SimHttpd* server = new SimHttpd;
+  server->config = *config;
+  uint16_t port = (uint16_t)(config->server_port + SimHal::options().portOffset);
+
+  server->listenFD = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  int on = 1;
+  setsockopt(server->listenFD, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(port);
+  if (server->listenFD < 0 || bind(server->listenFD, (sockaddr*)&addr, sizeof(addr)) != 0 ||
+      listen(server->listenFD, config->backlog_conn) != 0) {
+    fprintf(stderr, "[SIM] httpd listen %u: %s (try --port-offset)\n", port, strerror(errno));
+    if (server->listenFD >= 0) ::close(server->listenFD);
+    delete server;
+    return ESP_FAIL;
+  }
+
+  fprintf(stderr, "[SIM] httpd port %u listening on %u (%u sockets)\n",
+          config->server_port, port, config->max_open_sockets);
+  server->thread = std::thread(serverThread, server);
+  *handle = server;
+  return ESP_OK;
+}
+
+esp_err_t httpd_stop(httpd_handle_t handle) {
+  SimHttpd* server = (SimHttpd*)handle;
+  if (!server) return ESP_ERR_INVALID_ARG;
+
+  server->stopping = true;
+  if (server->thread.joinable()) {
+    if (server->thread.get_id() == std::this_thread::get_id()) {
+      server->thread.detach();
+      return ESP_OK;  // stopped from a handler: the thread ends after it returns
+    }
+    server->thread.join();
+  }
+  for (const SimHttpdConn& conn : server->conns) ::close(conn.fd);
+  ::close(server->listenFD);
+  delete server;
+  return ESP_OK;
+}
+
+esp_err_t httpd_register_uri_handler(httpd_handle_t handle, const httpd_uri_t* uri_handler) {
+  SimHttpd* server = (SimHttpd*)handle;
+  if (!server || !uri_handler) return ESP_ERR_INVALID_ARG;
+
+  for (const httpd_uri_t& handler : server->handlers) {
+    if (handler.method == uri_handler->method && strcmp(handler.uri, uri_handler->uri) == 0) {
+      return ESP_ERR_HTTPD_HANDLER_EXISTS;
+    }
+  }
+  if (server->handlers.size() >= server->config.max_uri_handlers) return ESP_ERR_HTTPD_HANDLERS_FULL;
+  server->handlers.push_back(*uri_handler);
+  return ESP_OK;
+}
+
+// "/path" exact, "/path*" prefix, "/path/?" with or without the last character
+bool httpd_uri_match_wildcard(const char* uri_template, const char* uri_to_match, size_t match_upto) {
+  size_t exactLen = strcspn(uri_template, "?*");
+  bool question = uri_template[exactLen] == '?';
+  bool asterisk = uri_template[exactLen + (question ? 1 : 0)] == '*';
+
+  if (!question && !asterisk) {
+    return strlen(uri_template) == match_upto && strncmp(uri_template, uri_to_match, match_upto) == 0;
+  }
+  if (question && exactLen > 0 && match_upto == exactLen - 1 &&
+      strncmp(uri_template, uri_to_match, match_upto) == 0) {
+    return true;
+  }
+  if (asterisk) return match_upto >= exactLen && strncmp(uri_template, uri_to_match, exactLen) == 0;
+  return match_upto == exactLen && strncmp(uri_template, uri_to_match, exactLen) == 0;
+}
+
+// ============================================================
+// Request API
+// ============================================================
+
+size_t httpd_req_get_url_query_len(httpd_req_t* r) {
+  const char* query = strchr(r->uri, '?');
+  return query ? strlen(query + 1) : 0;
+}
+
+esp_err_t httpd_req_get_url_query_str(httpd_req_t* r, char* buf, size_t buf_len) {
+  const char* query = strchr(r->uri, '?');
+  if (!query) return ESP_ERR_NOT_FOUND;
+  if (!buf || buf_len == 0) return ESP_ERR_INVALID_ARG;
+  snprintf(buf, buf_len, "%s", query + 1);
+  return strlen(query + 1) < buf_len ? ESP_OK : ESP_ERR_HTTPD_RESULT_TRUNC;
+}
+
+// Value of key in a query string, as sent (not URL-decoded)
+esp_err_t httpd_query_key_value(const char* qry, const char* key, char* val, size_t val_size) {
+  if (!qry || !key || !val || val_size == 0) return ESP_ERR_INVALID_ARG;
+  size_t keyLen = strlen(key);
+  for (const char* p = qry; *p; ) {
+    const char* end = strchr(p, '&');
+    size_t len = end ? (size_t)(end - p) : strlen(p);
+    if (len > keyLen && strncmp(p, key, keyLen) == 0 && p[keyLen] == '=') {
+      size_t valueLen = len - keyLen - 1;
+      snprintf(val, val_size, "%.*s", (int)valueLen, p + keyLen + 1);
+      return valueLen < val_size ? ESP_OK : ESP_ERR_HTTPD_RESULT_TRUNC;
+    }
+    if (!end) break;
+    p = end + 1;
+  }
+  return ESP_ERR_NOT_FOUND;
+}
+
+size_t httpd_req_get_hdr_value_len(httpd_req_t* r, const char* field) {
+  SimHttpdRequest* state = (SimHttpdRequest*)r->aux;
+  for (const auto& h : state->headers) {
+    if (strcasecmp(h.first.c_str(), field) == 0) return h.second.size();
+  }
+  return 0;
+}
+
+esp_err_t httpd_req_get_hdr_value_str(httpd_req_t* r, const char* field, char* val, size_t val_size) {
+  SimHttpdRequest* state = (SimHttpdRequest*)r->aux;
+  for (const auto& h : state->headers) {
+    if (strcasecmp(h.first.c_str(), field) != 0) continue;
+    snprintf(val, val_size, "%s", h.second.c_str());
+    return h.second.size() < val_size ? ESP_OK : ESP_ERR_HTTPD_RESULT_TRUNC;
+  }
+  return ESP_ERR_NOT_FOUND;
+}
+
+int httpd_req_recv(httpd_req_t* r, char* buf, size_t buf_len) {
+  SimHttpdRequest* state = (SimHttpdRequest*)r->aux;
+  size_t n = state->body.size() - state->bodyRead;
+  if (n > buf_len) n = buf_len;
+  memcpy(buf, state->body.data() + state->bodyRead, n);
+  state->bodyRead += n;
+  return (int)n;
+}
+
+int httpd_req_to_sockfd(httpd_req_t* r) {
+  return ((SimHttpdRequest*)r->aux)->fd;
+}
+
+// ============================================================
+// Response API
+// ============================================================
+
+esp_err_t httpd_resp_set_status(httpd_req_t* r, const char* status) {
+  ((SimHttpdRequest*)r->aux)->status = status;
+  return ESP_OK;
+}
+
+esp_err_t httpd_resp_set_type(httpd_req_t* r, const char* type) {
+  ((SimHttpdRequest*)r->aux)->type = type;
+  return ESP_OK;
+}
+
+esp_err_t httpd_resp_set_hdr(httpd_req_t* r, const char* field, const char* value) {
+  ((SimHttpdRequest*)r->aux)->responseHeaders.push_back({field, value});
+  return ESP_OK;
+}
+
+esp_err_t httpd_resp_send(httpd_req_t* r, const char* buf, ssize_t buf_len) {
+  SimHttpdRequest* state = (SimHttpdRequest*)r->aux;
+  if (state->sent) return ESP_ERR_HTTPD_RESP_SEND;
+  state->sent = true;
+
+  size_t length = buf ? (buf_len == HTTPD_RESP_USE_STRLEN ? strlen(buf) : (size_t)buf_len) : 0;
+  std::string response = "HTTP/1.1 " + state->status + "\r\n";
+  response += "Content-Type: " + state->type + "\r\n";
+  response += "Content-Length: " + std::to_string(length) + "\r\n";
+  for (const auto& h : state->responseHeaders) response += h.first + ": " + h.second + "\r\n";
+  response += "\r\n";
+  if (r->method != HTTP_HEAD && length > 0) response.append(buf, length);
+
+  if (!writeAll(state->fd, response)) {
+    state->failed = true;
+    return ESP_ERR_HTTPD_RESP_SEND;
+  }
+  return ESP_OK;
+}
+
+// The first chunk sends the status line and headers; a zero-length chunk ends the response
+esp_err_t httpd_resp_send_chunk(httpd_req_t* r, const char* buf, ssize_t buf_len) {
+  SimHttpdRequest* state = (SimHttpdRequest*)r->aux;
+  if (state->sent && !state->chunked) return ESP_ERR_HTTPD_RESP_SEND;
+
+  std::string response;
+  if (!state->sent) {
+    state->sent = true;
+    state->chunked = true;
+    response = "HTTP/1.1 " + state->status + "\r\n";
+    response += "Content-Type: " + state->type + "\r\n";
+    response += "Transfer-Encoding: chunked\r\n";
+    for (const auto& h : state->responseHeaders) response += h.first + ": " + h.second + "\r\n";
+    response += "\r\n";
+  }
+
+  size_t length = buf ? (buf_len == HTTPD_RESP_USE_STRLEN ? strlen(buf) : (size_t)buf_len) : 0;
+  char size[20];  // 16 hex digits, CRLF, NUL
+  snprintf(size, sizeof(size), "%zx\r\n", length);
+  response += size;
+  if (length > 0) response.append(buf, length);
+  response += "\r\n";
+
+  if (!writeAll(state->fd, response)) {
+    state->failed = true;
+    return ESP_ERR_HTTPD_RESP_SEND;
+  }
+  return ESP_OK;
+}
+
+esp_err_t httpd_resp_send_err(httpd_req_t* r, httpd_err_code_t error, const char* msg) {
+  const char* status;
+  const char* text;
+  switch (error) {
+    case HTTPD_400_BAD_REQUEST:        status = HTTPD_400; text = "Bad request syntax"; break;
+    case HTTPD_404_NOT_FOUND:          status = HTTPD_404; text = "This URI does not exist"; break;
+    case HTTPD_405_METHOD_NOT_ALLOWED: status = "405 Method Not Allowed"; text = "Request method for this URI is not handled by server"; break;
+    case HTTPD_408_REQ_TIMEOUT:        status = "408 Request Timeout"; text = "Server closed this connection"; break;
+    case HTTPD_414_URI_TOO_LONG:       status = "414 URI Too Long"; text = "URI is too long"; break;
+    default:                           status = HTTPD_500; text = "Server has encountered an unexpected error"; break;
+  }
+  httpd_resp_set_status(r, status);
+  httpd_resp_set_type(r, HTTPD_TYPE_TEXT);
+  return httpd_resp_send(r, msg ? msg : text, HTTPD_RESP_USE_STRLEN);
+}
+
+// ============================================================
+// Async requests
+// ============================================================
+
+esp_err_t httpd_req_async_handler_begin(httpd_req_t* r, httpd_req_t** out) {
+  if (!r || !out) return ESP_ERR_INVALID_ARG;
+  SimHttpdRequest* state = (SimHttpdRequest*)r->aux;
+  SimHttpd* server = (SimHttpd*)r->handle;
+
+  httpd_req_t* copy = new httpd_req_t(*r);
+  copy->aux = new SimHttpdRequest(*state);
+  state->async = true;
+  server->asyncOpen++;
+  *out = copy;
+  return ESP_OK;
+}
+
+esp_err_t httpd_req_async_handler_complete(httpd_req_t* r) {
+  if (!r) return ESP_ERR_INVALID_ARG;
+  SimHttpdRequest* state = (SimHttpdRequest*)r->aux;
+  SimHttpd* server = (SimHttpd*)r->handle;
+
+  ::close(state->fd);
+  server->asyncOpen--;
+  delete state;
+  delete r;
+  return ESP_OK;
+}
@@ -0,0 +1,78 @@
+/*
+  sim_main.cpp - Linux simulator entry point
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Compiles the unmodified sketch against the host HAL and drives its
+  setup()/loop() the way the Arduino core does on the ESP32-S3.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#include "sim_hal.h"
+#include "sim_world.h"
+
+#include "../dlc_firmware_s3.ino"
+
+static void printUsage(const char* program) {
+  fprintf(stderr,
+    "Usage: %s [options]\n"
+    "  --speed <x>         virtual time multiplier (default 1.0)\n"
+    "  --tty-link <path>   symlink the serial pty to <path>\n"
+    "  --nvs <dir>         persist Preferences in <dir> (default: in memory)\n"
+    "  --port-offset <n>   add <n> to every network listen port\n"
+    "  --idle-us <n>       real-time sleep between loop() passes (default 200)\n"
+    "  --ambient <C>       ambient temperature (default 5.0)\n"
+    "  --humidity <%%>      relative humidity (default 85.0)\n"
+    "  --no-heater-sensor  simulate a disconnected DS18B20\n"
+    "  --no-ambient-sensor simulate a missing BME280/DHT22\n"
+    "  --echo              copy serial output to stdout\n",
+    program);
+}
+
+int main(int argc, char** argv) {
+  SimHal::Options options;
+  SimWorld::Environment environment;
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+
+    if (arg == "--speed" && hasValue) {
+      options.speed = atof(argv[++i]);
+    } else if (arg == "--tty-link" && hasValue) {
+      options.ttyLink = argv[++i];
+    } else if (arg == "--nvs" && hasValue) {
+      options.nvsDir = argv[++i];
+    } else if (arg == "--port-offset" && hasValue) {
+      options.portOffset = atoi(argv[++i]);
+    } else if (arg == "--idle-us" && hasValue) {
+      options.idleMicros = (uint32_t)strtoul(argv[++i], nullptr, 10);
+    } else if (arg == "--ambient" && hasValue) {
+      environment.ambientTemp = (float)atof(argv[++i]);
+    } else if (arg == "--humidity" && hasValue) {
+      environment.humidity = (float)atof(argv[++i]);
+    } else if (arg == "--no-heater-sensor") {
+      environment.heaterSensorPresent = false;
+    } else if (arg == "--no-ambient-sensor") {
+      environment.ambientSensorPresent = false;
+    } else if (arg == "--echo") {
+      options.echo = true;
+    } else {
+      printUsage(argv[0]);
+      return arg == "--help" ? 0 : 2;
+    }
+  }
+
+  if (!SimHal::begin(options, argv)) return 1;
+  SimWorld::begin(environment);
+
+  setup();
+  while (SimHal::running()) {
+    loop();
+    SimHal::idle();
+  }
+
+  SimHal::end();
+  return 0;
+}
@@ -0,0 +1,436 @@
+/*
+  sim_net.cpp - Linux simulator network HAL (WiFi, UDP, WebServer)
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Built only with DLC_SIM_WIFI. Sockets are non-blocking at the accept and
+  receive level so loop() keeps its pacing; a request that has been
+  accepted is read and answered synchronously, as on the ESP32.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#include "sim_hal.h"
+
+#include <WiFi.h>
+#include <WiFiUdp.h>
+#include <WebServer.h>
+#include <ESPmDNS.h>
+#include <ElegantOTA.h>
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+WiFiClass WiFi;
+MDNSResponder MDNS;
+ElegantOTAClass ElegantOTA;
+
+static const uint8_t SIM_MAC[6] = {0x02, 0xD1, 0xC0, 0x00, 0x00, 0x01};  // locally administered
+static const int HTTP_READ_TIMEOUT = 2000;  // ms (real time) to receive a full request
+static const size_t HTTP_MAX_REQUEST = 16384;
+
+static uint16_t listenPort(int port) {
+  return (uint16_t)(port + SimHal::options().portOffset);
+}
+
+// bind() of the firmware's own lwIP sockets (hal/lwip/sockets.h)
+int simBind(int fd, const sockaddr* addr, socklen_t length) {
+  sockaddr_storage shifted = {};
+  memcpy(&shifted, addr, length < sizeof(shifted) ? length : sizeof(shifted));
+  if (shifted.ss_family == AF_INET) {
+    sockaddr_in* in = (sockaddr_in*)&shifted;
+    in->sin_port = htons(listenPort(ntohs(in->sin_port)));
+  } else if (shifted.ss_family == AF_INET6) {
+    sockaddr_in6* in6 = (sockaddr_in6*)&shifted;
+    in6->sin6_port = htons(listenPort(ntohs(in6->sin6_port)));
+  }
+  return ::bind(fd, (sockaddr*)&shifted, length);
+}
+
+// ============================================================
+// WiFi
+// ============================================================
+
+wl_status_t WiFiClass::begin(const char* ssid, const char* pass) {
+  (void)pass;
+  fprintf(stderr, "[SIM] WiFi joined \"%s\" (loopback)\n", ssid);
+  _status = WL_CONNECTED;
+  return _status;
+}
+
+bool WiFiClass::softAP(const char* ssid, const char* pass) {
+  (void)pass;
+  fprintf(stderr, "[SIM] WiFi AP \"%s\" (loopback)\n", ssid);
+  return true;
+}
+
+uint8_t* WiFiClass::macAddress(uint8_t* mac) const {
+  memcpy(mac, SIM_MAC, sizeof(SIM_MAC));
+  return mac;
+}
+
+String WiFiClass::macAddress() const {
+  char buf[18];
+  snprintf(buf, sizeof(buf), "%02X:%02X:%02X:%02X:%02X:%02X",
+           SIM_MAC[0], SIM_MAC[1], SIM_MAC[2], SIM_MAC[3], SIM_MAC[4], SIM_MAC[5]);
+  return String(buf);
+}
+
+// ============================================================
+// WiFiUDP
+// ============================================================
+
+uint8_t WiFiUDP::begin(uint16_t port) {
+  stop();
+  _fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (_fd < 0) return 0;
+
+  int on = 1;
+  setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+  setsockopt(_fd, SOL_SOCKET, SO_BROADCAST, &on, sizeof(on));
+
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(listenPort(port));
+  if (bind(_fd, (sockaddr*)&addr, sizeof(addr)) != 0) {
+    fprintf(stderr, "[SIM] UDP bind %u: %s\n", listenPort(port), strerror(errno));
+    stop();
+    return 0;
+  }
+  return 1;
+}
+
+void WiFiUDP::stop() {
+  if (_fd >= 0) close(_fd);
+  _fd = -1;
+  _rxLength = _rxPos = 0;
+}
+
+int WiFiUDP::parsePacket() {
+  _rxLength = _rxPos = 0;
+  if (_fd < 0) return 0;
+
+  sockaddr_in from = {};
+  socklen_t fromLength = sizeof(from);
+  ssize_t n = recvfrom(_fd, _rx, sizeof(_rx), 0, (sockaddr*)&from, &fromLength);
+  if (n <= 0) return 0;
+
+  uint32_t ip = ntohl(from.sin_addr.s_addr);
+  _remoteIP = IPAddress(ip >> 24, ip >> 16, ip >> 8, ip);
+  _remotePort = ntohs(from.sin_port);
+  _rxLength = (size_t)n;
+  return (int)n;
+}
+
+int WiFiUDP::read(uint8_t* buffer, size_t length) {
+  size_t n = _rxLength - _rxPos;
+  if (n > length) n = length;
+  memcpy(buffer, _rx + _rxPos, n);
+  _rxPos += n;
+  return (int)n;
+}
+
+int WiFiUDP::beginPacket(IPAddress ip, uint16_t port) {
+  _txIP = ip;
+  _txPort = port;
+  _tx.clear();
+  return _fd >= 0 ? 1 : 0;
+}
+
+size_t WiFiUDP::write(const uint8_t* buffer, size_t size) {
+  _tx.append((const char*)buffer, size);
+  return size;
+}
+
+int WiFiUDP::endPacket() {
+  if (_fd < 0) return 0;
+  sockaddr_in to = {};
+  to.sin_family = AF_INET;
+  to.sin_addr.s_addr = htonl(((uint32_t)_txIP[0] << 24) | ((uint32_t)_txIP[1] << 16) |
+                             ((uint32_t)_txIP[2] << 8) | _txIP[3]);
+  to.sin_port = htons(_txPort);
+  ssize_t n = sendto(_fd, _tx.data(), _tx.size(), 0, (sockaddr*)&to, sizeof(to));
+  _tx.clear();
+  return n >= 0 ? 1 : 0;
+}
+
+// ============================================================
+// WebServer
+// ============================================================
+
+static const char* statusText(int code) {
+  switch (code) {
+    case 200: return "OK";
+    case 204: return "No Content";
+    case 302: return "Found";
+    case 304: return "Not Modified";
+    case 400: return "Bad Request";
+    case 404: return "Not Found";
+    case 500: return "Internal Server Error";
+    case 501: return "Not Implemented";
+    default:  return "";
+  }
+}
+
+static HTTPMethod parseMethod(const std::string& method) {
+  if (method == "GET")     return HTTP_GET;
+  if (method == "HEAD")    return HTTP_HEAD;
+  if (method == "POST")    return HTTP_POST;
+  if (method == "PUT")     return HTTP_PUT;
+  if (method == "PATCH")   return HTTP_PATCH;
+  if (method == "DELETE")  return HTTP_DELETE;
+  if (method == "OPTIONS") return HTTP_OPTIONS;
+  return HTTP_ANY;
+}
+
+static std::string urlDecode(const std::string& text) {
+  std::string out;
+  for (size_t i = 0; i < text.size(); i++) {
+    if (text[i] == '+') {
+      out += ' ';
+    } else if (text[i] == '%' && i + 2 < text.size()) {
+      out += (char)strtol(text.substr(i + 1, 2).c_str(), nullptr, 16);
+      i += 2;
+    } else {
+      out += text[i];
+    }
+  }
+  return out;
+}
+
+void WebServer::begin() {
+  close();
+  _listenFD = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (_listenFD < 0) return;
+
+  int on = 1;
+  setsockopt(_listenFD, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(listenPort(_port));
+  if (bind(_listenFD, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(_listenFD, 8) != 0) {
+    fprintf(stderr, "[SIM] HTTP listen %u: %s (try --port-offset)\n", listenPort(_port), strerror(errno));
+    close();
+    return;
+  }
+  fprintf(stderr, "[SIM] HTTP port %d listening on %u\n", _port, listenPort(_port));
+}
+
+void WebServer::close() {
+  if (_listenFD >= 0) ::close(_listenFD);
+  _listenFD = -1;
+}
+
+void WebServer::on(const String& uri, HTTPMethod method, THandlerFunction handler) {
+  _routes.push_back({uri, method, handler});
+}
+
+void WebServer::handleClient() {
+  if (_listenFD < 0) return;
+
+  _clientFD = accept4(_listenFD, nullptr, nullptr, SOCK_CLOEXEC);
+  if (_clientFD < 0) return;
+
+  if (readRequest()) {
+    _responded = false;
+    _responseHeaders.clear();
+
+    const Route* match = nullptr;
+    for (const Route& route : _routes) {
+      if (route.uri == _uri && (route.method == HTTP_ANY || route.method == _method)) {
+        match = &route;
+        break;
+      }
+    }
+
+    if (match) {
+      match->handler();
+    } else if (_notFound) {
+      _notFound();
+    } else {
+      send(404, "text/plain", String("Not found: ") + _uri);
+    }
+    if (!_responded) send(500, "text/plain", "No response");
+    if (_chunked) sendContent("", 0);
+    _contentLength = 0;
+  }
+
+  ::close(_clientFD);
+  _clientFD = -1;
+}
+
+bool WebServer::readRequest() {
+  std::string data;
+  size_t headerEnd = std::string::npos;
+  size_t contentLength = 0;
+
+  // Read until the header block and the declared body have arrived
+  while (true) {
+    if (headerEnd != std::string::npos && data.size() >= headerEnd + 4 + contentLength) break;
+    if (data.size() > HTTP_MAX_REQUEST) return false;
+
+    pollfd pfd = {_clientFD, POLLIN, 0};
+    if (poll(&pfd, 1, HTTP_READ_TIMEOUT) <= 0) return false;
+    char buf[2048];
+    ssize_t n = recv(_clientFD, buf, sizeof(buf), 0);
+    if (n <= 0) return false;
+    data.append(buf, (size_t)n);
+
+    if (headerEnd == std::string::npos) {
+      headerEnd = data.find("\r\n\r\n");
+      if (headerEnd == std::string::npos) continue;
+
+      _requestHeaders.clear();
+      size_t lineStart = data.find("\r\n") + 2;
+      while (lineStart < headerEnd) {
+        size_t lineEnd = data.find("\r\n", lineStart);
+        std::string line = data.substr(lineStart, lineEnd - lineStart);
+        size_t colon = line.find(':');
+        if (colon != std::string::npos) {
+          size_t valueStart = line.find_first_not_of(' ', colon + 1);
+          std::string value = valueStart == std::string::npos ? "" : line.substr(valueStart);
+          _requestHeaders.push_back({String(line.substr(0, colon)), String(value)});
+        }
+        lineStart = lineEnd + 2;
+      }
+      contentLength = (size_t)header("Content-Length").toInt();
+    }
+  }
+
+  // Request line: METHOD /path?query HTTP/1.1
+  std::string requestLine = data.substr(0, data.find("\r\n"));
+  size_t sp1 = requestLine.find(' ');
+  size_t sp2 = requestLine.find(' ', sp1 + 1);
+  if (sp1 == std::string::npos || sp2 == std::string::npos) return false;
+
+  _method = parseMethod(requestLine.substr(0, sp1));
+  std::string target = requestLine.substr(sp1 + 1, sp2 - sp1 - 1);
+  size_t query = target.find('?');
+  _uri = String(urlDecode(target.substr(0, query)));
+
+  _args.clear();
+  if (query != std::string::npos) parseArgs(target.substr(query + 1));
+
+  std::string body = data.substr(headerEnd + 4, contentLength);
+  if (!body.empty()) {
+    if (header("Content-Type").startsWith("application/x-www-form-urlencoded")) {
+      parseArgs(body);
+    } else {
+      _args.push_back({String("plain"), String(body)});
+    }
+  }
+  return true;
+}
+
+void WebServer::parseArgs(const std::string& encoded) {
+  size_t start = 0;
+  while (start <= encoded.size()) {
+    size_t end = encoded.find('&', start);
+    if (end == std::string::npos) end = encoded.size();
+    std::string pair = encoded.substr(start, end - start);
+    if (!pair.empty()) {
+      size_t eq = pair.find('=');
+      std::string name = urlDecode(pair.substr(0, eq));
+      std::string value = eq == std::string::npos ? "" : urlDecode(pair.substr(eq + 1));
+      _args.push_back({String(name), String(value)});
+    }
+    start = end + 1;
+  }
+}
+
+String WebServer::arg(int index) const {
+  return (index >= 0 && index < (int)_args.size()) ? _args[index].second : String();
+}
+
+String WebServer::argName(int index) const {
+  return (index >= 0 && index < (int)_args.size()) ? _args[index].first : String();
+}
+
+String WebServer::arg(const String& name) const {
+  for (const auto& a : _args) {
+    if (a.first == name) return a.second;
+  }
+  return String();
+}
+
+bool WebServer::hasArg(const String& name) const {
+  for (const auto& a : _args) {
+    if (a.first == name) return true;
+  }
+  return false;
+}
+
+String WebServer::header(const String& name) const {
+  for (const auto& h : _requestHeaders) {
+    if (h.first.equalsIgnoreCase(name)) return h.second;
+  }
+  return String();
+}
+
+void WebServer::sendHeader(const String& name, const String& value, bool first) {
+  if (first) {
+    _responseHeaders.insert(_responseHeaders.begin(), {name, value});
+  } else {
+    _responseHeaders.push_back({name, value});
+  }
+}
+
+void WebServer::send(int code, const char* contentType, const String& content) {
+  sendResponse(code, contentType, content.c_str(), content.length());
+}
+
+void WebServer::send_P(int code, PGM_P contentType, PGM_P content, size_t contentLength) {
+  sendResponse(code, contentType, content, contentLength);
+}
+
+void WebServer::sendResponse(int code, const char* contentType, const char* content, size_t contentLength) {
+  if (_clientFD < 0 || _responded) return;
+  _responded = true;
+
+  std::string response = "HTTP/1.1 " + std::to_string(code) + " " + statusText(code) + "\r\n";
+  if (contentType) response += std::string("Content-Type: ") + contentType + "\r\n";
+  if (_contentLength == CONTENT_LENGTH_UNKNOWN) {
+    _chunked = _method != HTTP_HEAD;
+    response += "Transfer-Encoding: chunked\r\n";
+  } else {
+    response += "Content-Length: " + std::to_string(contentLength) + "\r\n";
+  }
+  response += "Connection: close\r\n";
+  for (const auto& h : _responseHeaders) {
+    response += h.first.str() + ": " + h.second.str() + "\r\n";
+  }
+  response += "\r\n";
+  if (_method != HTTP_HEAD && !_chunked) response.append(content, contentLength);
+  writeAll(response);
+}
+
+void WebServer::sendContent(const char* content, size_t contentLength) {
+  if (_clientFD < 0 || !_chunked) return;
+
+  // An empty chunk ends the body
+  char size[20];
+  snprintf(size, sizeof(size), "%zx\r\n", contentLength);
+  std::string chunk = size;
+  chunk.append(content, contentLength);
+  chunk += "\r\n";
+  if (contentLength == 0) _chunked = false;
+  writeAll(chunk);
+}
+
+void WebServer::writeAll(const std::string& data) {
+  size_t sent = 0;
+  while (sent < data.size()) {
+    ssize_t n = ::send(_clientFD, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+    if (n <= 0) return;
+    sent += (size_t)n;
+  }
+}
@@ -0,0 +1,173 @@
+/*
+  sim_rtos.cpp - Linux simulator: FreeRTOS tasks, mutexes and queues on std::thread
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Ticks are virtual milliseconds, so task periods scale with --speed like
+  millis() does. Once the simulator is stopping, a task that waits parks
+  for good instead of running against a half torn-down firmware.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#include <Arduino.h>
+#include "sim_hal.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct SimTask {
+  std::thread thread;
+};
+
+struct SimSemaphore {
+  std::timed_mutex mutex;
+};
+
+struct SimQueue {
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::deque<std::vector<uint8_t>> items;
+  size_t length;
+  size_t itemSize;
+};
+
+static std::chrono::microseconds realTimeout(TickType_t ticks) {
+  return std::chrono::microseconds((uint64_t)(ticks * 1000.0 / SimHal::options().speed));
+}
+
+static void parkIfStopping() {
+  while (!SimHal::running()) {
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+  }
+}
+
+// ============================================================
+// Tasks
+// ============================================================
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackDepth,
+                                   void* param, UBaseType_t priority, TaskHandle_t* handle,
+                                   BaseType_t core) {
+  (void)name; (void)stackDepth; (void)priority; (void)core;
+  SimTask* task = new SimTask;
+  task->thread = std::thread(function, param);
+  task->thread.detach();
+  if (handle) *handle = task;
+  return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stackDepth,
+                       void* param, UBaseType_t priority, TaskHandle_t* handle) {
+  return xTaskCreatePinnedToCore(function, name, stackDepth, param, priority, handle, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t handle) {
+  // Only self-deletion is used: end the calling thread's work for good
+  (void)handle;
+  while (true) {
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+  }
+}
+
+TickType_t xTaskGetTickCount() {
+  return (TickType_t)millis();
+}
+
+void vTaskDelay(TickType_t ticks) {
+  delay(ticks);
+  parkIfStopping();
+}
+
+void vTaskDelayUntil(TickType_t* previousWake, TickType_t increment) {
+  *previousWake += increment;
+  int32_t remaining = (int32_t)(*previousWake - xTaskGetTickCount());
+  if (remaining > 0) {
+    delay((uint32_t)remaining);
+  } else {
+    // Missed the slot, like FreeRTOS: run now and keep the period phase
+    std::this_thread::yield();
+  }
+  parkIfStopping();
+}
+
+// ============================================================
+// Mutexes
+// ============================================================
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+  return new SimSemaphore;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+  delete semaphore;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) {
+  if (ticks == portMAX_DELAY) {
+    semaphore->mutex.lock();
+    return pdTRUE;
+  }
+  return semaphore->mutex.try_lock_for(realTimeout(ticks)) ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+  semaphore->mutex.unlock();
+  return pdTRUE;
+}
+
+// ============================================================
+// Queues
+// ============================================================
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+  SimQueue* queue = new SimQueue;
+  queue->length = length;
+  queue->itemSize = itemSize;
+  return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+  delete queue;
+}
+
+// Waits until ready() holds or the virtual-time timeout expires
+template <typename Ready>
+static bool waitQueue(QueueHandle_t queue, std::unique_lock<std::mutex>& lock, TickType_t ticks, Ready ready) {
+  if (ticks == portMAX_DELAY) {
+    queue->changed.wait(lock, ready);
+    return true;
+  }
+  return queue->changed.wait_for(lock, realTimeout(ticks), ready);
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks) {
+  std::unique_lock<std::mutex> lock(queue->mutex);
+  if (!waitQueue(queue, lock, ticks, [queue]() { return queue->items.size() < queue->length; })) {
+    return errQUEUE_FULL;
+  }
+  const uint8_t* bytes = (const uint8_t*)item;
+  queue->items.emplace_back(bytes, bytes + queue->itemSize);
+  queue->changed.notify_all();
+  return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks) {
+  std::unique_lock<std::mutex> lock(queue->mutex);
+  if (!waitQueue(queue, lock, ticks, [queue]() { return !queue->items.empty(); })) {
+    return errQUEUE_EMPTY;
+  }
+  memcpy(item, queue->items.front().data(), queue->itemSize);
+  queue->items.pop_front();
+  queue->changed.notify_all();
+  return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+  std::lock_guard<std::mutex> lock(queue->mutex);
+  return (UBaseType_t)queue->items.size();
+}
@@ -0,0 +1,114 @@
+/*
+  sim_sensors.cpp - Linux simulator sensor register models
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  The BME280 at 0x76 answers reads of its data registers (0xF7-0xFE) with
+  the raw values that compensate, with SIM_BME280_CALIB, to the
+  environment's temperature and humidity and standard pressure. The raw
+  values are found by bisection against the datasheet's compensation,
+  written out again here so the firmware's copy is checked against it.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#include <Adafruit_I2CDevice.h>
+#include <Adafruit_BME280.h>
+#include "sim_world.h"
+
+namespace {
+
+const uint8_t BME280_ADDRESS = 0x76;
+const uint8_t BME280_DATA = 0xF7;
+const float STANDARD_PRESSURE = 1013.25f;  // hPa
+
+const bme280_calib_data& c = SIM_BME280_CALIB;
+
+// Datasheet section 4.2.3: t_fine, then the value in 0.01 C, Q24.8 Pa and Q22.10 %RH
+int32_t temperatureFine(int32_t adc) {
+  int32_t var1 = ((((adc >> 3) - ((int32_t)c.dig_T1 << 1))) * ((int32_t)c.dig_T2)) >> 11;
+  int32_t var2 = (((((adc >> 4) - ((int32_t)c.dig_T1)) * ((adc >> 4) - ((int32_t)c.dig_T1))) >> 12) *
+                  ((int32_t)c.dig_T3)) >> 14;
+  return var1 + var2;
+}
+
+int32_t temperature(int32_t tFine) {
+  return (tFine * 5 + 128) >> 8;
+}
+
+uint32_t pressure(int32_t adc, int32_t tFine) {
+  int64_t var1 = (int64_t)tFine - 128000;
+  int64_t var2 = var1 * var1 * (int64_t)c.dig_P6;
+  var2 = var2 + ((var1 * (int64_t)c.dig_P5) << 17);
+  var2 = var2 + (((int64_t)c.dig_P4) << 35);
+  var1 = ((var1 * var1 * (int64_t)c.dig_P3) >> 8) + ((var1 * (int64_t)c.dig_P2) << 12);
+  var1 = (((((int64_t)1) << 47) + var1)) * ((int64_t)c.dig_P1) >> 33;
+  if (var1 == 0) return 0;
+
+  int64_t p = 1048576 - adc;
+  p = (((p << 31) - var2) * 3125) / var1;
+  var1 = (((int64_t)c.dig_P9) * (p >> 13) * (p >> 13)) >> 25;
+  var2 = (((int64_t)c.dig_P8) * p) >> 19;
+  return (uint32_t)(((p + var1 + var2) >> 8) + (((int64_t)c.dig_P7) << 4));
+}
+
+uint32_t humidity(int32_t adc, int32_t tFine) {
+  int32_t v = tFine - 76800;
+  v = (((((adc << 14) - (((int32_t)c.dig_H4) << 20) - (((int32_t)c.dig_H5) * v)) + 16384) >> 15) *
+       (((((((v * ((int32_t)c.dig_H6)) >> 10) * (((v * ((int32_t)c.dig_H3)) >> 11) + 32768)) >> 10) +
+          2097152) * ((int32_t)c.dig_H2) + 8192) >> 14));
+  v = v - (((((v >> 15) * (v >> 15)) >> 7) * ((int32_t)c.dig_H1)) >> 4);
+  v = v < 0 ? 0 : v;
+  v = v > 419430400 ? 419430400 : v;
+  return (uint32_t)(v >> 12);
+}
+
+// Smallest raw value in [0, limit) whose output reaches target (rising
+// outputs) or stays under it (falling)
+template <typename Output>
+int32_t bisect(int32_t limit, int64_t target, bool rising, Output output) {
+  int32_t low = 0, high = limit - 1;
+  while (low < high) {
+    int32_t mid = low + (high - low) / 2;
+    int64_t value = output(mid);
+    if (rising ? value >= target : value <= target) high = mid;
+    else low = mid + 1;
+  }
+  return low;
+}
+
+void bme280Data(uint8_t* data) {
+  int32_t adcT = bisect(1 << 20, lroundf(SimWorld::ambientTemp() * 100.0f), true,
+                        [](int32_t adc) { return (int64_t)temperature(temperatureFine(adc)); });
+  int32_t tFine = temperatureFine(adcT);
+  int32_t adcP = bisect(1 << 20, lroundf(STANDARD_PRESSURE * 100.0f * 256.0f), false,
+                        [tFine](int32_t adc) { return (int64_t)pressure(adc, tFine); });
+  int32_t adcH = bisect(1 << 16, lroundf(SimWorld::humidity() * 1024.0f), true,
+                        [tFine](int32_t adc) { return (int64_t)humidity(adc, tFine); });
+
+  data[0] = adcP >> 12;
+  data[1] = adcP >> 4;
+  data[2] = (adcP << 4) & 0xF0;
+  data[3] = adcT >> 12;
+  data[4] = adcT >> 4;
+  data[5] = (adcT << 4) & 0xF0;
+  data[6] = adcH >> 8;
+  data[7] = adcH;
+}
+
+} // namespace
+
+bool Adafruit_I2CDevice::write_then_read(const uint8_t* writeBuffer, size_t writeLength, uint8_t* readBuffer,
+                                         size_t readLength, bool stop) {
+  (void)stop;
+  // Start, address and the bytes (9 clocks each) of both parts
+  delayMicroseconds((uint32_t)((writeLength + readLength + 2) * 9 * 1000000ull / _wire->getClock()));
+
+  if (_address != BME280_ADDRESS || !SimWorld::ambientSensorPresent()) return false;
+  if (writeLength != 1 || writeBuffer[0] != BME280_DATA || readLength > 8) return false;
+
+  uint8_t data[8];
+  bme280Data(data);
+  memcpy(readBuffer, data, readLength);
+  return true;
+}
@@ -0,0 +1,63 @@
+/*
+  sim_world.cpp - Linux simulator environment and heater thermal model
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#include "sim_world.h"
+#include "sim_hal.h"
+#include "config.h"
+
+namespace {
+
+SimWorld::Environment g_env;
+float g_heaterTemp = 0.0f;
+uint64_t g_lastUpdate = 0;
+
+// Advance the heater element to the current virtual time. The exact step
+// response of the first-order model keeps the result independent of how
+// often the firmware samples the sensor.
+void updateHeater() {
+  uint64_t now = SimHal::clockMicros();
+  float dt = (float)(now - g_lastUpdate) / 1e6f;
+  g_lastUpdate = now;
+
+  float duty = constrain(SimHal::pinValue(PIN_HEATER), 0.0f, 1.0f);
+  float target = g_env.ambientTemp + g_env.heaterRise * duty;
+  g_heaterTemp = target + (g_heaterTemp - target) * expf(-dt / g_env.heaterTau);
+}
+
+} // namespace
+
+namespace SimWorld {
+
+void begin(const Environment& environment) {
+  g_env = environment;
+  g_heaterTemp = g_env.ambientTemp;
+  g_lastUpdate = SimHal::clockMicros();
+}
+
+float ambientTemp() {
+  return g_env.ambientTemp;
+}
+
+float humidity() {
+  return g_env.humidity;
+}
+
+float heaterTemp() {
+  updateHeater();
+  return g_heaterTemp;
+}
+
+bool heaterSensorPresent() {
+  return g_env.heaterSensorPresent;
+}
+
+bool ambientSensorPresent() {
+  return g_env.ambientSensorPresent;
+}
+
+} // namespace SimWorld
@@ -0,0 +1,36 @@
+/*
+  sim_world.h - Linux simulator environment and heater thermal model
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  The heater element is a first-order lag towards ambient plus a rise
+  proportional to PWM duty on PIN_HEATER, integrated on the virtual clock.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef SIM_WORLD_H
+#define SIM_WORLD_H
+
+namespace SimWorld {
+
+struct Environment {
+  float ambientTemp = 5.0f;       // C
+  float humidity = 85.0f;         // %RH
+  float heaterRise = 30.0f;       // C above ambient at 100% duty
+  float heaterTau = 120.0f;       // s thermal time constant
+  bool heaterSensorPresent = true;
+  bool ambientSensorPresent = true;
+};
+
+void begin(const Environment& environment);
+
+float ambientTemp();
+float humidity();
+float heaterTemp();
+bool heaterSensorPresent();
+bool ambientSensorPresent();
+
+} // namespace SimWorld
+
+#endif // SIM_WORLD_H
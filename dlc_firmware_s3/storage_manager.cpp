@@ -9,11 +9,12 @@
 #include "storage_manager.h"
 #include "Debug.h"
 
-StorageManager storage;
+StorageManager deviceStorage[DEVICE_COUNT];
+StorageManager& storage = deviceStorage[0];
 
-void StorageManager::begin() {
-  _prefs.begin("dlc", false);
-  Debug::info("STORAGE", "NVS preferences initialized");
+void StorageManager::begin(const char* nvsNamespace) {
+  _prefs.begin(nvsNamespace, false);
+  Debug::infof("STORAGE", "NVS preferences initialized (%s)", nvsNamespace);
 }
 
 // --- Original firmware values ---
@@ -108,6 +109,14 @@ void StorageManager::saveServoRangeMax(uint16_t angle) {
   _prefs.putUShort(KEY_SERVO_RANGE_MAX, angle);
 }
 
+uint8_t StorageManager::loadEasing() {
+  return _prefs.getUChar(KEY_EASING, DEFAULT_EASING);
+}
+
+void StorageManager::saveEasing(uint8_t profile) {
+  _prefs.putUChar(KEY_EASING, profile);
+}
+
 // --- Light configuration ---
 
 uint16_t StorageManager::loadMaxBrightness() {
@@ -152,6 +161,32 @@ void StorageManager::saveShutoffTime(uint32_t ms) {
   _prefs.putULong(KEY_SHUTOFF_TIME, ms);
 }
 
+uint8_t StorageManager::loadHeatLaw() {
+  return _prefs.getUChar(KEY_HEAT_LAW, DEFAULT_HEAT_LAW);
+}
+
+void StorageManager::saveHeatLaw(uint8_t law) {
+  _prefs.putUChar(KEY_HEAT_LAW, law);
+}
+
+HeatTuning StorageManager::loadHeatTuning() {
+  HeatTuning tuning;
+  tuning.kp = _prefs.getFloat(KEY_HEAT_KP, DEFAULT_HEAT_KP);
+  tuning.ki = _prefs.getFloat(KEY_HEAT_KI, DEFAULT_HEAT_KI);
+  tuning.kd = _prefs.getFloat(KEY_HEAT_KD, DEFAULT_HEAT_KD);
+  tuning.modelRise = _prefs.getFloat(KEY_HEAT_RISE, DEFAULT_HEAT_MODEL_RISE);
+  tuning.modelTau = _prefs.getFloat(KEY_HEAT_TAU, DEFAULT_HEAT_MODEL_TAU);
+  return tuning;
+}
+
+void StorageManager::saveHeatTuning(const HeatTuning& tuning) {
+  _prefs.putFloat(KEY_HEAT_KP, tuning.kp);
+  _prefs.putFloat(KEY_HEAT_KI, tuning.ki);
+  _prefs.putFloat(KEY_HEAT_KD, tuning.kd);
+  _prefs.putFloat(KEY_HEAT_RISE, tuning.modelRise);
+  _prefs.putFloat(KEY_HEAT_TAU, tuning.modelTau);
+}
+
 // --- WiFi configuration ---
 
 String StorageManager::loadWifiSSID() {
@@ -2,6 +2,9 @@
   storage_manager.h - NVS Preferences wrapper replacing EEPROMWearLevel
   DarkLight Cover Calibrator - ESP32-S3 Port
 
+  One instance per DEVICES entry, each on its own NVS namespace. The
+  heater and WiFi settings live with device 0.
+
   (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
   Creative Commons Attribution-NonCommercial 4.0 International License
 */
@@ -15,7 +18,7 @@
 
 class StorageManager {
 public:
-  void begin();
+  void begin(const char* nvsNamespace);
 
   // Original firmware values
   uint8_t  loadCoverState();
@@ -45,6 +48,8 @@ public:
   void     saveServoRangeMin(uint16_t angle);
   uint16_t loadServoRangeMax();
   void     saveServoRangeMax(uint16_t angle);
+  uint8_t  loadEasing();
+  void     saveEasing(uint8_t profile);
 
   // Light configuration
   uint16_t loadMaxBrightness();
@@ -59,6 +64,10 @@ public:
   void    saveDeltaPoint(float value);
   uint32_t loadShutoffTime();
   void     saveShutoffTime(uint32_t ms);
+  uint8_t  loadHeatLaw();
+  void     saveHeatLaw(uint8_t law);
+  HeatTuning loadHeatTuning();
+  void       saveHeatTuning(const HeatTuning& tuning);
 
   // WiFi configuration
   String loadWifiSSID();
@@ -70,6 +79,7 @@ private:
   Preferences _prefs;
 };
 
-extern StorageManager storage;
+extern StorageManager deviceStorage[DEVICE_COUNT];
+extern StorageManager& storage;   // device 0
 
 #endif // STORAGE_MANAGER_H
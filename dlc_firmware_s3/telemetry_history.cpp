@@ -0,0 +1,190 @@
+/*
+  telemetry_history.cpp - Sensor and state history for a night's session
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#include "telemetry_history.h"
+
+#ifdef ENABLE_TELEMETRY_HISTORY
+
+#include "Debug.h"
+#include "device_state.h"
+
+static_assert(sizeof(HistorySample) == 14, "HistorySample is exported as-is");
+static_assert(sizeof(HistoryExportHeader) == 16, "HistoryExportHeader is exported as-is");
+static_assert(HISTORY_COARSE_INTERVAL % HISTORY_FINE_INTERVAL == 0, "a coarse sample is a whole number of fine ones");
+
+static const uint8_t HISTORY_AVERAGED = 4;  // fields of Accumulator::sums
+
+TelemetryHistory history;
+
+bool TelemetryHistory::begin() {
+  const uint16_t capacities[2] = {HISTORY_FINE_SAMPLES, HISTORY_COARSE_SAMPLES};
+  const uint32_t intervals[2] = {HISTORY_FINE_INTERVAL, HISTORY_COARSE_INTERVAL};
+
+  for (uint8_t r = 0; r < 2; r++) {
+    Ring& ring = _rings[r];
+    ring.samples = (HistorySample*)malloc(capacities[r] * sizeof(HistorySample));
+    if (!ring.samples) {
+      Debug::error("HISTORY", "Out of memory, history disabled");
+      free(_rings[0].samples);
+      _rings[0] = {};
+      return false;
+    }
+    ring.capacity = capacities[r];
+    ring.interval = intervals[r];
+  }
+
+  _tickStart = millis();
+  Debug::infof("HISTORY", "%u x %lu s and %u x %lu s samples (%u bytes)",
+               HISTORY_FINE_SAMPLES, (unsigned long)HISTORY_FINE_INTERVAL,
+               HISTORY_COARSE_SAMPLES, (unsigned long)HISTORY_COARSE_INTERVAL,
+               (unsigned)((HISTORY_FINE_SAMPLES + HISTORY_COARSE_SAMPLES) * sizeof(HistorySample)));
+  return true;
+}
+
+void TelemetryHistory::loop() {
+  if (!_rings[HISTORY_FINE].samples) return;
+
+  uint32_t intervalMillis = HISTORY_FINE_INTERVAL * 1000;
+  if (millis() - _tickStart < intervalMillis) return;
+
+  // One snapshot for every second that is due
+  HistorySample sample = capture();
+  while (millis() - _tickStart >= intervalMillis) {
+    _tickStart += intervalMillis;
+    _time += HISTORY_FINE_INTERVAL;
+    push(_rings[HISTORY_FINE], sample, _time);
+    accumulate(sample, _time);
+  }
+}
+
+const HistorySample& TelemetryHistory::getSample(HistoryResolution res, uint16_t index) const {
+  const Ring& ring = _rings[res];
+  uint16_t slot = (ring.head + ring.capacity - ring.count + index) % ring.capacity;
+  return ring.samples[slot];
+}
+
+uint32_t TelemetryHistory::getTime(HistoryResolution res, uint16_t index) const {
+  const Ring& ring = _rings[res];
+  return ring.newestTime - (uint32_t)(ring.count - 1 - index) * ring.interval;
+}
+
+uint16_t TelemetryHistory::firstAfter(HistoryResolution res, uint32_t since) const {
+  const Ring& ring = _rings[res];
+  if (ring.count == 0 || since >= ring.newestTime) return ring.count;
+
+  uint32_t newer = (ring.newestTime - since + ring.interval - 1) / ring.interval;
+  return newer >= ring.count ? 0 : ring.count - newer;
+}
+
+// ============================================================
+// CSV rows
+// ============================================================
+
+const char* TelemetryHistory::csvHeader() {
+  return "time,heaterTemp,heaterPWM,outsideTemp,humidity,dewPoint,heaterState,coverState,calibratorState,brightness";
+}
+
+// Hundredths as a decimal, or an empty string for HISTORY_NO_VALUE
+static void formatCenti(char* buffer, size_t size, int16_t value) {
+  if (value == HISTORY_NO_VALUE) {
+    buffer[0] = '\0';
+    return;
+  }
+  int32_t magnitude = value < 0 ? -(int32_t)value : value;
+  snprintf(buffer, size, "%s%ld.%02ld", value < 0 ? "-" : "", (long)(magnitude / 100), (long)(magnitude % 100));
+}
+
+size_t TelemetryHistory::formatRow(uint32_t time, const HistorySample& sample, char* buffer, size_t size) {
+  char heaterTemp[8], heaterPWM[4] = "", outsideTemp[8], humidity[8], dewPoint[8];
+  formatCenti(heaterTemp, sizeof(heaterTemp), sample.heaterTemp);
+  if (sample.heaterState != HEATER_NOT_PRESENT) snprintf(heaterPWM, sizeof(heaterPWM), "%u", sample.heaterPWM);
+  formatCenti(outsideTemp, sizeof(outsideTemp), sample.outsideTemp);
+  formatCenti(humidity, sizeof(humidity), sample.humidity);
+  formatCenti(dewPoint, sizeof(dewPoint), sample.dewPoint);
+
+  int length = snprintf(buffer, size, "%lu,%s,%s,%s,%s,%s,%u,%u,%u,%u", (unsigned long)time, heaterTemp,
+                        heaterPWM, outsideTemp, humidity, dewPoint, sample.heaterState,
+                        sample.coverState, sample.calibratorState, sample.brightness);
+  if (length < 0) return 0;
+  return (size_t)length < size ? (size_t)length : size - 1;
+}
+
+// ============================================================
+// Sampling
+// ============================================================
+
+#ifdef HEATER_INSTALLED
+  // Hundredths, clamped to the int16 range; NAN is HISTORY_NO_VALUE
+  static int16_t toCenti(float value) {
+    if (isnan(value)) return HISTORY_NO_VALUE;
+    float centi = roundf(value * 100.0f);
+    if (centi < -32767.0f) return -32767;
+    if (centi > 32767.0f) return 32767;
+    return (int16_t)centi;
+  }
+#endif
+
+HistorySample TelemetryHistory::capture() {
+  DeviceSnapshot snapshot = deviceState.read();
+  const CoverCalibratorSnapshot& device = snapshot.devices[0];
+
+  HistorySample sample;
+  #ifdef HEATER_INSTALLED
+    sample.heaterTemp = toCenti(snapshot.heater.heaterTemp);
+    sample.outsideTemp = toCenti(snapshot.heater.outsideTemp);
+    sample.humidity = toCenti(snapshot.heater.humidity);
+    sample.dewPoint = toCenti(snapshot.heater.dewPoint);
+  #else
+    // No heater and no sensors: the snapshot's zeros are not readings
+    sample.heaterTemp = HISTORY_NO_VALUE;
+    sample.outsideTemp = HISTORY_NO_VALUE;
+    sample.humidity = HISTORY_NO_VALUE;
+    sample.dewPoint = HISTORY_NO_VALUE;
+  #endif
+  sample.brightness = device.brightness;
+  sample.heaterPWM = snapshot.heater.heaterPWM;
+  sample.heaterState = snapshot.heaterState;
+  sample.coverState = device.coverState;
+  sample.calibratorState = device.calibratorState;
+  return sample;
+}
+
+void TelemetryHistory::push(Ring& ring, const HistorySample& sample, uint32_t time) {
+  ring.samples[ring.head] = sample;
+  ring.head = (ring.head + 1) % ring.capacity;
+  if (ring.count < ring.capacity) ring.count++;
+  ring.newestTime = time;
+}
+
+void TelemetryHistory::accumulate(const HistorySample& sample, uint32_t time) {
+  const int16_t values[HISTORY_AVERAGED] = {sample.heaterTemp, sample.outsideTemp, sample.humidity, sample.dewPoint};
+  for (uint8_t i = 0; i < HISTORY_AVERAGED; i++) {
+    if (values[i] == HISTORY_NO_VALUE) continue;
+    _minute.sums[i] += values[i];
+    _minute.valid[i]++;
+  }
+  _minute.pwmSum += sample.heaterPWM;
+  _minute.samples++;
+
+  if (_minute.samples < HISTORY_COARSE_INTERVAL / HISTORY_FINE_INTERVAL) return;
+
+  // States and brightness as they were at the end of the minute
+  HistorySample coarse = sample;
+  int16_t* averages[HISTORY_AVERAGED] = {&coarse.heaterTemp, &coarse.outsideTemp, &coarse.humidity, &coarse.dewPoint};
+  for (uint8_t i = 0; i < HISTORY_AVERAGED; i++) {
+    int32_t valid = _minute.valid[i];
+    *averages[i] = valid == 0 ? HISTORY_NO_VALUE
+                              : (int16_t)((_minute.sums[i] + (_minute.sums[i] < 0 ? -valid : valid) / 2) / valid);
+  }
+  coarse.heaterPWM = (uint8_t)((_minute.pwmSum + _minute.samples / 2) / _minute.samples);
+
+  push(_rings[HISTORY_COARSE], coarse, time);
+  _minute = {};
+}
+
+#endif // ENABLE_TELEMETRY_HISTORY
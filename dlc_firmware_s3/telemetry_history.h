@@ -0,0 +1,116 @@
+/*
+  telemetry_history.h - Sensor and state history for a night's session
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  Samples the device state once a second into two rings: HISTORY_FINE_SAMPLES
+  one-second samples (the last hour) and HISTORY_COARSE_SAMPLES one-minute
+  samples (the last day). A coarse sample averages the temperatures,
+  humidity, dew point and heater PWM of its minute and keeps the states and
+  brightness of its last second. Times are seconds since begin() and are
+  not stored: a sample's time follows from its place in the ring, and a
+  loop() stall is filled in with the state found afterwards.
+
+  Read with <X> over serial or GET /api/history (on the events server,
+  WEB_EVENTS_PORT). Written and read on the loop() task only.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef TELEMETRY_HISTORY_H
+#define TELEMETRY_HISTORY_H
+
+#include <Arduino.h>
+#include "config.h"
+
+#ifdef ENABLE_TELEMETRY_HISTORY
+
+enum HistoryResolution : uint8_t {
+  HISTORY_FINE   = 0,
+  HISTORY_COARSE = 1
+};
+
+const int16_t HISTORY_NO_VALUE = INT16_MIN;  // sensor absent or read failed
+
+// Device 0 and the heater; temperatures, humidity and dew point in 0.01 units,
+// HISTORY_NO_VALUE without a heater. heaterPWM is 0 when heaterState is
+// HEATER_NOT_PRESENT and the CSV leaves it empty.
+struct HistorySample {
+  int16_t heaterTemp;
+  int16_t outsideTemp;
+  int16_t humidity;
+  int16_t dewPoint;
+  uint16_t brightness;
+  uint8_t heaterPWM;
+  uint8_t heaterState;
+  uint8_t coverState;
+  uint8_t calibratorState;
+};
+
+// Header of the binary export, followed by count HistorySamples, oldest
+// first; all little-endian
+struct HistoryExportHeader {
+  char magic[4];           // "DLCH"
+  uint8_t version;
+  uint8_t sampleSize;      // sizeof(HistorySample)
+  uint16_t interval;       // s between samples
+  uint32_t count;
+  uint32_t newestTime;     // s since begin() of the last sample
+};
+
+class TelemetryHistory {
+public:
+  // False (and no history) if the rings cannot be allocated
+  bool begin();
+  void loop();
+
+  uint16_t getCount(HistoryResolution res) const      { return _rings[res].count; }
+  uint32_t getInterval(HistoryResolution res) const   { return _rings[res].interval; }
+  uint32_t getNewestTime(HistoryResolution res) const { return _rings[res].newestTime; }
+  uint32_t getUptime() const                          { return _time; }  // s since begin()
+
+  // Index 0 is the oldest sample
+  const HistorySample& getSample(HistoryResolution res, uint16_t index) const;
+  uint32_t getTime(HistoryResolution res, uint16_t index) const;
+
+  // Index of the first sample later than since (getCount() if none)
+  uint16_t firstAfter(HistoryResolution res, uint32_t since) const;
+
+  // time,heaterTemp,heaterPWM,outsideTemp,humidity,dewPoint,heaterState,
+  // coverState,calibratorState,brightness without a line end; a missing
+  // value (heaterPWM without a heater) is an empty field. Returns the length.
+  static size_t formatRow(uint32_t time, const HistorySample& sample, char* buffer, size_t size);
+  static const char* csvHeader();
+
+private:
+  struct Ring {
+    HistorySample* samples;
+    uint16_t capacity;
+    uint16_t head;           // next slot written
+    uint16_t count;
+    uint32_t interval;
+    uint32_t newestTime;
+  };
+
+  // Coarse sample being built
+  struct Accumulator {
+    int32_t sums[4];         // heaterTemp, outsideTemp, humidity, dewPoint
+    uint8_t valid[4];
+    uint32_t pwmSum;
+    uint8_t samples;
+  };
+
+  Ring _rings[2] = {};
+  Accumulator _minute = {};
+  uint32_t _time = 0;        // s since begin(), the last fine sample's
+  uint32_t _tickStart = 0;   // millis() of that second
+
+  void push(Ring& ring, const HistorySample& sample, uint32_t time);
+  void accumulate(const HistorySample& sample, uint32_t time);
+  static HistorySample capture();
+};
+
+extern TelemetryHistory history;
+
+#endif // ENABLE_TELEMETRY_HISTORY
+#endif // TELEMETRY_HISTORY_H
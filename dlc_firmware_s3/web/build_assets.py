@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+"""
+build_assets.py - Generates web_assets.h from the files in web/
+DarkLight Cover Calibrator - ESP32-S3 Port
+
+Each asset is gzipped (level 9, no timestamp, so the output only changes
+when the source does) into a flash-resident byte array with a strong ETag
+taken from the uncompressed content. The Arduino IDE has no pre-build
+step, so web_assets.h is committed; run this after editing anything in
+web/. --check exits non-zero if web_assets.h is out of date: it unpacks
+each array and compares the content, ETag and asset table against the
+sources, so a different zlib producing other gzip bytes still passes.
+
+(c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+Creative Commons Attribution-NonCommercial 4.0 International License
+"""
+
+import argparse
+import gzip
+import hashlib
+import os
+import re
+import sys
+
+WEB_DIR = os.path.dirname(os.path.abspath(__file__))
+OUTPUT = os.path.join(WEB_DIR, "..", "web_assets.h")
+
+# (URL path, source file, Content-Type)
+ASSETS = [
+    ("/", "dashboard.html", "text/html"),
+    ("/setup", "setup.html", "text/html"),
+    ("/style.css", "style.css", "text/css"),
+    ("/dashboard.js", "dashboard.js", "application/javascript"),
+    ("/setup.js", "setup.js", "application/javascript"),
+]
+
+HEADER = """/*
+  web_assets.h - Gzipped web dashboard and setup assets
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  GENERATED by web/build_assets.py from the files in web/ - do not edit.
+  Served as-is with Content-Encoding: gzip; the ETag is a hash of the
+  uncompressed file.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+
+#include <Arduino.h>
+
+struct WebAsset {
+  const char* path;
+  const char* contentType;
+  const uint8_t* data;    // gzip, in flash
+  size_t length;
+  const char* etag;       // quoted, strong
+};
+"""
+
+
+def array_name(filename):
+    return "WEB_" + filename.replace(".", "_").upper()
+
+
+def asset_etag(raw):
+    return '"' + hashlib.sha256(raw).hexdigest()[:16] + '"'
+
+
+def generate():
+    out = [HEADER]
+    table = []
+    total_raw = 0
+    total_gz = 0
+
+    for path, filename, content_type in ASSETS:
+        with open(os.path.join(WEB_DIR, filename), "rb") as f:
+            raw = f.read()
+        packed = gzip.compress(raw, compresslevel=9, mtime=0)
+        etag = asset_etag(raw)
+        name = array_name(filename)
+        total_raw += len(raw)
+        total_gz += len(packed)
+
+        out.append("// %s: %d bytes, %d gzipped" % (filename, len(raw), len(packed)))
+        out.append("static const uint8_t %s[] PROGMEM = {" % name)
+        for i in range(0, len(packed), 16):
+            out.append("  " + ", ".join("0x%02x" % b for b in packed[i:i + 16]) + ",")
+        out.append("};")
+        out.append("")
+        table.append('  {"%s", "%s", %s, sizeof(%s), "%s"},'
+                     % (path, content_type, name, name, etag.replace('"', '\\"')))
+
+    out.append("// %d bytes, %d gzipped" % (total_raw, total_gz))
+    out.append("static const WebAsset WEB_ASSETS[] = {")
+    out.extend(table)
+    out.append("};")
+    out.append("")
+    out.append("static const size_t WEB_ASSET_COUNT = sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]);")
+    out.append("")
+    out.append("#endif // WEB_ASSETS_H")
+    return "\n".join(out) + "\n"
+
+
+def check(current):
+    """List of the ways current (web_assets.h) differs from the sources"""
+    problems = []
+    arrays = dict(re.findall(r"static const uint8_t (\w+)\[\] PROGMEM = \{([^}]*)\};", current))
+    table = re.findall(r'\{"([^"]*)", "([^"]*)", (\w+), sizeof\(\w+\), "((?:[^"\\]|\\.)*)"\},', current)
+
+    expected = [(path, content_type, array_name(filename)) for path, filename, content_type in ASSETS]
+    if [entry[:3] for entry in table] != expected:
+        problems.append("asset table does not match ASSETS")
+
+    etags = {entry[2]: entry[3].replace('\\"', '"') for entry in table}
+    for path, filename, content_type in ASSETS:
+        with open(os.path.join(WEB_DIR, filename), "rb") as f:
+            raw = f.read()
+        name = array_name(filename)
+        if name not in arrays:
+            problems.append("%s: no %s array" % (filename, name))
+            continue
+        try:
+            packed = bytes(int(b, 16) for b in re.findall(r"0x([0-9a-f]{2})", arrays[name]))
+            unpacked = gzip.decompress(packed)
+        except (OSError, EOFError, ValueError):
+            problems.append("%s: %s is not valid gzip" % (filename, name))
+            continue
+        if unpacked != raw:
+            problems.append("%s: content differs" % filename)
+        if etags.get(name) != asset_etag(raw):
+            problems.append("%s: ETag differs" % filename)
+    return problems
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate web_assets.h from web/")
+    parser.add_argument("--check", action="store_true", help="fail if web_assets.h is out of date")
+    args = parser.parse_args()
+
+    generated = generate()
+    current = None
+    if os.path.exists(OUTPUT):
+        with open(OUTPUT, "r") as f:
+            current = f.read()
+
+    if args.check:
+        problems = check(current) if current is not None else ["web_assets.h is missing"]
+        for problem in problems:
+            print(problem, file=sys.stderr)
+        if problems:
+            print("web_assets.h is out of date, run web/build_assets.py", file=sys.stderr)
+            return 1
+        return 0
+
+    if generated != current:
+        with open(OUTPUT, "w") as f:
+            f.write(generated)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,102 @@
+const coverStates = ['Not Present','Closed','Moving','Open','Unknown','Error'];
+const calStates = ['Not Present','Off','Not Ready','Ready','Unknown','Error'];
+const heatStates = ['Not Present','Off','Auto','On','Unknown','Error','Set'];
+const coverColors = ['ind-gray','ind-green','ind-yellow','ind-green','ind-yellow','ind-red'];
+const calColors = ['ind-gray','ind-gray','ind-yellow','ind-green','ind-yellow','ind-red'];
+const heatColors = ['ind-gray','ind-gray','ind-blue','ind-green','ind-yellow','ind-red','ind-blue'];
+
+// Last known value of every /api/status field; stream events only carry the changed ones
+var live = {};
+var polling = null;
+
+function updateStatus() {
+  fetch('/api/status').then(r=>r.json()).then(d=>{
+    Object.assign(live, d);
+    render(live);
+  }).catch(e=>{});
+}
+
+function render(d) {
+  document.getElementById('coverState').textContent = coverStates[d.coverState] || '?';
+  document.getElementById('coverInd').className = 'indicator ' + (coverColors[d.coverState]||'ind-gray');
+  document.getElementById('calState').textContent = calStates[d.calState] || '?';
+  document.getElementById('calInd').className = 'indicator ' + (calColors[d.calState]||'ind-gray');
+  document.getElementById('brightness').textContent = d.brightness;
+  document.getElementById('maxBright').textContent = d.maxBrightness;
+  document.getElementById('brightSlider').max = d.maxBrightness;
+  document.getElementById('heatState').textContent = heatStates[d.heaterState] || '?';
+  document.getElementById('heatInd').className = 'indicator ' + (heatColors[d.heaterState]||'ind-gray');
+  document.getElementById('heatTemp').textContent = d.heaterTemp!=null?d.heaterTemp.toFixed(1):'--';
+  document.getElementById('outTemp').textContent = d.outsideTemp!=null?d.outsideTemp.toFixed(1):'--';
+  document.getElementById('humidity').textContent = d.humidity!=null?d.humidity.toFixed(1):'--';
+  document.getElementById('dewPoint').textContent = d.dewPoint!=null?d.dewPoint.toFixed(1):'--';
+  document.getElementById('heatPWM').textContent = d.heaterPWM!=null?d.heaterPWM:'--';
+  document.getElementById('fwVersion').textContent = d.version || '--';
+
+  // Disable controls when device not present (state 0)
+  setControlsEnabled('coverControls', d.coverState !== 0);
+  setControlsEnabled('calControls', d.calState !== 0);
+  setControlsEnabled('calSlider', d.calState !== 0);
+  setControlsEnabled('heaterControls', d.heaterState !== 0);
+}
+
+// The device pushes state changes over Server-Sent Events on the next port
+// up. Polling only runs while the stream is down or refused.
+function startPolling() {
+  if (polling) return;
+  polling = setInterval(updateStatus, 2000);
+  updateStatus();
+}
+
+function stopPolling() {
+  clearInterval(polling);
+  polling = null;
+}
+
+function connectEvents() {
+  if (!window.EventSource) { startPolling(); return; }
+  var port = (parseInt(location.port) || 80) + 1;
+  var es = new EventSource(location.protocol + '//' + location.hostname + ':' + port + '/events');
+  es.onopen = stopPolling;
+  es.onmessage = function(e) {
+    Object.assign(live, JSON.parse(e.data));
+    render(live);
+  };
+  es.onerror = function() {
+    startPolling();
+    // Closed means refused (all streams taken): try again later. Otherwise EventSource reconnects itself.
+    if (es.readyState === EventSource.CLOSED) setTimeout(connectEvents, 30000);
+  };
+}
+
+// A command's result arrives as an event; without the stream, fetch it shortly after
+function afterCmd() {
+  if (polling) setTimeout(updateStatus,300);
+}
+
+function setControlsEnabled(containerId, enabled) {
+  var el = document.getElementById(containerId);
+  if (!el) return;
+  var btns = el.querySelectorAll('button');
+  var inputs = el.querySelectorAll('input');
+  for (var i = 0; i < btns.length; i++) btns[i].disabled = !enabled;
+  for (var i = 0; i < inputs.length; i++) inputs[i].disabled = !enabled;
+  el.style.opacity = enabled ? '1' : '0.4';
+}
+
+function sendCmd(cmd) {
+  fetch('/api/cmd?action='+cmd, {method:'POST'}).then(afterCmd);
+}
+
+function setBrightness() {
+  var v = document.getElementById('brightSlider').value;
+  fetch('/api/cmd?action=lighton&brightness='+v, {method:'POST'}).then(afterCmd);
+}
+
+function lightOn() {
+  var v = document.getElementById('brightSlider').value;
+  if (v == 0) v = document.getElementById('maxBright').textContent;
+  fetch('/api/cmd?action=lighton&brightness='+v, {method:'POST'}).then(afterCmd);
+}
+
+connectEvents();
@@ -0,0 +1,154 @@
+function showMsg(id, ok, text) {
+  var el = document.getElementById(id);
+  el.textContent = text;
+  el.className = 'msg ' + (ok ? 'msg-ok' : 'msg-err');
+  el.style.display = 'block';
+  setTimeout(function(){ el.style.display='none'; }, 3000);
+}
+
+function loadSettings() {
+  fetch('/api/settings').then(r=>r.json()).then(d=>{
+    document.getElementById('wifiSSID').value = d.wifiSSID || '';
+    document.getElementById('servoOpen').value = d.servoOpen;
+    document.getElementById('servoClose').value = d.servoClose;
+    document.getElementById('servoMinPW').value = d.servoMinPW;
+    document.getElementById('servoMaxPW').value = d.servoMaxPW;
+    document.getElementById('moveTime').value = d.moveTime;
+    document.getElementById('easing').value = d.easing;
+    document.getElementById('rangeMin').value = d.rangeMin;
+    document.getElementById('rangeMax').value = d.rangeMax;
+    document.getElementById('servoPos').textContent = d.servoPos;
+    document.getElementById('openAngleDisp').textContent = d.servoOpen;
+    document.getElementById('closeAngleDisp').textContent = d.servoClose;
+    document.getElementById('maxBright').value = d.maxBright;
+    document.getElementById('stabTime').value = d.stabTime;
+    document.getElementById('deltaPoint').value = d.deltaPoint;
+    document.getElementById('shutoffMin').value = Math.round(d.shutoffTime / 60000);
+    if (d.heatLaw !== undefined) {
+      document.getElementById('heatLaw').value = d.heatLaw;
+      document.getElementById('heatKp').value = +d.kp.toFixed(2);
+      document.getElementById('heatKi').value = +d.ki.toFixed(4);
+      document.getElementById('heatKd').value = +d.kd.toFixed(1);
+      document.getElementById('modelRise').value = +d.modelRise.toFixed(1);
+      document.getElementById('modelTau').value = Math.round(d.modelTau);
+    }
+  });
+}
+
+function nudge(dir) {
+  fetch('/api/servo/nudge?dir='+dir, {method:'POST'}).then(r=>r.json()).then(d=>{
+    if (d.ok) {
+      document.getElementById('servoPos').textContent = d.pos;
+      document.getElementById('openAngleDisp').textContent = d.open;
+      document.getElementById('closeAngleDisp').textContent = d.close;
+    }
+  }).catch(()=>{});
+}
+
+function setAsOpen() {
+  fetch('/api/servo/setopen', {method:'POST'}).then(r=>r.json()).then(d=>{
+    if (d.ok) {
+      document.getElementById('openAngleDisp').textContent = d.open;
+      document.getElementById('servoOpen').value = d.open;
+      showMsg('posMsg', true, 'Open angle set to ' + d.open + '\u00B0');
+    }
+  }).catch(()=>showMsg('posMsg', false, 'Request failed'));
+}
+
+function setAsClose() {
+  fetch('/api/servo/setclose', {method:'POST'}).then(r=>r.json()).then(d=>{
+    if (d.ok) {
+      document.getElementById('closeAngleDisp').textContent = d.close;
+      document.getElementById('servoClose').value = d.close;
+      showMsg('posMsg', true, 'Close angle set to ' + d.close + '\u00B0');
+    }
+  }).catch(()=>showMsg('posMsg', false, 'Request failed'));
+}
+
+function postSettings(endpoint, data, msgId) {
+  fetch('/api/' + endpoint, {
+    method: 'POST',
+    headers: {'Content-Type':'application/x-www-form-urlencoded'},
+    body: Object.entries(data).map(([k,v])=>k+'='+encodeURIComponent(v)).join('&')
+  }).then(r=>r.json()).then(d=>{
+    showMsg(msgId, d.ok, d.ok ? 'Saved!' : (d.error||'Error'));
+  }).catch(()=>showMsg(msgId, false, 'Request failed'));
+}
+
+function saveWifi() {
+  postSettings('wifi', {
+    ssid: document.getElementById('wifiSSID').value,
+    pass: document.getElementById('wifiPass').value
+  }, 'wifiMsg');
+}
+
+function saveServo() {
+  postSettings('servo', {
+    open: document.getElementById('servoOpen').value,
+    close: document.getElementById('servoClose').value,
+    minpw: document.getElementById('servoMinPW').value,
+    maxpw: document.getElementById('servoMaxPW').value,
+    movetime: document.getElementById('moveTime').value,
+    easing: document.getElementById('easing').value,
+    rangemin: document.getElementById('rangeMin').value,
+    rangemax: document.getElementById('rangeMax').value
+  }, 'servoMsg');
+}
+
+function saveLight() {
+  postSettings('light', {
+    maxbright: document.getElementById('maxBright').value,
+    stabtime: document.getElementById('stabTime').value
+  }, 'lightMsg');
+}
+
+function saveHeater() {
+  postSettings('heater', {
+    delta: document.getElementById('deltaPoint').value,
+    shutoff: parseInt(document.getElementById('shutoffMin').value) * 60000,
+    law: document.getElementById('heatLaw').value,
+    kp: document.getElementById('heatKp').value,
+    ki: document.getElementById('heatKi').value,
+    kd: document.getElementById('heatKd').value,
+    rise: document.getElementById('modelRise').value,
+    tau: document.getElementById('modelTau').value
+  }, 'heaterMsg');
+}
+
+// The heater oscillates around its target for a few minutes; the new
+// gains are saved and shown when it finishes
+function startAutotune() {
+  fetch('/api/cmd?action=autotune', {method:'POST'}).then(()=>{
+    showMsg('heaterMsg', true, 'Autotune running...');
+    var poll = setInterval(function(){
+      fetch('/api/settings').then(r=>r.json()).then(d=>{
+        if (d.autotune === 1) return;
+        clearInterval(poll);
+        if (d.autotune === 2) loadSettings();
+        showMsg('heaterMsg', d.autotune === 2, d.autotune === 2 ? 'Autotune done' : 'Autotune failed');
+      }).catch(()=>{});
+    }, 5000);
+  }).catch(()=>showMsg('heaterMsg', false, 'Request failed'));
+}
+
+function setCardEnabled(cardId, enabled) {
+  var el = document.getElementById(cardId);
+  if (!el) return;
+  var btns = el.querySelectorAll('button');
+  var inputs = el.querySelectorAll('input, select');
+  for (var i = 0; i < btns.length; i++) btns[i].disabled = !enabled;
+  for (var i = 0; i < inputs.length; i++) inputs[i].disabled = !enabled;
+  el.style.opacity = enabled ? '1' : '0.4';
+}
+
+function checkDevicePresence() {
+  fetch('/api/status').then(r=>r.json()).then(d=>{
+    setCardEnabled('servoPosCard', d.coverState !== 0);
+    setCardEnabled('servoConfigCard', d.coverState !== 0);
+    setCardEnabled('lightCard', d.calState !== 0);
+    setCardEnabled('heaterCard', d.heaterState !== 0);
+  }).catch(()=>{});
+}
+
+loadSettings();
+checkDevicePresence();
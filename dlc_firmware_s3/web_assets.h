@@ -0,0 +1,460 @@
+/*
+  web_assets.h - Gzipped web dashboard and setup assets
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  GENERATED by web/build_assets.py from the files in web/ - do not edit.
+  Served as-is with Content-Encoding: gzip; the ETag is a hash of the
+  uncompressed file.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+
+#include <Arduino.h>
+
+struct WebAsset {
+  const char* path;
+  const char* contentType;
+  const uint8_t* data;    // gzip, in flash
+  size_t length;
+  const char* etag;       // quoted, strong
+};
+
+// dashboard.html: 3855 bytes, 906 gzipped
+static const uint8_t WEB_DASHBOARD_HTML[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xcd, 0x57, 0x51, 0x6f, 0xdb, 0x36,
+  0x10, 0x7e, 0xcf, 0xaf, 0xe0, 0x08, 0x6c, 0x69, 0x80, 0xc9, 0x4e, 0x03, 0x14, 0x28, 0x36, 0xc9,
+  0xc0, 0xea, 0x74, 0x48, 0x81, 0x16, 0x0e, 0xb0, 0xb4, 0xc3, 0x1e, 0xcf, 0x24, 0x6d, 0x71, 0xa1,
+  0x48, 0x81, 0x3c, 0xd9, 0xf1, 0xbf, 0xdf, 0x91, 0xb2, 0x6c, 0xc5, 0x73, 0x37, 0x57, 0x69, 0x83,
+  0x3e, 0x51, 0x24, 0xbf, 0xfb, 0xee, 0xe3, 0xe9, 0x78, 0x24, 0xf3, 0x1f, 0xae, 0x67, 0xd3, 0xbb,
+  0xbf, 0x6e, 0xdf, 0xb2, 0x12, 0x2b, 0x33, 0x39, 0xcb, 0x53, 0x93, 0x97, 0x0a, 0x24, 0x75, 0x2a,
+  0x85, 0xc0, 0x44, 0x09, 0x3e, 0x28, 0x2c, 0xf8, 0xc7, 0xbb, 0xdf, 0xb3, 0xd7, 0xbc, 0x1b, 0xb6,
+  0x50, 0xa9, 0x82, 0xaf, 0xb4, 0x5a, 0xd7, 0xce, 0x23, 0x67, 0xc2, 0x59, 0x54, 0x96, 0x60, 0x6b,
+  0x2d, 0xb1, 0x2c, 0xa4, 0x5a, 0x69, 0xa1, 0xb2, 0xd4, 0xf9, 0x99, 0x69, 0xab, 0x51, 0x83, 0xc9,
+  0x82, 0x00, 0xa3, 0x8a, 0x97, 0xa3, 0xcb, 0x48, 0x83, 0x1a, 0x8d, 0x9a, 0x5c, 0x83, 0xbf, 0x7f,
+  0xaf, 0x97, 0x25, 0xb2, 0xa9, 0x5b, 0x29, 0x3f, 0x05, 0xa3, 0xe7, 0x1e, 0xd0, 0xf9, 0x7c, 0xdc,
+  0x02, 0xce, 0x72, 0xa3, 0xed, 0x3d, 0xf3, 0xca, 0x14, 0x3c, 0xe0, 0xc6, 0xa8, 0x50, 0x2a, 0x45,
+  0x0e, 0x4b, 0xaf, 0x16, 0x05, 0x1f, 0xa7, 0xa1, 0x91, 0x08, 0x21, 0x52, 0x8e, 0x93, 0xf0, 0x7c,
+  0xee, 0xe4, 0x86, 0x7a, 0x52, 0xaf, 0x98, 0x30, 0x10, 0x42, 0xc1, 0xa3, 0x3a, 0xd0, 0x56, 0x79,
+  0x42, 0x31, 0x96, 0x97, 0x2f, 0x0f, 0xfd, 0xb2, 0xbe, 0x63, 0x9a, 0x8e, 0xa8, 0x9e, 0xbd, 0x85,
+  0x55, 0xb2, 0xa4, 0x51, 0xe8, 0x3c, 0xf3, 0x6e, 0x12, 0x04, 0xea, 0x95, 0xe2, 0x44, 0x19, 0xca,
+  0xb9, 0x03, 0x2f, 0xf3, 0x31, 0x1c, 0x82, 0x29, 0x82, 0x4d, 0xcd, 0x27, 0x7f, 0xc4, 0xe6, 0xc8,
+  0x74, 0x53, 0x4b, 0x40, 0xa2, 0xf8, 0x98, 0xda, 0x2d, 0x20, 0x1f, 0x93, 0x82, 0xc9, 0xd9, 0x81,
+  0x14, 0x41, 0x0e, 0x3a, 0x2d, 0xe5, 0xd5, 0x24, 0xa9, 0x27, 0xc9, 0x57, 0xdb, 0xa1, 0x1e, 0x32,
+  0x20, 0x60, 0x13, 0xb2, 0xa5, 0xd7, 0x9d, 0xc1, 0xd1, 0x79, 0x8d, 0xaa, 0xda, 0xcd, 0x13, 0x22,
+  0xd4, 0x60, 0x0f, 0x20, 0x06, 0xe6, 0xca, 0x90, 0x7a, 0x4c, 0xe2, 0x22, 0xe0, 0xbf, 0xf1, 0x2b,
+  0x30, 0x0d, 0xad, 0xa6, 0x9d, 0xd2, 0x32, 0xc6, 0x9f, 0x54, 0xbe, 0xb3, 0x72, 0x17, 0x33, 0x6d,
+  0xa5, 0x16, 0x31, 0xda, 0x94, 0x1b, 0x92, 0x24, 0xc2, 0x86, 0xe0, 0x2d, 0xf3, 0x81, 0x55, 0x72,
+  0xca, 0x27, 0x59, 0xd6, 0x4d, 0x3f, 0xf2, 0xbf, 0x8d, 0xd1, 0xe1, 0x67, 0x5c, 0xe5, 0x8e, 0x61,
+  0x4a, 0x3f, 0xdf, 0x3b, 0x13, 0x76, 0xce, 0xe7, 0x68, 0xc9, 0xa5, 0x8b, 0x3f, 0xa4, 0xa3, 0x99,
+  0x37, 0x88, 0xce, 0xf6, 0x00, 0x2c, 0x82, 0x42, 0x23, 0x84, 0xa2, 0xd4, 0x62, 0xce, 0x0a, 0xa3,
+  0xc5, 0x3d, 0x2d, 0x50, 0x59, 0x39, 0xad, 0xe4, 0x8b, 0x73, 0x57, 0x2b, 0x9b, 0xd8, 0xcf, 0x2f,
+  0xf8, 0x64, 0x46, 0x9d, 0x7c, 0xdc, 0x72, 0xfc, 0x0f, 0x65, 0xed, 0x75, 0x05, 0x7e, 0x73, 0x8c,
+  0x52, 0x18, 0x17, 0xd4, 0x8e, 0x73, 0x1a, 0x7b, 0x27, 0x92, 0x4a, 0xb0, 0x4b, 0xca, 0xed, 0x23,
+  0x9c, 0x25, 0x18, 0xdc, 0x51, 0xde, 0x50, 0xe7, 0x31, 0xe3, 0x2e, 0x66, 0xa7, 0xe5, 0x5a, 0x7f,
+  0x8f, 0x7c, 0xe7, 0x09, 0x07, 0xe6, 0xcb, 0xd3, 0x0d, 0xcc, 0xc9, 0xc9, 0xf6, 0xc4, 0x85, 0xbd,
+  0xf1, 0xb1, 0xf4, 0x58, 0xca, 0xad, 0x41, 0xab, 0x9b, 0xef, 0xcc, 0x7b, 0x5a, 0xd9, 0x98, 0xed,
+  0x11, 0x15, 0x3c, 0xb4, 0x3e, 0x06, 0xef, 0x1c, 0x0a, 0x86, 0xd1, 0x32, 0x66, 0x55, 0x27, 0x26,
+  0x75, 0xb3, 0x7d, 0x29, 0x65, 0xa9, 0xf6, 0x46, 0x5f, 0x7e, 0xa9, 0x6d, 0x86, 0xae, 0xfe, 0xe5,
+  0x75, 0xfd, 0xb0, 0xff, 0xf3, 0xda, 0xd6, 0x0d, 0x32, 0xdc, 0xd4, 0x84, 0xf1, 0x31, 0x43, 0x79,
+  0x4f, 0x7c, 0x47, 0x5e, 0x69, 0x5b, 0xf0, 0x4b, 0x6a, 0xe1, 0xa1, 0xe0, 0x57, 0xaf, 0x5e, 0x71,
+  0x96, 0x56, 0x9b, 0xc6, 0x9c, 0x4d, 0x14, 0x05, 0x97, 0x4e, 0x34, 0x15, 0x9d, 0x2e, 0xa3, 0xa5,
+  0xc2, 0xb7, 0x46, 0xc5, 0xcf, 0x37, 0x9b, 0x77, 0x94, 0xde, 0x2d, 0xd7, 0x27, 0x30, 0xe7, 0x17,
+  0x23, 0x54, 0x0f, 0x38, 0xdd, 0x9e, 0x42, 0x58, 0xea, 0x30, 0xda, 0x86, 0xed, 0xec, 0x58, 0x60,
+  0xdb, 0xb5, 0xb4, 0x88, 0x9e, 0x2a, 0x62, 0xe2, 0x93, 0xcb, 0x83, 0x40, 0x1d, 0xdf, 0x73, 0xda,
+  0x2e, 0xdc, 0xa3, 0x1d, 0x87, 0xfb, 0x9f, 0xfa, 0xe2, 0x22, 0x95, 0xfa, 0xcf, 0xec, 0xb5, 0xc7,
+  0x51, 0xfe, 0x9a, 0xd5, 0xc9, 0x44, 0x01, 0x33, 0x1b, 0xdd, 0xb7, 0x67, 0xdb, 0xcc, 0x3e, 0xb9,
+  0x82, 0x24, 0x4e, 0xb7, 0x58, 0x9c, 0xef, 0x49, 0x17, 0x8b, 0xa7, 0x54, 0x91, 0x1b, 0x45, 0x7b,
+  0xec, 0xfb, 0xaf, 0x20, 0x74, 0x95, 0xc0, 0x2f, 0x2e, 0x21, 0xd1, 0xe8, 0xb9, 0x6a, 0x48, 0x1b,
+  0x47, 0x76, 0xa7, 0xaa, 0x7a, 0xf0, 0x02, 0xa3, 0x71, 0x4f, 0xea, 0x4f, 0x52, 0x2d, 0x7f, 0x9d,
+  0x7e, 0x2b, 0xc1, 0xb3, 0x06, 0x03, 0x6d, 0xbb, 0xe1, 0x8a, 0x5d, 0xf3, 0xbc, 0x82, 0x6f, 0x9a,
+  0x4a, 0x4b, 0x8d, 0x9b, 0x61, 0xe1, 0xdd, 0x1a, 0xf7, 0xd4, 0xfe, 0xf8, 0xad, 0x84, 0x5e, 0xab,
+  0x35, 0xbb, 0x75, 0xda, 0xe2, 0x20, 0xa5, 0x52, 0xad, 0x93, 0xf1, 0xf3, 0xc5, 0xb5, 0xcd, 0xdc,
+  0xdb, 0x3f, 0x3f, 0x0c, 0x4e, 0x5c, 0xb2, 0x1d, 0x7a, 0xb2, 0x95, 0xc9, 0xfb, 0xf0, 0xb2, 0xfb,
+  0xaf, 0xc2, 0xbf, 0x2d, 0x94, 0xd0, 0xa0, 0x8b, 0xdc, 0xb1, 0x50, 0xfe, 0x46, 0xdf, 0x27, 0x56,
+  0xde, 0x35, 0x78, 0x3a, 0xe6, 0x96, 0xc7, 0x18, 0x2b, 0xb0, 0x0d, 0x98, 0x8e, 0xf3, 0x43, 0xea,
+  0x3d, 0xfd, 0x9a, 0x19, 0xf9, 0xe2, 0x28, 0x5d, 0x2f, 0xd3, 0xa5, 0x90, 0xba, 0x99, 0xb3, 0xd9,
+  0x57, 0xba, 0x6f, 0xa6, 0xe0, 0x6e, 0x8f, 0x8b, 0x93, 0x0e, 0x8a, 0xba, 0x23, 0xa7, 0x4b, 0x6a,
+  0xd0, 0xce, 0xf2, 0xcf, 0x3f, 0x09, 0x7b, 0xf7, 0x9b, 0xc5, 0xfa, 0x53, 0x07, 0xef, 0x65, 0x41,
+  0x1d, 0xdf, 0x80, 0x2d, 0x73, 0x1e, 0x84, 0xd7, 0x35, 0xb2, 0xe0, 0x05, 0xbd, 0xaf, 0x64, 0xf7,
+  0x34, 0x1b, 0xfd, 0x1d, 0x52, 0xd9, 0x4e, 0x93, 0x11, 0x9d, 0xde, 0x8a, 0x74, 0x18, 0xa5, 0xe7,
+  0xef, 0x3f, 0x12, 0xce, 0xea, 0x96, 0x0f, 0x0f, 0x00, 0x00,
+};
+
+// setup.html: 7049 bytes, 1510 gzipped
+static const uint8_t WEB_SETUP_HTML[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xc5, 0x59, 0xdd, 0x6f, 0xdb, 0x36,
+  0x10, 0x7f, 0xef, 0x5f, 0xc1, 0xe9, 0x21, 0x71, 0x80, 0x3a, 0xb6, 0xdc, 0x65, 0x0d, 0x5a, 0xdb,
+  0x43, 0xe7, 0xb4, 0xd8, 0xd0, 0x06, 0xf5, 0xea, 0x14, 0x41, 0x1f, 0x29, 0xe9, 0x6c, 0x71, 0xa1,
+  0x48, 0x8d, 0xa4, 0x6c, 0x67, 0xc3, 0xfe, 0xf7, 0x1d, 0x29, 0x4b, 0x56, 0x9c, 0x44, 0x91, 0xec,
+  0x7e, 0x3c, 0x24, 0x96, 0xc8, 0x3b, 0xde, 0x8f, 0xf7, 0x4d, 0x71, 0xf8, 0xd3, 0xc5, 0xc7, 0xc9,
+  0xd5, 0x97, 0xe9, 0x5b, 0x12, 0x9b, 0x84, 0x8f, 0x9f, 0x0d, 0xdd, 0xcf, 0x30, 0x06, 0x1a, 0xe1,
+  0x4b, 0x02, 0x86, 0x92, 0x30, 0xa6, 0x4a, 0x83, 0x19, 0x79, 0x9f, 0xaf, 0xde, 0x75, 0xcf, 0xbd,
+  0x62, 0x58, 0xd0, 0x04, 0x46, 0xde, 0x92, 0xc1, 0x2a, 0x95, 0xca, 0x78, 0x24, 0x94, 0xc2, 0x80,
+  0x40, 0xb2, 0x15, 0x8b, 0x4c, 0x3c, 0x8a, 0x60, 0xc9, 0x42, 0xe8, 0xba, 0x97, 0xe7, 0x84, 0x09,
+  0x66, 0x18, 0xe5, 0x5d, 0x1d, 0x52, 0x0e, 0x23, 0xff, 0xb4, 0x6f, 0x97, 0x31, 0xcc, 0x70, 0x18,
+  0x5f, 0x50, 0x75, 0xf3, 0x81, 0x2d, 0x62, 0x43, 0x66, 0x60, 0xb2, 0x74, 0xd8, 0xcb, 0x87, 0x9f,
+  0x0d, 0x39, 0x13, 0x37, 0x44, 0x01, 0x1f, 0x79, 0xda, 0xdc, 0x72, 0xd0, 0x31, 0x00, 0x8a, 0x89,
+  0x15, 0xcc, 0x47, 0x5e, 0xcf, 0x0d, 0x9d, 0x86, 0x5a, 0xdb, 0x85, 0x7a, 0x0e, 0xee, 0x30, 0x90,
+  0xd1, 0x2d, 0xbe, 0x45, 0x6c, 0x49, 0x42, 0x4e, 0xb5, 0x1e, 0x79, 0x16, 0x13, 0x65, 0x02, 0x14,
+  0x52, 0x11, 0x32, 0x8c, 0xfd, 0xfb, 0xd2, 0x70, 0xcc, 0x4e, 0x55, 0x98, 0x04, 0x5d, 0x3a, 0x72,
+  0x1c, 0xa5, 0x85, 0x38, 0x0f, 0x19, 0x75, 0x1c, 0x48, 0xaa, 0xa2, 0x61, 0x8f, 0xee, 0xce, 0x6a,
+  0xbb, 0x94, 0x57, 0xf0, 0xd3, 0xd0, 0xb0, 0x25, 0x78, 0xe3, 0x8d, 0x80, 0x7b, 0xd4, 0x59, 0x1a,
+  0x51, 0x83, 0xf3, 0x9f, 0xdd, 0xef, 0x86, 0x60, 0xd8, 0x43, 0x04, 0xe3, 0x67, 0x3b, 0x50, 0x42,
+  0x94, 0x57, 0x60, 0x89, 0x07, 0xe3, 0x6b, 0xf6, 0x8e, 0x91, 0x89, 0x14, 0x73, 0xb6, 0xc8, 0x14,
+  0x35, 0x4c, 0x0a, 0xc4, 0x3f, 0xd8, 0xcc, 0x57, 0xd8, 0xe6, 0x52, 0x25, 0xdd, 0x85, 0x92, 0x08,
+  0x2a, 0x9f, 0xc4, 0x69, 0x4e, 0x03, 0xe0, 0xe3, 0xd9, 0xec, 0x8f, 0x8b, 0x61, 0x2f, 0x7f, 0x2e,
+  0x66, 0x98, 0x48, 0x33, 0x43, 0xcc, 0x6d, 0x8a, 0xe6, 0x34, 0xb0, 0x46, 0x1d, 0xb3, 0xc8, 0x5a,
+  0x71, 0xce, 0x2c, 0xb5, 0x47, 0x52, 0x4e, 0x43, 0x88, 0x25, 0x8f, 0x40, 0x8d, 0xbc, 0x2f, 0x32,
+  0x53, 0xc4, 0xe1, 0x10, 0x60, 0x56, 0x52, 0xdd, 0x14, 0xf0, 0x72, 0xfc, 0xcd, 0x91, 0x4c, 0x71,
+  0x1e, 0xf9, 0xa3, 0x3a, 0x34, 0xe9, 0x86, 0x66, 0x8b, 0xc8, 0x72, 0xed, 0x20, 0x72, 0x60, 0x4a,
+  0xca, 0xfb, 0x68, 0x82, 0xcc, 0x18, 0x29, 0x0a, 0x40, 0x81, 0x11, 0x04, 0xff, 0xba, 0xa9, 0x62,
+  0x09, 0x55, 0xb7, 0x1e, 0x91, 0x22, 0xe4, 0x2c, 0xbc, 0x41, 0x27, 0xa3, 0x4b, 0xb8, 0x46, 0x11,
+  0x9d, 0x13, 0x34, 0x1d, 0x3e, 0xbb, 0x5d, 0x0e, 0x7b, 0x39, 0x7b, 0x65, 0x67, 0x05, 0x94, 0x4b,
+  0xbd, 0x28, 0x4d, 0x9e, 0xe0, 0xf3, 0xb8, 0x14, 0x5a, 0x63, 0x4b, 0xc7, 0xad, 0x41, 0x2d, 0xe5,
+  0x54, 0xea, 0xc9, 0x5d, 0xeb, 0xce, 0xec, 0x30, 0xc1, 0x71, 0xf6, 0xb8, 0x65, 0xb5, 0xa1, 0x26,
+  0xd3, 0xa8, 0x51, 0x86, 0x6b, 0xb9, 0x18, 0x40, 0xe1, 0x54, 0x2d, 0x98, 0xe8, 0x06, 0x12, 0x81,
+  0x26, 0xaf, 0xfc, 0x41, 0xba, 0xde, 0xea, 0xfa, 0x3e, 0x2b, 0x33, 0x90, 0x94, 0xf3, 0x48, 0xa1,
+  0x53, 0x2a, 0x76, 0x48, 0x9c, 0x41, 0xbc, 0xf1, 0x24, 0x53, 0x0a, 0x03, 0xba, 0x82, 0xc8, 0xd2,
+  0xd6, 0xb3, 0x2e, 0x29, 0xcf, 0xd0, 0xb5, 0xf3, 0xa9, 0xea, 0x5e, 0xbd, 0x71, 0xb7, 0xbb, 0x59,
+  0xe0, 0x28, 0x82, 0xc5, 0xeb, 0xbb, 0x8b, 0x55, 0xec, 0x75, 0x20, 0xe8, 0x8f, 0x29, 0x08, 0xf2,
+  0x46, 0x2c, 0x38, 0xec, 0x05, 0x57, 0x22, 0xbb, 0xe3, 0xbe, 0x60, 0x3a, 0xfd, 0x5e, 0x98, 0x27,
+  0x5c, 0x6a, 0x38, 0x00, 0x74, 0x68, 0xf9, 0xdb, 0xa3, 0x7e, 0x24, 0x64, 0x6d, 0x74, 0xec, 0x44,
+  0x6c, 0xd3, 0x10, 0x12, 0x59, 0xb4, 0x80, 0x4e, 0xd7, 0xef, 0x9f, 0x94, 0xce, 0x39, 0xc7, 0x0c,
+  0xdc, 0xd5, 0xec, 0x1f, 0x78, 0xe5, 0x9f, 0xfa, 0x56, 0x21, 0x47, 0x9c, 0xfe, 0x9d, 0xc9, 0xd7,
+  0xc4, 0xef, 0xdf, 0x8d, 0xad, 0x3d, 0xc4, 0xd4, 0x4a, 0xd1, 0x1b, 0x31, 0x07, 0x4a, 0xa9, 0x13,
+  0xe2, 0x93, 0x23, 0x95, 0x8b, 0x39, 0x54, 0x48, 0x9d, 0xc2, 0xfc, 0x3e, 0x8a, 0x79, 0x40, 0xca,
+  0xa1, 0xe6, 0xd3, 0x59, 0x18, 0x82, 0xcd, 0xa6, 0xdb, 0x0c, 0x08, 0xe6, 0x8d, 0xb6, 0x01, 0xe4,
+  0x52, 0x20, 0x18, 0x52, 0x64, 0x00, 0xaa, 0x89, 0x1d, 0x6e, 0xb8, 0xcb, 0x15, 0x55, 0x82, 0x89,
+  0xc5, 0xee, 0xc2, 0xce, 0xcb, 0x1f, 0x58, 0xd9, 0x8d, 0xd7, 0x6f, 0xcd, 0x3a, 0x79, 0x2a, 0xf5,
+  0x81, 0x19, 0x37, 0x2f, 0x9c, 0x0f, 0x26, 0xdd, 0xa6, 0x35, 0x55, 0xc9, 0xd5, 0x83, 0xb9, 0xf5,
+  0x81, 0x32, 0x57, 0x16, 0xba, 0x4f, 0x54, 0x2c, 0x80, 0x5c, 0x32, 0x41, 0x3a, 0x18, 0x8e, 0x0a,
+  0x40, 0x9f, 0xec, 0xd4, 0xbc, 0x9d, 0xaa, 0x27, 0xb2, 0x24, 0xc0, 0x8e, 0xc5, 0x01, 0x57, 0x96,
+  0x19, 0x79, 0x3d, 0x92, 0x30, 0x31, 0xf2, 0xfa, 0xf8, 0x4b, 0xd7, 0x23, 0x6f, 0xf0, 0xb2, 0xef,
+  0x3d, 0x99, 0x87, 0x1a, 0x80, 0xa2, 0xeb, 0xfd, 0x41, 0xd1, 0x75, 0x33, 0x50, 0x75, 0x9d, 0xc1,
+  0x3e, 0xfa, 0xac, 0x66, 0xf8, 0xa6, 0x88, 0x9d, 0xfd, 0x2d, 0xe3, 0xd7, 0xd6, 0xe3, 0x9d, 0xd4,
+  0xdd, 0x0a, 0x8d, 0xe3, 0xfc, 0x31, 0x1a, 0xb4, 0xbe, 0x38, 0xcd, 0xb8, 0xb6, 0x2d, 0x0e, 0x76,
+  0xe7, 0xa4, 0x93, 0xb5, 0xb1, 0xbe, 0x43, 0x8f, 0x4b, 0x4c, 0xaf, 0x37, 0xe8, 0xcf, 0xfa, 0x25,
+  0x7e, 0xfb, 0x78, 0x90, 0x3e, 0xad, 0x47, 0x1e, 0x0a, 0x8d, 0xae, 0x5b, 0x40, 0xfb, 0xea, 0xba,
+  0x95, 0xd8, 0x39, 0x5e, 0xb1, 0x04, 0x48, 0x27, 0x69, 0x03, 0x3d, 0x41, 0x3e, 0xcb, 0xb6, 0x01,
+  0xee, 0xf7, 0x4b, 0xe4, 0xf6, 0xf1, 0x50, 0xad, 0xe2, 0xe2, 0x09, 0xa6, 0xdb, 0xfb, 0x70, 0x34,
+  0x70, 0x08, 0x8d, 0x43, 0x00, 0x54, 0xdb, 0xac, 0xbd, 0x9d, 0xc4, 0x69, 0x99, 0xda, 0x84, 0x48,
+  0x5c, 0xc7, 0x61, 0xdd, 0x74, 0xfc, 0x01, 0x0f, 0x53, 0x54, 0x0d, 0x7b, 0xf9, 0x44, 0x0d, 0xad,
+  0x8f, 0x6d, 0x0d, 0x53, 0x61, 0xc6, 0x1b, 0x51, 0x0f, 0x6c, 0xb7, 0x19, 0xb0, 0xb0, 0x01, 0xe9,
+  0x0b, 0x6f, 0xfc, 0x76, 0x9d, 0xca, 0x06, 0x94, 0x3f, 0x7b, 0xe3, 0x3f, 0x33, 0x1a, 0x35, 0xa0,
+  0x3c, 0x73, 0x94, 0xca, 0x34, 0x20, 0xfd, 0xc5, 0x92, 0x32, 0xd1, 0x84, 0xf4, 0x25, 0x96, 0x3a,
+  0x54, 0xd7, 0x7d, 0x4a, 0xec, 0xc8, 0x9c, 0xda, 0x9f, 0x70, 0xc7, 0x36, 0x07, 0x17, 0x57, 0xc6,
+  0xca, 0x93, 0x8b, 0x7b, 0x7b, 0xe4, 0xe8, 0x92, 0xc7, 0xc8, 0xde, 0x95, 0x94, 0xdb, 0xb3, 0xf3,
+  0x4e, 0x0d, 0xcd, 0xcf, 0xd3, 0xdf, 0xb2, 0x86, 0xda, 0xb4, 0xf0, 0x9b, 0xb2, 0x62, 0x04, 0xb6,
+  0x2c, 0x64, 0x66, 0x20, 0xd5, 0xb5, 0xce, 0x8c, 0x91, 0x93, 0xd3, 0x7b, 0xf5, 0x3e, 0xea, 0x93,
+  0x8e, 0x14, 0x3d, 0x39, 0x9f, 0x9f, 0x34, 0x73, 0x93, 0xb3, 0x26, 0xae, 0x8f, 0x86, 0xf7, 0x5f,
+  0x36, 0x59, 0x0f, 0x01, 0x9c, 0xf9, 0x0d, 0x08, 0xcf, 0x51, 0xf2, 0x79, 0x13, 0xd1, 0x83, 0x33,
+  0xa4, 0xc4, 0x7f, 0xa4, 0x73, 0xde, 0x0d, 0x98, 0x69, 0xb2, 0x29, 0xbf, 0x3f, 0x78, 0x61, 0x9b,
+  0xcc, 0xc1, 0x0b, 0x82, 0x7d, 0xe8, 0x23, 0x5c, 0x35, 0x1e, 0xdb, 0xdc, 0x88, 0x33, 0x43, 0x03,
+  0xc6, 0xb1, 0xb3, 0xdd, 0x27, 0x3f, 0xe2, 0xd9, 0x27, 0xa8, 0xe4, 0xc7, 0x27, 0x93, 0xe3, 0xbe,
+  0x81, 0xe4, 0x7c, 0xb9, 0x0c, 0x24, 0xf7, 0xf6, 0x48, 0x20, 0xb9, 0x48, 0xd8, 0x3f, 0x90, 0x62,
+  0xa0, 0x06, 0xd4, 0x4e, 0x24, 0xfd, 0xee, 0x06, 0xbf, 0x69, 0x28, 0x5d, 0x00, 0x37, 0x14, 0xcf,
+  0xf4, 0x98, 0xc3, 0x48, 0xc7, 0x1d, 0x10, 0x27, 0x84, 0x06, 0xb6, 0x6a, 0x45, 0xb0, 0x6a, 0x61,
+  0x90, 0xc8, 0xae, 0xe3, 0x96, 0xd9, 0x6d, 0x62, 0xfa, 0xf6, 0x2c, 0x03, 0x29, 0x8e, 0x9c, 0x9e,
+  0x1d, 0x56, 0xb7, 0x66, 0x71, 0x66, 0x30, 0x36, 0x0b, 0x7f, 0x61, 0x22, 0x33, 0xad, 0x1a, 0x55,
+  0x9d, 0xf3, 0x6f, 0xfb, 0x67, 0xbf, 0x70, 0x9b, 0xf3, 0xef, 0xd2, 0x0c, 0xa0, 0x1d, 0x8d, 0x92,
+  0x9c, 0x7c, 0xa0, 0xab, 0xda, 0x6c, 0x65, 0x7d, 0x01, 0x69, 0x9e, 0xa8, 0xbd, 0x53, 0x25, 0xed,
+  0x97, 0x56, 0x1c, 0xa4, 0xbc, 0x59, 0x05, 0x9e, 0xda, 0x8f, 0x7d, 0x4d, 0x8a, 0xef, 0x54, 0x41,
+  0xc4, 0xdc, 0x67, 0xcb, 0x6f, 0x14, 0xfb, 0xef, 0x53, 0xd2, 0x99, 0x5e, 0x5f, 0xf6, 0x72, 0x87,
+  0x6b, 0x61, 0x42, 0xab, 0x9a, 0xf7, 0xe9, 0xd6, 0xc5, 0x72, 0xcf, 0xa2, 0xe2, 0xf6, 0x7b, 0xd8,
+  0xef, 0x3d, 0xab, 0xa2, 0x3e, 0x4a, 0x58, 0x14, 0x49, 0xf3, 0x5a, 0xb7, 0x85, 0xcf, 0x1a, 0xc2,
+  0x6f, 0x01, 0x2c, 0x72, 0xc0, 0x4a, 0x44, 0x7b, 0xea, 0x35, 0xfa, 0x41, 0x7a, 0xbd, 0x94, 0x98,
+  0x3d, 0xc8, 0x27, 0x86, 0x6d, 0x7e, 0x99, 0x82, 0x0c, 0x99, 0x67, 0x9c, 0x93, 0x54, 0xae, 0x40,
+  0xb5, 0xea, 0x9b, 0x71, 0x29, 0xbb, 0xd2, 0x36, 0xc2, 0xbf, 0x92, 0x8e, 0x73, 0x90, 0x2e, 0xf5,
+  0x60, 0x1c, 0x63, 0xfd, 0xb1, 0x09, 0x53, 0xb7, 0x85, 0x76, 0x45, 0xb3, 0xb2, 0xa5, 0x6f, 0xa1,
+  0xe5, 0x36, 0x25, 0x2b, 0x2f, 0x1a, 0x65, 0xcd, 0xca, 0x5f, 0x77, 0x8a, 0x56, 0xe3, 0x2f, 0x35,
+  0x06, 0xdb, 0xe0, 0x37, 0x98, 0x35, 0x4d, 0x26, 0xdc, 0xc7, 0x9a, 0xe2, 0xf9, 0x91, 0x22, 0x98,
+  0x57, 0xb1, 0xbd, 0xaa, 0xe0, 0xb6, 0xea, 0x5d, 0xb8, 0xab, 0xa2, 0x4a, 0x9d, 0x6b, 0x8a, 0x96,
+  0xcd, 0x3b, 0xa1, 0x2d, 0x95, 0x2a, 0xe9, 0x1c, 0x7f, 0x02, 0x87, 0x9d, 0xe4, 0xf7, 0x4e, 0xbf,
+  0x1e, 0x9f, 0x9c, 0xcc, 0xc1, 0x84, 0x71, 0xe7, 0xb8, 0x47, 0x53, 0xd6, 0x53, 0xf9, 0xec, 0xf1,
+  0xf3, 0x7f, 0x13, 0x30, 0xb1, 0x8c, 0x5e, 0x1d, 0x4f, 0x3f, 0xce, 0xae, 0x8e, 0xff, 0xc3, 0x1d,
+  0x6e, 0x18, 0xab, 0x1b, 0xac, 0xa0, 0x4e, 0x0b, 0x14, 0x4b, 0x50, 0x1a, 0xf3, 0xa2, 0x57, 0xb9,
+  0x41, 0x9a, 0x60, 0xd5, 0xc4, 0x0a, 0xce, 0x59, 0x80, 0x95, 0x5a, 0xa2, 0xca, 0x53, 0x7b, 0x17,
+  0x95, 0xb3, 0x0e, 0x75, 0xa8, 0x58, 0x6a, 0x88, 0x56, 0x61, 0x71, 0x41, 0x74, 0xfa, 0x97, 0xb6,
+  0x9a, 0xc9, 0x27, 0x2c, 0xa5, 0xbb, 0xaf, 0xc2, 0x6d, 0xbb, 0x8b, 0xb7, 0xff, 0x01, 0x4f, 0x91,
+  0x39, 0xfc, 0x89, 0x1b, 0x00, 0x00,
+};
+
+// style.css: 2784 bytes, 959 gzipped
+static const uint8_t WEB_STYLE_CSS[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x8d, 0x56, 0xdb, 0x8e, 0xa3, 0x38,
+  0x10, 0x7d, 0x9f, 0xaf, 0xb0, 0x34, 0x5a, 0xcd, 0x45, 0x21, 0xe2, 0x12, 0xe8, 0x5c, 0xb4, 0x1f,
+  0xb0, 0xcf, 0x3b, 0xf3, 0xb4, 0xda, 0x87, 0x02, 0x17, 0xc4, 0xdb, 0x60, 0x23, 0x63, 0x3a, 0x9d,
+  0x1d, 0xcd, 0xbf, 0x4f, 0x19, 0x07, 0xe2, 0x00, 0xdd, 0x1a, 0xa1, 0xa0, 0x00, 0xa7, 0x4e, 0x95,
+  0xab, 0x4e, 0x95, 0xfd, 0x95, 0xfd, 0x60, 0xb9, 0x7a, 0x0d, 0x3a, 0xf1, 0xbf, 0x90, 0xd5, 0x91,
+  0xfe, 0x6b, 0x8e, 0x3a, 0xa0, 0x57, 0x27, 0xd6, 0x80, 0xae, 0x84, 0x3c, 0xb2, 0xf0, 0xc4, 0x5a,
+  0xe0, 0x7c, 0xf8, 0x4e, 0xff, 0x7f, 0x7e, 0xc8, 0x15, 0xbf, 0x92, 0x5d, 0xa9, 0xa4, 0x09, 0x4a,
+  0x68, 0x44, 0x7d, 0x3d, 0xb2, 0x4f, 0x7f, 0x63, 0xa5, 0x90, 0x7d, 0xff, 0xeb, 0xd3, 0x86, 0x7d,
+  0x83, 0xb3, 0x6a, 0x60, 0xc3, 0x3a, 0x90, 0x5d, 0xd0, 0xa1, 0x16, 0xe5, 0x89, 0xe5, 0x50, 0x3c,
+  0x57, 0x5a, 0xf5, 0x92, 0x1f, 0xd9, 0xc7, 0x08, 0x22, 0x88, 0xf1, 0xc4, 0x0a, 0x55, 0x2b, 0x4d,
+  0xcf, 0x18, 0xda, 0xcb, 0x52, 0x6f, 0x0b, 0x22, 0x05, 0x21, 0x51, 0x93, 0x83, 0x06, 0x5e, 0x83,
+  0x8b, 0xe0, 0xe6, 0x7c, 0x64, 0xfb, 0x30, 0x6c, 0xfd, 0x90, 0x18, 0xf4, 0x46, 0x79, 0x71, 0x45,
+  0x99, 0xfd, 0xfc, 0xf3, 0xc3, 0x39, 0x22, 0xbb, 0x89, 0xf6, 0xb0, 0x4b, 0xb3, 0x70, 0xb4, 0xa2,
+  0x45, 0x19, 0xa3, 0x1a, 0xe2, 0xb2, 0xd0, 0x21, 0x78, 0x5a, 0x35, 0x92, 0xed, 0x36, 0xc5, 0x66,
+  0x30, 0x8e, 0x3d, 0xe3, 0x22, 0xb4, 0xd7, 0xdd, 0xa5, 0xf5, 0x40, 0x7e, 0x97, 0xc6, 0x91, 0x35,
+  0x9e, 0xf2, 0xe6, 0x5c, 0x44, 0x84, 0xed, 0x54, 0x2d, 0x38, 0xfb, 0x98, 0x24, 0xc9, 0x14, 0xe7,
+  0xf4, 0x7d, 0xe7, 0xa2, 0xdd, 0x4a, 0x78, 0x21, 0x97, 0x5c, 0x74, 0x6d, 0x0d, 0x94, 0xc4, 0xb2,
+  0x46, 0x7a, 0x5f, 0x41, 0x4b, 0x0c, 0xf1, 0x7d, 0xbd, 0x77, 0xda, 0xcc, 0xb3, 0x83, 0x95, 0x95,
+  0x1a, 0x7c, 0x35, 0x01, 0xc7, 0x42, 0x69, 0x30, 0x42, 0x51, 0xd4, 0x52, 0x49, 0xf4, 0xd2, 0x64,
+  0xd7, 0xe0, 0x98, 0x5d, 0xc0, 0x0f, 0x91, 0x8e, 0x24, 0xb7, 0xb5, 0x68, 0xe0, 0xa2, 0xef, 0x1e,
+  0x63, 0x85, 0xe3, 0x59, 0xbd, 0xa0, 0xde, 0x30, 0xf7, 0xb4, 0x85, 0xc2, 0x88, 0x17, 0xb4, 0x1a,
+  0xf2, 0xcb, 0x3b, 0x12, 0xdd, 0xa2, 0xbb, 0x9c, 0x85, 0x41, 0x57, 0x5c, 0xd0, 0x7c, 0x0e, 0x8e,
+  0xb2, 0x38, 0x4a, 0x70, 0xe1, 0x75, 0xc8, 0xf3, 0xac, 0xbc, 0xf3, 0x6c, 0xc4, 0xb7, 0xc8, 0x3a,
+  0x03, 0xa6, 0xef, 0x82, 0x4a, 0x0b, 0xee, 0x67, 0xd3, 0x3e, 0x9f, 0x86, 0x7b, 0x60, 0xb0, 0xa1,
+  0x77, 0x06, 0x03, 0x0a, 0xa9, 0x6f, 0x24, 0xf1, 0x6b, 0x6c, 0x11, 0xcc, 0x67, 0x2b, 0xa3, 0xa0,
+  0x14, 0x66, 0xc3, 0x1a, 0x21, 0x49, 0x6f, 0x9f, 0x63, 0x2b, 0xb4, 0x0d, 0x8b, 0x4a, 0xfd, 0xe5,
+  0xcb, 0x43, 0x29, 0xee, 0x7e, 0x68, 0x35, 0xcd, 0xb2, 0x6a, 0xff, 0xf5, 0x9d, 0x11, 0xe5, 0x35,
+  0xb0, 0x02, 0x46, 0x69, 0x8e, 0xac, 0x6b, 0xa1, 0xc0, 0x20, 0x47, 0x73, 0x41, 0x94, 0x27, 0x06,
+  0xb5, 0xa8, 0xe4, 0x60, 0x4b, 0xde, 0x0b, 0x42, 0xa0, 0xf6, 0x16, 0x38, 0x2c, 0xf7, 0x21, 0x2f,
+  0x61, 0x99, 0xec, 0xde, 0xa9, 0xc6, 0x2d, 0x96, 0x1a, 0x72, 0xac, 0xc7, 0x5e, 0x74, 0x8a, 0x0c,
+  0xb7, 0x07, 0xab, 0xc8, 0x51, 0x1a, 0x10, 0xda, 0xcb, 0xb7, 0x79, 0x81, 0xba, 0xc7, 0xd1, 0xe6,
+  0x82, 0xa2, 0x3a, 0x1b, 0xdb, 0xf8, 0x35, 0x5f, 0x13, 0x36, 0x99, 0x09, 0xc9, 0x45, 0x01, 0x46,
+  0x69, 0x7f, 0xd1, 0x42, 0xd6, 0xd4, 0xa5, 0x41, 0x5e, 0xab, 0xe2, 0xf9, 0xc4, 0x6e, 0x5d, 0x1a,
+  0x0d, 0x4d, 0x7a, 0xbe, 0x51, 0xba, 0xa7, 0x59, 0xfc, 0x69, 0xf8, 0xc7, 0x54, 0x48, 0xed, 0x70,
+  0xa3, 0xa8, 0xc9, 0x0f, 0xd5, 0x90, 0x92, 0x35, 0x97, 0xc8, 0xae, 0x80, 0x32, 0x0d, 0x27, 0xcc,
+  0x15, 0xeb, 0x5a, 0x5d, 0xe6, 0xa0, 0xb2, 0x3c, 0xd0, 0x90, 0x98, 0x40, 0x1a, 0x17, 0x4a, 0x2b,
+  0x77, 0xbb, 0x24, 0xc9, 0x26, 0x44, 0xee, 0xb2, 0xf0, 0x00, 0x89, 0xa3, 0x43, 0x56, 0x26, 0x5e,
+  0x34, 0x70, 0x9d, 0x43, 0xb2, 0xcc, 0x51, 0xe4, 0x46, 0x06, 0xf6, 0x65, 0xbb, 0x94, 0x82, 0xbd,
+  0x07, 0x17, 0x6d, 0xb5, 0x63, 0xef, 0x37, 0x19, 0xed, 0x3d, 0x09, 0x1b, 0x35, 0xbe, 0x70, 0x4c,
+  0xc4, 0xe1, 0x4b, 0xe1, 0xa6, 0xf7, 0xb1, 0x47, 0x5d, 0x13, 0xaf, 0x09, 0xa1, 0xe8, 0x75, 0x67,
+  0xab, 0xdc, 0x2a, 0xe1, 0x04, 0xf5, 0xa6, 0x0e, 0xee, 0x4d, 0x68, 0x03, 0x6f, 0xb5, 0xa0, 0x48,
+  0xae, 0x6f, 0x35, 0xee, 0x23, 0xca, 0xf5, 0xfc, 0x1c, 0x5b, 0x3c, 0x25, 0x69, 0x7a, 0xc7, 0x76,
+  0x7d, 0x51, 0x60, 0xd7, 0xbd, 0x53, 0x3a, 0x0f, 0xb5, 0xce, 0x98, 0xec, 0xf7, 0x98, 0x14, 0x13,
+  0xf6, 0x02, 0x5a, 0x52, 0x42, 0xde, 0xa9, 0xb3, 0x87, 0x5a, 0x67, 0xc4, 0x6c, 0x7f, 0xf0, 0xb0,
+  0x1c, 0x64, 0xb5, 0x04, 0x79, 0xb2, 0xb8, 0x83, 0xd6, 0xf9, 0x78, 0x12, 0x97, 0x71, 0x39, 0x41,
+  0x85, 0x2c, 0xd5, 0x3b, 0x0a, 0x1a, 0x21, 0xeb, 0x5c, 0xd1, 0xe1, 0x29, 0xe3, 0xf1, 0x08, 0x3c,
+  0x92, 0x84, 0x20, 0xaf, 0x97, 0xa2, 0x4d, 0xd3, 0xf4, 0x5e, 0x66, 0xa9, 0x4c, 0x00, 0x56, 0xfc,
+  0xc8, 0x07, 0xc3, 0x52, 0xe9, 0x66, 0x12, 0xe1, 0x5b, 0xd3, 0xd1, 0x03, 0x8d, 0xd3, 0x62, 0xd2,
+  0xeb, 0xad, 0x7d, 0x67, 0xa6, 0x4e, 0x5a, 0xb3, 0xf9, 0xb1, 0x54, 0xd6, 0x23, 0xb7, 0x90, 0x6d,
+  0x4f, 0x63, 0xd4, 0x7f, 0xd5, 0x61, 0x8d, 0x85, 0x21, 0x7f, 0xd3, 0x78, 0xb0, 0xcd, 0xff, 0xdb,
+  0x33, 0x6f, 0xb9, 0x8d, 0xae, 0xb6, 0xc0, 0xec, 0x0c, 0xf1, 0x76, 0x9c, 0x7a, 0x18, 0x1a, 0xbf,
+  0xb7, 0x3d, 0xd0, 0xfc, 0xb7, 0xbf, 0xf9, 0x0e, 0xd0, 0x74, 0xd5, 0xa2, 0x55, 0xe3, 0x95, 0x29,
+  0xb7, 0x5b, 0xed, 0xf5, 0xc9, 0xb5, 0x6b, 0x68, 0xc7, 0x17, 0xa8, 0xe7, 0x85, 0x34, 0xf2, 0x14,
+  0xe3, 0xd0, 0x2b, 0x41, 0xca, 0x33, 0x78, 0x9a, 0x0c, 0x50, 0x2f, 0xc4, 0x94, 0x3f, 0x45, 0x45,
+  0x54, 0x78, 0xc9, 0x28, 0x0f, 0x70, 0x00, 0x37, 0xf4, 0x29, 0x7d, 0x14, 0x99, 0x7f, 0xae, 0x9a,
+  0x8d, 0xab, 0xd5, 0x9d, 0x69, 0xb6, 0xf3, 0xcd, 0x49, 0x86, 0x6a, 0xff, 0x63, 0xae, 0x2d, 0xfe,
+  0xa9, 0x6d, 0xc3, 0xfc, 0x6b, 0xf7, 0x13, 0x62, 0x23, 0x1b, 0xdf, 0x60, 0xdc, 0x6a, 0x68, 0x73,
+  0x1d, 0x4f, 0x72, 0xbb, 0x61, 0x57, 0x18, 0x0e, 0x2a, 0x83, 0xe3, 0xbb, 0x4b, 0x32, 0xa3, 0x3e,
+  0xe9, 0xe8, 0xdc, 0x42, 0x16, 0x6b, 0x80, 0x71, 0x75, 0x43, 0x4f, 0x3c, 0xd4, 0x79, 0x6f, 0xeb,
+  0xec, 0xe7, 0x7b, 0x3c, 0x29, 0xfd, 0x02, 0xe4, 0x5d, 0xd3, 0x1c, 0xe0, 0x0a, 0x00, 0x00,
+};
+
+// dashboard.js: 4419 bytes, 1438 gzipped
+static const uint8_t WEB_DASHBOARD_JS[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xb5, 0x57, 0x5b, 0x6f, 0xdb, 0x36,
+  0x14, 0x7e, 0xcf, 0xaf, 0x60, 0x5e, 0x26, 0x09, 0x71, 0x14, 0x77, 0xdd, 0xc3, 0x10, 0xcf, 0x0d,
+  0xda, 0x34, 0x03, 0x3a, 0xb4, 0x75, 0x30, 0x67, 0xdb, 0x43, 0xd1, 0x07, 0x46, 0x3a, 0xb6, 0xd5,
+  0xd2, 0xa4, 0x47, 0x52, 0x76, 0x83, 0xc6, 0xff, 0x7d, 0x1f, 0x49, 0xc9, 0x92, 0x1d, 0x5f, 0xe2,
+  0x0d, 0x03, 0x82, 0x58, 0x3a, 0x87, 0xe7, 0x3b, 0x17, 0x9e, 0x9b, 0x32, 0x25, 0x8d, 0x65, 0x99,
+  0x9a, 0x93, 0x1e, 0x5a, 0x6e, 0xc9, 0xb0, 0x3e, 0xfb, 0x14, 0x7d, 0x54, 0x96, 0xdd, 0x6a, 0x32,
+  0x24, 0x6d, 0xd4, 0x89, 0xae, 0x85, 0x32, 0x94, 0xe3, 0xe1, 0x83, 0x9a, 0x17, 0x72, 0x8c, 0x87,
+  0xc1, 0x8c, 0x24, 0x7e, 0xfe, 0x90, 0x5f, 0xa5, 0x5a, 0xb8, 0xa7, 0x1b, 0xad, 0x95, 0x8e, 0x3e,
+  0xf7, 0x4e, 0xb2, 0x80, 0xc7, 0xc5, 0x4e, 0xb4, 0xc1, 0x68, 0x84, 0xff, 0x8e, 0xf6, 0x3b, 0xf1,
+  0xfc, 0x01, 0xcf, 0xf5, 0xef, 0x4e, 0xb8, 0x09, 0x71, 0x7b, 0x00, 0xef, 0x75, 0x69, 0x95, 0x7b,
+  0xd9, 0x66, 0x56, 0x27, 0x1a, 0x92, 0x6d, 0x19, 0xe7, 0x9c, 0xbd, 0x56, 0x42, 0xe9, 0x00, 0x57,
+  0xc8, 0xfc, 0x7c, 0xac, 0xb9, 0xb3, 0x20, 0x3c, 0x92, 0x77, 0xce, 0x3d, 0x3f, 0x90, 0x10, 0x6a,
+  0x71, 0x88, 0xa1, 0x11, 0x9c, 0xb6, 0xeb, 0xfb, 0xb0, 0x57, 0x8f, 0xff, 0x02, 0xda, 0x85, 0xe1,
+  0x59, 0xd8, 0xf7, 0xa2, 0xa4, 0xe7, 0x20, 0xb7, 0x4e, 0x43, 0xc9, 0xc9, 0xc5, 0x05, 0x7b, 0xcf,
+  0xa1, 0xc7, 0x47, 0x8f, 0xcd, 0x39, 0xe8, 0x4c, 0x8d, 0x18, 0x21, 0x5c, 0x0f, 0xec, 0x82, 0xcf,
+  0x8a, 0x0b, 0x83, 0x4b, 0x28, 0x0d, 0x1b, 0x15, 0x24, 0xf2, 0x1e, 0x33, 0x56, 0x13, 0x9f, 0x3a,
+  0xbe, 0xb4, 0x86, 0x29, 0x29, 0x1e, 0xe0, 0xbd, 0xc6, 0x59, 0x3b, 0x21, 0x96, 0x4d, 0xb8, 0x1c,
+  0x53, 0x0e, 0x32, 0x99, 0x93, 0x39, 0xd7, 0x4c, 0x14, 0x73, 0x82, 0xdd, 0xdf, 0x97, 0x3d, 0xff,
+  0x3a, 0x53, 0x42, 0x20, 0x99, 0x40, 0x91, 0xa5, 0x10, 0xd0, 0x3e, 0x2a, 0x65, 0x66, 0x0b, 0x25,
+  0x59, 0x39, 0xcb, 0x71, 0xd5, 0x43, 0xaf, 0x2a, 0x4e, 0xd8, 0xf7, 0x13, 0xc6, 0x46, 0x64, 0xb3,
+  0x49, 0x1c, 0xb5, 0x6c, 0x88, 0x92, 0x14, 0x5a, 0x64, 0xac, 0xfb, 0xaf, 0x74, 0xfa, 0xc5, 0x28,
+  0x19, 0x27, 0x15, 0x25, 0xef, 0xbf, 0x72, 0x22, 0x8c, 0x0d, 0xee, 0xbf, 0x50, 0x66, 0x53, 0x6e,
+  0x4c, 0x31, 0x96, 0xb1, 0x53, 0xdf, 0x61, 0x79, 0xd2, 0xf3, 0x3c, 0x4d, 0x32, 0x27, 0xed, 0x89,
+  0x9e, 0xb2, 0x4c, 0xd2, 0x8c, 0x3b, 0x1d, 0x04, 0xe9, 0x25, 0x48, 0xcb, 0x96, 0x41, 0xd5, 0xe1,
+  0x3c, 0xd8, 0x92, 0xab, 0xac, 0x9c, 0xc2, 0xe3, 0x74, 0x4c, 0xf6, 0x46, 0x90, 0x7b, 0x7c, 0xf3,
+  0xf0, 0x2e, 0x8f, 0xa3, 0xa6, 0x88, 0x9c, 0x71, 0xf4, 0x0d, 0x77, 0x25, 0x2d, 0xb8, 0x70, 0xb1,
+  0x55, 0x5f, 0x9f, 0xf2, 0xb4, 0x79, 0xfb, 0xcc, 0x1e, 0x1f, 0x59, 0x74, 0x15, 0xf5, 0x0e, 0xe2,
+  0xbe, 0x93, 0x39, 0x50, 0x33, 0x01, 0x6f, 0x3e, 0xf2, 0xa9, 0x0b, 0xa4, 0xbb, 0xbb, 0x02, 0x46,
+  0x2b, 0xcd, 0x22, 0x76, 0xc6, 0xe2, 0x56, 0x5a, 0xaf, 0xeb, 0x78, 0x7c, 0x6c, 0xf2, 0x23, 0xd9,
+  0xaf, 0xa9, 0x2a, 0xdb, 0xa7, 0xf6, 0xd7, 0xf5, 0xec, 0x90, 0xab, 0xe7, 0xe7, 0xd9, 0xce, 0xc5,
+  0x33, 0x2c, 0xaf, 0x4b, 0xa6, 0x8d, 0xfe, 0x7c, 0xab, 0xef, 0x75, 0x31, 0x9e, 0x58, 0xa4, 0x99,
+  0x79, 0x62, 0x77, 0x9e, 0x36, 0xcc, 0xbd, 0x18, 0x53, 0xfe, 0xed, 0x8d, 0x3f, 0xb9, 0x05, 0x62,
+  0xc5, 0x3b, 0x88, 0x12, 0x94, 0x0d, 0x45, 0x81, 0x74, 0x01, 0x10, 0x04, 0x8f, 0x04, 0x58, 0x35,
+  0xba, 0x27, 0x66, 0x34, 0x2d, 0x10, 0x41, 0x72, 0x2f, 0xc7, 0x64, 0x90, 0x3b, 0x7f, 0xf8, 0x1a,
+  0x9a, 0xf6, 0xb2, 0xa1, 0xe2, 0xf9, 0x57, 0xe1, 0xa4, 0xee, 0x68, 0x3a, 0xdb, 0x12, 0xc5, 0x00,
+  0xe8, 0x98, 0xa7, 0x7d, 0x57, 0xf1, 0x57, 0x6d, 0x52, 0x6a, 0xd5, 0xaf, 0xc5, 0x37, 0xca, 0xe3,
+  0x17, 0xc9, 0x65, 0x74, 0x7e, 0xbe, 0xdf, 0x1b, 0x55, 0xee, 0xd2, 0x01, 0x8e, 0x41, 0xec, 0xd7,
+  0x94, 0xb4, 0x68, 0x47, 0x69, 0x99, 0x94, 0xd3, 0x22, 0x2f, 0xec, 0xc3, 0x36, 0x57, 0x2a, 0x56,
+  0xe3, 0x48, 0x45, 0x38, 0x4a, 0x41, 0x4e, 0x8b, 0x5b, 0x55, 0xc8, 0x6d, 0x19, 0x57, 0xb3, 0x56,
+  0x0a, 0x6a, 0xc2, 0x71, 0x1e, 0x20, 0xbc, 0xb7, 0x7f, 0x7d, 0xd8, 0x79, 0x17, 0xe0, 0x6d, 0x5c,
+  0x05, 0x28, 0x87, 0x61, 0x47, 0x8b, 0x3f, 0x49, 0x1b, 0xf4, 0xc5, 0x2d, 0xc0, 0xf3, 0xc0, 0xf1,
+  0x39, 0xe9, 0x71, 0x00, 0x84, 0xa9, 0xf2, 0xb6, 0x30, 0xfc, 0x5e, 0x60, 0x26, 0xe0, 0xa8, 0x56,
+  0xc2, 0xb0, 0x05, 0x1a, 0x35, 0xcb, 0x69, 0x5e, 0x64, 0xc4, 0x24, 0xa6, 0xf9, 0x2c, 0x4c, 0x73,
+  0x16, 0xbb, 0xe6, 0x4e, 0xac, 0x9b, 0x40, 0xce, 0x90, 0x87, 0x76, 0xe7, 0x6f, 0xa4, 0x13, 0xaf,
+  0x5b, 0x61, 0x4d, 0x8d, 0xd0, 0xce, 0x5b, 0x7d, 0x8e, 0x9d, 0xf6, 0xfb, 0x90, 0xec, 0xed, 0x12,
+  0x75, 0x4d, 0xa6, 0x2d, 0x58, 0x35, 0x9a, 0xc3, 0x62, 0x55, 0x3d, 0x1f, 0x21, 0x14, 0xa2, 0xb9,
+  0xa6, 0xae, 0x55, 0x4f, 0x2b, 0xe1, 0xa5, 0x1f, 0xb9, 0x77, 0x18, 0x96, 0x55, 0x28, 0x66, 0xa5,
+  0x99, 0x60, 0xc7, 0x09, 0x41, 0x08, 0x03, 0x14, 0x73, 0x15, 0x0e, 0xb2, 0x21, 0x69, 0xfc, 0x9c,
+  0x0f, 0x5d, 0x90, 0x6e, 0xea, 0x79, 0xeb, 0xe7, 0xac, 0xc4, 0x15, 0x60, 0x98, 0x6a, 0xeb, 0xb0,
+  0xca, 0x59, 0xca, 0x6e, 0xab, 0xc1, 0xea, 0xe7, 0xb1, 0x2e, 0xa5, 0x8b, 0x76, 0x81, 0xe0, 0xbb,
+  0xc3, 0xd5, 0xc4, 0x2e, 0x0c, 0xae, 0x17, 0x23, 0x1e, 0x95, 0xaf, 0x69, 0x54, 0x62, 0xb9, 0x4b,
+  0x9b, 0x69, 0x07, 0xed, 0xda, 0x56, 0x20, 0xd5, 0xf8, 0x2d, 0x46, 0x2c, 0xae, 0xe6, 0x75, 0x02,
+  0x09, 0x5b, 0x6a, 0xe9, 0x5c, 0x6f, 0x46, 0x38, 0x82, 0xf0, 0x0e, 0x59, 0xa0, 0xb1, 0x33, 0xc4,
+  0xed, 0xf1, 0xdd, 0x61, 0x3f, 0x76, 0xbb, 0x21, 0x4e, 0xeb, 0x53, 0x7d, 0x7d, 0xc0, 0x1a, 0xab,
+  0x66, 0xeb, 0x1a, 0x33, 0x41, 0x5c, 0xaf, 0x20, 0x6b, 0xdd, 0xeb, 0x4a, 0xc3, 0xde, 0xd0, 0xc6,
+  0x41, 0x7e, 0x49, 0x8c, 0xfc, 0x10, 0xa0, 0x96, 0xed, 0xa7, 0x0b, 0xf4, 0x2f, 0xb5, 0x48, 0x3d,
+  0x63, 0xa8, 0x4a, 0x9d, 0x11, 0x98, 0x1b, 0x9e, 0xf6, 0x6a, 0xcf, 0xd8, 0x12, 0x62, 0x61, 0x45,
+  0xd1, 0x2e, 0xad, 0xe3, 0x19, 0xd7, 0x86, 0x60, 0x4c, 0x2c, 0x14, 0xda, 0x25, 0x14, 0xa5, 0x8e,
+  0x93, 0xb8, 0x2c, 0xff, 0xb9, 0x9b, 0xa0, 0x75, 0xbe, 0xe8, 0x55, 0x12, 0x7e, 0x41, 0x95, 0xb4,
+  0x60, 0x2d, 0x4d, 0x2d, 0x29, 0xad, 0xac, 0xca, 0x94, 0x80, 0x44, 0x74, 0x71, 0xe1, 0x7a, 0xee,
+  0x8a, 0x35, 0x51, 0xc6, 0x4a, 0xd7, 0x96, 0xc1, 0xba, 0x74, 0x1c, 0xaf, 0xdb, 0x9d, 0x0b, 0xdb,
+  0x55, 0xe8, 0xbb, 0x64, 0x52, 0x25, 0x15, 0x76, 0x6f, 0x17, 0xf2, 0x26, 0x66, 0x2b, 0xd6, 0x14,
+  0xf3, 0x85, 0x8f, 0x5d, 0x6f, 0xaf, 0x43, 0x12, 0x53, 0x88, 0xc2, 0xf6, 0x6d, 0xe8, 0xb7, 0xe1,
+  0xe0, 0x63, 0xea, 0xbd, 0x8b, 0x29, 0xc5, 0xf5, 0xf0, 0x64, 0xd7, 0x7a, 0xb4, 0x52, 0x41, 0x6e,
+  0xa3, 0x6e, 0x2b, 0xa8, 0xf1, 0x37, 0x82, 0xe9, 0x69, 0xc8, 0xc8, 0xf0, 0xed, 0xc0, 0xa6, 0xc4,
+  0x91, 0x88, 0x55, 0xb2, 0xb1, 0x98, 0x0b, 0x51, 0xe5, 0xa2, 0x61, 0x96, 0x7f, 0x25, 0x99, 0x5c,
+  0x32, 0x8b, 0xc5, 0x91, 0x8f, 0x79, 0x21, 0x99, 0x70, 0xa5, 0x92, 0xb2, 0x01, 0x32, 0x56, 0x2f,
+  0x0a, 0x43, 0xed, 0x68, 0x02, 0xa3, 0xba, 0x65, 0xc3, 0x0a, 0x6b, 0x48, 0x8c, 0x52, 0xaf, 0xca,
+  0x5d, 0x33, 0x0c, 0xd4, 0xee, 0x53, 0x22, 0x54, 0x59, 0x1f, 0x55, 0xd6, 0x12, 0x4c, 0xaf, 0xdf,
+  0x0f, 0x86, 0x37, 0x6f, 0x13, 0x97, 0xab, 0x77, 0xc5, 0x94, 0x30, 0x17, 0xe2, 0xb5, 0x7c, 0xe9,
+  0xb0, 0x97, 0xdd, 0x3a, 0x59, 0x97, 0x75, 0x71, 0xbe, 0x46, 0x4e, 0x4d, 0xa7, 0x1c, 0xb3, 0xd3,
+  0x59, 0x6f, 0x4a, 0x61, 0x19, 0x36, 0x5c, 0x84, 0xc5, 0x30, 0x8e, 0x3f, 0x19, 0x96, 0xdf, 0x1e,
+  0x5b, 0x14, 0x76, 0x02, 0xc4, 0x56, 0x91, 0x75, 0xc2, 0xd2, 0x0a, 0x23, 0x99, 0x99, 0xe0, 0x32,
+  0x51, 0x8c, 0x7c, 0x04, 0xbf, 0x9a, 0x6c, 0xf5, 0xaf, 0xd7, 0xd3, 0x7c, 0x5b, 0x91, 0xb5, 0x8c,
+  0x5c, 0xab, 0xa7, 0x97, 0xdd, 0xee, 0x66, 0xed, 0x3c, 0xed, 0x3f, 0xae, 0xcd, 0x22, 0x8e, 0x58,
+  0x1a, 0xf3, 0x0e, 0xa3, 0x40, 0x0c, 0x3a, 0x7c, 0x8e, 0x0a, 0xd7, 0xaa, 0x77, 0x74, 0xf7, 0x96,
+  0xa8, 0x0f, 0x84, 0xaf, 0x1e, 0x12, 0xed, 0xaa, 0x77, 0x18, 0xf7, 0x56, 0xba, 0x4c, 0x27, 0x91,
+  0xfe, 0x5d, 0xe2, 0xe3, 0x60, 0x48, 0x02, 0x61, 0x54, 0xfa, 0xb5, 0x10, 0x58, 0x82, 0x4a, 0x6b,
+  0xdd, 0x70, 0xa8, 0xcf, 0x16, 0x72, 0x86, 0x11, 0xbc, 0xeb, 0xb4, 0xe7, 0x86, 0xc3, 0x23, 0x24,
+  0x56, 0xec, 0x25, 0x70, 0xb8, 0xdb, 0xc3, 0xcf, 0x2f, 0x5e, 0x51, 0x2a, 0x48, 0x8e, 0xed, 0x04,
+  0x84, 0xb3, 0xb3, 0xc4, 0x53, 0x3e, 0x15, 0x9f, 0xd3, 0x3c, 0xcc, 0x94, 0x1c, 0x67, 0x4f, 0x2b,
+  0x1f, 0x77, 0x81, 0x04, 0x0b, 0xd6, 0x61, 0x02, 0x6d, 0x0f, 0x10, 0xac, 0x35, 0xf6, 0x41, 0x50,
+  0xaa, 0x66, 0x3c, 0xc3, 0x6c, 0x77, 0x0e, 0x04, 0x2e, 0xbb, 0x62, 0xd1, 0x8b, 0x88, 0x5d, 0xb2,
+  0xa8, 0x9b, 0xfe, 0x14, 0x6d, 0xde, 0x86, 0xcc, 0xdd, 0x95, 0x66, 0xd3, 0xfc, 0xe9, 0x97, 0x0b,
+  0x88, 0x57, 0xdc, 0x9f, 0xeb, 0x47, 0x67, 0x78, 0xe9, 0xb0, 0xef, 0x53, 0x42, 0xde, 0xe4, 0x97,
+  0xd1, 0xed, 0x60, 0x78, 0x17, 0x2d, 0xab, 0x2f, 0x98, 0x3a, 0x31, 0x9e, 0xde, 0x74, 0xb3, 0x46,
+  0xc6, 0xcd, 0x85, 0xce, 0xf7, 0xdc, 0xe7, 0xe6, 0x4a, 0xea, 0x3f, 0xea, 0x7a, 0xbb, 0xed, 0x12,
+  0xee, 0xb4, 0x92, 0x3f, 0x34, 0x6b, 0x33, 0x4c, 0x9d, 0x1f, 0x69, 0xa8, 0x07, 0x19, 0xc8, 0xff,
+  0x6a, 0xa2, 0xcb, 0x3d, 0x08, 0xba, 0x59, 0xb9, 0x1f, 0x60, 0xc7, 0xf2, 0xfe, 0x3f, 0xb9, 0xb9,
+  0x31, 0x64, 0x7a, 0x27, 0xff, 0x00, 0x8b, 0x98, 0x6f, 0x53, 0x43, 0x11, 0x00, 0x00,
+};
+
+// setup.js: 6172 bytes, 1604 gzipped
+static const uint8_t WEB_SETUP_JS[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xb5, 0x58, 0x41, 0x97, 0xda, 0x36,
+  0x10, 0xbe, 0xef, 0xaf, 0xd0, 0x5e, 0x2a, 0xd3, 0x65, 0x0d, 0x49, 0xd3, 0x1e, 0x4c, 0x49, 0xde,
+  0x66, 0x93, 0xbe, 0xee, 0x6b, 0xd2, 0xec, 0x0b, 0xdb, 0x97, 0x43, 0x9a, 0x83, 0xb0, 0x04, 0x28,
+  0x18, 0xc9, 0x95, 0x64, 0x60, 0xdf, 0xee, 0xfe, 0xf7, 0x8e, 0x24, 0xdb, 0x60, 0x30, 0xd8, 0x34,
+  0xcd, 0x05, 0xec, 0x91, 0xbe, 0xf1, 0x68, 0x66, 0x34, 0xfa, 0x46, 0x93, 0x4c, 0xc4, 0x86, 0x4b,
+  0x81, 0xf4, 0x4c, 0xae, 0xde, 0xeb, 0x69, 0xc0, 0x69, 0x17, 0xc9, 0x79, 0x17, 0x19, 0xb6, 0x36,
+  0x1d, 0xf4, 0x70, 0x86, 0xd0, 0x92, 0x28, 0xc4, 0x12, 0x34, 0x44, 0x54, 0xc6, 0xd9, 0x82, 0x09,
+  0x13, 0x4e, 0x99, 0x79, 0x9b, 0x30, 0xfb, 0xf8, 0xfa, 0xfe, 0x86, 0x02, 0xa4, 0x33, 0x80, 0x79,
+  0x2c, 0x09, 0x2d, 0xe8, 0x5a, 0x0a, 0x03, 0x23, 0x30, 0xdf, 0xbe, 0xe5, 0x03, 0x71, 0x42, 0xb4,
+  0xfe, 0x93, 0x2c, 0x18, 0x88, 0xf1, 0x42, 0x4f, 0x11, 0x46, 0x17, 0x28, 0x90, 0x73, 0xf4, 0xca,
+  0xbd, 0x5e, 0xca, 0x39, 0x46, 0x91, 0x7f, 0x64, 0x4a, 0xe1, 0x42, 0x9f, 0x36, 0xf7, 0x09, 0x0b,
+  0x29, 0xd7, 0x69, 0x42, 0xee, 0x2d, 0x74, 0x9c, 0xc8, 0x78, 0x8e, 0xed, 0xa8, 0x66, 0xe6, 0x8e,
+  0x2f, 0x98, 0xcc, 0x4c, 0x30, 0xc9, 0xd7, 0x10, 0x74, 0x1e, 0xf6, 0x40, 0x43, 0x2c, 0xa4, 0x60,
+  0x78, 0x80, 0x9e, 0xba, 0xe8, 0xa7, 0x7e, 0xbf, 0x0f, 0x9a, 0x9f, 0xce, 0xce, 0x0a, 0x04, 0x4a,
+  0x24, 0xa1, 0x23, 0x66, 0x0c, 0x17, 0x53, 0x1d, 0xf8, 0xe5, 0x4e, 0x98, 0x89, 0x67, 0x01, 0xee,
+  0x91, 0x94, 0xf7, 0x74, 0x3e, 0x84, 0x3b, 0xa1, 0x99, 0x31, 0x11, 0xa8, 0xe1, 0x4b, 0x15, 0x7e,
+  0xd5, 0xf6, 0x53, 0xb9, 0x84, 0x0e, 0x5f, 0x5a, 0x10, 0x3a, 0xe8, 0x1c, 0xbc, 0xe2, 0x13, 0x3e,
+  0x1a, 0xdd, 0xbc, 0x01, 0x1d, 0x4b, 0x92, 0x64, 0xd6, 0x03, 0x34, 0x2c, 0x84, 0xe8, 0xf1, 0x11,
+  0x61, 0xb7, 0x9e, 0x23, 0x1a, 0x34, 0x53, 0x4b, 0xf9, 0x21, 0x65, 0xa2, 0xa2, 0xa2, 0x94, 0xb6,
+  0x41, 0x5f, 0x27, 0x52, 0xb3, 0x7d, 0xb8, 0x13, 0xb7, 0xc1, 0xbf, 0xe7, 0xe2, 0xf6, 0xd3, 0x3e,
+  0xde, 0x89, 0x5b, 0xe1, 0xc9, 0xba, 0x16, 0x6f, 0xc5, 0x0d, 0xf8, 0x85, 0x5c, 0x32, 0x1b, 0xe9,
+  0x0a, 0xba, 0x10, 0x36, 0x60, 0x19, 0xd1, 0x10, 0xbe, 0x0a, 0xd2, 0x8b, 0x1a, 0x70, 0x8a, 0x88,
+  0x29, 0x83, 0xc5, 0x55, 0x90, 0x85, 0xb0, 0x15, 0x96, 0xac, 0x6b, 0xb0, 0x64, 0xdd, 0xc6, 0x57,
+  0xb7, 0xd2, 0xe5, 0x5b, 0x65, 0x2b, 0xe5, 0xfe, 0x82, 0xa1, 0x06, 0x0d, 0x12, 0x12, 0xe2, 0x4a,
+  0x4c, 0x13, 0xf6, 0x06, 0xf2, 0xff, 0x90, 0x9a, 0x16, 0x59, 0x13, 0xdb, 0xcc, 0x68, 0x54, 0xd4,
+  0x26, 0x7f, 0x16, 0x64, 0xfd, 0x5a, 0xf1, 0xe9, 0xcc, 0x54, 0x03, 0x58, 0x48, 0x9b, 0x3c, 0x62,
+  0xc8, 0x78, 0x2f, 0xfa, 0x85, 0xb0, 0x01, 0x4b, 0x59, 0x62, 0xc8, 0xad, 0xe4, 0xa2, 0xfa, 0xe9,
+  0x8d, 0xb8, 0xe9, 0xdb, 0xb3, 0xcc, 0xc8, 0xc9, 0xa4, 0x9a, 0x07, 0xef, 0x89, 0x99, 0x85, 0x4a,
+  0x66, 0x82, 0x06, 0x60, 0x88, 0x9f, 0x61, 0x6d, 0x41, 0x3d, 0xf4, 0x4b, 0xdf, 0x17, 0x18, 0xab,
+  0x94, 0x4f, 0x10, 0x8c, 0xcf, 0x18, 0x31, 0xef, 0xc8, 0x0a, 0x9d, 0x0f, 0x87, 0x08, 0x10, 0x6c,
+  0xc2, 0x05, 0xa3, 0xbe, 0xcc, 0x1c, 0xfd, 0x72, 0x8e, 0xab, 0x98, 0x9d, 0xcb, 0x06, 0x6d, 0xb0,
+  0x7f, 0xa4, 0x5b, 0xd0, 0x0b, 0x1a, 0xce, 0xd3, 0xd0, 0xc8, 0xdf, 0xf8, 0x9a, 0xd1, 0xe0, 0x79,
+  0xa7, 0x9d, 0x06, 0xbe, 0xa3, 0x81, 0x97, 0x1a, 0x5e, 0xb4, 0xd4, 0x40, 0x77, 0x34, 0xd0, 0x52,
+  0xc3, 0xb3, 0x66, 0x0d, 0x0b, 0x09, 0x61, 0xfa, 0xc8, 0x2b, 0x45, 0xeb, 0xc2, 0xee, 0xfb, 0x5c,
+  0x7c, 0xb2, 0xae, 0x3b, 0x92, 0x1d, 0x8a, 0x62, 0x31, 0x9e, 0x6b, 0x7a, 0x82, 0xdf, 0xa7, 0x9d,
+  0x73, 0x42, 0x64, 0x74, 0xca, 0x02, 0xca, 0x55, 0xdd, 0x19, 0x01, 0x1b, 0xa1, 0xe7, 0x26, 0xbc,
+  0x82, 0x09, 0x43, 0x7c, 0x01, 0xbf, 0x5d, 0xf4, 0xb0, 0x60, 0x66, 0x26, 0x69, 0x84, 0x6f, 0x3f,
+  0x8c, 0xee, 0xf0, 0x53, 0xf3, 0x01, 0xe2, 0x33, 0x46, 0xce, 0x5b, 0xa4, 0xc7, 0x91, 0x32, 0x91,
+  0x16, 0x15, 0xe2, 0x1b, 0x6a, 0x84, 0x2c, 0xcb, 0xc3, 0xb7, 0x14, 0x88, 0x78, 0x53, 0x1b, 0xbc,
+  0x47, 0xc3, 0x98, 0x58, 0xaf, 0x05, 0x1d, 0x58, 0xf1, 0xae, 0x7f, 0xe1, 0xa0, 0xbd, 0xd2, 0xb6,
+  0x2c, 0x05, 0x87, 0x1c, 0x0c, 0x33, 0xac, 0x5d, 0xf8, 0xfb, 0x7a, 0xf6, 0x7f, 0x71, 0x4d, 0xfd,
+  0x79, 0xbd, 0x0d, 0x2d, 0xc8, 0x16, 0x86, 0x70, 0xc1, 0x3f, 0x2c, 0xca, 0xa8, 0x8c, 0x75, 0x11,
+  0xb6, 0x28, 0x44, 0xac, 0x01, 0xd6, 0x25, 0xc8, 0x48, 0x47, 0x94, 0x3c, 0x18, 0x1e, 0xf0, 0xdf,
+  0x59, 0xbf, 0xff, 0xba, 0x8f, 0x3b, 0x07, 0xfc, 0xba, 0xaf, 0x77, 0x42, 0x12, 0x6d, 0x15, 0x7f,
+  0x64, 0xff, 0x64, 0x4c, 0x1b, 0x78, 0xe7, 0x09, 0x83, 0x9d, 0x59, 0xe7, 0x7f, 0x57, 0xcd, 0x8f,
+  0x05, 0xc0, 0x85, 0xf4, 0x3b, 0x47, 0xe0, 0x94, 0xbc, 0x3a, 0x9d, 0xf5, 0x54, 0xc0, 0x07, 0xa3,
+  0xe0, 0x70, 0x75, 0x61, 0x70, 0xf0, 0xef, 0x19, 0x07, 0x98, 0x6f, 0x4a, 0x3e, 0xca, 0x04, 0x4d,
+  0xed, 0x31, 0xd5, 0x45, 0x94, 0x18, 0xd2, 0x45, 0xc0, 0x8e, 0x6f, 0xe8, 0x7e, 0x78, 0xac, 0x69,
+  0x9b, 0xa9, 0xde, 0xc1, 0x79, 0x80, 0x90, 0x8f, 0x50, 0xd7, 0xc9, 0xa0, 0x28, 0x53, 0xa6, 0x74,
+  0x84, 0x1e, 0x70, 0xee, 0xcf, 0xcb, 0xbb, 0xfb, 0x94, 0xe1, 0x08, 0x93, 0x34, 0x4d, 0x38, 0x58,
+  0x0f, 0x16, 0xf4, 0xd6, 0x97, 0xab, 0xd5, 0xea, 0x72, 0x22, 0xd5, 0xe2, 0x32, 0x53, 0x09, 0x13,
+  0x31, 0x14, 0x47, 0x8a, 0x9f, 0xbc, 0x8a, 0xb1, 0xa4, 0xf7, 0x11, 0xfa, 0x30, 0xfe, 0xca, 0x62,
+  0x13, 0x82, 0x02, 0xc5, 0x99, 0x0e, 0xac, 0x71, 0x1d, 0x38, 0xd0, 0xd3, 0x20, 0xf8, 0x3c, 0xef,
+  0x2e, 0xbf, 0xc0, 0xfa, 0xe7, 0x17, 0x18, 0xea, 0xa0, 0x07, 0xff, 0xf5, 0xf1, 0xe6, 0x5a, 0x2e,
+  0x52, 0x60, 0xe1, 0xc2, 0x04, 0x4b, 0x48, 0x8d, 0xaf, 0x60, 0x68, 0x80, 0x7f, 0xc0, 0x1d, 0xef,
+  0xb5, 0xa6, 0xdc, 0x29, 0x7c, 0xe9, 0x56, 0xdf, 0xb5, 0x7b, 0x61, 0xee, 0x7f, 0x6d, 0xef, 0x30,
+  0x22, 0x4b, 0x46, 0xcf, 0x6d, 0xef, 0x00, 0xf9, 0x05, 0x9d, 0x83, 0x54, 0x8f, 0x8f, 0xf8, 0xad,
+  0xfd, 0x77, 0xae, 0x3d, 0x10, 0x96, 0x5c, 0x55, 0xdb, 0xbd, 0x01, 0xdf, 0xf8, 0x04, 0x7c, 0x3d,
+  0xdf, 0x19, 0x95, 0x10, 0x39, 0x76, 0x8f, 0x0b, 0xaf, 0x6b, 0xcd, 0xc1, 0xe7, 0xad, 0x3b, 0x01,
+  0xef, 0xd3, 0x14, 0x3a, 0xa3, 0x06, 0xd0, 0x2d, 0x4c, 0x29, 0x40, 0x76, 0x4d, 0x60, 0xb3, 0x15,
+  0xdb, 0xcc, 0xaa, 0xb1, 0x75, 0x64, 0x53, 0xbf, 0xd6, 0x58, 0xb7, 0x29, 0x4a, 0x6b, 0x6d, 0x4d,
+  0x89, 0x4e, 0xa8, 0x62, 0xde, 0x5c, 0xb7, 0x05, 0xa2, 0x53, 0x36, 0x9e, 0xc7, 0x2d, 0xb8, 0x48,
+  0x57, 0xd1, 0x29, 0x6d, 0x46, 0x8e, 0x23, 0xeb, 0x16, 0xb8, 0xed, 0xf6, 0x22, 0xc7, 0x41, 0x87,
+  0x60, 0x80, 0x97, 0x45, 0xed, 0x3b, 0x0b, 0x0f, 0xf4, 0x0d, 0x42, 0xd4, 0xb6, 0xa9, 0xf0, 0x20,
+  0xc7, 0xef, 0x61, 0x89, 0x51, 0xfb, 0x9e, 0x62, 0x1b, 0x48, 0xd6, 0x51, 0xfb, 0x86, 0x22, 0xcf,
+  0x00, 0xbf, 0xf0, 0xfa, 0x14, 0x78, 0x67, 0x99, 0x75, 0x6d, 0x0a, 0x24, 0x8e, 0x89, 0x97, 0x65,
+  0x82, 0xac, 0xc7, 0x8e, 0x85, 0x47, 0x27, 0xf0, 0x77, 0x6f, 0xb8, 0xe5, 0xe0, 0x0d, 0xfe, 0xdd,
+  0xe5, 0xee, 0xb9, 0xe1, 0xce, 0x84, 0x03, 0x86, 0xff, 0x0e, 0xc4, 0x91, 0xa9, 0x5a, 0xcb, 0x67,
+  0x6e, 0xa8, 0x34, 0xdd, 0xb1, 0xf8, 0xe8, 0x14, 0xf2, 0x9f, 0xdb, 0xed, 0x29, 0x7b, 0x04, 0xfb,
+  0x4e, 0x69, 0x76, 0x03, 0x35, 0xe9, 0x04, 0xfe, 0xdf, 0x41, 0x3f, 0x7a, 0x96, 0xef, 0x75, 0x25,
+  0xe4, 0x58, 0x66, 0xee, 0x90, 0x78, 0x0f, 0x99, 0xa7, 0x51, 0x5b, 0xea, 0x9e, 0x03, 0x78, 0xd4,
+  0x96, 0xa9, 0xe7, 0x00, 0x1a, 0xb5, 0x25, 0xe6, 0x79, 0x0a, 0x72, 0x7d, 0x7c, 0x97, 0xec, 0x30,
+  0x71, 0x8f, 0x32, 0x24, 0x8b, 0xda, 0x53, 0xee, 0x3c, 0xf4, 0x3e, 0x86, 0x9b, 0xd8, 0xf7, 0x7a,
+  0xe8, 0x6e, 0xc6, 0x90, 0x17, 0x23, 0xa9, 0x63, 0x9e, 0x24, 0xf0, 0xa8, 0x11, 0x71, 0xdc, 0x1c,
+  0x71, 0xa3, 0xe1, 0x43, 0x0a, 0xb4, 0x23, 0x38, 0x91, 0x10, 0x81, 0x73, 0x6f, 0x65, 0x2b, 0x49,
+  0x06, 0x73, 0x06, 0x08, 0xce, 0x09, 0x24, 0xd8, 0xca, 0x6a, 0x99, 0x12, 0x2e, 0x2c, 0x8a, 0xb9,
+  0x2c, 0xa2, 0x70, 0x76, 0x53, 0x77, 0x70, 0x08, 0xb4, 0x82, 0xc3, 0x04, 0xf4, 0x20, 0x68, 0xbd,
+  0xb8, 0x9e, 0x31, 0xbd, 0x95, 0x6f, 0xa0, 0xd9, 0x5c, 0x41, 0x88, 0x4d, 0x26, 0xea, 0x68, 0x4f,
+  0xbc, 0xa0, 0xaf, 0x88, 0x9b, 0x3a, 0x24, 0xf9, 0xac, 0x83, 0xdc, 0xc7, 0x91, 0xda, 0xca, 0x71,
+  0xb5, 0xb5, 0xd6, 0x92, 0x57, 0x14, 0x1f, 0x43, 0x2a, 0x13, 0x02, 0xb2, 0x3a, 0x0c, 0xc3, 0x82,
+  0x42, 0xd8, 0x4b, 0xb6, 0x54, 0x26, 0xf6, 0x9a, 0x0d, 0x18, 0x07, 0xa4, 0x25, 0xec, 0x6e, 0x92,
+  0x6c, 0x5f, 0x6d, 0xe5, 0xa4, 0xe5, 0x3f, 0x5e, 0x4f, 0x6d, 0x58, 0x58, 0xb1, 0x16, 0x34, 0x84,
+  0xa6, 0xf4, 0x59, 0x07, 0x29, 0x66, 0x32, 0x55, 0x32, 0x53, 0x5b, 0xe0, 0x19, 0x51, 0xa5, 0x01,
+  0xd6, 0xa6, 0xce, 0xe0, 0x98, 0x8a, 0xe7, 0x9d, 0x9d, 0x5b, 0xb4, 0xcd, 0xec, 0x5a, 0x5f, 0xec,
+  0xc2, 0xf7, 0x25, 0xf6, 0x60, 0x2f, 0x5d, 0x45, 0xed, 0xf5, 0x9d, 0xbd, 0x1b, 0x2c, 0x25, 0xc5,
+  0x31, 0x5d, 0x7c, 0x67, 0xbf, 0xb3, 0x70, 0xd2, 0x2e, 0xfa, 0xb9, 0x68, 0xc7, 0xeb, 0xb9, 0xd9,
+  0xb6, 0x51, 0xed, 0x69, 0xf2, 0x35, 0x51, 0xf4, 0xad, 0x20, 0x63, 0x18, 0x0e, 0x62, 0x78, 0xb6,
+  0x44, 0x82, 0xf9, 0xf7, 0x96, 0xd7, 0xa5, 0x1e, 0xe5, 0x0c, 0xb3, 0xee, 0x3c, 0x67, 0xc9, 0x76,
+  0x10, 0x2c, 0x7c, 0x6c, 0x20, 0x99, 0x87, 0xf6, 0x2e, 0x13, 0xac, 0x51, 0xf7, 0x23, 0x96, 0x00,
+  0xdf, 0x92, 0xea, 0x2a, 0x49, 0x02, 0x3c, 0xce, 0x8c, 0x91, 0xc2, 0xaf, 0xde, 0xce, 0x85, 0x63,
+  0x35, 0x33, 0x07, 0x67, 0xbb, 0xd1, 0x2e, 0xd8, 0x6d, 0x65, 0x1e, 0x64, 0x37, 0x52, 0xe0, 0x90,
+  0x00, 0xea, 0x0f, 0xe0, 0xef, 0x57, 0xf7, 0xc1, 0x10, 0xc8, 0xde, 0xd4, 0xcc, 0x40, 0x70, 0x71,
+  0xd1, 0x71, 0x92, 0xcf, 0xfc, 0x8b, 0xbd, 0x46, 0x75, 0x6b, 0x83, 0xb9, 0xe7, 0xf9, 0x32, 0x0f,
+  0x29, 0xf1, 0x96, 0x54, 0xd5, 0x78, 0xd9, 0x11, 0x45, 0xe5, 0x7d, 0xad, 0x4c, 0x49, 0xcc, 0x8d,
+  0xbd, 0xe4, 0xcd, 0x47, 0x6d, 0x16, 0x3c, 0x73, 0x91, 0xef, 0x87, 0x2f, 0x70, 0x35, 0x0e, 0xf1,
+  0x8c, 0xc5, 0xf3, 0x37, 0x6c, 0xc9, 0x63, 0x76, 0xab, 0x98, 0x06, 0xa2, 0x59, 0xdb, 0xb7, 0x18,
+  0x62, 0xb2, 0x36, 0x9b, 0x63, 0x27, 0xac, 0x65, 0x7f, 0x6d, 0x85, 0x2e, 0x63, 0x63, 0x60, 0x0a,
+  0x6a, 0x04, 0xea, 0x98, 0xbb, 0xca, 0x29, 0x2e, 0x79, 0x6a, 0x71, 0xc0, 0xad, 0x27, 0x7c, 0x7a,
+  0x2a, 0xd4, 0x1d, 0x8a, 0x1b, 0x10, 0x49, 0x9a, 0x21, 0x3e, 0x7f, 0x4b, 0x8c, 0x7f, 0xdd, 0x85,
+  0xd5, 0xb6, 0xdd, 0xbb, 0xfb, 0xb5, 0xd6, 0x9d, 0x83, 0xb3, 0x7f, 0x01, 0xce, 0x48, 0x5c, 0x8f,
+  0x1c, 0x18, 0x00, 0x00,
+};
+
+// 24279 bytes, 6417 gzipped
+static const WebAsset WEB_ASSETS[] = {
+  {"/", "text/html", WEB_DASHBOARD_HTML, sizeof(WEB_DASHBOARD_HTML), "\"f3c71aa8a23a8fb1\""},
+  {"/setup", "text/html", WEB_SETUP_HTML, sizeof(WEB_SETUP_HTML), "\"b2b480d1260eaa44\""},
+  {"/style.css", "text/css", WEB_STYLE_CSS, sizeof(WEB_STYLE_CSS), "\"5a5a5aaf2a877006\""},
+  {"/dashboard.js", "application/javascript", WEB_DASHBOARD_JS, sizeof(WEB_DASHBOARD_JS), "\"a038ae4b53e2a38f\""},
+  {"/setup.js", "application/javascript", WEB_SETUP_JS, sizeof(WEB_SETUP_JS), "\"e42fb3aa0987d354\""},
+};
+
+static const size_t WEB_ASSET_COUNT = sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]);
+
+#endif // WEB_ASSETS_H
@@ -0,0 +1,244 @@
+/*
+  web_events.cpp - Live status stream (Server-Sent Events) for the dashboard
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#include "web_events.h"
+#include "device_state.h"
+#include "json_writer.h"
+#include "Debug.h"
+#include <errno.h>
+#include <sys/socket.h>
+
+// Same names and order as /api/status
+static const char* const FIELD_NAMES[] = {
+  "coverState", "calState", "brightness", "maxBrightness", "heaterState",
+  "heaterTemp", "outsideTemp", "humidity", "dewPoint", "heaterPWM",
+};
+
+static const char EVENT_PREFIX[] = "data: ";
+static const size_t EVENT_PREFIX_LEN = sizeof(EVENT_PREFIX) - 1;
+
+// Singleton accessor
+WebEvents& getWebEvents() {
+  static WebEvents instance;
+  return instance;
+}
+
+void WebEvents::begin() {
+  // The server and its streams survive WiFi reconnects
+  if (_running) return;
+
+  _joins = xQueueCreate(WEB_EVENTS_MAX_CLIENTS, sizeof(httpd_req_t*));
+
+  httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+  config.server_port = WEB_EVENTS_PORT;
+  config.ctrl_port = WEB_EVENTS_CTRL_PORT;
+  config.core_id = WEB_EVENTS_TASK_CORE;
+  config.max_open_sockets = WEB_EVENTS_MAX_CLIENTS + 1;
+  config.max_uri_handlers = WEB_EVENTS_MAX_HANDLERS;
+  config.send_wait_timeout = WEB_EVENTS_SEND_TIMEOUT;
+
+  if (httpd_start(&_server, &config) != ESP_OK) {
+    Debug::errorf("EVENTS", "Server failed to start on port %d", WEB_EVENTS_PORT);
+    return;
+  }
+
+  httpd_uri_t uri = {};
+  uri.uri = "/events";
+  uri.method = HTTP_GET;
+  uri.handler = handleEvents;
+  uri.user_ctx = this;
+  httpd_register_uri_handler(_server, &uri);
+
+  xTaskCreatePinnedToCore(senderTask, "events", WEB_EVENTS_TASK_STACK, this,
+                          WEB_EVENTS_TASK_PRIORITY, &_task, WEB_EVENTS_TASK_CORE);
+  _running = true;
+
+  Debug::infof("EVENTS", "Status stream on port %d (/events)", WEB_EVENTS_PORT);
+}
+
+bool WebEvents::addHandler(const char* uri, esp_err_t (*handler)(httpd_req_t* req), void* ctx) {
+  if (!_running) return false;
+  httpd_uri_t entry = {};
+  entry.uri = uri;
+  entry.method = HTTP_GET;
+  entry.handler = handler;
+  entry.user_ctx = ctx;
+  esp_err_t err = httpd_register_uri_handler(_server, &entry);
+  return err == ESP_OK || err == ESP_ERR_HTTPD_HANDLER_EXISTS;
+}
+
+// httpd task: sends the headers, then hands the open response to the
+// sender task. The page is served from WEB_PORT, so CORS must allow it.
+esp_err_t WebEvents::handleEvents(httpd_req_t* req) {
+  WebEvents* self = (WebEvents*)req->user_ctx;
+  httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+
+  if (self->_open.fetch_add(1) >= WEB_EVENTS_MAX_CLIENTS) {
+    // EventSource gives up on a non-200 reply and the dashboard polls instead
+    self->_open--;
+    httpd_resp_set_status(req, HTTPD_503);
+    return httpd_resp_sendstr(req, "Too many event streams");
+  }
+
+  httpd_resp_set_type(req, "text/event-stream");
+  httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+
+  // "retry" sets the browser's reconnect delay (ms) after a dropped stream
+  httpd_req_t* async = nullptr;
+  if (httpd_resp_send_chunk(req, "retry: 3000\n\n", HTTPD_RESP_USE_STRLEN) != ESP_OK ||
+      httpd_req_async_handler_begin(req, &async) != ESP_OK) {
+    self->_open--;
+    return ESP_FAIL;
+  }
+
+  // The queue holds WEB_EVENTS_MAX_CLIENTS, so there is always room
+  xQueueSend(self->_joins, &async, 0);
+  return ESP_OK;
+}
+
+// ============================================================
+// Sender task
+// ============================================================
+
+void WebEvents::senderTask(void* param) {
+  WebEvents* self = (WebEvents*)param;
+  httpd_req_t* joined[WEB_EVENTS_MAX_CLIENTS];
+
+  for (;;) {
+    // Sleeps for one poll interval unless a new stream arrives
+    uint8_t joinCount = 0;
+    while (joinCount < WEB_EVENTS_MAX_CLIENTS &&
+           xQueueReceive(self->_joins, &joined[joinCount],
+                         joinCount == 0 ? pdMS_TO_TICKS(WEB_EVENTS_POLL_MS) : 0) == pdTRUE) {
+      joinCount++;
+    }
+
+    // Nothing is rendered while no dashboard is open
+    uint32_t version = deviceState.version();
+    if ((version != self->_sentVersion && self->_clientCount > 0) || joinCount > 0) {
+      self->_sentVersion = version;
+      self->sendChanges(joined, joinCount);
+    }
+
+    self->dropClosed();
+
+    if (self->_clientCount > 0 && millis() - self->_lastSend >= WEB_EVENTS_KEEPALIVE) {
+      self->sendKeepAlive();
+    }
+  }
+}
+
+// Open streams get the fields that changed since the last event, new ones
+// get every field. Publishes that change nothing visible (a sensor read
+// with the same rounded values) send nothing.
+void WebEvents::sendChanges(httpd_req_t* const* joined, uint8_t joinCount) {
+  FieldText fields[FIELD_COUNT];
+  renderFields(fields);
+
+  size_t length = buildEvent(fields, false);
+  if (length > 0) {
+    for (uint8_t i = _clientCount; i-- > 0;) sendTo(i, _event, length);
+  }
+  memcpy(_sent, fields, sizeof(_sent));
+
+  if (joinCount == 0) return;
+  length = buildEvent(fields, true);
+  for (uint8_t j = 0; j < joinCount; j++) {
+    addClient(joined[j]);
+    sendTo(_clientCount - 1, _event, length);
+  }
+}
+
+// A comment line: ignored by EventSource, but a failed send finds clients
+// that went away without closing the connection
+void WebEvents::sendKeepAlive() {
+  for (uint8_t i = _clientCount; i-- > 0;) sendTo(i, ":\n\n", 3);
+  _lastSend = millis();
+}
+
+// "data: {...}\n\n" into _event. Returns its length, or 0 when a delta
+// has no changed field.
+size_t WebEvents::buildEvent(const FieldText* fields, bool full) {
+  memcpy(_event, EVENT_PREFIX, EVENT_PREFIX_LEN);
+  JsonWriter json(_event + EVENT_PREFIX_LEN, sizeof(_event) - EVENT_PREFIX_LEN - 2);
+  bool any = false;
+
+  json.beginObject();
+  for (uint8_t i = 0; i < FIELD_COUNT; i++) {
+    if (!full && strcmp(fields[i], _sent[i]) == 0) continue;
+    json.key(FIELD_NAMES[i]);
+    json.valueRaw(fields[i]);
+    any = true;
+  }
+  if (full) json.field("version", DLC_VERSION);
+  json.endObject();
+
+  if (!any || json.overflowed()) return 0;
+  size_t length = EVENT_PREFIX_LEN + json.length();
+  memcpy(_event + length, "\n\n", 2);
+  return length + 2;
+}
+
+bool WebEvents::sendTo(uint8_t index, const char* data, size_t length) {
+  if (httpd_resp_send_chunk(_clients[index], data, length) == ESP_OK) {
+    _lastSend = millis();
+    return true;
+  }
+  dropClient(index);
+  return false;
+}
+
+void WebEvents::addClient(httpd_req_t* req) {
+  _clients[_clientCount++] = req;
+  Debug::infof("EVENTS", "Stream opened (%d open)", _clientCount);
+}
+
+// A closed tab frees its slot at once instead of at the next keepalive:
+// a non-blocking peek reads end-of-stream (0) or a reset from the socket
+void WebEvents::dropClosed() {
+  for (uint8_t i = _clientCount; i-- > 0;) {
+    char c;
+    int n = recv(httpd_req_to_sockfd(_clients[i]), &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) dropClient(i);
+  }
+}
+
+// The client is gone: completing the request releases its socket
+void WebEvents::dropClient(uint8_t index) {
+  httpd_req_async_handler_complete(_clients[index]);
+  _clients[index] = _clients[--_clientCount];
+  _open--;
+  Debug::infof("EVENTS", "Stream closed (%d open)", _clientCount);
+}
+
+// JSON text of each field, rounded as the dashboard shows it, so that
+// comparing the text finds the changes worth sending
+void WebEvents::renderFields(FieldText* fields) {
+  DeviceSnapshot state = deviceState.read();
+
+  snprintf(fields[0], FIELD_TEXT_LEN, "%d", (int)state.devices[0].coverState);
+  snprintf(fields[1], FIELD_TEXT_LEN, "%d", (int)state.devices[0].calibratorState);
+  snprintf(fields[2], FIELD_TEXT_LEN, "%u", (unsigned)state.devices[0].brightness);
+  snprintf(fields[3], FIELD_TEXT_LEN, "%u", (unsigned)state.devices[0].maxBrightness);
+  snprintf(fields[4], FIELD_TEXT_LEN, "%d", (int)state.heaterState);
+
+  #ifdef HEATER_INSTALLED
+    const float readings[] = {state.heater.heaterTemp, state.heater.outsideTemp,
+                              state.heater.humidity, state.heater.dewPoint};
+    for (uint8_t i = 0; i < 4; i++) {
+      if (isnan(readings[i])) {
+        strcpy(fields[5 + i], "null");
+      } else {
+        snprintf(fields[5 + i], FIELD_TEXT_LEN, "%.1f", readings[i]);
+      }
+    }
+    snprintf(fields[9], FIELD_TEXT_LEN, "%u", (unsigned)state.heater.heaterPWM);
+  #else
+    for (uint8_t i = 5; i < FIELD_COUNT; i++) strcpy(fields[i], "null");
+  #endif
+}
@@ -0,0 +1,72 @@
+/*
+  web_events.h - Live status stream (Server-Sent Events) for the dashboard
+  DarkLight Cover Calibrator - ESP32-S3 Port
+
+  GET /events on WEB_EVENTS_PORT opens a text/event-stream. The first event
+  carries every /api/status field; after that an event is sent only when
+  a field changes, and carries just the changed fields. A sender task
+  watches deviceState.version() and costs nothing while the state is idle.
+  The stream has its own small esp_http_server so that held connections
+  never block the synchronous WebServer on WEB_PORT; addHandler() puts
+  other long responses (the history export) on it too.
+
+  (c) Copyright Nathan Woelfle 2020-present day. All Rights Reserved.
+  Creative Commons Attribution-NonCommercial 4.0 International License
+*/
+
+#ifndef WEB_EVENTS_H
+#define WEB_EVENTS_H
+
+#include <Arduino.h>
+#include <esp_http_server.h>
+#include <atomic>
+#include "config.h"
+
+class WebEvents {
+public:
+  void begin();
+  bool isRunning() const { return _running; }
+
+  // GET handler for another URI on this server, false if it is not running
+  bool addHandler(const char* uri, esp_err_t (*handler)(httpd_req_t* req), void* ctx);
+
+private:
+  static const uint8_t FIELD_COUNT = 10;
+  static const size_t  FIELD_TEXT_LEN = 8;   // "-1234.5", "65535", "null"
+
+  typedef char FieldText[FIELD_TEXT_LEN];
+
+  httpd_handle_t _server = nullptr;
+  TaskHandle_t   _task = nullptr;
+  QueueHandle_t  _joins = nullptr;           // async requests handed over by the httpd task
+  std::atomic<uint8_t> _open{0};             // streams accepted by the handler and not yet dropped
+  bool _running = false;
+
+  // Sender task only
+  httpd_req_t* _clients[WEB_EVENTS_MAX_CLIENTS] = {};
+  uint8_t   _clientCount = 0;
+  uint32_t  _sentVersion = 0;
+  FieldText _sent[FIELD_COUNT] = {};         // field values in the last event
+  uint32_t  _lastSend = 0;
+  char      _event[WEB_EVENTS_EVENT_LEN];
+
+  static esp_err_t handleEvents(httpd_req_t* req);
+  static void senderTask(void* param);
+
+  void sendChanges(httpd_req_t* const* joined, uint8_t joinCount);
+  void sendKeepAlive();
+  size_t buildEvent(const FieldText* fields, bool full);
+  bool sendTo(uint8_t index, const char* data, size_t length);
+  void addClient(httpd_req_t* req);
+  void dropClient(uint8_t index);
+  void dropClosed();
+
+  static void renderFields(FieldText* fields);
+
+  WebEvents() {}
+  friend WebEvents& getWebEvents();
+};
+
+WebEvents& getWebEvents();
+
+#endif // WEB_EVENTS_H
@@ -7,14 +7,21 @@
 */
 
 #include "web_ui_handler.h"
-#include "html_templates.h"
+#include "web_assets.h"
+#include "web_events.h"
+#include "alpaca_handler.h"
 #include "storage_manager.h"
 #include "Debug.h"
+#include "perf_monitor.h"
+#include "telemetry_history.h"
+#include "device_state.h"
 #include <ArduinoJson.h>
 #include <ElegantOTA.h>
+#include <sys/select.h>
 
 #ifdef COVER_INSTALLED
   #include "cover_controller.h"
+  #include "easing.h"
 #endif
 #ifdef LIGHT_INSTALLED
   #include "light_controller.h"
@@ -30,9 +37,16 @@ WebUIHandler& getWebUIHandler() {
 }
 
 void WebUIHandler::begin() {
+  static const char* headerKeys[] = {"If-None-Match"};
+  _server.collectHeaders(headerKeys, 1);
   setupRoutes();
   ElegantOTA.begin(&_server);
   _server.begin();
+  getWebEvents().begin();
+  #ifdef ENABLE_TELEMETRY_HISTORY
+    if (!_historyJoins) _historyJoins = xQueueCreate(1, sizeof(HistoryExport));
+    getWebEvents().addHandler("/api/history", handleHistoryExport, this);
+  #endif
   _running = true;
   Debug::infof("WEBUI", "Web server started on port %d (OTA at /update)", WEB_PORT);
 }
@@ -41,11 +55,16 @@ void WebUIHandler::loop() {
   if (!_running) return;
   _server.handleClient();
   ElegantOTA.loop();
+  #ifdef ENABLE_TELEMETRY_HISTORY
+    exportHistory();
+  #endif
 }
 
 void WebUIHandler::setupRoutes() {
-  _server.on("/", HTTP_GET, [this]() { handleDashboard(); });
-  _server.on("/setup", HTTP_GET, [this]() { handleSetup(); });
+  for (size_t i = 0; i < WEB_ASSET_COUNT; i++) {
+    const WebAsset* asset = &WEB_ASSETS[i];
+    _server.on(asset->path, HTTP_GET, [this, asset]() { handleAsset(*asset); });
+  }
   _server.on("/api/status", HTTP_GET, [this]() { handleApiStatus(); });
   _server.on("/api/cmd", HTTP_POST, [this]() { handleApiCommand(); });
   _server.on("/api/settings", HTTP_GET, [this]() { handleApiSettings(); });
@@ -57,53 +76,46 @@ void WebUIHandler::setupRoutes() {
   _server.on("/api/light", HTTP_POST, [this]() { handleApiSaveLight(); });
   _server.on("/api/heater", HTTP_POST, [this]() { handleApiSaveHeater(); });
   _server.on("/api/restart", HTTP_POST, [this]() { handleApiRestart(); });
+  _server.on("/api/log", HTTP_GET, [this]() { handleApiLog(); });
+  _server.on("/api/perf", HTTP_GET, [this]() { handleApiPerf(); });
+  _server.on("/api/history", HTTP_GET, [this]() { handleApiHistory(); });
+  _server.on("/api/discovery", HTTP_GET, [this]() { handleApiDiscovery(); });
 }
 
-String WebUIHandler::processTemplate(const char* html) {
-  String page = String(html);
-  page.replace("%STYLE%", getStyleCSS());
-  return page;
-}
+// Pages, CSS and JS are sent gzipped straight from flash. The browser
+// revalidates on every load (no-cache) and gets a bodyless 304 while the
+// ETag still matches.
+void WebUIHandler::handleAsset(const WebAsset& asset) {
+  _server.sendHeader("ETag", asset.etag);
+  _server.sendHeader("Cache-Control", "no-cache");
 
-void WebUIHandler::handleDashboard() {
-  String page = processTemplate(getDashboardHTML());
-  _server.send(200, "text/html", page);
-}
+  String ifNoneMatch = _server.header("If-None-Match");
+  if (ifNoneMatch.indexOf(asset.etag) >= 0 || ifNoneMatch == "*") {
+    _server.send(304);
+    return;
+  }
 
-void WebUIHandler::handleSetup() {
-  String page = processTemplate(getSetupHTML());
-  _server.send(200, "text/html", page);
+  _server.sendHeader("Content-Encoding", "gzip");
+  _server.send_P(200, asset.contentType, (PGM_P)asset.data, asset.length);
 }
 
 void WebUIHandler::handleApiStatus() {
   JsonDocument doc;
+  DeviceSnapshot state = deviceState.read();
 
-  #ifdef COVER_INSTALLED
-    doc["coverState"] = (int)cover.getState();
-  #else
-    doc["coverState"] = (int)COVER_NOT_PRESENT;
-  #endif
-
-  #ifdef LIGHT_INSTALLED
-    doc["calState"] = (int)light.getState();
-    doc["brightness"] = (int)light.getCurrentBrightness();
-    doc["maxBrightness"] = (int)light.getMaxBrightness();
-  #else
-    doc["calState"] = (int)CAL_NOT_PRESENT;
-    doc["brightness"] = 0;
-    doc["maxBrightness"] = 0;
-  #endif
+  doc["coverState"] = (int)state.devices[0].coverState;
+  doc["calState"] = (int)state.devices[0].calibratorState;
+  doc["brightness"] = (int)state.devices[0].brightness;
+  doc["maxBrightness"] = (int)state.devices[0].maxBrightness;
+  doc["heaterState"] = (int)state.heaterState;
 
   #ifdef HEATER_INSTALLED
-    doc["heaterState"] = (int)heater.getState();
-    HeaterData hd = heater.getHeaterData();
-    doc["heaterTemp"] = hd.heaterTemp;
-    doc["outsideTemp"] = hd.outsideTemp;
-    doc["humidity"] = hd.humidity;
-    doc["dewPoint"] = hd.dewPoint;
-    doc["heaterPWM"] = (int)hd.heaterPWM;
+    doc["heaterTemp"] = state.heater.heaterTemp;
+    doc["outsideTemp"] = state.heater.outsideTemp;
+    doc["humidity"] = state.heater.humidity;
+    doc["dewPoint"] = state.heater.dewPoint;
+    doc["heaterPWM"] = (int)state.heater.heaterPWM;
   #else
-    doc["heaterState"] = (int)HEATER_NOT_PRESENT;
     doc["heaterTemp"] = nullptr;
     doc["outsideTemp"] = nullptr;
     doc["humidity"] = nullptr;
@@ -111,6 +123,7 @@ void WebUIHandler::handleApiStatus() {
     doc["heaterPWM"] = nullptr;
   #endif
 
+  doc["stateVersion"] = state.version;
   doc["version"] = DLC_VERSION;
 
   char buffer[512];
@@ -141,6 +154,7 @@ void WebUIHandler::handleApiCommand() {
     else if (action == "manualheat") heater.setManualHeat(true);
     else if (action == "heatonclose") heater.setHeatOnClose(true);
     else if (action == "heateroff") heater.turnOff();
+    else if (action == "autotune") heater.startAutotune();
   #endif
 
   _server.send(200, "application/json", "{\"ok\":true}");
@@ -159,6 +173,7 @@ void WebUIHandler::handleApiSettings() {
     doc["moveTime"] = cover.getMoveTime();
     doc["rangeMin"] = cover.getRangeMin();
     doc["rangeMax"] = cover.getRangeMax();
+    doc["easing"] = cover.getEasing();
     doc["servoPos"] = cover.getCurrentPosition();
   #else
     doc["servoOpen"] = DEFAULT_SERVO_OPEN_ANGLE;
@@ -168,6 +183,7 @@ void WebUIHandler::handleApiSettings() {
     doc["moveTime"] = DEFAULT_TIME_TO_MOVE;
     doc["rangeMin"] = DEFAULT_SERVO_RANGE_MIN;
     doc["rangeMax"] = DEFAULT_SERVO_RANGE_MAX;
+    doc["easing"] = DEFAULT_EASING;
     doc["servoPos"] = 0;
   #endif
 
@@ -180,14 +196,23 @@ void WebUIHandler::handleApiSettings() {
   #endif
 
   #ifdef HEATER_INSTALLED
+    const HeatTuning& tuning = heater.getTuning();
     doc["deltaPoint"] = heater.getDeltaPoint();
     doc["shutoffTime"] = heater.getShutoffTime();
+    doc["heatLaw"] = (int)heater.getControlLaw();
+    doc["kp"] = tuning.kp;
+    doc["ki"] = tuning.ki;
+    doc["kd"] = tuning.kd;
+    doc["modelRise"] = tuning.modelRise;
+    doc["modelTau"] = tuning.modelTau;
+    doc["autotune"] = (int)heater.getAutotuneState();
+    doc["autotuneCycles"] = heater.getAutotuneCycles();
   #else
     doc["deltaPoint"] = DEFAULT_DELTA_POINT;
     doc["shutoffTime"] = DEFAULT_HEATER_SHUTOFF;
   #endif
 
-  char buffer[512];
+  char buffer[768];
   serializeJson(doc, buffer, sizeof(buffer));
   _server.send(200, "application/json", buffer);
 }
@@ -217,6 +242,8 @@ void WebUIHandler::handleApiSaveServo() {
     uint32_t moveTime = _server.arg("movetime").toInt();
     uint16_t rangeMin = _server.arg("rangemin").toInt();
     uint16_t rangeMax = _server.arg("rangemax").toInt();
+    EasingProfile easing = cover.getEasing();
+    Easing::fromName(_server.arg("easing").c_str(), easing);
 
     cover.setServoOpenAngle(openAngle);
     cover.setServoCloseAngle(closeAngle);
@@ -225,6 +252,7 @@ void WebUIHandler::handleApiSaveServo() {
     cover.setMoveTime(moveTime);
     cover.setRangeMin(rangeMin);
     cover.setRangeMax(rangeMax);
+    cover.setEasing(easing);
 
     #ifdef ENABLE_SAVING_TO_MEMORY
       storage.saveServoOpenAngle(openAngle);
@@ -234,6 +262,7 @@ void WebUIHandler::handleApiSaveServo() {
       storage.saveMoveTime(moveTime);
       storage.saveServoRangeMin(rangeMin);
       storage.saveServoRangeMax(rangeMax);
+      storage.saveEasing(easing);
     #endif
 
     Debug::info("WEBUI", "Servo settings saved");
@@ -303,9 +332,22 @@ void WebUIHandler::handleApiSaveHeater() {
     heater.setDeltaPoint(delta);
     heater.setShutoffTime(shutoff);
 
+    // Control law and gains are optional; missing ones keep their value
+    HeatControlLaw law = heater.getControlLaw();
+    HeatControl::fromName(_server.arg("law").c_str(), law);
+    HeatTuning tuning = heater.getTuning();
+    if (_server.hasArg("kp")) tuning.kp = _server.arg("kp").toFloat();
+    if (_server.hasArg("ki")) tuning.ki = _server.arg("ki").toFloat();
+    if (_server.hasArg("kd")) tuning.kd = _server.arg("kd").toFloat();
+    if (_server.hasArg("rise")) tuning.modelRise = _server.arg("rise").toFloat();
+    if (_server.hasArg("tau")) tuning.modelTau = _server.arg("tau").toFloat();
+    heater.setControl(law, tuning);
+
     #ifdef ENABLE_SAVING_TO_MEMORY
       storage.saveDeltaPoint(delta);
       storage.saveShutoffTime(shutoff);
+      storage.saveHeatLaw(law);
+      storage.saveHeatTuning(tuning);
     #endif
 
     Debug::info("WEBUI", "Heater settings saved");
@@ -314,8 +356,250 @@ void WebUIHandler::handleApiSaveHeater() {
   _server.send(200, "application/json", "{\"ok\":true}");
 }
 
+void WebUIHandler::handleApiLog() {
+  char* buf = (char*)malloc(LOG_MEMORY_SIZE + 1);
+  if (!buf) {
+    _server.send(500, "text/plain", "Out of memory");
+    return;
+  }
+  Debug::copyMemoryLog(buf, LOG_MEMORY_SIZE + 1);
+  _server.send(200, "text/plain", String(buf));
+  free(buf);
+}
+
+// Loop profiler; ?reset=1 clears the statistics after reporting them
+void WebUIHandler::handleApiPerf() {
+  #ifdef ENABLE_PERF_MONITOR
+    JsonDocument doc;
+    doc["uptime"] = perf.getUptime();
+    doc["loopRate"] = perf.getLoopRate();
+
+    JsonArray sections = doc["sections"].to<JsonArray>();
+    for (uint8_t i = 0; i < PERF_SECTION_COUNT; i++) {
+      PerfStats stats = perf.getStats((PerfSection)i);
+      if (stats.count == 0) continue;
+      JsonObject s = sections.add<JsonObject>();
+      s["name"] = PerfMonitor::name((PerfSection)i);
+      s["count"] = stats.count;
+      s["min"] = stats.minMicros;
+      s["avg"] = stats.avgMicros;
+      s["max"] = stats.maxMicros;
+      s["p99"] = stats.p99Micros;
+    }
+
+    if (_server.arg("reset") == "1") perf.reset();
+
+    char buffer[1024];
+    serializeJson(doc, buffer, sizeof(buffer));
+    _server.send(200, "application/json", buffer);
+  #else
+    _server.send(404, "application/json", "{\"ok\":false,\"error\":\"Profiler not enabled\"}");
+  #endif
+}
+
+// Telemetry history is written by the events server (WEB_EVENTS_PORT), a few
+// chunks per loop() pass; the old URL redirects there with its query
+void WebUIHandler::handleApiHistory() {
+  #ifdef ENABLE_TELEMETRY_HISTORY
+    // Same host, port + 1, as dashboard.js does for /events
+    String host = _server.hostHeader();
+    uint16_t port = WEB_PORT;
+    int colon = host.lastIndexOf(':');
+    if (colon >= 0 && host.indexOf(']', colon) < 0) {
+      port = host.substring(colon + 1).toInt();
+      host = host.substring(0, colon);
+    }
+
+    String location = "http://" + host + ":" + String(port + 1) + "/api/history";
+    for (int i = 0; i < _server.args(); i++) {
+      location += (i == 0) ? "?" : "&";
+      location += _server.argName(i) + "=" + _server.arg(i);
+    }
+    _server.sendHeader("Location", location);
+    _server.send(307, "application/json", "{\"ok\":true}");
+  #else
+    _server.send(404, "application/json", "{\"ok\":false,\"error\":\"History not enabled\"}");
+  #endif
+}
+
+void WebUIHandler::handleApiDiscovery() {
+  const DiscoveryStats& stats = getAlpacaHandler().getDiscoveryStats();
+  JsonDocument doc;
+  doc["received"] = stats.received;
+  doc["replied"] = stats.replied;
+  doc["rateLimited"] = stats.rateLimited;
+  doc["ignored"] = stats.ignored;
+  doc["sendFailed"] = stats.sendFailed;
+  doc["ipv6"] = stats.ipv6;
+
+  char buffer[192];
+  serializeJson(doc, buffer, sizeof(buffer));
+  _server.send(200, "application/json", buffer);
+}
+
 void WebUIHandler::handleApiRestart() {
   _server.send(200, "application/json", "{\"ok\":true}");
   delay(500);
   ESP.restart();
 }
+
+// ============================================================
+// History export (events server)
+// ============================================================
+
+#ifdef ENABLE_TELEMETRY_HISTORY
+
+static esp_err_t sendHistoryError(httpd_req_t* req, const char* status, const char* body) {
+  httpd_resp_set_status(req, status);
+  httpd_resp_set_type(req, HTTPD_TYPE_JSON);
+  httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+  return httpd_resp_sendstr(req, body);
+}
+
+// httpd task: GET /api/history?res=fine|coarse&since=<s>&format=csv|bin,
+// oldest sample first. Checks the query and hands the request to loop(),
+// which owns the rings. One export at a time.
+esp_err_t WebUIHandler::handleHistoryExport(httpd_req_t* req) {
+  WebUIHandler* self = (WebUIHandler*)req->user_ctx;
+
+  char query[64] = "";
+  char res[8] = "";
+  char format[8] = "";
+  char since[12] = "";
+  if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+    httpd_query_key_value(query, "res", res, sizeof(res));
+    httpd_query_key_value(query, "format", format, sizeof(format));
+    httpd_query_key_value(query, "since", since, sizeof(since));
+  }
+
+  if ((res[0] && strcmp(res, "fine") != 0 && strcmp(res, "coarse") != 0) ||
+      (format[0] && strcmp(format, "csv") != 0 && strcmp(format, "bin") != 0)) {
+    return sendHistoryError(req, HTTPD_400, "{\"ok\":false,\"error\":\"Bad res or format\"}");
+  }
+  if (self->_historyBusy.exchange(true)) {
+    return sendHistoryError(req, HTTPD_503, "{\"ok\":false,\"error\":\"Export in progress\"}");
+  }
+
+  HistoryExport request = {nullptr, strcmp(res, "coarse") == 0 ? HISTORY_COARSE : HISTORY_FINE,
+                           (uint32_t)strtoul(since, nullptr, 10), strcmp(format, "bin") == 0};
+  if (httpd_req_async_handler_begin(req, &request.req) != ESP_OK) {
+    self->_historyBusy = false;
+    return ESP_FAIL;
+  }
+
+  // _historyBusy admits one export, so the queue always has room
+  xQueueSend(self->_historyJoins, &request, 0);
+  return ESP_OK;
+}
+
+void WebUIHandler::exportHistory() {
+  if (!_export.req) {
+    if (!_historyJoins || xQueueReceive(_historyJoins, &_export, 0) != pdTRUE) return;
+    startHistoryExport();
+  }
+
+  for (uint8_t n = 0; n < HISTORY_WEB_CHUNKS; n++) {
+    if (!sendHistoryChunk()) break;
+  }
+}
+
+// Rows are fixed here and followed by time, as <X> does, so samples pushed
+// during the export neither shift nor extend it
+void WebUIHandler::startHistoryExport() {
+  uint16_t first = history.firstAfter(_export.res, _export.since);
+  _exportRows = history.getCount(_export.res) - first;
+  _exportTime = (_exportRows > 0) ? history.getTime(_export.res, first) : 0;
+  _exportStarted = false;
+  _exportLastSend = millis();
+
+  // Headers set before the handover are not kept by the async request
+  snprintf(_exportUptime, sizeof(_exportUptime), "%lu", (unsigned long)history.getUptime());
+  httpd_resp_set_type(_export.req, _export.binary ? "application/octet-stream" : "text/csv");
+  httpd_resp_set_hdr(_export.req, "Access-Control-Allow-Origin", "*");
+  httpd_resp_set_hdr(_export.req, "Cache-Control", "no-store");
+  httpd_resp_set_hdr(_export.req, "X-Uptime", _exportUptime);
+}
+
+// A client that stops reading must not stall loop() in send()
+static bool socketWritable(int fd) {
+  fd_set writable;
+  FD_ZERO(&writable);
+  FD_SET(fd, &writable);
+  struct timeval now = {0, 0};
+  return select(fd + 1, nullptr, &writable, nullptr, &now) > 0;
+}
+
+// Writes one chunk: the CSV header or HistoryExportHeader first, then rows.
+// A row whose sample was overwritten meanwhile keeps its time and loses its
+// values. False once the export is over or the client is not ready.
+bool WebUIHandler::sendHistoryChunk() {
+  if (!socketWritable(httpd_req_to_sockfd(_export.req))) {
+    if (millis() - _exportLastSend >= WEB_EVENTS_SEND_TIMEOUT * 1000UL) {
+      Debug::error("WEBUI", "History export stalled, dropped");
+      endHistoryExport(false);
+    }
+    return false;
+  }
+
+  uint16_t count = history.getCount(_export.res);
+  uint32_t interval = history.getInterval(_export.res);
+  uint32_t newest = history.getNewestTime(_export.res);
+
+  char buffer[HISTORY_CHUNK_SIZE];
+  size_t length = 0;
+
+  if (!_exportStarted) {
+    if (_export.binary) {
+      uint32_t last = (_exportRows > 0) ? _exportTime + (_exportRows - 1) * interval : newest;
+      HistoryExportHeader header = {{'D', 'L', 'C', 'H'}, 1, (uint8_t)sizeof(HistorySample),
+                                    (uint16_t)interval, _exportRows, last};
+      memcpy(buffer, &header, sizeof(header));
+      length = sizeof(header);
+    } else {
+      length = snprintf(buffer, sizeof(buffer), "%s\n", TelemetryHistory::csvHeader());
+    }
+    _exportStarted = true;
+  }
+
+  static const HistorySample GAP = {HISTORY_NO_VALUE, HISTORY_NO_VALUE, HISTORY_NO_VALUE, HISTORY_NO_VALUE,
+                                    0, 0, 0, 0, 0};
+  while (_exportRows > 0) {
+    size_t rowSize = _export.binary ? sizeof(HistorySample) : MAX_SEND_CHARS + 1;
+    if (length + rowSize > sizeof(buffer)) break;
+
+    uint32_t back = (newest - _exportTime) / interval;
+    const HistorySample& sample = (back < count) ? history.getSample(_export.res, count - 1 - back) : GAP;
+    if (_export.binary) {
+      memcpy(buffer + length, &sample, sizeof(HistorySample));
+      length += sizeof(HistorySample);
+    } else if (back < count) {
+      length += TelemetryHistory::formatRow(_exportTime, sample, buffer + length, MAX_SEND_CHARS);
+      buffer[length++] = '\n';
+    } else {
+      length += snprintf(buffer + length, MAX_SEND_CHARS, "%lu,,,,,,,,,\n", (unsigned long)_exportTime);
+    }
+
+    _exportTime += interval;
+    _exportRows--;
+  }
+
+  if (httpd_resp_send_chunk(_export.req, buffer, length) != ESP_OK) {
+    endHistoryExport(false);
+    return false;
+  }
+  _exportLastSend = millis();
+
+  if (_exportRows > 0) return true;
+  endHistoryExport(true);
+  return false;
+}
+
+// Completing the request releases its socket
+void WebUIHandler::endHistoryExport(bool complete) {
+  if (complete) httpd_resp_send_chunk(_export.req, nullptr, 0);
+  httpd_req_async_handler_complete(_export.req);
+  _export.req = nullptr;
+  _historyBusy = false;
+}
+
+#endif // ENABLE_TELEMETRY_HISTORY
@@ -11,7 +11,12 @@
 
 #include <Arduino.h>
 #include <WebServer.h>
+#include <esp_http_server.h>
+#include <atomic>
 #include "config.h"
+#include "telemetry_history.h"
+
+struct WebAsset;
 
 class WebUIHandler {
 public:
@@ -25,9 +30,8 @@ private:
 
   void setupRoutes();
 
-  // Page handlers
-  void handleDashboard();
-  void handleSetup();
+  // Static assets (web_assets.h)
+  void handleAsset(const WebAsset& asset);
 
   // API handlers
   void handleApiStatus();
@@ -41,9 +45,39 @@ private:
   void handleApiSaveLight();
   void handleApiSaveHeater();
   void handleApiRestart();
+  void handleApiLog();
+  void handleApiPerf();
+  void handleApiHistory();
+  void handleApiDiscovery();
+
+  #ifdef ENABLE_TELEMETRY_HISTORY
+    // /api/history is served by the events server (WEB_EVENTS_PORT): its
+    // handler hands the request over and loop() writes HISTORY_WEB_CHUNKS
+    // chunks per pass, so a whole ring never stalls loop()
+    struct HistoryExport {
+      httpd_req_t* req;
+      HistoryResolution res;
+      uint32_t since;
+      bool binary;
+    };
+
+    QueueHandle_t _historyJoins = nullptr;   // requests handed over by the httpd task
+    std::atomic<bool> _historyBusy{false};   // an export is queued or being written
+
+    // loop() only
+    HistoryExport _export = {};
+    uint32_t _exportTime = 0;                // time of the next row
+    uint16_t _exportRows = 0;                // rows still to write
+    uint32_t _exportLastSend = 0;            // millis() of the last chunk the client took
+    bool     _exportStarted = false;         // header (CSV or binary) written
+    char     _exportUptime[12];              // X-Uptime, kept until the headers are sent
 
-  // Helper
-  String processTemplate(const char* html);
+    static esp_err_t handleHistoryExport(httpd_req_t* req);
+    void exportHistory();
+    void startHistoryExport();
+    bool sendHistoryChunk();
+    void endHistoryExport(bool complete);
+  #endif
 
   WebUIHandler() : _server(WEB_PORT) {}
   friend WebUIHandler& getWebUIHandler();
@@ -42,11 +42,35 @@ For more information, please refer to the full terms of the Creative Commons Att
 #include "darklight_covercalibrator.h"
 #include "indicom.h"
 #include "connectionplugins/connectionserial.h"
-#include <termios.h>
-#include <mutex>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 static std::unique_ptr<DarkLight_CoverCalibrator> mydriver(new DarkLight_CoverCalibrator());
-std::mutex serialMutex;
+
+//how often TimerHit checks on a poll cycle that is still on the wire
+static const uint32_t POLL_CHECK_MS = 20;
+//poll period while the cover is moving, only used with the single frame status command
+static const uint32_t MOVING_POLL_MS = 100;
+
+//split a reply into its fields
+static std::vector<std::string> splitFields(const std::string &response, const char *delimiters)
+{
+    std::vector<std::string> fields;
+    size_t start = 0;
+    while (true)
+    {
+        size_t end = response.find_first_of(delimiters, start);
+        fields.push_back(response.substr(start, end - start));
+        if (end == std::string::npos)
+        {
+            break;
+        }
+        start = end + 1;
+    }
+    return fields;
+}//end of splitFields
 
 DarkLight_CoverCalibrator::DarkLight_CoverCalibrator() : lightDisabled(false), coverIsMoving(false), lightIsReady(true),
     autoOn(false), autoHeatOn(false), heatOnClose(false), heatModeIsChanging(false)
@@ -100,6 +124,10 @@ bool DarkLight_CoverCalibrator::initProperties()
     MoveToSP.fill(getDeviceName(), "MOVE_TO", "Cover", MAIN_CONTROL_TAB, IP_WO, ISR_ATMOST1, 60, IPS_IDLE);
     IDSnoopDevice(getDeviceName(), "MOVE_TO");
 
+    //servo position (reported by firmware with status support)
+    ServoPositionNP[0].fill("SERVO_POSITION", "Servo Angle:", "%0.f", 0, 360, 0, 0);
+    ServoPositionNP.fill(getDeviceName(), "SERVO_POSITION", "Cover", MAIN_CONTROL_TAB, IP_RO, 60, IPS_IDLE);
+
     //----- CALIBRATOR CONTROL -----
     //calibrator state
     CalibratorStateTP[0].fill("CALIBRATOR_STATE", "Light State:", "UNKNOWN");
@@ -159,6 +187,16 @@ bool DarkLight_CoverCalibrator::initProperties()
     TurnHeaterSP.fill(getDeviceName(), "TURN_HEATER", "Heater", MAIN_CONTROL_TAB, IP_WO, ISR_1OFMANY, 60, IPS_IDLE);
     IDSnoopDevice(getDeviceName(), "TURN_HEATER");
 
+    //heater telemetry
+    HeaterDataNP[Heater1_Temp].fill("HEATER1_TEMP", "Heater 1 Temp (C):", "%0.1f", -50, 100, 0, 0);
+    HeaterDataNP[Heater1_PWM].fill("HEATER1_PWM", "Heater 1 Power:", "%0.f", 0, 255, 0, 0);
+    HeaterDataNP[Heater2_Temp].fill("HEATER2_TEMP", "Heater 2 Temp (C):", "%0.1f", -50, 100, 0, 0);
+    HeaterDataNP[Heater2_PWM].fill("HEATER2_PWM", "Heater 2 Power:", "%0.f", 0, 255, 0, 0);
+    HeaterDataNP[Ambient_Temp].fill("AMBIENT_TEMP", "Ambient Temp (C):", "%0.1f", -50, 100, 0, 0);
+    HeaterDataNP[Humidity].fill("HUMIDITY", "Humidity (%):", "%0.1f", 0, 100, 0, 0);
+    HeaterDataNP[Dew_Point].fill("DEW_POINT", "Dew Point (C):", "%0.1f", -50, 100, 0, 0);
+    HeaterDataNP.fill(getDeviceName(), "HEATER_DATA", "Heater", MAIN_CONTROL_TAB, IP_RO, 60, IPS_IDLE);
+
     //----- INITIAL CONTROLS -----
     //stabilize light time
     //set default time
@@ -215,16 +253,15 @@ bool DarkLight_CoverCalibrator::initProperties()
         if (isConnected())
         {
             std::string coverStateText = CoverStateTP[0].getText();
-            char MoveToResponse[8] = {0};
             switch (MoveToSP.findOnSwitchIndex())
             {
                 case Open:
                     if(coverStateText != "Open" && coverStateText != "Moving")
                     {
                         LOG_INFO("Opening Cover");
-                        if (sendCommand("O", MoveToResponse))
+                        if (!sendCommand("O", MoveToSP, [this](const char *response)
                         {
-                            LOGF_DEBUG("OpenCover response: %s", MoveToResponse);
+                            LOGF_DEBUG("OpenCover response: %s", response);
                             coverIsMoving = true;
 
                             std::string calibratorStateText = CalibratorStateTP[0].getText();
@@ -233,8 +270,7 @@ bool DarkLight_CoverCalibrator::initProperties()
                                 getCalibratorState();
                                 getBrightness();
                             }
-                        }
-                        else
+                        }))
                         {
                             LOG_WARN("Open command failed");
                         }
@@ -244,17 +280,16 @@ bool DarkLight_CoverCalibrator::initProperties()
                     if(coverStateText != "Closed" && coverStateText != "Moving")
                     {
                         LOG_INFO("Closing Cover");
-                        if (sendCommand("C", MoveToResponse))
+                        if (!sendCommand("C", MoveToSP, [this](const char *response)
                         {
-                            LOGF_DEBUG("CloseCover response: %s", MoveToResponse);
+                            LOGF_DEBUG("CloseCover response: %s", response);
                             coverIsMoving = true;
 
                             if (autoOn)
                             {
                                 lightIsReady = false;
                             }
-                        }
-                        else
+                        }))
                         {
                             LOG_WARN("Close command failed");
                         }
@@ -264,12 +299,11 @@ bool DarkLight_CoverCalibrator::initProperties()
                     if(coverStateText == "Moving")
                     {
                         LOG_INFO("Halting Cover");
-                        if (sendCommand("H", MoveToResponse))
+                        if (!sendCommand("H", MoveToSP, [this](const char *response)
                         {
-                            LOGF_DEBUG("HaltCover response: %s", MoveToResponse);
+                            LOGF_DEBUG("HaltCover response: %s", response);
                             coverIsMoving = true;
-                        }
-                        else
+                        }))
                         {
                             LOG_WARN("Halt command failed");
                         }
@@ -279,8 +313,8 @@ bool DarkLight_CoverCalibrator::initProperties()
 
             //reset switch
             MoveToSP.reset();
-            //set property state back to idle
-            MoveToSP.setState(IPS_IDLE);
+            //set property state back to idle, or Busy until a slow reply is in
+            MoveToSP.setState(commandState(MoveToSP));
             //inform INDI of the operation
             MoveToSP.apply();
         }
@@ -295,7 +329,6 @@ bool DarkLight_CoverCalibrator::initProperties()
     {
         if (isConnected())
         {
-            char TurnLightResponse[8] = {0};
             std::string calibratorStateText = CalibratorStateTP[0].getText();
             std::string coverStateText = CoverStateTP[0].getText();
             switch (TurnLightSP.findOnSwitchIndex())
@@ -333,9 +366,9 @@ bool DarkLight_CoverCalibrator::initProperties()
                     {
                         LOG_INFO("Turning Light OFF");
                         //if light already off ignore
-                        if (sendCommand("F", TurnLightResponse))
+                        if (!sendCommand("F", TurnLightSP, [this](const char *response)
                         {
-                            LOGF_DEBUG("CalibratorOff response: %s", TurnLightResponse);
+                            LOGF_DEBUG("CalibratorOff response: %s", response);
 
                             //set CalibratorState to Off (1)
                             CalibratorStateTP[0].setText("Off");
@@ -344,16 +377,15 @@ bool DarkLight_CoverCalibrator::initProperties()
                             //set CurrentBrightness to Off (0)
                             CurrentBrightnessNP[0].setValue(0);
                             CurrentBrightnessNP.apply();
-                        }
-                        else
+                        }))
                         {
                             LOG_WARN("Turn light OFF command failed");
                         }
                         break;
                     }
             }
-            //set property state back to idle
-            TurnLightSP.setState(IPS_IDLE);
+            //set property state back to idle, or Busy until a slow reply is in
+            TurnLightSP.setState(commandState(TurnLightSP));
             //inform INDI of the operation
             TurnLightSP.apply();
         }
@@ -460,7 +492,6 @@ bool DarkLight_CoverCalibrator::initProperties()
     //Go to preset BB / NB values
     GoToSavedSP.onUpdate([this]
     {
-        char GoToSavedResponse[8] = {0};
         if (TurnLightSP.findOnSwitchIndex() == Light_On)
         {
             switch (GoToSavedSP.findOnSwitchIndex())
@@ -469,13 +500,12 @@ bool DarkLight_CoverCalibrator::initProperties()
                     LOG_INFO("Setting Brightness to Broadband value");
                     //get broadband value
 
-                    if (sendCommand("GB", GoToSavedResponse))
+                    if (!sendCommand("GB", GoToSavedSP, [this](const char *response)
                     {
-                        LOGF_DEBUG("GoTo BB response: %s", GoToSavedResponse);
+                        LOGF_DEBUG("GoTo BB response: %s", response);
                         //convert response to a double
-                        setBrightness(std::stod(GoToSavedResponse));
-                    }
-                    else
+                        setBrightness(std::stod(response));
+                    }))
                     {
                         LOG_WARN("GoTo Broadband command failed");
                     }
@@ -483,13 +513,12 @@ bool DarkLight_CoverCalibrator::initProperties()
                 case Narrowband:
                     LOG_INFO("Setting Brightness to Narrowband value");
                     //get narrowband value
-                    if (sendCommand("GN", GoToSavedResponse))
+                    if (!sendCommand("GN", GoToSavedSP, [this](const char *response)
                     {
-                        LOGF_DEBUG("GoTo NB response: %s", GoToSavedResponse);
+                        LOGF_DEBUG("GoTo NB response: %s", response);
                         //convert response to a double
-                        setBrightness(std::stod(GoToSavedResponse));
-                    }
-                    else
+                        setBrightness(std::stod(response));
+                    }))
                     {
                         LOG_WARN("GoTo Narrowband command failed");
                     }
@@ -503,8 +532,8 @@ bool DarkLight_CoverCalibrator::initProperties()
 
         //reset switch
         GoToSavedSP.reset();
-        //set property state back to idle
-        GoToSavedSP.setState(IPS_IDLE);
+        //set property state back to idle, or Busy until a slow reply is in
+        GoToSavedSP.setState(commandState(GoToSavedSP));
         //inform INDI of the operation
         GoToSavedSP.apply();
     });//end of GoToSavedSP
@@ -512,7 +541,6 @@ bool DarkLight_CoverCalibrator::initProperties()
     //Save preset BB / NB values
     SetToSavedSP.onUpdate([this]
     {
-        char SetToSavedResponse[8] = {0};
         if (TurnLightSP.findOnSwitchIndex() == Light_On)
         {
             switch (SetToSavedSP.findOnSwitchIndex())
@@ -520,22 +548,20 @@ bool DarkLight_CoverCalibrator::initProperties()
                 case Set_Broadband:
                     LOG_INFO("Saving Broadband Brightness");
 
-                    if (sendCommand("DB", SetToSavedResponse))
+                    if (!sendCommand("DB", SetToSavedSP, [this](const char *response)
                     {
-                        LOGF_DEBUG("Set BB response: %s", SetToSavedResponse);
-                    }
-                    else
+                        LOGF_DEBUG("Set BB response: %s", response);
+                    }))
                     {
                         LOG_WARN("Save Broadband value command failed");
                     }
                     break;
                 case Set_Narrowband:
                     LOG_INFO("Saving Narrowband Brightness");
-                    if (sendCommand("DN", SetToSavedResponse))
+                    if (!sendCommand("DN", SetToSavedSP, [this](const char *response)
                     {
-                        LOGF_DEBUG("Set NB response: %s", SetToSavedResponse);
-                    }
-                    else
+                        LOGF_DEBUG("Set NB response: %s", response);
+                    }))
                     {
                         LOG_WARN("Save Narrowband value command failed");
                     }
@@ -549,8 +575,8 @@ bool DarkLight_CoverCalibrator::initProperties()
 
         //reset switch
         SetToSavedSP.reset();
-        //set property state back to idle
-        SetToSavedSP.setState(IPS_IDLE);
+        //set property state back to idle, or Busy until a slow reply is in
+        SetToSavedSP.setState(commandState(SetToSavedSP));
         //inform INDI of the operation
         SetToSavedSP.apply();
     });//end of SetToSavedSP
@@ -615,7 +641,6 @@ bool DarkLight_CoverCalibrator::initProperties()
     {
         if (isConnected())
         {
-            char HeaterResponse[8] = {0};
             std::string heaterStateText = HeaterStateTP[0].getText();
             switch (TurnHeaterSP.findOnSwitchIndex())
             {
@@ -623,11 +648,10 @@ bool DarkLight_CoverCalibrator::initProperties()
                     if (heaterStateText != "On" && heaterStateText != "Error")
                     {
                         LOG_INFO("Turning heater ON");
-                        if (sendCommand("W", HeaterResponse))
+                        if (!sendCommand("W", TurnHeaterSP, [this](const char *response)
                         {
-                            LOGF_DEBUG("Heater response: %s", HeaterResponse);
-                        }
-                        else
+                            LOGF_DEBUG("Heater response: %s", response);
+                        }))
                         {
                             LOG_WARN("Set Heater ON command failed");
                         }
@@ -637,11 +661,10 @@ bool DarkLight_CoverCalibrator::initProperties()
                     if (heaterStateText != "Off")
                     {
                         LOG_INFO("Turning heater OFF");
-                        if (sendCommand("w", HeaterResponse))
+                        if (!sendCommand("w", TurnHeaterSP, [this](const char *response)
                         {
-                            LOGF_DEBUG("Heater response: %s", HeaterResponse);
-                        }
-                        else
+                            LOGF_DEBUG("Heater response: %s", response);
+                        }))
                         {
                             LOG_WARN("Set Heater OFF command failed");
                         }
@@ -651,13 +674,12 @@ bool DarkLight_CoverCalibrator::initProperties()
                     if (!autoHeatOn)
                     {
                         LOG_INFO("Setting heater to AUTO");
-                        if (sendCommand("Q", HeaterResponse))
+                        if (!sendCommand("Q", TurnHeaterSP, [this](const char *response)
                         {
-                            LOGF_DEBUG("Heater response: %s", HeaterResponse);
+                            LOGF_DEBUG("Heater response: %s", response);
                             autoHeatOn = true;
                             heatOnClose = false;
-                        }
-                        else
+                        }))
                         {
                             LOG_WARN("Enable Heater AUTO command failed");
                         }
@@ -665,12 +687,11 @@ bool DarkLight_CoverCalibrator::initProperties()
                     else
                     {
                         LOG_INFO("Turning OFF auto heating");
-                        if (sendCommand("q", HeaterResponse))
+                        if (!sendCommand("q", TurnHeaterSP, [this](const char *response)
                         {
-                            LOGF_DEBUG("Heater response: %s", HeaterResponse);
+                            LOGF_DEBUG("Heater response: %s", response);
                             autoHeatOn = false;
-                        }
-                        else
+                        }))
                         {
                             LOG_WARN("Disable Heater AUTO command failed");
                         }
@@ -680,13 +701,12 @@ bool DarkLight_CoverCalibrator::initProperties()
                     if (!heatOnClose)
                     {
                         LOG_INFO("Setting heater to turn ON at CLOSE");
-                        if (sendCommand("E", HeaterResponse))
+                        if (!sendCommand("E", TurnHeaterSP, [this](const char *response)
                         {
-                            LOGF_DEBUG("Heater response: %s", HeaterResponse);
+                            LOGF_DEBUG("Heater response: %s", response);
                             heatOnClose = true;
                             autoHeatOn = false;
-                        }
-                        else
+                        }))
                         {
                             LOG_WARN("Enable Heat On Close command failed");
                         }
@@ -694,12 +714,11 @@ bool DarkLight_CoverCalibrator::initProperties()
                     else
                     {
                         LOG_INFO("Turning heat on close OFF");
-                        if (sendCommand("e", HeaterResponse))
+                        if (!sendCommand("e", TurnHeaterSP, [this](const char *response)
                         {
-                            LOGF_DEBUG("Heater response: %s", HeaterResponse);
+                            LOGF_DEBUG("Heater response: %s", response);
                             heatOnClose = false;
-                        }
-                        else
+                        }))
                         {
                             LOG_WARN("Disable Heat On Close command failed");
                         }
@@ -783,24 +802,59 @@ bool DarkLight_CoverCalibrator::Handshake()
         LOG_DEBUG("Serial port is open");
     }
 
+    //hand the port to the transport I/O thread
+    if (!transport.start(PortFD))
+    {
+        LOG_ERROR("Failed to start serial transport");
+        return false;
+    }
+
     // Send handshake command 'Z' and expect '?' in response
     const char *handshakeCommand = "Z";
     char response[8] = {0}; // Assuming 8 bytes is sufficient for the response
 
     LOG_DEBUG("Sending handshake command");
 
-    if (!sendCommand(handshakeCommand, response))
+    if (!sendCommand(handshakeCommand, response, CONNECT_WAIT_MS))
     {
         LOG_ERROR("Failed to send handshake command. Check baud rate");
+        transport.stop();
+        lateCommands.clear();
         return false;
     }
 
     if (response[0] != '?')
     {
         LOGF_ERROR("Invalid handshake response. Expected '?', but received: %s", response);
+        transport.stop();
         return false;
     }
 
+    //newer firmware answers a whole poll cycle with one status frame
+    statusSupported = false;
+    char versionResponse[8] = {0};
+    if (sendCommand("V", versionResponse, CONNECT_WAIT_MS))
+    {
+        LOGF_INFO("Firmware version %s", versionResponse);
+        int major = 0, minor = 0;
+        if (sscanf(versionResponse, "v%d.%d", &major, &minor) == 2)
+        {
+            //Nano firmware from v1.3.0, ESP32-S3 firmware from v2.2.0
+            statusSupported = (major == 1 && minor >= 3) || (major == 2 && minor >= 2) || major > 2;
+        }
+    }
+    LOGF_DEBUG("Status command %s", statusSupported ? "supported" : "not supported");
+
+    //ask the firmware to push state changes instead of being polled for them, older firmware answers '?'
+    eventsEnabled = false;
+    char eventResponse[8] = {0};
+    if (sendCommand("N1", eventResponse, CONNECT_WAIT_MS) && eventResponse[0] != '?')
+    {
+        eventsEnabled = true;
+        eventCallbackID = IEAddCallback(transport.getEventFD(), eventHandler, this);
+    }
+    LOGF_DEBUG("Event mode %s", eventsEnabled ? "enabled" : "not supported");
+
     return true;
 }//end of Handshake
 
@@ -816,6 +870,10 @@ bool DarkLight_CoverCalibrator::updateProperties()
         {
             defineProperty(CoverStateTP);
             defineProperty(MoveToSP);
+            if (statusSupported)
+            {
+                defineProperty(ServoPositionNP);
+            }
         }
         else
         {
@@ -888,6 +946,7 @@ bool DarkLight_CoverCalibrator::updateProperties()
             defineProperty(HeatOnCloseSP);
             defineProperty(HeaterStateTP);
             defineProperty(TurnHeaterSP);
+            defineProperty(HeaterDataNP);
         }
         else
         {
@@ -900,6 +959,7 @@ bool DarkLight_CoverCalibrator::updateProperties()
     {
         deleteProperty(CoverStateTP);
         deleteProperty(MoveToSP);
+        deleteProperty(ServoPositionNP);
         deleteProperty(CalibratorStateTP);
         deleteProperty(TurnLightSP);
         deleteProperty(MaxBrightnessNP);
@@ -915,136 +975,385 @@ bool DarkLight_CoverCalibrator::updateProperties()
         deleteProperty(HeatOnCloseSP);
         deleteProperty(HeaterStateTP);
         deleteProperty(TurnHeaterSP);
+        deleteProperty(HeaterDataNP);
     }
 
     return true;
 }//end of updateProperties
 
-bool DarkLight_CoverCalibrator::sendCommand(const char *command, const char *response)
+bool DarkLight_CoverCalibrator::Disconnect()
 {
-    std::lock_guard<std::mutex> lock(serialMutex); //acquire mutex for thread safety
+    //stop the I/O thread before the port is closed underneath it
+    DLCTransportStats stats = transport.getStats();
+    LOGF_DEBUG("Serial stats: %llu sent, %llu received, %llu retries, %llu timeouts, %llu errors, %llu stale, %llu noise bytes, %llu log lines",
+               (unsigned long long)stats.sent, (unsigned long long)stats.received, (unsigned long long)stats.retries,
+               (unsigned long long)stats.timeouts, (unsigned long long)stats.errors, (unsigned long long)stats.stale,
+               (unsigned long long)stats.noise, (unsigned long long)stats.logs);
+    if (eventCallbackID != -1)
+    {
+        IERmCallback(eventCallbackID);
+        eventCallbackID = -1;
+    }
+    //leave the firmware polling-only for the next client, but do not hang on a missing device
+    if (eventsEnabled)
+    {
+        transport.submit("N0").wait_for(std::chrono::seconds(1));
+        eventsEnabled = false;
+    }
 
-    if (PortFD == -1)
+    transport.stop();
+    pollPending = false;
+    for (LateCommand &late : lateCommands)
     {
-        return false; //cannot send if port is not open
+        if (late.property != nullptr)
+        {
+            late.property->setState(IPS_IDLE);
+        }
+    }
+    lateCommands.clear();
+    PortFD = -1;
+
+    return INDI::DefaultDevice::Disconnect();
+}//end of Disconnect
+
+void DarkLight_CoverCalibrator::eventHandler(int fd, void *userpointer)
+{
+    INDI_UNUSED(fd);
+    static_cast<DarkLight_CoverCalibrator *>(userpointer)->processEvents();
+}//end of eventHandler
+
+void DarkLight_CoverCalibrator::processEvents()
+{
+    for (const std::string &event : transport.takeEvents())
+    {
+        LOGF_DEBUG("Event received: <!%s>", event.c_str());
+        if (event.size() < 2)
+        {
+            continue;
+        }
+
+        std::string value = event.substr(1);
+        switch (event[0])
+        {
+            case 'P':
+                parseCoverState(value.c_str());
+                break;
+            case 'L':
+                //light changed outside the driver (button), follow it until Ready
+                if (value == "2")
+                {
+                    lightIsReady = false;
+                }
+                parseCalibratorState(value.c_str());
+                break;
+            case 'R':
+                parseHeaterState(value.c_str());
+                break;
+            default:
+                LOGF_DEBUG("Unknown event <!%s>", event.c_str());
+                break;
+        }
+    }
+
+    //firmware debug output, kept out of the protocol stream by the <#...> framing
+    for (const std::string &line : transport.takeLogs())
+    {
+        LOGF_DEBUG("Firmware: %s", line.c_str());
+    }
+}//end of processEvents
+
+bool DarkLight_CoverCalibrator::sendCommand(const char *command, const char *response, uint32_t waitMs)
+{
+    LOGF_DEBUG("Sending command: <%s>", command);
+
+    //queue behind anything already in flight and wait for our own reply, but never hold the INDI event loop
+    //for the transport's whole retry budget
+    std::future<DLCReply> reply = transport.submit(command);
+    if (reply.wait_for(std::chrono::milliseconds(waitMs)) != std::future_status::ready)
+    {
+        LOGF_WARN("No reply to <%s> within %u ms", command, waitMs);
+        lateCommands.push_back({command, std::move(reply), nullptr, nullptr});
+        return false;
+    }
+
+    std::string value;
+    if (!receiveReply(reply, command, value))
+    {
+        return false;
     }
 
-    int nbytes_read = 0, nbytes_written = 0, tty_rc = 0;
-    char res[8] = {0};
+    //callers use 8 byte buffers
+    strncpy(const_cast<char*>(response), value.c_str(), 7);
+    const_cast<char*>(response)[7] = '\0';
+    return true; //success
+}//end of sendCommand
+
+bool DarkLight_CoverCalibrator::sendCommand(const char *command, INDI::Property &property,
+        const std::function<void(const char *)> &onReply)
+{
+    LOGF_DEBUG("Sending command: <%s>", command);
 
-    //retry a maximum of 3 times
-    const int maxRetries = 3;
-    int retryCount = 0;
+    std::future<DLCReply> reply = transport.submit(command);
+    if (reply.wait_for(std::chrono::milliseconds(COMMAND_WAIT_MS)) != std::future_status::ready)
+    {
+        //the device is busy or retrying, finish at TimerHit and show the property as Busy meanwhile
+        LOGF_DEBUG("Command <%s> still on the wire, completing it later", command);
+        lateCommands.push_back({command, std::move(reply), &property, onReply});
+        property.setState(IPS_BUSY);
+        property.apply();
+        return true;
+    }
 
-    //form the command
-    std::string commandToSend = "<";
-    commandToSend += command;
-    commandToSend += ">";
+    std::string value;
+    if (!receiveReply(reply, command, value))
+    {
+        return false;
+    }
 
-    LOGF_DEBUG("Sending command: %s", commandToSend.c_str());
+    onReply(value.c_str());
+    return true;
+}//end of sendCommand
 
-    do
+IPState DarkLight_CoverCalibrator::commandState(const INDI::Property &property) const
+{
+    for (const LateCommand &late : lateCommands)
     {
-        //set a timeout of 5 seconds
-        int timeoutMs = 5000;
+        if (late.property == &property)
+        {
+            return IPS_BUSY;
+        }
+    }
+    return IPS_IDLE;
+}//end of commandState
 
-        //use a loop with select to monitor the serial port with a timeout
-        while (true)
+void DarkLight_CoverCalibrator::applyLateCommands()
+{
+    //take the finished ones first, a reply handler may send commands of its own
+    std::vector<LateCommand> finished;
+    for (auto late = lateCommands.begin(); late != lateCommands.end();)
+    {
+        if (late->reply.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
         {
-            tcflush(PortFD, TCIOFLUSH);
-            if ((tty_rc = tty_write_string(PortFD, commandToSend.c_str(), &nbytes_written)) != TTY_OK)
-            {
-                char errorMessage[MAXRBUF];
-                tty_error_msg(tty_rc, errorMessage, MAXRBUF);
-                LOGF_ERROR("Serial write error: %s", errorMessage);
-                return false;
-            }
+            finished.push_back(std::move(*late));
+            late = lateCommands.erase(late);
+        }
+        else
+        {
+            ++late;
+        }
+    }
 
-            struct timeval timeout;
-            timeout.tv_sec = timeoutMs / 1000;
-            timeout.tv_usec = (timeoutMs % 1000) * 1000;
+    for (LateCommand &late : finished)
+    {
+        std::string response;
+        bool ok = receiveReply(late.reply, late.command.c_str(), response);
+        if (ok && late.onReply)
+        {
+            late.onReply(response.c_str());
+        }
 
-            fd_set readfds;
-            FD_ZERO(&readfds);
-            FD_SET(PortFD, &readfds);
+        if (late.property != nullptr && commandState(*late.property) != IPS_BUSY)
+        {
+            late.property->setState(ok ? IPS_IDLE : IPS_ALERT);
+            late.property->apply();
+        }
+    }
+}//end of applyLateCommands
 
-            int selectResult = select(PortFD + 1, &readfds, nullptr, nullptr, &timeout);
-            if (selectResult == -1)
-            {
-                LOGF_ERROR("Serial select error: %s", strerror(errno));
-                return false;
-            }
-            else if (selectResult == 0)
+bool DarkLight_CoverCalibrator::receiveReply(std::future<DLCReply> &reply, const char *command, std::string &response)
+{
+    if (!reply.valid())
+    {
+        return false;
+    }
+
+    DLCReply result = reply.get();
+    switch (result.status)
+    {
+        case DLCStatus::Ok:
+            if (result.retries > 0)
             {
-                LOG_ERROR("Serial read timed out");
-                break; //exit the inner loop and try again (retry)
+                LOGF_DEBUG("Command <%s> needed %d retries", command, result.retries);
             }
-            else
-            {
-                //data is available for reading, proceed with tty_read_section
-                if ((tty_rc = tty_read_section(PortFD, res, '>', 1, &nbytes_read)) == TTY_OK)
-                {
-                    //response received successfully
-                    LOGF_DEBUG("Response received: %s", res);
-                    res[nbytes_read - 1] = '\0';
+            LOGF_DEBUG("Response received: <%s>", result.value.c_str());
+            response = result.value;
+            return true;
+        case DLCStatus::Timeout:
+            LOGF_ERROR("Maximum retry attempts reached for <%s>. Transmission failed.", command);
+            break;
+        case DLCStatus::IOError:
+            LOGF_ERROR("Serial I/O error on <%s>", command);
+            break;
+        case DLCStatus::Stopped:
+            LOGF_DEBUG("Command <%s> dropped, serial port is closed", command);
+            break;
+    }
 
-                    //ensure response is copied back to the caller's buffer
-                    strcpy(const_cast<char*>(response), res + 1);
-                    return true; //success
-                }
-                else
-                {
-                    LOGF_ERROR("Serial read error: %s", res);
-                }
-            }
-        }
+    return false;
+}//end of receiveReply
+
+bool DarkLight_CoverCalibrator::mainValues()
+{
+    const std::string& coverState = CoverStateTP[0].getText();
+    pollCover = coverState != "Not Present" && coverIsMoving;
+    //brightness is only used if the light is not yet Ready, but asking now is cheaper than a second round trip
+    pollLight = coverState != "Not Present" && !lightIsReady;
+
+    //refresh HeaterState if On/Auto/Heat On Close is set
+    const std::string& heaterStateTP = HeaterStateTP[0].getText();
+    const int turnHeaterSP = TurnHeaterSP.findOnSwitchIndex();
+    pollHeater = (heaterStateTP != "Not Present" && turnHeaterSP != 1) || (heatModeIsChanging);
+    const bool heaterPresent = heaterStateTP != "Not Present";
 
-        //increment the retry count
-        retryCount++;
+    //cover and heater changes are pushed by the firmware, only telemetry still needs polling
+    if (eventsEnabled)
+    {
+        pollCover = false;
+        pollHeater = heatModeIsChanging;
     }
-    while (retryCount < maxRetries);
 
-    LOG_ERROR("Maximum retry attempts reached. Transmission failed.");
-    return false; // Error
-}//end of sendCommand
+    if (statusSupported)
+    {
+        //one frame answers the whole cycle
+        if (pollCover || pollLight || pollHeater || heaterPresent)
+        {
+            statusReply = transport.submit("U");
+        }
+    }
+    else
+    {
+        //queue every query of this cycle back to back so they share one round trip
+        if (pollCover)
+        {
+            coverReply = transport.submit("P");
+        }
+        if (pollLight)
+        {
+            calibratorReply = transport.submit("L");
+            brightnessReply = transport.submit("B");
+        }
+        if (pollHeater)
+        {
+            heaterReply = transport.submit("R");
+        }
+        if (heaterPresent)
+        {
+            heaterDataReply = transport.submit("Y");
+        }
+    }
 
-bool DarkLight_CoverCalibrator::mainValues()
+    pollPending = true;
+    return true;
+}//end of mainValues
+
+bool DarkLight_CoverCalibrator::pollComplete()
+{
+    for (std::future<DLCReply> *reply : {&statusReply, &coverReply, &calibratorReply, &brightnessReply, &heaterReply, &heaterDataReply})
+    {
+        if (reply->valid() && reply->wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            return false;
+        }
+    }
+    return true;
+}//end of pollComplete
+
+void DarkLight_CoverCalibrator::applyPoll()
 {
+    std::string response;
+
+    //get Status
+    if (statusReply.valid())
+    {
+        LOG_DEBUG("Get Status");
+        if (receiveReply(statusReply, "U", response))
+        {
+            parseStatus(response);
+        }
+        else
+        {
+            LOG_ERROR("Status ERROR");
+        }
+    }
+
     //get CoverState
-    const std::string& coverState = CoverStateTP[0].getText();
-    if (coverState != "Not Present" && coverIsMoving)
+    if (coverReply.valid())
     {
-        getCoverState();
+        LOG_DEBUG("Get CoverState");
+        if (receiveReply(coverReply, "P", response))
+        {
+            parseCoverState(response.c_str());
+        }
+        else
+        {
+            LOG_ERROR("CoverState ERROR");
+        }
     }
 
     //get CalibratorState
-    const std::string& calibratorState = CalibratorStateTP[0].getText();
-    if (coverState != "Not Present" && !lightIsReady)
+    if (calibratorReply.valid())
     {
-        getCalibratorState();
+        LOG_DEBUG("Get CalibratorState");
+        if (receiveReply(calibratorReply, "L", response))
+        {
+            parseCalibratorState(response.c_str());
+        }
+        else
+        {
+            LOG_ERROR("CalibratorState ERROR");
+        }
+    }
 
-        //check brightness if light on
+    //check brightness if light on
+    if (brightnessReply.valid())
+    {
+        bool brightnessOk = receiveReply(brightnessReply, "B", response);
         if (CalibratorStateTP[0].getText() != std::string("Ready"))
         {
-            getBrightness();
+            if (brightnessOk)
+            {
+                parseBrightness(response.c_str());
+            }
 
             //change switch state visual
             TurnLightSP[Light_On].setState(ISS_ON);
             TurnLightSP[Light_Off].setState(ISS_OFF);
             TurnLightSP.apply();
-        }//end of Brightness
+        }
+    }//end of Brightness
+
+    //get HeaterState
+    if (heaterReply.valid())
+    {
+        LOG_DEBUG("Get HeaterState");
+        if (receiveReply(heaterReply, "R", response))
+        {
+            parseHeaterState(response.c_str());
+        }
+        else
+        {
+            LOG_ERROR("HeaterState ERROR");
+        }
     }
 
-    //refresh HeaterState if On/Auto/Heat On Close is set
-    const std::string& heaterStateTP = HeaterStateTP[0].getText();
-    const int turnHeaterSP = TurnHeaterSP.findOnSwitchIndex();
-    if ((heaterStateTP != "Not Present" && turnHeaterSP != 1) || (heatModeIsChanging))
+    //get heater telemetry, h1t:<temp>:h1p:<pwm>|h2t:<temp>:h2p:<pwm>|o:<temp>:h:<humidity>:d:<dewpoint>
+    if (heaterDataReply.valid())
     {
-        getHeaterState();
+        //firmware without telemetry answers '?'
+        if (receiveReply(heaterDataReply, "Y", response) && response != "?")
+        {
+            std::vector<std::string> fields = splitFields(response, ":|");
+            std::vector<std::string> values;
+            for (size_t i = 1; i < fields.size(); i += 2)
+            {
+                values.push_back(fields[i]);
+            }
+            parseHeaterData(values);
+        }
     }
 
-    return true;
-}//end of mainValues
+    pollPending = false;
+}//end of applyPoll
 
 void DarkLight_CoverCalibrator::TimerHit()
 {
@@ -1053,8 +1362,32 @@ void DarkLight_CoverCalibrator::TimerHit()
         return;
     }
 
-    mainValues();
-    SetTimer(getCurrentPollingPeriod());
+    //commands that outlived their wait in a property handler
+    applyLateCommands();
+
+    //never block the INDI event loop on the serial port, check back until the cycle completes
+    if (!pollPending)
+    {
+        mainValues();
+    }
+
+    if (!pollComplete())
+    {
+        SetTimer(POLL_CHECK_MS);
+        return;
+    }
+
+    applyPoll();
+
+    //follow the cover closely while it moves if a poll only costs one frame
+    if (statusSupported && coverIsMoving && !eventsEnabled)
+    {
+        SetTimer(std::min(MOVING_POLL_MS, getCurrentPollingPeriod()));
+    }
+    else
+    {
+        SetTimer(getCurrentPollingPeriod());
+    }
 }//end of TimerHit
 
 void DarkLight_CoverCalibrator::setStabilizeTime()
@@ -1143,59 +1476,64 @@ void DarkLight_CoverCalibrator::getCoverState()
     }
     else
     {
-        LOGF_DEBUG("CoverState response: %s", CoverStateResponse);
+        parseCoverState(CoverStateResponse);
+    }
+}//end of getCoverState
 
-        //handle potential multi-character responses
-        if (strlen(CoverStateResponse) > 1)
-        {
-            LOG_WARN("CoverState: Unexpected multi-character response");
-            CoverStateTP[0].setText("Invalid Response");
-        }
-        else
+void DarkLight_CoverCalibrator::parseCoverState(const char *CoverStateResponse)
+{
+    LOGF_DEBUG("CoverState response: %s", CoverStateResponse);
+
+    //handle potential multi-character responses
+    if (strlen(CoverStateResponse) > 1)
+    {
+        LOG_WARN("CoverState: Unexpected multi-character response");
+        CoverStateTP[0].setText("Invalid Response");
+    }
+    else
+    {
+        //process the response
+        int responseValue = CoverStateResponse[0] - '0';
+        switch (responseValue)
         {
-            //process the response
-            int responseValue = CoverStateResponse[0] - '0';
-            switch (responseValue)
-            {
-                case 0:
-                    CoverStateTP[0].setText("Not Present");
-                    break;
-                case 1:
-                    CoverStateTP[0].setText("Closed");
-                    coverIsMoving = false;
-                    LOG_INFO("Cover is CLOSED");
-                    if (autoOn)
-                    {
-                        LOG_INFO("Activating light");
-                    }
-                    break;
-                case 2:
-                    CoverStateTP[0].setText("Moving");
-                    break;
-                case 3:
-                    CoverStateTP[0].setText("Open");
-                    coverIsMoving = false;
-                    LOG_INFO("Cover is OPEN");
-                    break;
-                case 4:
-                    CoverStateTP[0].setText("Unknown");
-                    coverIsMoving = false;
-                    LOG_WARN("Cover in UNKNOWN state");
-                    break;
-                case 5:
-                    CoverStateTP[0].setText("Error");
-                    coverIsMoving = false;
-                    LOG_ERROR("Cover reported ERROR");
-                    break;
-                default:
-                    LOG_WARN("CoverState: Invalid response value");
-                    CoverStateTP[0].setText("Invalid Response");
-            }
-            CoverStateTP.setState(IPS_IDLE);
-            CoverStateTP.apply();
+            case 0:
+                CoverStateTP[0].setText("Not Present");
+                break;
+            case 1:
+                CoverStateTP[0].setText("Closed");
+                coverIsMoving = false;
+                LOG_INFO("Cover is CLOSED");
+                if (autoOn)
+                {
+                    LOG_INFO("Activating light");
+                }
+                break;
+            case 2:
+                CoverStateTP[0].setText("Moving");
+                break;
+            case 3:
+                CoverStateTP[0].setText("Open");
+                coverIsMoving = false;
+                LOG_INFO("Cover is OPEN");
+                break;
+            case 4:
+                CoverStateTP[0].setText("Unknown");
+                coverIsMoving = false;
+                LOG_WARN("Cover in UNKNOWN state");
+                break;
+            case 5:
+                CoverStateTP[0].setText("Error");
+                coverIsMoving = false;
+                LOG_ERROR("Cover reported ERROR");
+                break;
+            default:
+                LOG_WARN("CoverState: Invalid response value");
+                CoverStateTP[0].setText("Invalid Response");
         }
+        CoverStateTP.setState(IPS_IDLE);
+        CoverStateTP.apply();
     }
-}//end of getCoverState
+}//end of parseCoverState
 
 void DarkLight_CoverCalibrator::getCalibratorState()
 {
@@ -1207,62 +1545,67 @@ void DarkLight_CoverCalibrator::getCalibratorState()
     }
     else
     {
-        LOGF_DEBUG("CalibratorState response: %s", GetCalibratorStateResponse);
+        parseCalibratorState(GetCalibratorStateResponse);
+    }
+}//end of getCalibratorState
+
+void DarkLight_CoverCalibrator::parseCalibratorState(const char *GetCalibratorStateResponse)
+{
+    LOGF_DEBUG("CalibratorState response: %s", GetCalibratorStateResponse);
+
+    //handle potential multi-character responses
+    if (strlen(GetCalibratorStateResponse) > 1)
+    {
+        LOG_WARN("CalibratorState: Unexpected multi-character response");
+        CalibratorStateTP[0].setText("Invalid Response");
+    }
+    else
+    {
+        int responseValue = GetCalibratorStateResponse[0] - '0';
+        switch (responseValue)
+        {
+            case 0:
+                CalibratorStateTP[0].setText("Not Present");
+                break;
+            case 1:
+                CalibratorStateTP[0].setText("Off");
+                break;
+            case 2:
+                CalibratorStateTP[0].setText("Not Ready");
+                break;
+            case 3:
+                CalibratorStateTP[0].setText("Ready");
+                lightIsReady = true;
+                break;
+            case 4:
+                CalibratorStateTP[0].setText("Unknown");
+                break;
+            case 5:
+                CalibratorStateTP[0].setText("Error");
+                break;
+            default:
+                LOG_WARN("CalibratorState: Invalid response value");
+                CalibratorStateTP[0].setText("Invalid Response");
+        }
 
-        //handle potential multi-character responses
-        if (strlen(GetCalibratorStateResponse) > 1)
+        if (responseValue != 0 && responseValue != 1)
         {
-            LOG_WARN("CalibratorState: Unexpected multi-character response");
-            CalibratorStateTP[0].setText("Invalid Response");
+            //set light button to ON
+            TurnLightSP[Light_On].setState(ISS_ON);
+            TurnLightSP[Light_Off].setState(ISS_OFF);
         }
         else
         {
-            int responseValue = GetCalibratorStateResponse[0] - '0';
-            switch (responseValue)
-            {
-                case 0:
-                    CalibratorStateTP[0].setText("Not Present");
-                    break;
-                case 1:
-                    CalibratorStateTP[0].setText("Off");
-                    break;
-                case 2:
-                    CalibratorStateTP[0].setText("Not Ready");
-                    break;
-                case 3:
-                    CalibratorStateTP[0].setText("Ready");
-                    lightIsReady = true;
-                    break;
-                case 4:
-                    CalibratorStateTP[0].setText("Unknown");
-                    break;
-                case 5:
-                    CalibratorStateTP[0].setText("Error");
-                    break;
-                default:
-                    LOG_WARN("CalibratorState: Invalid response value");
-                    CalibratorStateTP[0].setText("Invalid Response");
-            }
-
-            if (responseValue != 0 && responseValue != 1)
-            {
-                //set light button to ON
-                TurnLightSP[Light_On].setState(ISS_ON);
-                TurnLightSP[Light_Off].setState(ISS_OFF);
-            }
-            else
-            {
-                //set light button to OFF
-                TurnLightSP[Light_On].setState(ISS_OFF);
-                TurnLightSP[Light_Off].setState(ISS_ON);
-            }
-            TurnLightSP.apply();
-
-            CalibratorStateTP.setState(IPS_IDLE);
-            CalibratorStateTP.apply();
+            //set light button to OFF
+            TurnLightSP[Light_On].setState(ISS_OFF);
+            TurnLightSP[Light_Off].setState(ISS_ON);
         }
+        TurnLightSP.apply();
+
+        CalibratorStateTP.setState(IPS_IDLE);
+        CalibratorStateTP.apply();
     }
-}//end of getCalibratorState
+}//end of parseCalibratorState
 
 void DarkLight_CoverCalibrator::getBrightness()
 {
@@ -1274,30 +1617,35 @@ void DarkLight_CoverCalibrator::getBrightness()
     }
     else
     {
-        LOGF_DEBUG("CurrentBrightness response: %s", BrightnessResponse);
+        parseBrightness(BrightnessResponse);
+    }
+}//end of getBrightness
+
+void DarkLight_CoverCalibrator::parseBrightness(const char *BrightnessResponse)
+{
+    LOGF_DEBUG("CurrentBrightness response: %s", BrightnessResponse);
+
+    //handle potential multi-character responses
+    if (strlen(BrightnessResponse) > 3)
+    {
+    }
+    else
+    {
+        int brightnessValue = std::stoi(BrightnessResponse);
 
-        //handle potential multi-character responses
-        if (strlen(BrightnessResponse) > 3)
+        //check range
+        if (brightnessValue >= 0 && brightnessValue <= MaxBrightnessNP[0].getValue())
         {
+            CurrentBrightnessNP[0].setValue(brightnessValue);
+            CurrentBrightnessNP.setState(IPS_IDLE);
+            CurrentBrightnessNP.apply();
         }
         else
         {
-            int brightnessValue = std::stoi(BrightnessResponse);
-
-            //check range
-            if (brightnessValue >= 0 && brightnessValue <= MaxBrightnessNP[0].getValue())
-            {
-                CurrentBrightnessNP[0].setValue(brightnessValue);
-                CurrentBrightnessNP.setState(IPS_IDLE);
-                CurrentBrightnessNP.apply();
-            }
-            else
-            {
-                LOG_WARN("Brightness value out of range");
-            }
+            LOG_WARN("Brightness value out of range");
         }
     }
-}//end of getBrightness
+}//end of parseBrightness
 
 void DarkLight_CoverCalibrator::setBrightness(double BrightnessValue)
 {
@@ -1433,91 +1781,174 @@ void DarkLight_CoverCalibrator::getHeaterState()
     }
     else
     {
-        LOGF_DEBUG("HeaterState response: %s", HeaterStateResponse);
+        parseHeaterState(HeaterStateResponse);
+    }
+}//end of getHeaterState
 
-        //handle potential multi-character responses
-        if (strlen(HeaterStateResponse) > 1)
-        {
-            LOG_WARN("HeaterState: Unexpected multi-character response");
-            HeaterStateTP[0].setText("Invalid Response");
-        }
-        else
+void DarkLight_CoverCalibrator::parseHeaterState(const char *HeaterStateResponse)
+{
+    LOGF_DEBUG("HeaterState response: %s", HeaterStateResponse);
+
+    //handle potential multi-character responses
+    if (strlen(HeaterStateResponse) > 1)
+    {
+        LOG_WARN("HeaterState: Unexpected multi-character response");
+        HeaterStateTP[0].setText("Invalid Response");
+    }
+    else
+    {
+        //process the response
+        int responseValue = HeaterStateResponse[0] - '0';
+        switch (responseValue)
         {
-            //process the response
-            int responseValue = HeaterStateResponse[0] - '0';
-            switch (responseValue)
-            {
-                case 0:
-                    HeaterStateTP[0].setText("Not Present");
-                    break;
-                case 1:
-                    HeaterStateTP[0].setText("Off");
-                    TurnHeaterSP[Heat_On].setState(ISS_OFF);
-                    TurnHeaterSP[Heat_Off].setState(ISS_ON);
-                    TurnHeaterSP[Heat_Auto].setState(ISS_OFF);
-                    TurnHeaterSP[Heat_At_Close].setState(ISS_OFF);
-                    break;
-                case 2:
-                    HeaterStateTP[0].setText("Auto");
+            case 0:
+                HeaterStateTP[0].setText("Not Present");
+                break;
+            case 1:
+                HeaterStateTP[0].setText("Off");
+                TurnHeaterSP[Heat_On].setState(ISS_OFF);
+                TurnHeaterSP[Heat_Off].setState(ISS_ON);
+                TurnHeaterSP[Heat_Auto].setState(ISS_OFF);
+                TurnHeaterSP[Heat_At_Close].setState(ISS_OFF);
+                break;
+            case 2:
+                HeaterStateTP[0].setText("Auto");
+                TurnHeaterSP[Heat_On].setState(ISS_OFF);
+                TurnHeaterSP[Heat_Off].setState(ISS_OFF);
+                TurnHeaterSP[Heat_Auto].setState(ISS_ON);
+                TurnHeaterSP[Heat_At_Close].setState(ISS_OFF);
+                break;
+            case 3:
+                HeaterStateTP[0].setText("On");
+                TurnHeaterSP[Heat_On].setState(ISS_ON);
+                TurnHeaterSP[Heat_Off].setState(ISS_OFF);
+                TurnHeaterSP[Heat_Auto].setState(ISS_OFF);
+                TurnHeaterSP[Heat_At_Close].setState(ISS_OFF);
+                break;
+            case 4:
+                HeaterStateTP[0].setText("Unknown");
+                if (autoHeatOn)
+                {
                     TurnHeaterSP[Heat_On].setState(ISS_OFF);
-                    TurnHeaterSP[Heat_Off].setState(ISS_OFF);
                     TurnHeaterSP[Heat_Auto].setState(ISS_ON);
                     TurnHeaterSP[Heat_At_Close].setState(ISS_OFF);
-                    break;
-                case 3:
-                    HeaterStateTP[0].setText("On");
-                    TurnHeaterSP[Heat_On].setState(ISS_ON);
-                    TurnHeaterSP[Heat_Off].setState(ISS_OFF);
-                    TurnHeaterSP[Heat_Auto].setState(ISS_OFF);
-                    TurnHeaterSP[Heat_At_Close].setState(ISS_OFF);
-                    break;
-                case 4:
-                    HeaterStateTP[0].setText("Unknown");
-                    if (autoHeatOn)
-                    {
-                        TurnHeaterSP[Heat_On].setState(ISS_OFF);
-                        TurnHeaterSP[Heat_Auto].setState(ISS_ON);
-                        TurnHeaterSP[Heat_At_Close].setState(ISS_OFF);
-                    }
-                    else if (heatOnClose)
-                    {
-                        TurnHeaterSP[Heat_On].setState(ISS_OFF);
-                        TurnHeaterSP[Heat_Auto].setState(ISS_OFF);
-                        TurnHeaterSP[Heat_At_Close].setState(ISS_ON);
-                    }
-                    else
-                    {
-                        TurnHeaterSP[Heat_On].setState(ISS_ON);
-                        TurnHeaterSP[Heat_Auto].setState(ISS_OFF);
-                        TurnHeaterSP[Heat_At_Close].setState(ISS_OFF);
-                    }
-                    
-                    TurnHeaterSP[Heat_Off].setState(ISS_OFF);                    
-                    break;
-                case 5:
-                    HeaterStateTP[0].setText("Error");
-                    TurnHeaterSP[Heat_On].setState(ISS_OFF);
-                    TurnHeaterSP[Heat_Off].setState(ISS_ON);
-                    TurnHeaterSP[Heat_Auto].setState(ISS_OFF);
-                    TurnHeaterSP[Heat_At_Close].setState(ISS_OFF);
-                    break;
-                case 6:
-                    HeaterStateTP[0].setText("Set");
+                }
+                else if (heatOnClose)
+                {
                     TurnHeaterSP[Heat_On].setState(ISS_OFF);
-                    TurnHeaterSP[Heat_Off].setState(ISS_OFF);
                     TurnHeaterSP[Heat_Auto].setState(ISS_OFF);
                     TurnHeaterSP[Heat_At_Close].setState(ISS_ON);
-                    break;
-                default:
-                    LOG_WARN("HeaterState: Invalid response value");
-                    HeaterStateTP[0].setText("Invalid Response");
-            }
-            if (responseValue == 1)
+                }
+                else
+                {
+                    TurnHeaterSP[Heat_On].setState(ISS_ON);
+                    TurnHeaterSP[Heat_Auto].setState(ISS_OFF);
+                    TurnHeaterSP[Heat_At_Close].setState(ISS_OFF);
+                }
+                
+                TurnHeaterSP[Heat_Off].setState(ISS_OFF);                    
+                break;
+            case 5:
+                HeaterStateTP[0].setText("Error");
+                TurnHeaterSP[Heat_On].setState(ISS_OFF);
+                TurnHeaterSP[Heat_Off].setState(ISS_ON);
+                TurnHeaterSP[Heat_Auto].setState(ISS_OFF);
+                TurnHeaterSP[Heat_At_Close].setState(ISS_OFF);
+                break;
+            case 6:
+                HeaterStateTP[0].setText("Set");
+                TurnHeaterSP[Heat_On].setState(ISS_OFF);
+                TurnHeaterSP[Heat_Off].setState(ISS_OFF);
+                TurnHeaterSP[Heat_Auto].setState(ISS_OFF);
+                TurnHeaterSP[Heat_At_Close].setState(ISS_ON);
+                break;
+            default:
+                LOG_WARN("HeaterState: Invalid response value");
+                HeaterStateTP[0].setText("Invalid Response");
+        }
+        if (responseValue == 1)
+        {
+            heatModeIsChanging = false;
+        }
+        HeaterStateTP.apply();
+        TurnHeaterSP.apply();
+    }
+}//end of parseHeaterState
+
+void DarkLight_CoverCalibrator::parseStatus(const std::string &StatusResponse)
+{
+    LOGF_DEBUG("Status response: %s", StatusResponse.c_str());
+
+    //P:L:R:B:S:h1t:h1p:h2t:h2p:o:h:d
+    std::vector<std::string> fields = splitFields(StatusResponse, ":");
+    if (fields.size() != 12)
+    {
+        LOG_WARN("Status: Unexpected number of fields");
+        return;
+    }
+
+    if (pollCover)
+    {
+        parseCoverState(fields[0].c_str());
+    }
+
+    if (pollLight)
+    {
+        parseCalibratorState(fields[1].c_str());
+
+        //check brightness if light on
+        if (CalibratorStateTP[0].getText() != std::string("Ready"))
+        {
+            if (fields[3] != "na")
             {
-                heatModeIsChanging = false;
+                parseBrightness(fields[3].c_str());
             }
-            HeaterStateTP.apply();
-            TurnHeaterSP.apply();
+
+            //change switch state visual
+            TurnLightSP[Light_On].setState(ISS_ON);
+            TurnLightSP[Light_Off].setState(ISS_OFF);
+            TurnLightSP.apply();
+        }
+    }
+
+    if (pollHeater)
+    {
+        parseHeaterState(fields[2].c_str());
+    }
+
+    if (fields[4] != "na")
+    {
+        double position = std::atof(fields[4].c_str());
+        if (position != ServoPositionNP[0].getValue())
+        {
+            ServoPositionNP[0].setValue(position);
+            ServoPositionNP.apply();
+        }
+    }
+
+    if (HeaterStateTP[0].getText() != std::string("Not Present"))
+    {
+        parseHeaterData(std::vector<std::string>(fields.begin() + 5, fields.end()));
+    }
+}//end of parseStatus
+
+void DarkLight_CoverCalibrator::parseHeaterData(const std::vector<std::string> &values)
+{
+    //h1t, h1p, h2t, h2p, o, h, d
+    if (values.size() != 7)
+    {
+        LOG_WARN("HeaterData: Unexpected number of fields");
+        return;
+    }
+
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        //channels that are not installed report na
+        if (values[i] != "na")
+        {
+            HeaterDataNP[i].setValue(std::atof(values[i].c_str()));
         }
     }
-}//end of getHeaterState
\ No newline at end of file
+    HeaterDataNP.setState(IPS_OK);
+    HeaterDataNP.apply();
+}//end of parseHeaterData
@@ -41,6 +41,10 @@ For more information, please refer to the full terms of the Creative Commons Att
 #pragma once
 
 #include "libindi/defaultdevice.h"
+#include "dlc_transport.h"
+
+#include <functional>
+#include <vector>
 
 namespace Connection
 {
@@ -57,28 +61,54 @@ class DarkLight_CoverCalibrator : public INDI::DefaultDevice
         virtual bool initProperties() override;
         virtual bool updateProperties() override;
         virtual void TimerHit() override;
+        virtual bool Disconnect() override;
 
     private:
 
         //serial communications
         bool Handshake();
-        bool sendCommand(const char *command, const char *response);
+        //wait at most waitMs for the reply, a later one is only logged
+        bool sendCommand(const char *command, const char *response, uint32_t waitMs = COMMAND_WAIT_MS);
+        //from property handlers: onReply runs now if the reply comes within COMMAND_WAIT_MS, else at TimerHit with
+        //the property Busy until then
+        bool sendCommand(const char *command, INDI::Property &property, const std::function<void(const char *)> &onReply);
+        bool receiveReply(std::future<DLCReply> &reply, const char *command, std::string &response);
+        IPState commandState(const INDI::Property &property) const;
+        void applyLateCommands();
+        static constexpr uint32_t COMMAND_WAIT_MS = 500;
+        //a Nano resets when the port opens and needs a couple of seconds before it answers
+        static constexpr uint32_t CONNECT_WAIT_MS = 12000;
         int PortFD{-1};
+        DLCTransport transport;
+
+        //firmware pushes <!Xn> state changes, handled from the INDI event loop
+        static void eventHandler(int fd, void *userpointer);
+        void processEvents();
+        bool eventsEnabled {false};
+        int eventCallbackID {-1};
 
         Connection::Serial *serialConnection{nullptr};
 
         bool mainValues();
+        bool pollComplete();
+        void applyPoll();
         void setStabilizeTime();
         void setAutoOn();
         void setLightDisabled();
         void getCoverState();
+        void parseCoverState(const char *CoverStateResponse);
         void getCalibratorState();
+        void parseCalibratorState(const char *GetCalibratorStateResponse);
         void getBrightness();
+        void parseBrightness(const char *BrightnessResponse);
         void setBrightness(double BrightnessValue);
         void setAutoHeatOn();
         void setHeatOnClose();
         void setHeaterState();
         void getHeaterState();
+        void parseHeaterState(const char *HeaterStateResponse);
+        void parseStatus(const std::string &StatusResponse);
+        void parseHeaterData(const std::vector<std::string> &values);
         bool lightDisabled;
         bool coverIsMoving;
         bool lightIsReady;
@@ -87,6 +117,31 @@ class DarkLight_CoverCalibrator : public INDI::DefaultDevice
         bool heatOnClose;
         bool heatModeIsChanging;
 
+        //firmware answers <U> with every value of a poll cycle in one frame
+        bool statusSupported {false};
+
+        //replies of the poll cycle currently on the wire
+        bool pollPending {false};
+        bool pollCover {false};
+        bool pollLight {false};
+        bool pollHeater {false};
+        std::future<DLCReply> statusReply;
+        std::future<DLCReply> heaterDataReply;
+        std::future<DLCReply> coverReply;
+        std::future<DLCReply> calibratorReply;
+        std::future<DLCReply> brightnessReply;
+        std::future<DLCReply> heaterReply;
+
+        //commands whose reply did not come within the wait, finished at TimerHit
+        struct LateCommand
+        {
+            std::string command;
+            std::future<DLCReply> reply;
+            INDI::Property *property;
+            std::function<void(const char *)> onReply;
+        };
+        std::vector<LateCommand> lateCommands;
+
         //define properties
         //----- generic -----
         INDI::PropertyNumber StabilizeTimeNP {1};
@@ -95,6 +150,7 @@ class DarkLight_CoverCalibrator : public INDI::DefaultDevice
         INDI::PropertyText CoverStateTP {1};
         INDI::PropertySwitch MoveToSP {3};
         enum {Open, Close, Halt};
+        INDI::PropertyNumber ServoPositionNP {1};
 
         //----- light -----
         INDI::PropertySwitch AutoOnSP {1};
@@ -122,6 +178,8 @@ class DarkLight_CoverCalibrator : public INDI::DefaultDevice
         INDI::PropertyText HeaterStateTP {1};
         INDI::PropertySwitch TurnHeaterSP {4};
         enum {Heat_On, Heat_Off, Heat_Auto, Heat_At_Close};
+        INDI::PropertyNumber HeaterDataNP {7};
+        enum {Heater1_Temp, Heater1_PWM, Heater2_Temp, Heater2_PWM, Ambient_Temp, Humidity, Dew_Point};
         
     protected:
         virtual bool saveConfigItems(FILE *fp) override;
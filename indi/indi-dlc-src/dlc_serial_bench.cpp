@@ -0,0 +1,491 @@
+/*******************************************************************
+Creative Commons Attribution-NonCommercial License
+
+Copyright © 2020-2025 Nathan Woelfle
+
+This work is licensed under a Creative Commons Attribution-NonCommercial 4.0 International License.
+
+You are free to:
+
+    Share — copy and redistribute the material in any medium or format
+    Adapt — remix, transform, and build upon the material
+
+Under the following conditions:
+
+    Attribution — You must give appropriate credit, provide a link to the license, and indicate if changes were made. You may do so in any reasonable manner, but not in any way that suggests the licensor endorses you or your use.
+    NonCommercial — You may not use the material for commercial purposes.
+    No additional restrictions — You may not apply legal terms or technological measures that legally restrict others from doing anything the license permits.
+
+Notices:
+
+    You may not use this work for commercial purposes without written permission from the copyright holder.
+    This work is provided "as is" without warranty of any kind, either express or implied, including but not limited to the warranties of merchantability, fitness for a particular purpose, and noninfringement. In no event shall the authors or copyright holders be liable for any claim, damages, or other liability, whether in an action of contract, tort, or otherwise, arising from, out of, or in connection with the software or the use or other dealings in the software.
+
+Scope:
+
+    This license applies to both the hardware and software components of the DarkLight Cover Calibrator.
+
+Modified Versions:
+
+    You are permitted to create modified versions of the DarkLight Cover Calibrator for non-commercial use, provided that you:
+        Retain the original copyright notice and license terms.
+        Include a clear reference to the original creator (Nathan Woelfle) and provide a link to the original work.
+
+Jurisdiction:
+
+    This license is governed by the laws of the United States of America, and by international copyright laws and treaties.
+
+For more information, please refer to the full terms of the Creative Commons Attribution-NonCommercial 4.0 International License: https://creativecommons.org/licenses/by-nc/4.0/
+*******************************************************************/
+
+//Serial protocol benchmark.
+//Drives a DLC (or the firmware simulator's pty) through DLCTransport with a
+//weighted command mix and prints latency percentiles, throughput, retries and
+//timeouts as JSON on stdout, so runs can be diffed against a stored baseline.
+//
+//  dlc_serial_bench --port /tmp/dlc --mix poll --count 5000 --depth 4
+
+#include "dlc_transport.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <map>
+#include <random>
+#include <sstream>
+#include <termios.h>
+#include <unistd.h>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+struct Options
+{
+    std::string port;
+    int baud {115200};
+    std::string mix {"poll"};
+    int count {1000};
+    int warmup {20};
+    int depth {1};
+    int timeoutMs {1000};
+    int retries {3};
+    int settleMs {0};
+    int maxBrightness {255};
+    unsigned seed {1};
+    bool events {false};
+};
+
+struct MixEntry
+{
+    std::string command;
+    double weight;
+};
+
+struct Sample
+{
+    std::string command;
+    std::future<DLCReply> reply;
+    Clock::time_point start;
+    Clock::time_point done;
+    bool completed {false};
+    bool recorded {false};
+};
+
+struct Summary
+{
+    std::vector<double> latencies;  //microseconds, successful replies only
+    uint64_t ok {0};
+    uint64_t timeouts {0};
+    uint64_t ioErrors {0};
+    uint64_t retries {0};
+};
+
+void printUsage(const char *program)
+{
+    fprintf(stderr,
+            "Usage: %s --port <device> [options]\n"
+            "  --mix <name|spec>    poll, sweep, telemetry, mixed or a spec like P=70,T=20,Y=10\n"
+            "  --count <n>          measured commands (default 1000)\n"
+            "  --warmup <n>         unmeasured commands sent first (default 20)\n"
+            "  --depth <n>          commands kept in flight (default 1)\n"
+            "  --timeout <ms>       per-frame reply timeout (default 1000)\n"
+            "  --retries <n>        resends before a timeout is reported (default 3)\n"
+            "  --baud <rate>        serial speed (default 115200)\n"
+            "  --settle <ms>        wait after opening the port (default 0)\n"
+            "  --max-brightness <n> top of the T sweep (default 255)\n"
+            "  --seed <n>           command mix random seed (default 1)\n"
+            "  --events             enable <!Xn> event mode during the run\n",
+            program);
+}
+
+speed_t baudConstant(int baud)
+{
+    switch (baud)
+    {
+        case 9600:
+            return B9600;
+        case 19200:
+            return B19200;
+        case 38400:
+            return B38400;
+        case 57600:
+            return B57600;
+        case 230400:
+            return B230400;
+        case 460800:
+            return B460800;
+        case 921600:
+            return B921600;
+        default:
+            return B115200;
+    }
+}
+
+int openPort(const Options &options)
+{
+    int fd = open(options.port.c_str(), O_RDWR | O_NOCTTY);
+    if (fd < 0)
+    {
+        perror(options.port.c_str());
+        return -1;
+    }
+
+    struct termios tio;
+    if (tcgetattr(fd, &tio) != 0)
+    {
+        perror("tcgetattr");
+        close(fd);
+        return -1;
+    }
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, baudConstant(options.baud));
+    cfsetospeed(&tio, baudConstant(options.baud));
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+    tcsetattr(fd, TCSANOW, &tio);
+
+    if (options.settleMs > 0)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(options.settleMs));
+    }
+    return fd;
+}
+
+//expand a preset name or parse "CMD=weight,CMD=weight"
+bool parseMix(const std::string &spec, std::vector<MixEntry> &mix)
+{
+    static const std::map<std::string, std::string> presets =
+    {
+        {"poll", "P=1"},
+        {"sweep", "T=1"},
+        {"telemetry", "Y=1"},
+        {"mixed", "P=6,L=2,B=1,Y=1"},
+    };
+
+    auto preset = presets.find(spec);
+    std::stringstream tokens(preset != presets.end() ? preset->second : spec);
+    std::string token;
+    while (std::getline(tokens, token, ','))
+    {
+        size_t eq = token.find('=');
+        std::string command = token.substr(0, eq);
+        double weight = (eq == std::string::npos) ? 1.0 : atof(token.c_str() + eq + 1);
+        if (command.empty() || weight <= 0)
+        {
+            return false;
+        }
+        mix.push_back({command, weight});
+    }
+    return !mix.empty();
+}
+
+double percentile(const std::vector<double> &sorted, double p)
+{
+    if (sorted.empty())
+    {
+        return 0.0;
+    }
+    //nearest-rank
+    size_t rank = static_cast<size_t>(p / 100.0 * sorted.size() + 0.999999);
+    rank = std::min(std::max<size_t>(rank, 1), sorted.size());
+    return sorted[rank - 1];
+}
+
+std::string jsonEscape(const std::string &text)
+{
+    std::string out;
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out += '\\';
+        }
+        if (static_cast<unsigned char>(c) >= 0x20)
+        {
+            out += c;
+        }
+    }
+    return out;
+}
+
+void printLatency(std::vector<double> latencies)
+{
+    std::sort(latencies.begin(), latencies.end());
+    double sum = 0;
+    for (double l : latencies)
+    {
+        sum += l;
+    }
+    printf("{\"min\": %.1f, \"mean\": %.1f, \"p50\": %.1f, \"p99\": %.1f, \"p999\": %.1f, \"max\": %.1f}",
+           latencies.empty() ? 0.0 : latencies.front(),
+           latencies.empty() ? 0.0 : sum / latencies.size(),
+           percentile(latencies, 50), percentile(latencies, 99), percentile(latencies, 99.9),
+           latencies.empty() ? 0.0 : latencies.back());
+}
+
+}//end of anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    Options options;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--port" && hasValue)
+            options.port = argv[++i];
+        else if (arg == "--mix" && hasValue)
+            options.mix = argv[++i];
+        else if (arg == "--count" && hasValue)
+            options.count = atoi(argv[++i]);
+        else if (arg == "--warmup" && hasValue)
+            options.warmup = atoi(argv[++i]);
+        else if (arg == "--depth" && hasValue)
+            options.depth = std::max(1, atoi(argv[++i]));
+        else if (arg == "--timeout" && hasValue)
+            options.timeoutMs = atoi(argv[++i]);
+        else if (arg == "--retries" && hasValue)
+            options.retries = atoi(argv[++i]);
+        else if (arg == "--baud" && hasValue)
+            options.baud = atoi(argv[++i]);
+        else if (arg == "--settle" && hasValue)
+            options.settleMs = atoi(argv[++i]);
+        else if (arg == "--max-brightness" && hasValue)
+            options.maxBrightness = std::max(1, atoi(argv[++i]));
+        else if (arg == "--seed" && hasValue)
+            options.seed = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+        else if (arg == "--events")
+            options.events = true;
+        else
+        {
+            printUsage(argv[0]);
+            return arg == "--help" ? 0 : 2;
+        }
+    }
+
+    std::vector<MixEntry> mix;
+    if (options.port.empty() || !parseMix(options.mix, mix))
+    {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    int fd = openPort(options);
+    if (fd < 0)
+    {
+        return 1;
+    }
+
+    DLCTransport transport;
+    transport.setTimeout(options.timeoutMs);
+    transport.setMaxRetries(options.retries);
+    transport.setMaxInFlight(static_cast<size_t>(options.depth));
+    if (!transport.start(fd))
+    {
+        fprintf(stderr, "Failed to start transport\n");
+        close(fd);
+        return 1;
+    }
+
+    DLCReply version = transport.submit("V").get();
+    if (version.status != DLCStatus::Ok)
+    {
+        fprintf(stderr, "No reply to <V> from %s\n", options.port.c_str());
+        transport.stop();
+        close(fd);
+        return 1;
+    }
+    if (options.events)
+    {
+        transport.submit("N1").get();
+    }
+
+    std::vector<double> weights;
+    for (const MixEntry &entry : mix)
+    {
+        weights.push_back(entry.weight);
+    }
+    std::mt19937 rng(options.seed);
+    std::discrete_distribution<size_t> pick(weights.begin(), weights.end());
+    int sweepValue = 0;
+    bool usedSweep = false;
+
+    auto nextCommand = [&]()
+    {
+        std::string command = mix[pick(rng)].command;
+        //a bare T walks the brightness up and down between 0 and max
+        if (command == "T")
+        {
+            usedSweep = true;
+            int period = 2 * options.maxBrightness;
+            int step = sweepValue++ % period;
+            command += std::to_string(step <= options.maxBrightness ? step : period - step);
+        }
+        return command;
+    };
+
+    Summary total;
+    std::map<std::string, Summary> perCommand;
+    std::deque<Sample> window;
+    int submitted = 0;
+    int totalCommands = options.warmup + options.count;
+    Clock::time_point measureStart = Clock::now();
+
+    auto stampCompleted = [&window]()
+    {
+        for (Sample &sample : window)
+        {
+            if (!sample.completed &&
+                    sample.reply.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            {
+                sample.completed = true;
+                sample.done = Clock::now();
+            }
+        }
+    };
+
+    while (submitted < totalCommands || !window.empty())
+    {
+        while (submitted < totalCommands && static_cast<int>(window.size()) < options.depth)
+        {
+            if (submitted == options.warmup)
+            {
+                measureStart = Clock::now();
+            }
+
+            Sample sample;
+            sample.command = nextCommand();
+            sample.recorded = submitted >= options.warmup;
+            sample.start = Clock::now();
+            sample.reply = transport.submit(sample.command);
+            window.push_back(std::move(sample));
+            submitted++;
+        }
+
+        //replies complete in order, so the head is always the next to finish
+        Sample &head = window.front();
+        head.reply.wait();
+        stampCompleted();
+
+        DLCReply reply = head.reply.get();
+        if (reply.status == DLCStatus::Stopped)
+        {
+            fprintf(stderr, "Transport stopped\n");
+            break;
+        }
+
+        if (head.recorded)
+        {
+            std::string key = head.command.substr(0, 1);
+            for (Summary *summary : {&total, &perCommand[key]})
+            {
+                summary->retries += reply.retries;
+                if (reply.status == DLCStatus::Ok)
+                {
+                    summary->ok++;
+                    summary->latencies.push_back(
+                        std::chrono::duration<double, std::micro>(head.done - head.start).count());
+                }
+                else if (reply.status == DLCStatus::Timeout)
+                {
+                    summary->timeouts++;
+                }
+                else
+                {
+                    summary->ioErrors++;
+                }
+            }
+        }
+        window.pop_front();
+    }
+
+    double elapsed = std::chrono::duration<double>(Clock::now() - measureStart).count();
+
+    if (usedSweep)
+    {
+        transport.submit("F").wait();
+    }
+    if (options.events)
+    {
+        transport.submit("N0").wait();
+    }
+
+    DLCTransportStats stats = transport.getStats();
+    transport.stop();
+    close(fd);
+
+    printf("{\n");
+    printf("  \"port\": \"%s\",\n", jsonEscape(options.port).c_str());
+    printf("  \"firmware\": \"%s\",\n", jsonEscape(version.value).c_str());
+    printf("  \"mix\": {");
+    for (size_t i = 0; i < mix.size(); i++)
+    {
+        printf("%s\"%s\": %g", i ? ", " : "", jsonEscape(mix[i].command).c_str(), mix[i].weight);
+    }
+    printf("},\n");
+    printf("  \"depth\": %d,\n", options.depth);
+    printf("  \"events\": %s,\n", options.events ? "true" : "false");
+    printf("  \"count\": %d,\n", options.count);
+    printf("  \"ok\": %llu,\n", static_cast<unsigned long long>(total.ok));
+    printf("  \"timeouts\": %llu,\n", static_cast<unsigned long long>(total.timeouts));
+    printf("  \"io_errors\": %llu,\n", static_cast<unsigned long long>(total.ioErrors));
+    printf("  \"retries\": %llu,\n", static_cast<unsigned long long>(total.retries));
+    printf("  \"elapsed_s\": %.3f,\n", elapsed);
+    printf("  \"throughput_cmd_per_s\": %.1f,\n", elapsed > 0 ? total.ok / elapsed : 0.0);
+    printf("  \"latency_us\": ");
+    printLatency(total.latencies);
+    printf(",\n  \"per_command\": {\n");
+    size_t n = 0;
+    for (const auto &entry : perCommand)
+    {
+        printf("    \"%s\": {\"ok\": %llu, \"timeouts\": %llu, \"retries\": %llu, \"latency_us\": ",
+               jsonEscape(entry.first).c_str(),
+               static_cast<unsigned long long>(entry.second.ok),
+               static_cast<unsigned long long>(entry.second.timeouts),
+               static_cast<unsigned long long>(entry.second.retries));
+        printLatency(entry.second.latencies);
+        printf("}%s\n", ++n < perCommand.size() ? "," : "");
+    }
+    printf("  },\n");
+    printf("  \"transport\": {\"sent\": %llu, \"received\": %llu, \"retries\": %llu, "
+           "\"timeouts\": %llu, \"errors\": %llu, \"events\": %llu, \"stale\": %llu, \"noise\": %llu, \"logs\": %llu}\n",
+           static_cast<unsigned long long>(stats.sent),
+           static_cast<unsigned long long>(stats.received),
+           static_cast<unsigned long long>(stats.retries),
+           static_cast<unsigned long long>(stats.timeouts),
+           static_cast<unsigned long long>(stats.errors),
+           static_cast<unsigned long long>(stats.events),
+           static_cast<unsigned long long>(stats.stale),
+           static_cast<unsigned long long>(stats.noise),
+           static_cast<unsigned long long>(stats.logs));
+    printf("}\n");
+
+    return (total.timeouts > 0 || total.ioErrors > 0) ? 3 : 0;
+}//end of main
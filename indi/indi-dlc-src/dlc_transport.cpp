@@ -0,0 +1,655 @@
+/*******************************************************************
+Creative Commons Attribution-NonCommercial License
+
+Copyright © 2020-2025 Nathan Woelfle
+
+This work is licensed under a Creative Commons Attribution-NonCommercial 4.0 International License.
+
+You are free to:
+
+    Share — copy and redistribute the material in any medium or format
+    Adapt — remix, transform, and build upon the material
+
+Under the following conditions:
+
+    Attribution — You must give appropriate credit, provide a link to the license, and indicate if changes were made. You may do so in any reasonable manner, but not in any way that suggests the licensor endorses you or your use.
+    NonCommercial — You may not use the material for commercial purposes.
+    No additional restrictions — You may not apply legal terms or technological measures that legally restrict others from doing anything the license permits.
+
+Notices:
+
+    You may not use this work for commercial purposes without written permission from the copyright holder.
+    This work is provided "as is" without warranty of any kind, either express or implied, including but not limited to the warranties of merchantability, fitness for a particular purpose, and noninfringement. In no event shall the authors or copyright holders be liable for any claim, damages, or other liability, whether in an action of contract, tort, or otherwise, arising from, out of, or in connection with the software or the use or other dealings in the software.
+
+Scope:
+
+    This license applies to both the hardware and software components of the DarkLight Cover Calibrator.
+
+Modified Versions:
+
+    You are permitted to create modified versions of the DarkLight Cover Calibrator for non-commercial use, provided that you:
+        Retain the original copyright notice and license terms.
+        Include a clear reference to the original creator (Nathan Woelfle) and provide a link to the original work.
+
+Jurisdiction:
+
+    This license is governed by the laws of the United States of America, and by international copyright laws and treaties.
+
+For more information, please refer to the full terms of the Creative Commons Attribution-NonCommercial 4.0 International License: https://creativecommons.org/licenses/by-nc/4.0/
+*******************************************************************/
+
+#include "dlc_transport.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/select.h>
+#include <termios.h>
+#include <unistd.h>
+
+//idle wait of the I/O thread when nothing is in flight
+static const int IDLE_WAIT_MS = 250;
+
+DLCTransport::~DLCTransport()
+{
+    stop();
+}
+
+bool DLCTransport::start(int portFD)
+{
+    stop();
+
+    if (portFD < 0)
+    {
+        return false;
+    }
+
+    if (pipe(wakePipe) != 0)
+    {
+        return false;
+    }
+    if (pipe(eventPipe) != 0)
+    {
+        stop();
+        return false;
+    }
+    for (int end : {wakePipe[0], wakePipe[1], eventPipe[0], eventPipe[1]})
+    {
+        fcntl(end, F_SETFL, O_NONBLOCK);
+    }
+
+    fd = portFD;
+    inFrame = false;
+    inLogFrame = false;
+    frameLength = 0;
+    resyncing = false;
+    resyncSkips = 0;
+
+    //start from a clean line, anything already buffered belongs to nobody
+    tcflush(fd, TCIOFLUSH);
+
+    running = true;
+    ioThread = std::thread(&DLCTransport::run, this);
+    return true;
+}//end of start
+
+void DLCTransport::stop()
+{
+    if (ioThread.joinable())
+    {
+        running = false;
+        wake();
+        ioThread.join();
+    }
+    running = false;
+
+    failAll(DLCStatus::Stopped);
+
+    for (int *end : {&wakePipe[0], &wakePipe[1], &eventPipe[0], &eventPipe[1]})
+    {
+        if (*end != -1)
+        {
+            close(*end);
+            *end = -1;
+        }
+    }
+    fd = -1;
+
+    std::lock_guard<std::mutex> lock(eventMutex);
+    events.clear();
+    logs.clear();
+}//end of stop
+
+std::future<DLCReply> DLCTransport::submit(const std::string &command)
+{
+    Request request;
+    request.frame = "<" + command + ">";
+    std::future<DLCReply> reply = request.promise.get_future();
+
+    if (!running)
+    {
+        request.promise.set_value(DLCReply {DLCStatus::Stopped, "", 0});
+        return reply;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        pending.push_back(std::move(request));
+    }
+    wake();
+
+    return reply;
+}//end of submit
+
+std::vector<std::string> DLCTransport::takeEvents()
+{
+    //drain the notification bytes first so an event queued meanwhile signals again
+    if (eventPipe[0] != -1)
+    {
+        char drain[32];
+        while (read(eventPipe[0], drain, sizeof(drain)) > 0)
+        {
+        }
+    }
+
+    std::vector<std::string> taken;
+    std::lock_guard<std::mutex> lock(eventMutex);
+    taken.swap(events);
+    return taken;
+}//end of takeEvents
+
+std::vector<std::string> DLCTransport::takeLogs()
+{
+    std::lock_guard<std::mutex> lock(eventMutex);
+    std::vector<std::string> taken(logs.begin(), logs.end());
+    logs.clear();
+    return taken;
+}//end of takeLogs
+
+DLCTransportStats DLCTransport::getStats()
+{
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return stats;
+}//end of getStats
+
+void DLCTransport::wake()
+{
+    if (wakePipe[1] != -1)
+    {
+        const char byte = 0;
+        //a full pipe already guarantees a wake-up, so the result is irrelevant
+        (void)!write(wakePipe[1], &byte, 1);
+    }
+}//end of wake
+
+void DLCTransport::run()
+{
+    while (running)
+    {
+        //move queued requests onto the wire while there is room in the pipeline,
+        //but not while a barrier is outstanding
+        std::deque<Request> toSend;
+        if (!resyncing)
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            while (!pending.empty() && inFlight.size() + toSend.size() < maxInFlight)
+            {
+                toSend.push_back(std::move(pending.front()));
+                pending.pop_front();
+            }
+        }
+
+        for (Request &request : toSend)
+        {
+            if (!writeFrame(request.frame))
+            {
+                request.promise.set_value(DLCReply {DLCStatus::IOError, "", request.retries});
+                std::lock_guard<std::mutex> lock(statsMutex);
+                stats.errors++;
+                continue;
+            }
+            request.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+            inFlight.push_back(std::move(request));
+        }
+
+        //wait for a reply, a new request or the oldest frame's deadline
+        int waitMs = IDLE_WAIT_MS;
+        if (resyncing || !inFlight.empty())
+        {
+            auto deadline = resyncing ? resyncDeadline : inFlight.front().deadline;
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline -
+                             std::chrono::steady_clock::now()).count();
+            waitMs = static_cast<int>(std::max<long long>(0, std::min<long long>(remaining, IDLE_WAIT_MS)));
+        }
+
+        fd_set readfds;
+        FD_ZERO(&readfds);
+        FD_SET(fd, &readfds);
+        FD_SET(wakePipe[0], &readfds);
+
+        struct timeval timeout;
+        timeout.tv_sec = waitMs / 1000;
+        timeout.tv_usec = (waitMs % 1000) * 1000;
+
+        int selectResult = select(std::max(fd, wakePipe[0]) + 1, &readfds, nullptr, nullptr, &timeout);
+        if (selectResult == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            failAll(DLCStatus::IOError);
+            continue;
+        }
+
+        if (selectResult > 0 && FD_ISSET(wakePipe[0], &readfds))
+        {
+            char drain[32];
+            while (read(wakePipe[0], drain, sizeof(drain)) > 0)
+            {
+            }
+        }
+
+        if (selectResult > 0 && FD_ISSET(fd, &readfds))
+        {
+            readAvailable();
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (resyncing ? now >= resyncDeadline : (!inFlight.empty() && now >= inFlight.front().deadline))
+        {
+            handleTimeout();
+        }
+    }
+}//end of run
+
+bool DLCTransport::writeFrame(const std::string &frame)
+{
+    size_t written = 0;
+    while (written < frame.size())
+    {
+        ssize_t rc = write(fd, frame.data() + written, frame.size() - written);
+        if (rc > 0)
+        {
+            written += static_cast<size_t>(rc);
+        }
+        else if (rc < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        else if (rc < 0 && errno == EAGAIN)
+        {
+            fd_set writefds;
+            FD_ZERO(&writefds);
+            FD_SET(fd, &writefds);
+            struct timeval timeout {1, 0};
+            if (select(fd + 1, nullptr, &writefds, nullptr, &timeout) <= 0)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats.sent++;
+    return true;
+}//end of writeFrame
+
+void DLCTransport::readAvailable()
+{
+    char buffer[256];
+    ssize_t nbytes = read(fd, buffer, sizeof(buffer));
+    if (nbytes <= 0)
+    {
+        if (nbytes < 0 && (errno == EINTR || errno == EAGAIN))
+        {
+            return;
+        }
+        //readable but nothing to read means the device went away
+        failAll(DLCStatus::IOError);
+        return;
+    }
+
+    uint64_t noise = 0;
+    for (ssize_t i = 0; i < nbytes; i++)
+    {
+        char c = buffer[i];
+
+        //a start marker always begins a new frame, abandoning any partial one
+        if (c == '<')
+        {
+            if (inFrame)
+            {
+                noise += frameLength + 1;
+                if (!inLogFrame && frameLength > 0)
+                {
+                    dropPartialReply();
+                }
+            }
+            inFrame = true;
+            inLogFrame = false;
+            frameLength = 0;
+            continue;
+        }
+
+        if (!inFrame)
+        {
+            noise++;
+            continue;
+        }
+
+        if (c == '>')
+        {
+            inFrame = false;
+            if (inLogFrame)
+            {
+                queueLog(std::string(frameBuffer, frameLength));
+            }
+            else
+            {
+                handleFrame(std::string(frameBuffer, frameLength));
+            }
+            continue;
+        }
+
+        //<#...> carries free text, only control characters are foreign to it
+        if (frameLength == 0 && !inLogFrame && c == '#')
+        {
+            inLogFrame = true;
+            continue;
+        }
+
+        //a character the protocol never sends (newline, '[', space...) means the
+        //'<' belonged to log text, not a frame
+        bool valid = inLogFrame ? static_cast<unsigned char>(c) >= 0x20 : isFrameChar(c);
+        if (!valid || frameLength >= MAX_FRAME_CHARS)
+        {
+            inFrame = false;
+            noise += frameLength + (inLogFrame ? 3 : 2);
+            if (!inLogFrame && frameLength > 0)
+            {
+                dropPartialReply();
+            }
+            continue;
+        }
+
+        frameBuffer[frameLength++] = c;
+    }
+
+    if (noise > 0)
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.noise += noise;
+    }
+}//end of readAvailable
+
+void DLCTransport::handleFrame(const std::string &value)
+{
+    //event frames can arrive between any two replies
+    if (!value.empty() && value[0] == '!')
+    {
+        {
+            std::lock_guard<std::mutex> lock(eventMutex);
+            events.push_back(value.substr(1));
+        }
+        {
+            std::lock_guard<std::mutex> lock(statsMutex);
+            stats.events++;
+        }
+        const char byte = 0;
+        (void)!write(eventPipe[1], &byte, 1);
+        return;
+    }
+
+    //until the barrier's own version string arrives, every reply may be a late
+    //one from before the timeout
+    if (resyncing)
+    {
+        resyncHeard = true;
+        if (value[0] == 'v' && resyncSkips-- == 0)
+        {
+            finishResync();
+            return;
+        }
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.stale++;
+        return;
+    }
+
+    //a reply nobody is waiting for, or one that answers a different command, is
+    //a leftover from a request that timed out
+    if (inFlight.empty() || !replyMatches(inFlight.front().frame, value))
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.stale++;
+        return;
+    }
+
+    completeFront(DLCStatus::Ok, value);
+}//end of handleFrame
+
+void DLCTransport::queueLog(const std::string &line)
+{
+    {
+        std::lock_guard<std::mutex> lock(eventMutex);
+        if (logs.size() >= MAX_QUEUED_LOGS)
+        {
+            logs.pop_front();
+        }
+        logs.push_back(line);
+    }
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.logs++;
+    }
+    const char byte = 0;
+    (void)!write(eventPipe[1], &byte, 1);
+}//end of queueLog
+
+bool DLCTransport::isFrameChar(char c)
+{
+    return std::isalnum(static_cast<unsigned char>(c)) || std::strchr(":|.-?!", c) != nullptr;
+}//end of isFrameChar
+
+bool DLCTransport::replyMatches(const std::string &frame, const std::string &reply)
+{
+    //frame is "<X...>", every command is answered with "?" if the firmware lacks it
+    char command = frame.size() > 2 ? frame[1] : '\0';
+    if (reply == "?")
+    {
+        return true;
+    }
+    if (reply.empty())
+    {
+        return false;
+    }
+
+    auto allDigits = [&reply]()
+    {
+        return std::all_of(reply.begin(), reply.end(), [](char c)
+        {
+            return std::isdigit(static_cast<unsigned char>(c)) != 0;
+        });
+    };
+
+    switch (command)
+    {
+        //state queries
+        case 'P':
+        case 'L':
+        case 'R':
+            return reply.size() == 1 && allDigits();
+
+        //numeric queries
+        case 'B':
+        case 'M':
+        case 'G':
+            return allDigits();
+
+        case 'V':
+            return reply[0] == 'v';
+
+        case 'Y':
+            return reply.compare(0, 4, "h1t:") == 0;
+
+        case 'U':
+            return std::count(reply.begin(), reply.end(), ':') == 11;
+
+        //everything else echoes the command as received (truncated to the
+        //firmware's receive buffer for long parameters)
+        default:
+            return frame.compare(1, reply.size(), reply) == 0;
+    }
+}//end of replyMatches
+
+void DLCTransport::completeFront(DLCStatus status, const std::string &value)
+{
+    Request request = std::move(inFlight.front());
+    inFlight.pop_front();
+
+    //count before completing so a caller reading stats after its reply sees it
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        if (status == DLCStatus::Ok)
+        {
+            stats.received++;
+        }
+        else if (status == DLCStatus::Timeout)
+        {
+            stats.timeouts++;
+        }
+        else
+        {
+            stats.errors++;
+        }
+    }
+
+    request.promise.set_value(DLCReply {status, value, request.retries});
+}//end of completeFront
+
+void DLCTransport::dropPartialReply()
+{
+    //log text cut into a reply: the reply is lost, and the next one may have the
+    //same shape and be matched to the wrong request, so resync now as after a
+    //timeout. A partial frame that was only log text costs one resend.
+    if (resyncing || inFlight.empty())
+    {
+        return;
+    }
+
+    //bounded like a timeout, so log text that keeps cutting replies cannot
+    //hold the line in resync forever
+    Request &oldest = inFlight.front();
+    oldest.retries++;
+    if (oldest.retries >= maxRetries)
+    {
+        completeFront(DLCStatus::Timeout, "");
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.retries++;
+    }
+
+    startResync(std::count_if(inFlight.begin(), inFlight.end(), [](const Request &request)
+    {
+        return request.frame == "<V>";
+    }));
+}//end of dropPartialReply
+
+void DLCTransport::handleTimeout()
+{
+    //version replies owed by <V> requests written before the barrier, counted
+    //before the oldest request may be given up
+    size_t versionsAhead = std::count_if(inFlight.begin(), inFlight.end(), [](const Request &request)
+    {
+        return request.frame == "<V>";
+    });
+
+    if (!inFlight.empty())
+    {
+        Request &oldest = inFlight.front();
+        oldest.retries++;
+
+        if (oldest.retries >= maxRetries)
+        {
+            completeFront(DLCStatus::Timeout, "");
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(statsMutex);
+            stats.retries++;
+        }
+    }
+
+    if (resyncing)
+    {
+        //a whole timeout without a reply: nothing late is still on its way
+        if (!resyncHeard)
+        {
+            finishResync();
+            return;
+        }
+        //the device is still answering older frames, and the last barrier too
+        versionsAhead = resyncSkips + 1;
+    }
+
+    startResync(versionsAhead);
+}//end of handleTimeout
+
+void DLCTransport::startResync(size_t versionsAhead)
+{
+    resyncing = true;
+    resyncHeard = false;
+    resyncSkips = versionsAhead;
+    resyncDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    if (!writeFrame("<V>"))
+    {
+        resyncing = false;
+        failAll(DLCStatus::IOError);
+    }
+}//end of startResync
+
+void DLCTransport::finishResync()
+{
+    resyncing = false;
+
+    //the line is in step again, so everything still unanswered goes out afresh
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    for (size_t i = 0; i < inFlight.size(); i++)
+    {
+        if (!writeFrame(inFlight[i].frame))
+        {
+            failAll(DLCStatus::IOError);
+            return;
+        }
+        inFlight[i].deadline = deadline;
+    }
+}//end of finishResync
+
+void DLCTransport::failAll(DLCStatus status)
+{
+    resyncing = false;
+
+    while (!inFlight.empty())
+    {
+        completeFront(status, "");
+    }
+
+    std::deque<Request> dropped;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        dropped.swap(pending);
+    }
+    for (Request &request : dropped)
+    {
+        request.promise.set_value(DLCReply {status, "", request.retries});
+    }
+}//end of failAll
@@ -0,0 +1,203 @@
+/*******************************************************************
+Creative Commons Attribution-NonCommercial License
+
+Copyright © 2020-2025 Nathan Woelfle
+
+This work is licensed under a Creative Commons Attribution-NonCommercial 4.0 International License.
+
+You are free to:
+
+    Share — copy and redistribute the material in any medium or format
+    Adapt — remix, transform, and build upon the material
+
+Under the following conditions:
+
+    Attribution — You must give appropriate credit, provide a link to the license, and indicate if changes were made. You may do so in any reasonable manner, but not in any way that suggests the licensor endorses you or your use.
+    NonCommercial — You may not use the material for commercial purposes.
+    No additional restrictions — You may not apply legal terms or technological measures that legally restrict others from doing anything the license permits.
+
+Notices:
+
+    You may not use this work for commercial purposes without written permission from the copyright holder.
+    This work is provided "as is" without warranty of any kind, either express or implied, including but not limited to the warranties of merchantability, fitness for a particular purpose, and noninfringement. In no event shall the authors or copyright holders be liable for any claim, damages, or other liability, whether in an action of contract, tort, or otherwise, arising from, out of, or in connection with the software or the use or other dealings in the software.
+
+Scope:
+
+    This license applies to both the hardware and software components of the DarkLight Cover Calibrator.
+
+Modified Versions:
+
+    You are permitted to create modified versions of the DarkLight Cover Calibrator for non-commercial use, provided that you:
+        Retain the original copyright notice and license terms.
+        Include a clear reference to the original creator (Nathan Woelfle) and provide a link to the original work.
+
+Jurisdiction:
+
+    This license is governed by the laws of the United States of America, and by international copyright laws and treaties.
+
+For more information, please refer to the full terms of the Creative Commons Attribution-NonCommercial 4.0 International License: https://creativecommons.org/licenses/by-nc/4.0/
+*******************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//result of a single <X> command exchange
+enum class DLCStatus
+{
+    Ok,
+    Timeout,
+    IOError,
+    Stopped
+};
+
+struct DLCReply
+{
+    DLCStatus status {DLCStatus::Stopped};
+    std::string value;      //reply payload without the < > framing
+    int retries {0};        //number of times the frame had to be resent
+};
+
+//transport counters, read by the driver for debug output
+struct DLCTransportStats
+{
+    uint64_t sent {0};
+    uint64_t received {0};
+    uint64_t retries {0};
+    uint64_t timeouts {0};
+    uint64_t errors {0};
+    uint64_t events {0};
+    uint64_t stale {0};     //well-formed frames that did not answer the oldest request
+    uint64_t noise {0};     //bytes discarded outside frames (old firmware log text, line noise)
+    uint64_t logs {0};      //<#...> firmware log frames received
+};
+
+//Serial transport for the DarkLight protocol.
+//Commands are queued by any thread and written by a dedicated I/O thread. Up to
+//maxInFlight frames may be outstanding at once; the firmware answers strictly in
+//order, so replies are matched to requests FIFO. Unsolicited <!...> event frames
+//are never matched to a request, they are queued and signalled on getEventFD().
+//Firmware debug output arrives as <#...> log frames and is queued the same way.
+//The receive side resynchronises on every '<': text between frames (the ESP32
+//shares the port with its debug log) is skipped, and a reply that does not fit
+//the oldest request is dropped as stale instead of being matched out of step.
+//Replies carry no sequence number and several have the same shape (P, L and R
+//answer one digit, B, M and G any number), so a timeout does not resend at
+//once: a late reply could then be matched to the next request. Instead a <V>
+//is sent as a barrier and every reply is dropped until the barrier's version
+//string comes back; as the firmware answers in order, nothing older can follow
+//it, and only then is everything in flight resent.
+//A reply cut short by log text is lost the same way and starts the same resync.
+class DLCTransport
+{
+    public:
+        DLCTransport() = default;
+        ~DLCTransport();
+
+        DLCTransport(const DLCTransport &) = delete;
+        DLCTransport &operator=(const DLCTransport &) = delete;
+
+        //take ownership of the I/O on an already opened port (does not close it)
+        bool start(int fd);
+        //stop the I/O thread and fail every pending request with DLCStatus::Stopped
+        void stop();
+        bool isRunning() const
+        {
+            return running;
+        }
+
+        //queue a command (without < >) and return a future for its reply
+        std::future<DLCReply> submit(const std::string &command);
+
+        void setTimeout(int ms)
+        {
+            timeoutMs = ms;
+        }
+        void setMaxRetries(int retries)
+        {
+            maxRetries = retries;
+        }
+        void setMaxInFlight(size_t frames)
+        {
+            maxInFlight = frames > 0 ? frames : 1;
+        }
+
+        DLCTransportStats getStats();
+
+        //readable whenever events are queued, for the INDI event loop
+        int getEventFD() const
+        {
+            return eventPipe[0];
+        }
+        //take every queued event frame (payload after the '!')
+        std::vector<std::string> takeEvents();
+        //take every queued firmware log line (payload after the '#'), call after takeEvents
+        std::vector<std::string> takeLogs();
+
+    private:
+        struct Request
+        {
+            std::string frame;
+            std::promise<DLCReply> promise;
+            int retries {0};
+            std::chrono::steady_clock::time_point deadline;
+        };
+
+        void run();
+        bool writeFrame(const std::string &frame);
+        void readAvailable();
+        void handleFrame(const std::string &value);
+        void queueLog(const std::string &line);
+        static bool isFrameChar(char c);
+        static bool replyMatches(const std::string &frame, const std::string &reply);
+        void completeFront(DLCStatus status, const std::string &value);
+        void dropPartialReply();
+        void handleTimeout();
+        void startResync(size_t versionsAhead);
+        void finishResync();
+        void failAll(DLCStatus status);
+        void wake();
+
+        int fd {-1};
+        int wakePipe[2] {-1, -1};
+        int eventPipe[2] {-1, -1};
+        std::thread ioThread;
+        std::atomic<bool> running {false};
+
+        std::mutex queueMutex;
+        std::deque<Request> pending;    //waiting to be written, guarded by queueMutex
+        std::deque<Request> inFlight;   //written, awaiting reply, I/O thread only
+
+        //after a timeout, I/O thread only: waiting for the <V> barrier's reply
+        bool resyncing {false};
+        bool resyncHeard {false};       //a reply arrived since the last barrier was sent
+        size_t resyncSkips {0};         //version replies still due ahead of the barrier's
+        std::chrono::steady_clock::time_point resyncDeadline;
+
+        //receive framing, persists across reads, I/O thread only
+        static const size_t MAX_FRAME_CHARS = 160;
+        char frameBuffer[MAX_FRAME_CHARS];
+        size_t frameLength {0};
+        bool inFrame {false};
+        bool inLogFrame {false};
+
+        std::mutex eventMutex;
+        std::vector<std::string> events;
+        static const size_t MAX_QUEUED_LOGS = 64;
+        std::deque<std::string> logs;   //oldest dropped when nobody collects them
+
+        std::atomic<int> timeoutMs {5000};
+        std::atomic<int> maxRetries {3};
+        std::atomic<size_t> maxInFlight {8};
+
+        std::mutex statsMutex;
+        DLCTransportStats stats;
+};
@@ -0,0 +1,340 @@
+/*******************************************************************
+Creative Commons Attribution-NonCommercial License
+
+Copyright © 2020-2025 Nathan Woelfle
+
+This work is licensed under a Creative Commons Attribution-NonCommercial 4.0 International License.
+
+You are free to:
+
+    Share — copy and redistribute the material in any medium or format
+    Adapt — remix, transform, and build upon the material
+
+Under the following conditions:
+
+    Attribution — You must give appropriate credit, provide a link to the license, and indicate if changes were made. You may do so in any reasonable manner, but not in any way that suggests the licensor endorses you or your use.
+    NonCommercial — You may not use the material for commercial purposes.
+    No additional restrictions — You may not apply legal terms or technological measures that legally restrict others from doing anything the license permits.
+
+Notices:
+
+    You may not use this work for commercial purposes without written permission from the copyright holder.
+    This work is provided "as is" without warranty of any kind, either express or implied, including but not limited to the warranties of merchantability, fitness for a particular purpose, and noninfringement. In no event shall the authors or copyright holders be liable for any claim, damages, or other liability, whether in an action of contract, tort, or otherwise, arising from, out of, or in connection with the software or the use or other dealings in the software.
+
+Scope:
+
+    This license applies to both the hardware and software components of the DarkLight Cover Calibrator.
+
+Modified Versions:
+
+    You are permitted to create modified versions of the DarkLight Cover Calibrator for non-commercial use, provided that you:
+        Retain the original copyright notice and license terms.
+        Include a clear reference to the original creator (Nathan Woelfle) and provide a link to the original work.
+
+Jurisdiction:
+
+    This license is governed by the laws of the United States of America, and by international copyright laws and treaties.
+
+For more information, please refer to the full terms of the Creative Commons Attribution-NonCommercial 4.0 International License: https://creativecommons.org/licenses/by-nc/4.0/
+*******************************************************************/
+
+//DLCTransport tests against a stub device on a socketpair.
+//The stub answers like the firmware, strictly in order, and can hold one reply
+//back past the transport's timeout. It can also mix the port's other traffic
+//into its replies: plain log text, abandoned partial frames, <#...> log frames
+//and <!...> event frames. Each scenario checks that every request gets the
+//reply to its own command and that every event and log frame is delivered.
+//Run by ctest (BUILD_DLC_TESTS=ON).
+//
+//  dlc_transport_test
+
+#include "dlc_transport.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+
+const int TIMEOUT_MS = 200;
+
+//replies of the stub; P/L/R and B share a shape on purpose
+std::string stubReply(const std::string &command)
+{
+    switch (command[0])
+    {
+        case 'P':
+            return "1";
+        case 'L':
+            return "3";
+        case 'R':
+            return "2";
+        case 'B':
+            return "4";
+        case 'M':
+            return "255";
+        case 'V':
+            return "v2.2.0";
+        default:
+            return command;
+    }
+}
+
+//what the stub writes around its replies
+enum class Noise
+{
+    None,
+    Interleaved,    //log text, partial frames, log and event frames before every reply
+    SplitReply      //log text written into the middle of the delayFrame'th reply
+};
+
+const char *const LOG_LINE = "[INF][HEATER] Output 40%";
+const char *const EVENT = "P1";
+
+class StubDevice
+{
+    public:
+        //hold the reply to the delayFrame'th frame (0-based) back for delayMs
+        StubDevice(int fd, int delayFrame, int delayMs, Noise noise)
+            : fd(fd), delayFrame(delayFrame), delayMs(delayMs), noise(noise)
+        {
+            thread = std::thread(&StubDevice::run, this);
+        }
+        ~StubDevice()
+        {
+            shutdown(fd, SHUT_RDWR);
+            thread.join();
+        }
+
+        int eventsSent() const
+        {
+            return events;
+        }
+        int logsSent() const
+        {
+            return logs;
+        }
+
+    private:
+        void run()
+        {
+            std::string frame;
+            bool inFrame = false;
+            int frames = 0;
+            char c;
+            while (read(fd, &c, 1) == 1)
+            {
+                if (c == '<')
+                {
+                    inFrame = true;
+                    frame.clear();
+                }
+                else if (c == '>' && inFrame)
+                {
+                    inFrame = false;
+                    bool delayed = frames++ == delayFrame;
+                    if (delayed)
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+                    }
+                    if (!reply(stubReply(frame), frames, delayed))
+                    {
+                        return;
+                    }
+                }
+                else if (inFrame)
+                {
+                    frame += c;
+                }
+            }
+        }
+
+        bool reply(const std::string &value, int frame, bool delayed)
+        {
+            if (noise == Noise::SplitReply && delayed)
+            {
+                //the reply is lost, the transport has to time out and resend
+                return writeBytes("<" + value.substr(0, 1)) && writeBytes("[INF][COVER] Opening\r\n") &&
+                       writeBytes(value.substr(1) + ">");
+            }
+            if (noise != Noise::Interleaved)
+            {
+                return writeBytes("<" + value + ">");
+            }
+
+            switch (frame % 4)
+            {
+                case 0:
+                    //log text from firmware without <#...> frames
+                    if (!writeBytes("[INF][COVER] Opening\r\n"))
+                    {
+                        return false;
+                    }
+                    break;
+                case 1:
+                    logs++;
+                    if (!writeBytes(std::string("<#") + LOG_LINE + ">"))
+                    {
+                        return false;
+                    }
+                    break;
+                case 2:
+                    //an event, then a '<' inside log text
+                    events++;
+                    if (!writeBytes(std::string("<!") + EVENT + ">[WRN][COVER] Position < 50\r\n"))
+                    {
+                        return false;
+                    }
+                    break;
+                default:
+                    //once, a partial frame abandoned for log text and read apart
+                    //from the reply; it costs a resync, so not on every frame
+                    if (!partialSent && !writeBytes("<2"))
+                    {
+                        return false;
+                    }
+                    partialSent = true;
+                    if (!writeBytes("[INF][COVER] Closing\r\n"))
+                    {
+                        return false;
+                    }
+                    break;
+            }
+            return writeBytes("<" + value + ">");
+        }
+
+        //one write, paced so that consecutive ones arrive in separate reads; no
+        //SIGPIPE when the test shuts the socket down under a late reply
+        bool writeBytes(const std::string &bytes)
+        {
+            if (send(fd, bytes.data(), bytes.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(bytes.size()))
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            return true;
+        }
+
+        int fd;
+        int delayFrame;
+        int delayMs;
+        Noise noise;
+        std::atomic<int> events {0};
+        std::atomic<int> logs {0};
+        bool partialSent {false};
+        std::thread thread;
+};
+
+//submit the first batch, wait, submit the second, then check every reply and
+//that the events and log lines the stub sent were all delivered
+bool runScenario(const char *name, const std::vector<std::string> &first, int gapMs,
+                 const std::vector<std::string> &second, int delayFrame, int delayMs, Noise noise)
+{
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+    {
+        perror("socketpair");
+        return false;
+    }
+
+    bool passed = true;
+    {
+        StubDevice device(fds[1], delayFrame, delayMs, noise);
+        DLCTransport transport;
+        transport.setTimeout(TIMEOUT_MS);
+        transport.setMaxRetries(3);
+        transport.setMaxInFlight(8);
+        transport.start(fds[0]);
+
+        std::vector<std::pair<std::string, std::future<DLCReply>>> replies;
+        for (const std::string &command : first)
+        {
+            replies.emplace_back(command, transport.submit(command));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(gapMs));
+        for (const std::string &command : second)
+        {
+            replies.emplace_back(command, transport.submit(command));
+        }
+
+        for (auto &entry : replies)
+        {
+            DLCReply reply = entry.second.get();
+            std::string expected = stubReply(entry.first);
+            if (reply.status != DLCStatus::Ok || reply.value != expected)
+            {
+                fprintf(stderr, "%s: <%s> got status %d \"%s\", expected \"%s\"\n", name, entry.first.c_str(),
+                        static_cast<int>(reply.status), reply.value.c_str(), expected.c_str());
+                passed = false;
+            }
+        }
+
+        //every event and log frame came before the last reply
+        std::vector<std::string> events = transport.takeEvents();
+        std::vector<std::string> logs = transport.takeLogs();
+        size_t goodEvents = std::count(events.begin(), events.end(), EVENT);
+        size_t goodLogs = std::count(logs.begin(), logs.end(), LOG_LINE);
+        if (events.size() != static_cast<size_t>(device.eventsSent()) || goodEvents != events.size())
+        {
+            fprintf(stderr, "%s: got %zu events (%zu intact), expected %d\n", name, events.size(), goodEvents,
+                    device.eventsSent());
+            passed = false;
+        }
+        if (logs.size() != static_cast<size_t>(device.logsSent()) || goodLogs != logs.size())
+        {
+            fprintf(stderr, "%s: got %zu log lines (%zu intact), expected %d\n", name, logs.size(), goodLogs,
+                    device.logsSent());
+            passed = false;
+        }
+
+        DLCTransportStats stats = transport.getStats();
+        printf("%s: %s (retries %llu, stale %llu, noise %llu)\n", name, passed ? "ok" : "FAILED",
+               static_cast<unsigned long long>(stats.retries), static_cast<unsigned long long>(stats.stale),
+               static_cast<unsigned long long>(stats.noise));
+        transport.stop();
+    }
+
+    close(fds[0]);
+    close(fds[1]);
+    return passed;
+}
+
+}//end of anonymous namespace
+
+int main()
+{
+    bool passed = true;
+
+    //no delay: plain pipelining
+    passed &= runScenario("pipelined", {"P", "L", "B", "R", "M", "V"}, 0, {}, -1, 0, Noise::None);
+
+    //[P,L] times out while the P reply is late, then [B,R] is queued
+    passed &= runScenario("late-then-queued", {"P", "L"}, TIMEOUT_MS + 50, {"B", "R"}, 0, TIMEOUT_MS + 100,
+                          Noise::None);
+
+    //a mixed batch in flight when the P reply is late
+    passed &= runScenario("late-in-batch", {"P", "L", "B", "R", "P", "L", "B", "R"}, 0, {}, 0, TIMEOUT_MS + 100,
+                          Noise::None);
+
+    //late reply in the middle of the batch, a V among the requests
+    passed &= runScenario("late-mid-batch", {"L", "V", "B", "R", "P"}, 0, {"B", "R"}, 2, TIMEOUT_MS + 100, Noise::None);
+
+    //late by more than two timeouts, so the barrier itself times out once
+    passed &= runScenario("late-twice", {"P", "L", "B"}, 0, {"R"}, 0, 2 * TIMEOUT_MS + 100, Noise::None);
+
+    //log text, partial frames, log and event frames around every reply
+    passed &= runScenario("interleaved", {"P", "L", "B", "R", "M", "V", "P", "L"}, 0, {}, -1, 0,
+                          Noise::Interleaved);
+
+    //the same while the P reply is late, so stale replies come with the noise
+    passed &= runScenario("interleaved-late", {"P", "L", "B", "R"}, 0, {"M", "P"}, 0, TIMEOUT_MS + 100,
+                          Noise::Interleaved);
+
+    //log text splits the B reply, which is lost and resent
+    passed &= runScenario("split-reply", {"P", "L", "B", "R"}, 0, {"M"}, 2, 0, Noise::SplitReply);
+
+    return passed ? 0 : 1;
+}//end of main